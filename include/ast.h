@@ -35,6 +35,7 @@ typedef struct {
 typedef struct ASTNode ASTNode;
 typedef struct ASTNodeList ASTNodeList;
 typedef struct ASTProgram ASTProgram;
+typedef struct ASTArena ASTArena;
 
 /* ============================================================================
  * AST NODE TYPES
@@ -142,6 +143,7 @@ struct ASTNodeList {
     ASTNode **nodes;
     size_t count;
     size_t capacity;
+    ASTArena *arena;        /* Arena holding the list and its array, or NULL */
 };
 
 /* ============================================================================
@@ -150,13 +152,21 @@ struct ASTNodeList {
  */
 struct ASTNode {
     ASTNodeType type;
+    DataType elem_type;     /* Element type of a list: declared on a list
+                               declaration, filled by semantic analysis on
+                               list-valued expressions and on calls of list
+                               builtins (the element type the call works on);
+                               TYPE_UNKNOWN otherwise */
     SourceLocation loc;
-    DataType data_type;     /* Resolved type (filled by semantic analysis) */
+    DataType data_type;     /* Resolved type (filled by semantic analysis); for
+                               ask/read the target's, for for-each the iterator's */
+    int in_arena;           /* Allocated from an ASTArena (not freed one by one) */
     
     union {
         /* AST_PROGRAM */
         struct {
             ASTNodeList *statements;
+            ASTArena *arena;    /* Arena owning the whole tree, or NULL */
         } program;
         
         /* AST_VAR_DECL */
@@ -373,12 +383,50 @@ ASTNode *ast_create_func_call(const char *name, ASTNodeList *args, SourceLocatio
 ASTNode *ast_create_index(ASTNode *array, ASTNode *index, SourceLocation loc);
 ASTNode *ast_create_list(ASTNodeList *elements, SourceLocation loc);
 
+/* ============================================================================
+ * AST ARENA
+ * ============================================================================
+ * Bump allocator for whole trees. While an arena is current on the calling
+ * thread, ast_create_* and the node list functions allocate nodes, lists
+ * and copied names from it. Arena nodes are never freed one by one:
+ * ast_free() ignores them, except on a program node that owns its arena
+ * (data.program.arena), where it releases the arena and so the whole tree.
+ * The parser builds every tree this way (see naturelang_parse_ctx).
+ */
+
+/* Create an empty arena (the first block is allocated on first use) */
+ASTArena *ast_arena_create(void);
+
+/* Release every block of the arena; all trees built in it become invalid */
+void ast_arena_destroy(ASTArena *arena);
+
+/* Invalidate every tree built in the arena, keeping its newest block for
+ * the next one (the streaming parser resets after each statement) */
+void ast_arena_reset(ASTArena *arena);
+
+/* Make arena current on this thread (NULL = malloc); returns the previous one */
+ASTArena *ast_arena_set_current(ASTArena *arena);
+
+/* Arena used by ast_create_* on this thread, or NULL */
+ASTArena *ast_arena_current(void);
+
+/* Zeroed, suitably aligned memory from the arena (exits on out-of-memory) */
+void *ast_arena_alloc(ASTArena *arena, size_t size);
+
+/* Copy a NUL-terminated string into the arena (NULL stays NULL) */
+char *ast_arena_strdup(ASTArena *arena, const char *str);
+
+/* Bytes handed out by the arena / reserved in its blocks */
+size_t ast_arena_used(const ASTArena *arena);
+size_t ast_arena_reserved(const ASTArena *arena);
+
 /* ============================================================================
  * AST UTILITY FUNCTIONS
  * ============================================================================
  */
 
-/* Free an AST node and all children */
+/* Free an AST node and all children (a single arena release for parser trees;
+ * iterative otherwise, so any depth is safe) */
 void ast_free(ASTNode *node);
 
 /* Get string representation of node type */
@@ -396,6 +444,65 @@ void ast_print(ASTNode *node, int indent);
 /* Deep clone an AST node */
 ASTNode *ast_clone(ASTNode *node);
 
+/* ============================================================================
+ * ITERATIVE TRAVERSAL
+ * ============================================================================
+ * Trees can be far deeper than the C stack allows: a generated chain of a
+ * million `plus` terms is a million levels deep (left-recursive rules keep
+ * the parser stack flat, so nothing stops it earlier). Passes over such
+ * trees keep their own stack of frames instead of recursing. A frame
+ * records how many children of its node have been visited so far; the
+ * first AST_WALK_INLINE frames live inside the stack object, so walks over
+ * ordinary trees never allocate.
+ *
+ *     ast_walk_push(&stack, root);
+ *     while (stack.count > 0) {
+ *         ASTWalkFrame *f = ast_walk_top(&stack);
+ *         if (f->next < ast_child_count(f->node)) {
+ *             ast_walk_push(&stack, ast_child(f->node, f->next++));
+ *             continue;
+ *         }
+ *         ... post-order work on f->node ...
+ *         ast_walk_pop(&stack);
+ *     }
+ */
+#define AST_WALK_INLINE 64
+
+typedef struct {
+    ASTNode *node;          /* May be NULL (absent optional child) */
+    size_t next;            /* Children pushed so far */
+    union {
+        void *ptr;
+        long num;
+    } aux;                  /* Per-pass scratch, zero on push */
+} ASTWalkFrame;
+
+typedef struct {
+    ASTWalkFrame *frames;   /* inline_frames until the walk gets deeper */
+    size_t count;
+    size_t capacity;
+    ASTWalkFrame inline_frames[AST_WALK_INLINE];
+} ASTWalkStack;
+
+void ast_walk_init(ASTWalkStack *stack);
+void ast_walk_free(ASTWalkStack *stack);
+
+/* Push a frame for node and return it (earlier frame pointers may move) */
+ASTWalkFrame *ast_walk_push(ASTWalkStack *stack, ASTNode *node);
+
+/* Topmost frame, or NULL when the stack is empty */
+ASTWalkFrame *ast_walk_top(ASTWalkStack *stack);
+void ast_walk_pop(ASTWalkStack *stack);
+
+/*
+ * Children of a node in source order, the order ast_visit() uses: list
+ * items (statements, parameters, arguments, elements) and then the pointer
+ * fields as declared in struct ASTNode. Optional children that are absent
+ * (an if without else) are returned as NULL.
+ */
+size_t ast_child_count(const ASTNode *node);
+ASTNode *ast_child(const ASTNode *node, size_t index);
+
 /* ============================================================================
  * AST VISITOR PATTERN (for traversal)
  * ============================================================================
@@ -410,7 +517,12 @@ struct ASTVisitor {
     ASTVisitFunc visit_post;    /* Called after visiting children */
 };
 
-/* Visit all nodes in the AST */
+/* Visit all nodes in the AST (iteratively, so any depth is safe) */
 void ast_visit(ASTNode *node, ASTVisitor *visitor);
 
+/* Heap bytes held by an AST: nodes, child lists and owned strings
+ * (allocator overhead not included; for an arena-owning program, the
+ * bytes its arena handed out, including arrays left behind by list growth) */
+size_t ast_memory_usage(ASTNode *node);
+
 #endif /* NATURELANG_AST_H */
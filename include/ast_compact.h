@@ -0,0 +1,167 @@
+/*
+ * NatureLang Compiler
+ * Copyright (c) 2026
+ *
+ * Compact AST Encoding
+ *
+ * A flat, index-based copy of a parsed tree for passes that walk large
+ * programs. Nodes live in one typed pool and refer to each other by 32-bit
+ * index instead of by pointer; each node is a fixed 12-byte header plus a
+ * payload of 32-bit words sized for its kind (a `break` has none, a call
+ * has one word per argument). Names are interned in a string pool, and a
+ * source location is a single 32-bit byte offset into the file, turned back
+ * into line and column through a per-file line table.
+ *
+ * Nodes are read through the accessor functions below, so that semantic.c,
+ * ir.c and codegen.c can move from `node->data.x.y` to the compact form one
+ * access at a time:
+ *
+ *     node->data.if_stmt.condition      ast_compact_field(ac, n, AST_FIELD_CONDITION)
+ *     node->data.block.statements->...  ast_compact_list_count / ast_compact_list_item
+ *     node->data.identifier.name        ast_compact_name(ac, n)
+ *     node->loc                         ast_compact_location(ac, n)
+ */
+
+#ifndef NATURELANG_AST_COMPACT_H
+#define NATURELANG_AST_COMPACT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "ast.h"
+
+/* Index of a node in an ASTCompact pool; AST_REF_NULL is "no node" */
+typedef uint32_t ASTRef;
+#define AST_REF_NULL        ((ASTRef)0)
+
+/* Location offset of nodes without a line number */
+#define AST_LOC_NONE        UINT32_MAX
+
+/* Fixed part of every node (12 bytes) */
+typedef struct {
+    uint8_t type;           /* ASTNodeType */
+    uint8_t data_type;      /* DataType (filled by semantic analysis) in the low
+                               four bits, a list's element type in the high four */
+    uint8_t op;             /* Operator, or the declared DataType of a declaration */
+    uint8_t flag;           /* is_const, is_safe or the value of a bool literal */
+    uint32_t loc;           /* Byte offset into the file, or AST_LOC_NONE */
+    uint32_t payload;       /* First payload word in ASTCompact.words */
+} ASTCompactNode;
+
+typedef struct {
+    ASTCompactNode *nodes;  /* nodes[0] is the unused AST_REF_NULL slot */
+    uint32_t node_count;
+    uint32_t node_capacity;
+
+    uint32_t *words;        /* Payloads: child refs, string offsets, list counts */
+    uint32_t word_count;
+    uint32_t word_capacity;
+
+    char *strings;          /* Interned NUL-terminated strings; offset 0 is NULL */
+    uint32_t string_size;
+    uint32_t string_capacity;
+
+    uint32_t *line_starts;  /* Byte offset of the start of each line (line 1 first) */
+    uint32_t line_count;
+    const char *filename;   /* Shared by every location of the tree */
+    int has_columns;        /* Locations carry columns (else first_column reads 0) */
+
+    ASTRef root;
+} ASTCompact;
+
+/*
+ * Named children, for ast_compact_field(). Each name stands for the
+ * pointer field of the same name in struct ASTNode; asking a node kind for
+ * a field it does not have returns AST_REF_NULL.
+ */
+typedef enum {
+    AST_FIELD_INITIALIZER,  /* var_decl */
+    AST_FIELD_BODY,         /* func_decl, while, repeat, for_each, secure_zone */
+    AST_FIELD_TARGET,       /* assign */
+    AST_FIELD_VALUE,        /* assign, return, display */
+    AST_FIELD_CONDITION,    /* if, while */
+    AST_FIELD_THEN,         /* if */
+    AST_FIELD_ELSE,         /* if */
+    AST_FIELD_COUNT,        /* repeat */
+    AST_FIELD_ITERABLE,     /* for_each */
+    AST_FIELD_PROMPT,       /* ask */
+    AST_FIELD_LEFT,         /* binary_op */
+    AST_FIELD_RIGHT,        /* binary_op */
+    AST_FIELD_OPERAND,      /* unary_op, ternary_op */
+    AST_FIELD_LOWER,        /* ternary_op */
+    AST_FIELD_UPPER,        /* ternary_op */
+    AST_FIELD_ARRAY,        /* index */
+    AST_FIELD_INDEX,        /* index */
+    AST_FIELD_EXPR          /* expr_stmt */
+} ASTCompactField;
+
+/* ============================================================================
+ * BUILDING
+ * ============================================================================
+ */
+
+/*
+ * Encode the tree under root. source/length is the text the tree was
+ * parsed from and gives the exact line table; with source == NULL the
+ * table is derived from the locations in the tree, which keeps every
+ * line/column pair distinct but not the true byte offsets.
+ */
+ASTCompact *ast_compact_build(const ASTNode *root, const char *source, size_t length);
+
+/* Release the pools (the tree it was built from is not touched) */
+void ast_compact_free(ASTCompact *ac);
+
+/* Rebuild a pointer tree (through ast_create_*, so into the current arena if any) */
+ASTNode *ast_compact_expand(const ASTCompact *ac, ASTRef ref);
+
+/* Bytes held by the pools (used part only) */
+size_t ast_compact_memory_usage(const ASTCompact *ac);
+
+/* ============================================================================
+ * NODE ACCESSORS
+ * ============================================================================
+ */
+
+ASTNodeType ast_compact_type(const ASTCompact *ac, ASTRef ref);
+DataType ast_compact_data_type(const ASTCompact *ac, ASTRef ref);
+void ast_compact_set_data_type(ASTCompact *ac, ASTRef ref, DataType type);
+DataType ast_compact_elem_type(const ASTCompact *ac, ASTRef ref);
+
+/* Start of the node; last_line/last_column repeat the start */
+SourceLocation ast_compact_location(const ASTCompact *ac, ASTRef ref);
+
+/* Line of the node (0 if unknown), without building a SourceLocation */
+int ast_compact_line(const ASTCompact *ac, ASTRef ref);
+
+/* Named pointer child (see ASTCompactField) */
+ASTRef ast_compact_field(const ASTCompact *ac, ASTRef ref, ASTCompactField field);
+
+/*
+ * The node list of a program, block, list literal, function declaration
+ * (parameters) or call (arguments); 0 items for other kinds.
+ */
+uint32_t ast_compact_list_count(const ASTCompact *ac, ASTRef ref);
+ASTRef ast_compact_list_item(const ASTCompact *ac, ASTRef ref, uint32_t index);
+
+/* All children in source order, for generic walks (may include AST_REF_NULL) */
+uint32_t ast_compact_child_count(const ASTCompact *ac, ASTRef ref);
+ASTRef ast_compact_child(const ASTCompact *ac, ASTRef ref, uint32_t index);
+
+/*
+ * Name of a declaration, parameter, for-each iterator, identifier or call,
+ * or the target variable of ask/read; NULL for other kinds.
+ */
+const char *ast_compact_name(const ASTCompact *ac, ASTRef ref);
+
+Operator ast_compact_operator(const ASTCompact *ac, ASTRef ref);
+
+/* var_type, param_type or return_type */
+DataType ast_compact_declared_type(const ASTCompact *ac, ASTRef ref);
+
+/* is_const (var_decl), is_safe (secure_zone) or value (bool literal) */
+int ast_compact_flag(const ASTCompact *ac, ASTRef ref);
+
+long long ast_compact_int_value(const ASTCompact *ac, ASTRef ref);
+double ast_compact_float_value(const ASTCompact *ac, ASTRef ref);
+const char *ast_compact_string_value(const ASTCompact *ac, ASTRef ref);
+
+#endif /* NATURELANG_AST_COMPACT_H */
@@ -46,7 +46,6 @@ typedef struct CodegenContext {
     char error_message[1024];
     int in_function;          /* Track if we're in a function body */
     int in_loop;              /* Track if we're in a loop */
-    int needs_input_buffer;   /* Track if program uses input */
     int needs_list_support;   /* Track if program uses lists */
 } CodegenContext;
 
@@ -0,0 +1,70 @@
+/*
+ * NatureLang Compiler
+ * Copyright (c) 2026
+ *
+ * Hand-Written Lexer Header
+ *
+ * Alternative parser-mode lexer that produces the same token stream as
+ * the flex scanner (naturelang.l built with USE_BISON_TOKENS) without a
+ * DFA: whitespace, comments and string bodies are skipped with SSE2/AVX2
+ * block scans, and words and multi-word phrases are recognized with a
+ * build-time perfect hash (lexer_words.def).
+ *
+ * The parser uses it when built with `make LEXER_BACKEND=fast`; the
+ * bridge in fast_lexer_bridge.c then provides yylex() and friends.
+ * `make test-lexer-diff` compares both lexers token by token.
+ */
+
+#ifndef NATURELANG_FAST_LEXER_H
+#define NATURELANG_FAST_LEXER_H
+
+#include <stddef.h>
+
+/* Token numbers and YYSTYPE/YYLTYPE come from the Bison header */
+#include "naturelang.tab.h"
+
+/* Copy of the last lexeme returned by fast_lexer_text() */
+#define FAST_LEXER_TEXT_MAX 256
+
+typedef enum {
+    FAST_LEXER_NORMAL,      /* Between tokens */
+    FAST_LEXER_IN_STRING,   /* Hit end of input inside a string literal */
+    FAST_LEXER_IN_COMMENT   /* Hit end of input inside a block comment */
+} FastLexerMode;
+
+typedef struct {
+    char *cur;                  /* Next unread byte */
+    char *end;                  /* End of the source text (first padding NUL) */
+    char *line_start;           /* First byte of the current line */
+    char *tok_start;            /* Last returned lexeme */
+    size_t tok_len;
+    int line;                   /* Current line (same as flex yylineno) */
+    FastLexerMode mode;
+    const char *filename;       /* Name used in diagnostics */
+    int error_count;
+    char text[FAST_LEXER_TEXT_MAX];
+} FastLexer;
+
+/*
+ * Start lexing base[0 .. size-3] in place; base[size-2] and base[size-1]
+ * must be NUL (see SOURCE_BUFFER_PADDING). String literals are decoded
+ * in place, so the buffer must be writable and outlive the tokens.
+ *
+ * @return 0 on success, -1 if the buffer is not properly terminated.
+ */
+int fast_lexer_init(FastLexer *lx, char *base, size_t size, const char *filename);
+
+/*
+ * Scan the next token.
+ *
+ * @return Bison token number, or 0 at end of input.
+ */
+int fast_lexer_next(FastLexer *lx, YYSTYPE *lval, YYLTYPE *lloc);
+
+/* Current line number (counts every newline consumed so far) */
+int fast_lexer_lineno(const FastLexer *lx);
+
+/* NUL-terminated copy of the last lexeme (truncated), for diagnostics */
+const char *fast_lexer_text(FastLexer *lx);
+
+#endif /* NATURELANG_FAST_LEXER_H */
@@ -81,6 +81,10 @@ typedef enum {
 
     /* String operations */
     TAC_CONCAT,         /* result = arg1 + arg2 (string concat) */
+    TAC_STRBUF_BEGIN,   /* result = new empty string builder */
+    TAC_STRBUF_APPEND,  /* append arg2, formatted as text, to builder arg1 */
+    TAC_STRBUF_END,     /* result = text of builder arg1 (leaves it empty) */
+    TAC_STRBUF_TEXT,    /* result = copy of builder arg1's text so far */
 
     /* Control flow helpers */
     TAC_BREAK,          /* break out of loop */
@@ -92,11 +96,12 @@ typedef enum {
     TAC_SECURE_BEGIN,   /* secure zone begin */
     TAC_SECURE_END,     /* secure zone end */
 
-    /* List operations */
+    /* List operations (the instruction's elem_type says what the list holds) */
     TAC_LIST_CREATE,    /* result = create_list(count) */
     TAC_LIST_APPEND,    /* list_append(list, item) */
     TAC_LIST_GET,       /* result = list[index] */
     TAC_LIST_SET,       /* list[index] = value */
+    TAC_LIST_ITEM,      /* result = list[index], index known to be in range */
 
     /* No-op (for optimization passes) */
     TAC_NOP,
@@ -142,6 +147,10 @@ typedef struct {
  */
 typedef struct TACInstr {
     TACOpcode opcode;
+    DataType elem_type;     /* Element type of a LIST_* instruction's list; for
+                               a CALL the call's AST elem_type (what a returned
+                               list holds, or what a list builtin works on);
+                               TYPE_UNKNOWN for untyped lists and other opcodes */
     TACOperand result;      /* Destination */
     TACOperand arg1;        /* First source operand */
     TACOperand arg2;        /* Second source operand */
@@ -216,6 +225,19 @@ Unique labels are required so gotos always jump to the correct place.*/
 /* Generate TAC IR from a validated AST */
 TACProgram *ir_generate(ASTNode *ast);
 
+/*
+ * Streaming IR generation: lower top-level statements one at a time, in
+ * order, as the streaming parser hands them over. The TAC copies what it
+ * needs, so each statement only has to live for its call. The result is
+ * the program ir_generate would build from the whole tree.
+ */
+typedef struct IRStream IRStream;
+
+IRStream *ir_stream_create(void);
+void ir_stream_statement(IRStream *stream, ASTNode *statement);
+/* Finish the program and free the stream */
+TACProgram *ir_stream_finish(IRStream *stream);
+
 /* Free all IR resources */
 void ir_free(TACProgram *program);
 
@@ -259,6 +281,10 @@ TACInstr *tac_emit3(TACFunction *func, TACOpcode op,
                     TACOperand result, TACOperand arg1,
                     TACOperand arg2, TACOperand arg3);
 
+/* Insert an instruction in front of `at` (for optimization passes) */
+TACInstr *tac_insert_before(TACFunction *func, TACInstr *at, TACOpcode op,
+                            TACOperand result, TACOperand arg1, TACOperand arg2);
+
 /* Emit a label */
 TACInstr *tac_emit_label(TACFunction *func, int label_id);
 
@@ -23,6 +23,8 @@ typedef struct {
     int emit_comments;        /* Include TAC comment annotations */
     int emit_debug_info;      /* Include line number comments */
     int indent_size;          /* Indentation spaces (default: 4) */
+    int narrow_integers;      /* Declare provably small numbers as int32_t/int16_t/int8_t */
+    int release_regions;      /* Release function and secure zone allocations in one step */
 } IRCodegenOptions;
 
 /* ============================================================================
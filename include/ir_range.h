@@ -0,0 +1,61 @@
+/*
+ * NatureLang Compiler
+ * Copyright (c) 2026
+ *
+ * Integer Range Analysis Header
+ *
+ * Computes, for every `number` temporary and variable of a TAC function,
+ * an interval that holds every value it can take at run time. The code
+ * generator uses it to declare provably small values (loop counters,
+ * indices, small accumulators) as int32_t, int16_t or int8_t instead of
+ * long long.
+ *
+ * The analysis is flow-insensitive (one interval per temp or variable
+ * name) with one exception: a counter that a loop only ever steps in one
+ * direction is bounded by the loop's exit test, so
+ *
+ *     t3 = ASSIGN 0
+ *   L0:
+ *     t4 = t3 GTE 1000
+ *     if t4 goto L1
+ *     ...
+ *     t3 = t3 ADD 1
+ *     goto L0
+ *
+ * gives t3 the range [0, 1000].
+ */
+
+#ifndef NATURELANG_IR_RANGE_H
+#define NATURELANG_IR_RANGE_H
+
+#include "ir.h"
+
+/* Closed interval; empty when lo > hi */
+typedef struct {
+    long long lo;
+    long long hi;
+} IRRange;
+
+typedef struct IRRangeInfo IRRangeInfo;
+
+/* Analyze one function (parameters are taken as unbounded) */
+IRRangeInfo *ir_range_analyze(const TACFunction *func);
+
+/* Release an analysis result */
+void ir_range_free(IRRangeInfo *info);
+
+/*
+ * Range of a `number` operand: a literal's value, or the interval of the
+ * temp or variable it names. Operands of other types and names the
+ * function never mentions are unbounded.
+ */
+IRRange ir_range_of(const IRRangeInfo *info, const TACOperand *op);
+
+/*
+ * Narrowest signed C integer width (8, 16, 32 or 64 bits) holding every
+ * value of the operand; 64 for everything that is not a `number` temp
+ * or variable.
+ */
+int ir_range_width(const IRRangeInfo *info, const TACOperand *op);
+
+#endif /* NATURELANG_IR_RANGE_H */
@@ -0,0 +1,57 @@
+/*
+ * NatureLang Compiler
+ * Copyright (c) 2026
+ *
+ * Region Analysis Header
+ *
+ * Decides where the generated code may open an allocation region (see
+ * nl_region_enter in the runtime): around a function activation or a
+ * secure zone, when nothing allocated inside can still be reached after
+ * it ends. The code generator brackets those with
+ *
+ *     NLRegionMark _nl_region = nl_region_enter();
+ *     ...
+ *     nl_region_leave(_nl_region);
+ *
+ * so that, with the runtime in region mode, every string and list they
+ * built is released in one step.
+ *
+ * Text and list values (and string builders) are what can hold region
+ * memory. They get out of a function or zone by
+ *
+ *  - being returned (functions returning `text` or `list` are rejected),
+ *  - being written to a variable declared outside it,
+ *  - being stored into a list that was not created inside it,
+ *  - being appended to a string builder begun outside it,
+ *  - a temp computed inside a zone being read after it, or
+ *  - a call to a user function that does any of the above itself.
+ *
+ * Calls are resolved over the whole program, so the effects of a callee
+ * are known before any caller is judged.
+ */
+
+#ifndef NATURELANG_IR_REGION_H
+#define NATURELANG_IR_REGION_H
+
+#include "ir.h"
+#include <stdbool.h>
+
+typedef struct IRRegionInfo IRRegionInfo;
+
+/* Analyze every function of a program */
+IRRegionInfo *ir_region_analyze(const TACProgram *prog);
+
+/* Release an analysis result */
+void ir_region_free(IRRegionInfo *info);
+
+/* Whether everything a call of `func` allocates is dead once it returns */
+bool ir_region_function(const IRRegionInfo *info, const TACFunction *func);
+
+/*
+ * Whether everything allocated between `zone` (a TAC_SECURE_BEGIN of
+ * `func`) and its matching TAC_SECURE_END is dead after the zone.
+ */
+bool ir_region_zone(const IRRegionInfo *info, const TACFunction *func,
+                    const TACInstr *zone);
+
+#endif /* NATURELANG_IR_REGION_H */
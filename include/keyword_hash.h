@@ -0,0 +1,52 @@
+/*
+ * NatureLang Compiler
+ * Copyright (c) 2026
+ *
+ * Keyword Perfect-Hash Primitives
+ *
+ * Hash functions shared by the build-time generator (gen_keyword_hash)
+ * and the runtime lookup in tokens.c. The generator searches for one
+ * displacement per bucket so that every keyword lands in its own slot
+ * of a table exactly as large as the keyword set (hash-and-displace).
+ *
+ * Case folding is part of the hash: ASCII letters are folded to
+ * lowercase byte-by-byte while hashing, so "Display", "DISPLAY" and
+ * "display" reach the same slot without a lowercase copy.
+ *
+ * Both sides MUST use these exact functions; changing them invalidates
+ * build/keyword_hash_tables.h, which the Makefile regenerates.
+ */
+
+#ifndef NATURELANG_KEYWORD_HASH_H
+#define NATURELANG_KEYWORD_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* ASCII-only lowercase fold: 'A'..'Z' get bit 0x20, all other bytes pass */
+static inline unsigned char kw_fold(unsigned char c) {
+    return (unsigned char)(c | (((unsigned)(c - 'A') < 26u) << 5));
+}
+
+/* First-level hash: FNV-1a over the case-folded bytes */
+static inline uint32_t kw_hash(const char *s, size_t len) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        h ^= kw_fold((unsigned char)s[i]);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/* Second-level hash: re-mix the first-level hash with a bucket displacement */
+static inline uint32_t kw_displace(uint32_t h, uint32_t d) {
+    h ^= d * 0x9e3779b9u;
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+}
+
+#endif /* NATURELANG_KEYWORD_HASH_H */
@@ -5,6 +5,8 @@
  * Lexer Public API Header
  * 
  * This file declares the public interface for the NatureLang lexer.
+ * The scanner itself is reentrant; the standalone Token API below wraps
+ * one process-wide scanner for the lexer test tool.
  * 
  * BUILD MODES:
  * - Standalone mode (default): Full Token API with token_create*, token_free, etc.
@@ -15,6 +17,7 @@
 #define NATURELANG_LEXER_H
 
 #include <stdio.h>
+#include <stddef.h>
 
 /* When building with Bison, we don't need the full Token API */
 #ifndef USE_BISON_TOKENS
@@ -31,21 +34,36 @@
 #define MAX_STRING_LENGTH 4096
 #define MAX_ERROR_LENGTH 512
 
-/* Flex-provided variables */
-extern FILE *yyin;
-extern char *yytext;
-extern int yyleng;
+/*
+ * Scanner handle. The lexer is reentrant (%option reentrant): all scanner
+ * state, including line/column tracking and string decoding, lives behind
+ * a yyscan_t, so several scanners can run at once (one per thread).
+ */
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void *yyscan_t;
+#endif
 
 /**
- * Low-level lex function (Flex-generated).
- * @return Token type as integer, 0 for EOF
+ * Create a scanner over an in-memory buffer, scanned in place
+ * (yy_scan_buffer; nothing is copied).
+ * The text is base[0 .. size-3]; base[size-2] and base[size-1] must be
+ * NUL (see SOURCE_BUFFER_PADDING). The buffer must stay alive and writable
+ * until lexer_scan_end(): in parser mode identifier and string tokens are
+ * slices into it, and string literals are decoded in place.
+ * @param scanner  Receives the new scanner
+ * @param base     Start of the buffer
+ * @param size     Buffer size including the two trailing NULs
+ * @param filename Name used in diagnostics (may be NULL)
+ * @return 0 on success, -1 if the buffer is not properly terminated or
+ *         the scanner could not be allocated
  */
-int yylex(void);
+int lexer_scan_buffer(yyscan_t *scanner, char *base, size_t size, const char *filename);
 
 /**
- * Destroy lexer scanner state (Flex-generated).
+ * Destroy a scanner created by lexer_scan_buffer (does not free the buffer).
  */
-int yylex_destroy(void);
+void lexer_scan_end(yyscan_t scanner);
 
 /* ============================================================================
  * STANDALONE LEXER API (only when NOT building with Bison)
@@ -60,9 +78,6 @@ extern double yylval_float;
 extern char *yylval_string;
 extern char yylval_char;
 
-/* Location tracking */
-extern SourceLocation yylloc;
-
 /* Error tracking */
 extern int lexer_error_count;
 
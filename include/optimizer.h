@@ -40,6 +40,8 @@ typedef struct {
     bool algebraic_simplification; /* x+0 -> x, x*1 -> x, etc. */
     bool strength_reduction;     /* pow(x,2) -> x*x, x*2 -> x+x, etc. */
     bool redundant_load_elimination; /* Remove consecutive loads of same value */
+    bool text_accumulators;      /* Keep `s = s + x` loop accumulators in a builder */
+    bool concat_fusion;          /* Build concatenation chains in one string builder */
 
     /* Reporting */
     bool verbose;                /* Print what each pass does */
@@ -56,6 +58,8 @@ typedef struct {
     int algebraic_simplifications;
     int strength_reductions;
     int redundant_loads_removed;
+    int text_accumulators_lowered;
+    int concat_chains_fused;
     int total_instructions_before;
     int total_instructions_after;
     int passes_run;
@@ -104,6 +108,15 @@ int opt_strength_reduction(TACFunction *func, bool verbose);
  *   t0 = 5; t1 = 5;  -->  t0 = 5; t1 = t0 */
 int opt_redundant_load_elimination(TACFunction *func, bool verbose);
 
+/* Text Accumulators: a text variable only ever appended to in a loop is
+ * kept in a string builder until the loop exits
+ *   L0: t1 = s CONCAT x; s = t1; goto L0  -->  L0: STRBUF_APPEND b, x; goto L0 */
+int opt_text_accumulators(TACFunction *func, bool verbose);
+
+/* Concat Chain Fusion: append a chain of concatenations into one builder
+ *   t1 = a CONCAT b; t2 = t1 CONCAT c  -->  STRBUF_BEGIN/APPEND a, b, c/END */
+int opt_concat_fusion(TACFunction *func, bool verbose);
+
 /* ============================================================================
  * UTILITY
  * ============================================================================
@@ -11,13 +11,86 @@
 #define NATURELANG_PARSER_H
 
 #include <stdio.h>
+#include <stddef.h>
 #include "ast.h"
 
+/* ============================================================================
+ * PARSE CONTEXT
+ * ============================================================================
+ */
+
+/*
+ * Streaming callback: receives each top-level statement as soon as the
+ * parser has reduced it. The statement is valid only during the call.
+ */
+typedef void (*ParseStatementFn)(ASTNode *statement, void *data);
+
+/*
+ * Per-parse state. The parser is pure and the scanner reentrant, so
+ * every parse owns its state here and independent contexts can be
+ * parsed concurrently (one per thread).
+ */
+typedef struct ParseContext {
+    const char *filename;   /* Name used in diagnostics */
+    ASTNode *result;        /* Root AST of the last successful parse */
+    int error_count;        /* Syntax errors reported by the last parse */
+    char *scratch;          /* Identifier text scratch (parser-internal) */
+    size_t scratch_cap;
+    ASTArena *arena;        /* Arena of the parse in progress (parser-internal) */
+    ParseStatementFn on_statement;  /* Streaming callback, or NULL */
+    void *on_statement_data;
+} ParseContext;
+
+/*
+ * Initialize a parse context.
+ * 
+ * @param ctx       The context to initialize.
+ * @param filename  Name used in diagnostics (may be NULL).
+ */
+void parse_context_init(ParseContext *ctx, const char *filename);
+
+/*
+ * Release parser-internal memory held by a context.
+ * The result AST is owned by the caller and is not freed.
+ *
+ * Every parse builds its AST in an arena (see ast_arena_create). On
+ * success the arena moves to the result program node, so one ast_free()
+ * on the result releases the whole tree at once.
+ */
+void parse_context_free(ParseContext *ctx);
+
 /* ============================================================================
  * PARSER FUNCTIONS
  * ============================================================================
  */
 
+/*
+ * Parse a NatureLang program from a caller-owned buffer using the given
+ * context. Thread-safe for distinct contexts and buffers.
+ * The buffer must end with two NUL bytes and stay writable; it is
+ * modified during scanning (string literals are unescaped in place).
+ * 
+ * @param ctx     Parse context (see parse_context_init).
+ * @param buffer  Source text followed by two NUL bytes.
+ * @param size    Buffer size, including the two NUL bytes.
+ * @return        The root AST node (also in ctx->result), or NULL on error.
+ */
+ASTNode *naturelang_parse_ctx(ParseContext *ctx, char *buffer, size_t size);
+
+/*
+ * Parse a file in streaming mode: every top-level statement goes to
+ * on_statement as soon as it is parsed, and its memory is reused for
+ * the next one, so the whole tree never exists at once. Statements
+ * before a syntax error have already been delivered when it is reported.
+ *
+ * @param filename      Path of the source file.
+ * @param on_statement  Called once per top-level statement, in order.
+ * @param data          Passed through to on_statement.
+ * @return              0 on success, -1 on a read or syntax error.
+ */
+int naturelang_parse_file_stream(const char *filename, ParseStatementFn on_statement,
+                                 void *data);
+
 /*
  * Parse a NatureLang program from a file.
  * 
@@ -26,6 +99,26 @@
  */
 ASTNode *naturelang_parse(FILE *input);
 
+/*
+ * Parse a NatureLang program from a file path.
+ * Regular files are memory-mapped and scanned in place.
+ * 
+ * @param filename  Path of the source file.
+ * @return          The root AST node, or NULL on error.
+ */
+ASTNode *naturelang_parse_file(const char *filename);
+
+/*
+ * Parse a NatureLang program from a caller-owned buffer, in place.
+ * The buffer must end with two NUL bytes and stay writable; it is
+ * modified during scanning (string literals are unescaped in place).
+ * 
+ * @param buffer  Source text followed by two NUL bytes.
+ * @param size    Buffer size, including the two NUL bytes.
+ * @return        The root AST node, or NULL on error.
+ */
+ASTNode *naturelang_parse_buffer(char *buffer, size_t size);
+
 /*
  * Parse a NatureLang program from a string.
  * 
@@ -35,20 +128,36 @@ ASTNode *naturelang_parse(FILE *input);
 ASTNode *naturelang_parse_string(const char *source);
 
 /*
- * Get the result of the last parse operation.
+ * Get the result of the last parse operation on the calling thread
+ * (naturelang_parse* wrappers only; contexts carry their own result).
  * 
  * @return  The root AST node from the last parse.
  */
 ASTNode *get_parse_result(void);
 
+#ifdef NATURELANG_PARSE_STATS
 /* ============================================================================
- * ERROR HANDLING
+ * GLR STATISTICS
  * ============================================================================
+ * Only in the instrumented parser object used by bench_frontend
+ * (the PARSER_MODE parser built with -DYYDEBUG=1 -DNATURELANG_PARSE_STATS).
+ * Counts come from Bison's GLR trace, so parsing is slower while
+ * counting and the default LALR(1) parser reports zeros; not
+ * thread-safe (yydebug is a global).
  */
+typedef struct {
+    long splits;            /* Stack splits (conflicts taken at parse time) */
+    long merges;            /* Split stacks that rejoined in the same state */
+    long dead_stacks;       /* Split stacks discarded on a syntax error */
+    long deferred_actions;  /* Semantic actions postponed while split */
+    long resolutions;       /* Returns to deterministic (single stack) parsing */
+} ParseGLRStats;
 
-/*
- * Parser error callback (can be overridden).
- */
-void yyerror(const char *s);
+/* Reset the counters and start counting */
+void parse_glr_stats_begin(void);
+
+/* Stop counting and return the counters */
+ParseGLRStats parse_glr_stats_end(void);
+#endif
 
 #endif /* NATURELANG_PARSER_H */
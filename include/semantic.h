@@ -36,6 +36,29 @@ typedef struct {
  * The caller owns the returned SymbolTable and must free it */
 SemanticResult semantic_analyze(ASTNode *program);
 
+/* Same, checking top-level function bodies on up to `jobs` threads
+ * (0 = one per online CPU). The diagnostics and the result do not depend
+ * on the number of threads. */
+SemanticResult semantic_analyze_jobs(ASTNode *program, int jobs);
+
+/* Streaming analysis, one top-level statement at a time as the parser
+ * produces them: begin, then check each statement in order (function
+ * bodies at once, diagnostics printed as they are found). Statements
+ * only need to live for their call; functions are remembered by their
+ * signature. Returns whether the statement checked cleanly; the result
+ * accumulates the counts and is freed with semantic_result_free. */
+SemanticResult semantic_stream_begin(void);
+bool semantic_stream_statement(SemanticResult *result, ASTNode *statement);
+
+/* Performance lint over a successfully analyzed program (or one top-level
+ * statement of a stream): warns (through
+ * result->symtab) about text appended to itself in loops, loop-invariant
+ * lengths in while conditions and element searches nested in loops.
+ * opt_level is the level the program is compiled at (appends the optimizer
+ * makes linear are only reported below -O1).
+ * Adds the findings to result->warning_count and returns their number. */
+int semantic_perf_lint(ASTNode *program, SemanticResult *result, int opt_level);
+
 /* Free a semantic result (destroys symbol table if present) */
 void semantic_result_free(SemanticResult *result);
 
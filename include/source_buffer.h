@@ -0,0 +1,62 @@
+/*
+ * NatureLang Compiler
+ * Copyright (c) 2026
+ *
+ * Source Buffer Header
+ *
+ * In-memory source text for the scanner. The lexer scans a SourceBuffer
+ * in place with yy_scan_buffer, so the text is never copied into stdio
+ * or flex buffers and tokens can refer to it by (pointer, length).
+ *
+ * Every buffer holds the source followed by SOURCE_BUFFER_PADDING NUL
+ * bytes, which is the end-of-buffer marker flex requires. The bytes are
+ * writable: flex temporarily terminates each lexeme in place and string
+ * literals are unescaped in place.
+ */
+
+#ifndef NATURELANG_SOURCE_BUFFER_H
+#define NATURELANG_SOURCE_BUFFER_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+/* Trailing NUL bytes required by yy_scan_buffer */
+#define SOURCE_BUFFER_PADDING 2
+
+typedef struct {
+    char *data;         /* Source text + SOURCE_BUFFER_PADDING NULs */
+    size_t length;      /* Source length, excluding the padding */
+    size_t map_length;  /* Length passed to mmap, 0 if heap-allocated */
+} SourceBuffer;
+
+/*
+ * Map a source file into memory (private, copy-on-write).
+ * Falls back to reading into a heap buffer when the file cannot be
+ * mapped or its last page has no room for the padding.
+ *
+ * @param sb        Buffer to initialize.
+ * @param filename  Path of the file to load.
+ * @return          0 on success, -1 on failure (errno is set).
+ */
+int source_buffer_open(SourceBuffer *sb, const char *filename);
+
+/*
+ * Read an entire stream (file, pipe or stdin) into a heap buffer.
+ *
+ * @return  0 on success, -1 on failure.
+ */
+int source_buffer_from_stream(SourceBuffer *sb, FILE *input);
+
+/*
+ * Copy a string into a padded heap buffer.
+ *
+ * @return  0 on success, -1 on failure.
+ */
+int source_buffer_from_string(SourceBuffer *sb, const char *source, size_t length);
+
+/*
+ * Release the buffer (munmap or free) and reset it.
+ */
+void source_buffer_close(SourceBuffer *sb);
+
+#endif /* NATURELANG_SOURCE_BUFFER_H */
@@ -7,6 +7,17 @@
  * The symbol table manages all identifiers (variables, functions, constants)
  * and their associated information (type, scope, etc.) during semantic analysis.
  * It supports nested scopes for blocks, functions, and control structures.
+ *
+ * Names are interned in a single hash table. Each name points to a stack of
+ * its bindings, innermost first, so a lookup is one hash probe however many
+ * scopes or symbols there are. A scope's symbol list is its undo log:
+ * leaving the scope pops exactly the bindings it added.
+ *
+ * A table can be layered over a read-only outer table (symtab_create_over),
+ * so that several threads can check function bodies against one global
+ * scope. Every declaration and initialization is stamped with a counter;
+ * the layered table sees the outer symbols as they were at a given stamp,
+ * through private copies it makes on first lookup.
  */
 
 #ifndef NATURELANG_SYMBOL_TABLE_H
@@ -14,6 +25,10 @@
 
 #include "ast.h"
 #include <stdbool.h>
+#include <stddef.h>
+
+/* Interned name with its stack of bindings (private to symbol_table.c) */
+typedef struct SymbolName SymbolName;
 
 /* ============================================================================
  * SYMBOL KIND ENUMERATION
@@ -33,21 +48,27 @@ typedef enum {
  * Represents a single symbol in the symbol table
  */
 typedef struct Symbol {
-    char *name;                 /* Symbol name (identifier) */
+    const char *name;           /* Symbol name (interned, owned by the table) */
     SymbolKind kind;            /* What kind of symbol */
     DataType type;              /* Data type of the symbol */
+    DataType elem_type;         /* Element type of a list (TYPE_UNKNOWN if not known) */
     int scope_level;            /* Nesting level where declared (0 = global) */
     bool is_initialized;        /* Has been assigned a value? */
     SourceLocation decl_loc;    /* Where it was declared (for error messages) */
+    unsigned long declared_at;  /* Table stamp of the declaration */
+    unsigned long initialized_at; /* Stamp of the first initialization (0 = none) */
     
-    /* Function-specific information */
+    /* Function-specific information (a copy, so it outlives the AST) */
     struct {
-        ASTNodeList *params;    /* Parameter list (for functions) */
+        DataType *param_types;  /* Parameter types, owned by the symbol */
+        size_t param_count;
         DataType return_type;   /* Return type (for functions) */
         bool has_return;        /* Does function have a return statement? */
     } func_info;
     
     struct Symbol *next;        /* Next symbol in the same scope (linked list) */
+    struct Symbol *shadowed;    /* Outer binding of the same name it hides */
+    SymbolName *entry;          /* Hash table entry of the name */
 } Symbol;
 
 /* ============================================================================
@@ -57,7 +78,7 @@ typedef struct Symbol {
  */
 typedef struct Scope {
     int level;                  /* Nesting level (0 = global) */
-    Symbol *symbols;            /* Head of symbol linked list for this scope */
+    Symbol *symbols;            /* Symbols declared here, newest first (undo log) */
     struct Scope *parent;       /* Enclosing scope (NULL for global) */
     
     /* Scope context information */
@@ -67,6 +88,16 @@ typedef struct Scope {
     DataType expected_return;   /* Expected return type (if in function) */
 } Scope;
 
+/* ============================================================================
+ * BUFFERED DIAGNOSTIC
+ * ============================================================================
+ * An error or warning held back by a table that buffers its diagnostics
+ */
+typedef struct {
+    int group;                  /* Caller's tag (see symtab_set_diagnostic_group) */
+    char *message;              /* Whole line as it would be printed, without '\n' */
+} SymbolDiagnostic;
+
 /* ============================================================================
  * SYMBOL TABLE STRUCTURE
  * ============================================================================
@@ -76,10 +107,28 @@ typedef struct SymbolTable {
     Scope *current_scope;       /* Currently active scope */
     Scope *global_scope;        /* Global scope (always exists) */
     int scope_depth;            /* Current nesting depth */
+
+    /* Interned names (open addressing, power-of-two size) */
+    SymbolName **names;
+    size_t name_capacity;
+    size_t name_count;
+    
+    /* Read-only table this one is layered over, and how much of it is seen */
+    const struct SymbolTable *outer;
+    unsigned long outer_stamp;  /* Outer symbols declared after this are hidden */
+    unsigned long stamp;        /* Bumped by each declaration and initialization */
     
     /* Error tracking */
     int error_count;            /* Number of semantic errors found */
     int warning_count;          /* Number of warnings */
+    char error_buf[256];        /* Message returned by the symtab_declare_* calls */
+    
+    /* Diagnostics are printed at once unless buffering is on */
+    bool buffer_diagnostics;
+    int diagnostic_group;       /* Tag given to new buffered diagnostics */
+    SymbolDiagnostic *diagnostics;
+    size_t diagnostic_count;
+    size_t diagnostic_capacity;
 } SymbolTable;
 
 /* ============================================================================
@@ -90,9 +139,17 @@ typedef struct SymbolTable {
 /* Create a new symbol table with global scope */
 SymbolTable *symtab_create(void);
 
+/* Create a table layered over outer, which sees the outer symbols as they
+ * were at the given stamp (see symtab_stamp). The outer table must not change
+ * while the new table is in use; several tables may share one outer table. */
+SymbolTable *symtab_create_over(const SymbolTable *outer, unsigned long stamp);
+
 /* Destroy symbol table and free all memory */
 void symtab_destroy(SymbolTable *table);
 
+/* Current stamp (covers every declaration and initialization so far) */
+unsigned long symtab_stamp(const SymbolTable *table);
+
 /* ============================================================================
  * SCOPE MANAGEMENT
  * ============================================================================
@@ -139,7 +196,7 @@ const char *symtab_declare_variable(SymbolTable *table, const char *name,
                                      DataType type, bool is_const,
                                      SourceLocation loc);
 
-/* Declare a new function in current scope
+/* Declare a new function in current scope (the signature is copied out of params)
  * Returns NULL on success, or error message on failure */
 const char *symtab_declare_function(SymbolTable *table, const char *name,
                                      ASTNodeList *params, DataType return_type,
@@ -163,7 +220,7 @@ Symbol *symtab_lookup_current_scope(SymbolTable *table, const char *name);
 Symbol *symtab_lookup_function(SymbolTable *table, const char *name);
 
 /* Mark a variable as initialized */
-void symtab_mark_initialized(Symbol *sym);
+void symtab_mark_initialized(SymbolTable *table, Symbol *sym);
 
 /* ============================================================================
  * ERROR/WARNING HELPERS
@@ -182,6 +239,12 @@ int symtab_error_count(SymbolTable *table);
 /* Get warning count */
 int symtab_warning_count(SymbolTable *table);
 
+/* Hold diagnostics in table->diagnostics instead of printing them */
+void symtab_buffer_diagnostics(SymbolTable *table, bool buffer);
+
+/* Tag the diagnostics reported from now on */
+void symtab_set_diagnostic_group(SymbolTable *table, int group);
+
 /* ============================================================================
  * DEBUGGING / PRINTING
  * ============================================================================
@@ -56,6 +56,10 @@ typedef enum {
     TOK_OTHERWISE,      /* "otherwise" */
     TOK_ELSE,           /* "else" */
     TOK_END,            /* "end" */
+    TOK_END_IF,         /* "end if" (combined) */
+    TOK_END_WHILE,      /* "end while" (combined) */
+    TOK_END_REPEAT,     /* "end repeat" (combined) */
+    TOK_END_FOR,        /* "end for" (combined) */
     TOK_REPEAT,         /* "repeat" */
     TOK_TIMES,          /* "times" */
     TOK_WHILE,          /* "while" */
@@ -120,6 +124,20 @@ typedef enum {
     TOK_FIRST,          /* "first" */
     TOK_LAST,           /* "last" */
     
+    /* ========== KEYWORDS - Random Numbers ========== */
+    TOK_RANDOM_NUMBER,  /* "random number" */
+    TOK_RANDOM_NUMBERS, /* "random numbers" */
+    TOK_RANDOM_DECIMAL, /* "random decimal" */
+    TOK_SEED_RANDOM,    /* "seed random" */
+    
+    /* ========== KEYWORDS - List Aggregates ========== */
+    TOK_CONTAINS,       /* "contains" */
+    TOK_SUM_OF,         /* "the sum of" */
+    TOK_LARGEST,        /* "the largest in", "the largest of" */
+    TOK_SMALLEST,       /* "the smallest in", "the smallest of" */
+    TOK_COUNT_OF,       /* "the count of" */
+    TOK_POSITION_OF,    /* "the position of" */
+    
     /* ========== KEYWORDS - Logical ========== */
     TOK_IS,             /* "is" */
     TOK_NOT,            /* "not" */
@@ -307,4 +325,7 @@ size_t get_keyword_table_size(void);
 /* Lookup a keyword by string (returns TOK_IDENTIFIER if not found) */
 TokenType lookup_keyword(const char *str);
 
+/* Same, for a lexeme of known length that need not be NUL-terminated */
+TokenType lookup_keyword_n(const char *str, size_t len);
+
 #endif /* NATURELANG_TOKENS_H */
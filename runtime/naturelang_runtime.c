@@ -7,6 +7,7 @@
 
 #define _POSIX_C_SOURCE 200809L
 #include "naturelang_runtime.h"
+#include "naturelang_ryu_tables.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -14,31 +15,70 @@
 #include <ctype.h>
 #include <time.h>
 #include <math.h>
+#include <limits.h>
+#include <errno.h>
+#include <unistd.h>
+#include <stdatomic.h>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 /* ============================================================================
  * List Support
  * ============================================================================ */
 
-NLList *nl_list_new(void) {
+/* typed array-এ এক element কত byte নেয় (flag list bit-packed, তাই আলাদা হিসাব)। */
+static size_t nl_list_bytes(int item_type, int capacity) {
+    switch (item_type) {
+        case NL_LIST_NUMBER:  return sizeof(long long) * (size_t)capacity;
+        case NL_LIST_DECIMAL: return sizeof(double) * (size_t)capacity;
+        case NL_LIST_TEXT:    return sizeof(char*) * (size_t)capacity;
+        case NL_LIST_FLAG:    return ((size_t)capacity + 7) / 8;
+        default:              return 0;
+    }
+}
+
+/* packed flag array থেকে index-তম bit পড়ি। */
+static int nl_list_flag_bit(const NLList *list, int index) {
+    return (list->flags[index >> 3] >> (index & 7)) & 1;
+}
+
+/* packed flag array-এ index-তম bit set/clear করি। */
+static void nl_list_put_flag_bit(NLList *list, int index, int value) {
+    unsigned char mask = (unsigned char)(1u << (index & 7));
+    if (value) list->flags[index >> 3] |= mask;
+    else list->flags[index >> 3] &= (unsigned char)~mask;
+}
+
+NLList *nl_list_new_typed(int item_type, int capacity) {
     /* NLList struct-এর জন্য heap memory allocate করি। */
-    NLList *list = malloc(sizeof(NLList));
-    /* allocation fail হলে NULL ফেরত দিয়ে caller-কে failure signal দিই। */
+    NLList *list = nl_malloc(sizeof(NLList));
+    /* allocation fail হলে NULL ফেরত দিয়ে caller-কে failure signal দিই। */
     if (!list) return NULL;
-    /* প্রাথমিক list capacity ছোট fixed value (8) দিয়ে শুরু। */
-    list->capacity = 8;
-    /* নতুন list-এ শুরুতে কোনো item নেই। */
+    /* element type creation-এর সময়েই স্থির; পরে আর বদলায় না। */
+    list->item_type = item_type;
     list->length = 0;
-    /* item_type default 0 (number/unspecified baseline) হিসেবে initialize। */
-    list->item_type = 0;
-    /* item pointers রাখার backing array allocate (capacity সংখ্যক slot)। */
-    list->items = malloc(sizeof(void*) * list->capacity);
+    list->data = NULL;
+    list->capacity = 0;
+    /* untyped list-এর storage প্রথম append-এ type জানার পর allocate হবে। */
+    if (item_type != NL_LIST_UNTYPED) {
+        /* প্রাথমিক capacity ছোট fixed value (8), বা caller-এর hint। */
+        list->capacity = capacity > 8 ? capacity : 8;
+        list->data = nl_malloc(nl_list_bytes(item_type, list->capacity));
+    }
     /* fully initialized list pointer caller-কে return। */
     return list;
 }
 
+NLList *nl_list_new(void) {
+    /* type ছাড়া empty list: প্রথম typed append যে type আনে সেটাই নেবে। */
+    return nl_list_new_typed(NL_LIST_UNTYPED, 0);
+}
+
 NLList *nl_list_create(int count, ...) {
-    /* প্রথমে একটি empty list object তৈরি করি। */
-    NLList *list = nl_list_new();
+    /* count==0 হলে untyped empty list, নাহলে number list। */
+    NLList *list = count > 0 ? nl_list_new_typed(NL_LIST_NUMBER, count) : nl_list_new();
     /* allocation/create fail হলে NULL ফেরত। */
     if (!list) return NULL;
     
@@ -46,13 +86,11 @@ NLList *nl_list_create(int count, ...) {
     va_list args;
     va_start(args, count);
     
-    /* count সংখ্যক variadic value পড়ে list-এ append করি। */
+    /* count সংখ্যক long long argument সরাসরি contiguous array-তে লিখি। */
     for (int i = 0; i < count; i++) {
-        /* প্রতিটি argument long long হিসেবে read। */
-        long long val = va_arg(args, long long);
-        /* read করা সংখ্যাটি numeric list item হিসেবে append। */
-        nl_list_append_num(list, val);
+        list->nums[i] = va_arg(args, long long);
     }
+    list->length = count;
     
     /* variadic reading context close। */
     va_end(args);
@@ -60,24 +98,48 @@ NLList *nl_list_create(int count, ...) {
     return list;
 }
 
+NLList *nl_list_of(int item_type, int count, ...) {
+    /* element type অজানা: খালি হলে untyped list, নাহলে number list ধরে নিই। */
+    if (item_type == NL_LIST_UNTYPED) {
+        if (count == 0) return nl_list_new();
+        item_type = NL_LIST_NUMBER;
+    }
+    NLList *list = nl_list_new_typed(item_type, count);
+    if (!list) return NULL;
+    
+    va_list args;
+    va_start(args, count);
+    /* প্রতিটি argument list-এর element type অনুযায়ী পড়ে typed slot-এ লিখি। */
+    for (int i = 0; i < count; i++) {
+        switch (item_type) {
+            case NL_LIST_DECIMAL: list->decs[i] = va_arg(args, double); break;
+            case NL_LIST_TEXT: {
+                const char *text = va_arg(args, const char*);
+                list->strs[i] = nl_strdup(text ? text : "");
+                break;
+            }
+            case NL_LIST_FLAG:    nl_list_put_flag_bit(list, i, va_arg(args, int) != 0); break;
+            default:              list->nums[i] = va_arg(args, long long); break;
+        }
+    }
+    list->length = count;
+    va_end(args);
+    return list;
+}
+
 void nl_list_free(NLList *list) {
     /* NULL guard: list না থাকলে free করার কিছু নেই। */
     if (list) {
-        /* Free string items if this is a string list */
-        /*0 → number list (nl_list_append_num এ সেট করা)
-    1 → decimal list (nl_list_append_dec এ সেট করা)
-    2 → string list (nl_list_append_str এ সেট করা)*/
-        /* item_type==2 হলে items গুলো strdup-allocated string pointer। */
-        if (list->item_type == 2) {
-            /* প্রতিটি string element আলাদাভাবে মুক্ত করি। */
+        /* text list-এর প্রতিটি string list-এর নিজের (owned), তাই আলাদা free। */
+        if (list->item_type == NL_LIST_TEXT) {
             for (int i = 0; i < list->length; i++) {
-                free(list->items[i]);
+                nl_free(list->strs[i]);
             }
         }
-        /* item pointer array buffer মুক্ত করি। */
-        free(list->items);
+        /* typed payload array একটাই buffer, একবারে মুক্ত। */
+        nl_free(list->data);
         /* list struct নিজেকেও মুক্ত করি। */
-        free(list);
+        nl_free(list);
     }
 }
 
@@ -86,162 +148,906 @@ int nl_list_length(NLList *list) {
     return list ? list->length : 0;
 }
 
-static void nl_list_ensure_capacity(NLList *list) {
-    /* বর্তমান length capacity-তে পৌঁছালে grow প্রয়োজন। */
+/*
+ * নতুন element-এর জন্য জায়গা নিশ্চিত করি। untyped list প্রথম append-এ
+ * `item_type` গ্রহণ করে; typed list-এর type এখানে কখনো বদলায় না।
+ */
+static void nl_list_ensure_capacity(NLList *list, int item_type) {
+    if (list->item_type == NL_LIST_UNTYPED) {
+        list->item_type = item_type;
+    }
+    /* বর্তমান length capacity-তে পৌঁছালে grow প্রয়োজন। */
     if (list->length >= list->capacity) {
         /* growth policy: capacity দ্বিগুণ করে amortized append খরচ কমাই। */
-        list->capacity *= 2;
-        /* expanded capacity অনুযায়ী items array realloc করি। */
-        list->items = realloc(list->items, sizeof(void*) * list->capacity);
+        int capacity = list->capacity > 0 ? list->capacity * 2 : 8;
+        void *data = nl_realloc(list->data, nl_list_bytes(list->item_type, capacity));
+        if (!data) {
+            fprintf(stderr, "Runtime Error: out of memory growing a list\n");
+            exit(1);
+        }
+        list->data = data;
+        list->capacity = capacity;
     }
 }
 
-void nl_list_append(NLList *list, void *item) {
-    /* NULL list হলে append করার কিছু নেই, early return। */
-    if (!list) return;
-    /* নতুন element বসানোর আগে capacity যথেষ্ট কিনা নিশ্চিত করি। */
-    nl_list_ensure_capacity(list);
-    /* item pointer next slot-এ রেখে length post-increment করি। */
-    list->items[list->length++] = item;
+/*
+ * Slot-এ value লেখা (slot-এর পুরনো text আগেই free করা থাকতে হবে)।
+ * list-এর element type আলাদা হলে value convert করে রাখি।
+ */
+static void nl_list_put_num(NLList *list, int index, long long value) {
+    switch (list->item_type) {
+        case NL_LIST_DECIMAL: list->decs[index] = (double)value; break;
+        case NL_LIST_TEXT:    list->strs[index] = nl_num_to_string(value); break;
+        case NL_LIST_FLAG:    nl_list_put_flag_bit(list, index, value != 0); break;
+        default:              list->nums[index] = value; break;
+    }
+}
+
+static void nl_list_put_dec(NLList *list, int index, double value) {
+    switch (list->item_type) {
+        case NL_LIST_DECIMAL: list->decs[index] = value; break;
+        case NL_LIST_TEXT:    list->strs[index] = nl_dec_to_string(value); break;
+        case NL_LIST_FLAG:    nl_list_put_flag_bit(list, index, value != 0.0); break;
+        default:              list->nums[index] = (long long)value; break;
+    }
+}
+
+static void nl_list_put_str(NLList *list, int index, const char *value) {
+    switch (list->item_type) {
+        case NL_LIST_DECIMAL: list->decs[index] = nl_to_decimal(value); break;
+        case NL_LIST_TEXT:    list->strs[index] = nl_strdup(value ? value : ""); break;
+        case NL_LIST_FLAG:    nl_list_put_flag_bit(list, index, value && *value); break;
+        default:              list->nums[index] = nl_to_number(value); break;
+    }
+}
+
+/* valid list ও in-range index কিনা যাচাই। */
+static int nl_list_in_range(const NLList *list, int index) {
+    return list && index >= 0 && index < list->length;
+}
+
+/* set-এর আগে text slot-এর পুরনো string মুক্ত করি। */
+static void nl_list_release(NLList *list, int index) {
+    if (list->item_type == NL_LIST_TEXT) {
+        nl_free(list->strs[index]);
+    }
 }
 
 void nl_list_append_num(NLList *list, long long value) {
     /* defensive guard: list না থাকলে কাজ বন্ধ। */
     if (!list) return;
-    /* numeric item যোগের আগে array grow প্রয়োজন কিনা দেখি। */
-    nl_list_ensure_capacity(list);
-    /* Store number directly as pointer (works for 64-bit) */
-    /* integer value intptr_t হয়ে void* slot-এ store করি (tagless storage)। */
-    list->items[list->length++] = (void*)(intptr_t)value;
-    /* item_type 0 মানে number-list mode চিহ্নিত করি। */
-    list->item_type = 0;
+    nl_list_ensure_capacity(list, NL_LIST_NUMBER);
+    nl_list_put_num(list, list->length++, value);
 }
 
 void nl_list_append_dec(NLList *list, double value) {
-    /* invalid list pointer হলে append করা যাবে না। */
     if (!list) return;
-    /* append-এর আগে প্রয়োজন হলে items array বড় করি। */
-    nl_list_ensure_capacity(list);
-    /* double সরাসরি pointer-cast safe নয়, তাই heap-এ value রাখি। */
-    double *ptr = malloc(sizeof(double));
-    /* allocated slot-এ decimal value লিখি। */
-    *ptr = value;
-    /* decimal pointer list slot-এ append। */
-    list->items[list->length++] = ptr;
-    /* item_type 1 দিয়ে decimal-list হিসেবে mark করি। */
-    list->item_type = 1;
+    /* decimal সরাসরি double[]-এ বসে; আলাদা heap allocation লাগে না। */
+    nl_list_ensure_capacity(list, NL_LIST_DECIMAL);
+    nl_list_put_dec(list, list->length++, value);
 }
 
 void nl_list_append_str(NLList *list, const char *value) {
-    /* list না থাকলে append operation skip। */
     if (!list) return;
-    /* নতুন string item-এর জন্য capacity ensure। */
-    nl_list_ensure_capacity(list);
-    /* input string-এর owned copy (strdup) list-এ সংরক্ষণ করি। */
-    list->items[list->length++] = strdup(value);
-    /* item_type 2 = string-list mode। */
-    list->item_type = 2;
+    /* input string-এর owned copy list-এ সংরক্ষণ করি। */
+    nl_list_ensure_capacity(list, NL_LIST_TEXT);
+    nl_list_put_str(list, list->length++, value);
 }
 
-void *nl_list_get(NLList *list, int index) {
-    /* invalid list বা out-of-range index হলে safe NULL ফেরত। */
-    if (!list || index < 0 || index >= list->length) {
-        return NULL;
-    }
-    /* valid index হলে raw item pointer ফেরত। */
-    return list->items[index];
+void nl_list_append_flag(NLList *list, int value) {
+    if (!list) return;
+    nl_list_ensure_capacity(list, NL_LIST_FLAG);
+    nl_list_put_num(list, list->length++, value != 0);
 }
 
 long long nl_list_get_num(NLList *list, int index) {
     /* invalid access হলে numeric fallback 0। */
-    if (!list || index < 0 || index >= list->length) {
-        return 0;
+    if (!nl_list_in_range(list, index)) return 0;
+    switch (list->item_type) {
+        case NL_LIST_DECIMAL: return (long long)list->decs[index];
+        case NL_LIST_TEXT:    return nl_to_number(list->strs[index]);
+        case NL_LIST_FLAG:    return nl_list_flag_bit(list, index);
+        default:              return list->nums[index];
     }
-    /* stored pointer-slot থেকে intptr_t হয়ে long long-এ back-cast। */
-    /*list->items[index] হলো void*
-    (intptr_t) দিয়ে সেই pointer value-টাকে integer-এ রূপান্তর করছে
-    তারপর (long long) করে function-এর return type-এর সাথে মিলিয়ে দিচ্ছে*/
-    return (long long)(intptr_t)list->items[index];
 }
 
 double nl_list_get_dec(NLList *list, int index) {
     /* list invalid বা index range-এর বাইরে হলে safe fallback 0.0। */
-    if (!list || index < 0 || index >= list->length) {
-        return 0.0;
+    if (!nl_list_in_range(list, index)) return 0.0;
+    switch (list->item_type) {
+        case NL_LIST_DECIMAL: return list->decs[index];
+        case NL_LIST_TEXT:    return nl_to_decimal(list->strs[index]);
+        case NL_LIST_FLAG:    return nl_list_flag_bit(list, index);
+        default:              return (double)list->nums[index];
     }
-    /* stored item-কে double pointer ধরে dereference করে decimal value ফেরত। */
-    return *(double*)list->items[index];
 }
 
 char *nl_list_get_str(NLList *list, int index) {
-    /* invalid access হলে empty string fallback দিই (NULL নয়)। */
-    if (!list || index < 0 || index >= list->length) {
+    /* invalid access বা text নয় এমন list হলে empty string (NULL নয়)। */
+    if (!nl_list_in_range(list, index) || list->item_type != NL_LIST_TEXT) {
         return "";
     }
-    /* valid slot-এর stored pointer-কে string pointer হিসেবে return। */
-    return (char*)list->items[index];
+    return list->strs[index];
 }
 
-void nl_list_set(NLList *list, int index, void *item) {
-    /* invalid list/index হলে set operation skip। */
-    if (!list || index < 0 || index >= list->length) return;
-    /* target index-এ নতুন raw item pointer বসাই। */
-    list->items[index] = item;
+int nl_list_get_flag(NLList *list, int index) {
+    if (!nl_list_in_range(list, index)) return 0;
+    switch (list->item_type) {
+        case NL_LIST_DECIMAL: return list->decs[index] != 0.0;
+        case NL_LIST_TEXT:    return list->strs[index][0] != '\0';
+        case NL_LIST_FLAG:    return nl_list_flag_bit(list, index);
+        default:              return list->nums[index] != 0;
+    }
 }
 
 void nl_list_set_num(NLList *list, int index, long long value) {
     /* list বা index invalid হলে update না করে return। */
-    if (!list || index < 0 || index >= list->length) return;
-    /* numeric value intptr_t হয়ে pointer-slot-এ encode করে রাখি। */
-    list->items[index] = (void*)(intptr_t)value;
+    if (!nl_list_in_range(list, index)) return;
+    nl_list_release(list, index);
+    nl_list_put_num(list, index, value);
+}
+
+void nl_list_set_dec(NLList *list, int index, double value) {
+    if (!nl_list_in_range(list, index)) return;
+    nl_list_release(list, index);
+    nl_list_put_dec(list, index, value);
+}
+
+void nl_list_set_str(NLList *list, int index, const char *value) {
+    if (!nl_list_in_range(list, index)) return;
+    /* value একই string হতে পারে, তাই আগে copy নিয়ে তারপর পুরনোটা free। */
+    if (list->item_type == NL_LIST_TEXT) {
+        char *copy = nl_strdup(value ? value : "");
+        nl_free(list->strs[index]);
+        list->strs[index] = copy;
+        return;
+    }
+    nl_list_put_str(list, index, value);
+}
+
+void nl_list_set_flag(NLList *list, int index, int value) {
+    if (!nl_list_in_range(list, index)) return;
+    nl_list_release(list, index);
+    nl_list_put_num(list, index, value != 0);
+}
+
+/* ---- Generic pointer-slot shim (পুরনো generated code-এর জন্য) ---- */
+
+/* generic item pointer-কে list-এর element type অনুযায়ী slot-এ লিখি। */
+static void nl_list_put_item(NLList *list, int index, void *item) {
+    switch (list->item_type) {
+        case NL_LIST_DECIMAL:
+            /* decimal item double-এর pointer; value copy করি। */
+            list->decs[index] = item ? *(double*)item : 0.0;
+            break;
+        case NL_LIST_TEXT:
+            /* text item heap string; ownership list নেয়। */
+            list->strs[index] = item ? item : nl_strdup("");
+            break;
+        default:
+            /* number/flag item pointer-এ encode করা সংখ্যা। */
+            nl_list_put_num(list, index, (long long)(intptr_t)item);
+            break;
+    }
+}
+
+void nl_list_append(NLList *list, void *item) {
+    /* NULL list হলে append করার কিছু নেই, early return। */
+    if (!list) return;
+    /* untyped list-এ generic append পুরনো আচরণ মতো number ধরে নিই। */
+    nl_list_ensure_capacity(list, NL_LIST_NUMBER);
+    nl_list_put_item(list, list->length++, item);
+}
+
+void *nl_list_get(NLList *list, int index) {
+    /* invalid list বা out-of-range index হলে safe NULL ফেরত। */
+    if (!nl_list_in_range(list, index)) return NULL;
+    switch (list->item_type) {
+        case NL_LIST_DECIMAL: return &list->decs[index];
+        case NL_LIST_TEXT:    return list->strs[index];
+        case NL_LIST_FLAG:    return (void*)(intptr_t)nl_list_flag_bit(list, index);
+        default:              return (void*)(intptr_t)list->nums[index];
+    }
+}
+
+void nl_list_set(NLList *list, int index, void *item) {
+    /* invalid list/index হলে set operation skip। */
+    if (!nl_list_in_range(list, index)) return;
+    nl_list_release(list, index);
+    nl_list_put_item(list, index, item);
 }
 
 void nl_list_remove(NLList *list, int index) {
-    /* remove request invalid হলে কিছু না করে বের হয়ে যাই। */
-    if (!list || index < 0 || index >= list->length) return;
+    /* remove request invalid হলে কিছু না করে বের হয়ে যাই। */
+    if (!nl_list_in_range(list, index)) return;
     
-    /* Free string item if applicable */
-    /* string-list mode হলে remove হওয়া slot-এর string memory আগে free। */
-    if (list->item_type == 2) {
-        free(list->items[index]);
-    }
+    /* string-list mode হলে remove হওয়া slot-এর string memory আগে free। */
+    nl_list_release(list, index);
     
-    /* Shift items */
     /* removed slot পূরণে ডানদিকের item গুলো এক ধাপ বামে shift। */
-    for (int i = index; i < list->length - 1; i++) {
-        list->items[i] = list->items[i + 1];
+    if (list->item_type == NL_LIST_FLAG) {
+        for (int i = index; i < list->length - 1; i++) {
+            nl_list_put_flag_bit(list, i, nl_list_flag_bit(list, i + 1));
+        }
+    } else {
+        size_t width = nl_list_bytes(list->item_type, 1);
+        char *base = list->data;
+        memmove(base + (size_t)index * width, base + (size_t)(index + 1) * width,
+                (size_t)(list->length - index - 1) * width);
     }
     /* logical list length এক কমাই। */
     list->length--;
 }
 
-int nl_list_contains_num(NLList *list, long long value) {
-    /* NULL list হলে contain check false। */
-    if (!list) return 0;
-    /* linear scan করে target number পাওয়া যায় কিনা দেখি। */
+/* ============================================================================
+ * List Search and Reduction
+ * ============================================================================ */
+
+/*
+ * number ও decimal list-এর contiguous storage SIMD দিয়ে scan করি: AVX2-এ
+ * একবারে 4টি, SSE2-এ 2টি element; program যে instruction set-এর জন্য
+ * compile হয়েছে সেটাই (fast_lexer-এর মতো compile-time বাছাই), নাহলে scalar।
+ */
+#if defined(__AVX2__)
+#define NL_VEC_LANES 4
+typedef __m256i nl_ivec;
+typedef __m256d nl_dvec;
+static inline nl_ivec nl_iload(const long long *p) { return _mm256_loadu_si256((const __m256i *)p); }
+static inline nl_ivec nl_iset(long long x) { return _mm256_set1_epi64x(x); }
+static inline nl_ivec nl_izero(void) { return _mm256_setzero_si256(); }
+static inline nl_ivec nl_iadd(nl_ivec a, nl_ivec b) { return _mm256_add_epi64(a, b); }
+static inline nl_ivec nl_isub(nl_ivec a, nl_ivec b) { return _mm256_sub_epi64(a, b); }
+static inline nl_ivec nl_ieq(nl_ivec a, nl_ivec b) { return _mm256_cmpeq_epi64(a, b); }
+static inline unsigned nl_imask(nl_ivec m) { return (unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(m)); }
+static inline void nl_istore(long long *p, nl_ivec v) { _mm256_storeu_si256((__m256i *)p, v); }
+/* 64-bit signed compare শুধু AVX2-এ আছে; SSE2-এ min/max scalar থাকে। */
+#define NL_VEC_INT_MINMAX 1
+static inline nl_ivec nl_imin(nl_ivec a, nl_ivec b) { return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b)); }
+static inline nl_ivec nl_imax(nl_ivec a, nl_ivec b) { return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(b, a)); }
+static inline nl_dvec nl_dload(const double *p) { return _mm256_loadu_pd(p); }
+static inline nl_dvec nl_dset(double x) { return _mm256_set1_pd(x); }
+static inline nl_ivec nl_deq(nl_dvec a, nl_dvec b) { return _mm256_castpd_si256(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)); }
+static inline nl_dvec nl_dmin(nl_dvec a, nl_dvec b) { return _mm256_min_pd(a, b); }
+static inline nl_dvec nl_dmax(nl_dvec a, nl_dvec b) { return _mm256_max_pd(a, b); }
+static inline void nl_dstore(double *p, nl_dvec v) { _mm256_storeu_pd(p, v); }
+#elif defined(__SSE2__)
+#define NL_VEC_LANES 2
+typedef __m128i nl_ivec;
+typedef __m128d nl_dvec;
+static inline nl_ivec nl_iload(const long long *p) { return _mm_loadu_si128((const __m128i *)p); }
+static inline nl_ivec nl_iset(long long x) { return _mm_set1_epi64x(x); }
+static inline nl_ivec nl_izero(void) { return _mm_setzero_si128(); }
+static inline nl_ivec nl_iadd(nl_ivec a, nl_ivec b) { return _mm_add_epi64(a, b); }
+static inline nl_ivec nl_isub(nl_ivec a, nl_ivec b) { return _mm_sub_epi64(a, b); }
+static inline nl_ivec nl_ieq(nl_ivec a, nl_ivec b) {
+    /* SSE2-তে 64-bit equality নেই: দুই 32-bit অর্ধেকই মিলতে হবে। */
+    nl_ivec e = _mm_cmpeq_epi32(a, b);
+    return _mm_and_si128(e, _mm_shuffle_epi32(e, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+static inline unsigned nl_imask(nl_ivec m) { return (unsigned)_mm_movemask_pd(_mm_castsi128_pd(m)); }
+static inline void nl_istore(long long *p, nl_ivec v) { _mm_storeu_si128((__m128i *)p, v); }
+static inline nl_dvec nl_dload(const double *p) { return _mm_loadu_pd(p); }
+static inline nl_dvec nl_dset(double x) { return _mm_set1_pd(x); }
+static inline nl_ivec nl_deq(nl_dvec a, nl_dvec b) { return _mm_castpd_si128(_mm_cmpeq_pd(a, b)); }
+static inline nl_dvec nl_dmin(nl_dvec a, nl_dvec b) { return _mm_min_pd(a, b); }
+static inline nl_dvec nl_dmax(nl_dvec a, nl_dvec b) { return _mm_max_pd(a, b); }
+static inline void nl_dstore(double *p, nl_dvec v) { _mm_storeu_pd(p, v); }
+#endif
+
+#ifdef NL_VEC_LANES
+/* vector-এর সব lane যোগ করি (count-এর জন্য)। */
+static inline long long nl_ihsum(nl_ivec v) {
+    long long lanes[NL_VEC_LANES];
+    nl_istore(lanes, v);
+    unsigned long long total = 0;
+    for (int j = 0; j < NL_VEC_LANES; j++) total += (unsigned long long)lanes[j];
+    return (long long)total;
+}
+#endif
+
+/* value-এর প্রথম index, না থাকলে -1। */
+static int nl_nums_find(const long long *v, int n, long long value) {
+    int i = 0;
+#ifdef NL_VEC_LANES
+    nl_ivec key = nl_iset(value);
+    for (; i + NL_VEC_LANES <= n; i += NL_VEC_LANES) {
+        unsigned mask = nl_imask(nl_ieq(nl_iload(v + i), key));
+        if (mask) return i + __builtin_ctz(mask);
+    }
+#endif
+    for (; i < n; i++) {
+        if (v[i] == value) return i;
+    }
+    return -1;
+}
+
+static int nl_nums_count(const long long *v, int n, long long value) {
+    int i = 0;
+    long long count = 0;
+#ifdef NL_VEC_LANES
+    nl_ivec key = nl_iset(value);
+    nl_ivec matches = nl_izero();
+    /* মিললে compare-এর lane -1, তাই বিয়োগ করলে count এক বাড়ে। */
+    for (; i + NL_VEC_LANES <= n; i += NL_VEC_LANES) {
+        matches = nl_isub(matches, nl_ieq(nl_iload(v + i), key));
+    }
+    count = nl_ihsum(matches);
+#endif
+    for (; i < n; i++) count += v[i] == value;
+    return (int)count;
+}
+
+/* 64-bit wrap-around যোগফল (unsigned-এ, যাতে overflow undefined না হয়)। */
+static long long nl_nums_sum(const long long *v, int n) {
+    int i = 0;
+    unsigned long long total = 0;
+#ifdef NL_VEC_LANES
+    nl_ivec acc = nl_izero();
+    for (; i + NL_VEC_LANES <= n; i += NL_VEC_LANES) acc = nl_iadd(acc, nl_iload(v + i));
+    total = (unsigned long long)nl_ihsum(acc);
+#endif
+    for (; i < n; i++) total += (unsigned long long)v[i];
+    return (long long)total;
+}
+
+/* n > 0 ধরে নিয়ে smallest (largest != 0 হলে largest)। */
+static long long nl_nums_extreme(const long long *v, int n, int largest) {
+    int i = 0;
+    long long best = v[0];
+#ifdef NL_VEC_INT_MINMAX
+    if (n >= NL_VEC_LANES) {
+        nl_ivec acc = nl_iload(v);
+        for (i = NL_VEC_LANES; i + NL_VEC_LANES <= n; i += NL_VEC_LANES) {
+            nl_ivec x = nl_iload(v + i);
+            acc = largest ? nl_imax(acc, x) : nl_imin(acc, x);
+        }
+        long long lanes[NL_VEC_LANES];
+        nl_istore(lanes, acc);
+        for (int j = 0; j < NL_VEC_LANES; j++) {
+            if (largest ? lanes[j] > best : lanes[j] < best) best = lanes[j];
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        if (largest ? v[i] > best : v[i] < best) best = v[i];
+    }
+    return best;
+}
+
+static int nl_decs_find(const double *v, int n, double value) {
+    int i = 0;
+#ifdef NL_VEC_LANES
+    nl_dvec key = nl_dset(value);
+    for (; i + NL_VEC_LANES <= n; i += NL_VEC_LANES) {
+        unsigned mask = nl_imask(nl_deq(nl_dload(v + i), key));
+        if (mask) return i + __builtin_ctz(mask);
+    }
+#endif
+    for (; i < n; i++) {
+        if (v[i] == value) return i;
+    }
+    return -1;
+}
+
+static int nl_decs_count(const double *v, int n, double value) {
+    int i = 0;
+    long long count = 0;
+#ifdef NL_VEC_LANES
+    nl_dvec key = nl_dset(value);
+    nl_ivec matches = nl_izero();
+    for (; i + NL_VEC_LANES <= n; i += NL_VEC_LANES) {
+        matches = nl_isub(matches, nl_deq(nl_dload(v + i), key));
+    }
+    count = nl_ihsum(matches);
+#endif
+    for (; i < n; i++) count += v[i] == value;
+    return (int)count;
+}
+
+/*
+ * decimal যোগফল সবসময় চারটি interleaved lane-এ (lane j = index j mod 4),
+ * শেষে (s0 + s1) + (s2 + s3): AVX2, SSE2 ও scalar — তিন পথেই একই ক্রমে যোগ,
+ * তাই ফলাফল machine ভেদে এক bit-ও বদলায় না।
+ */
+static double nl_decs_sum(const double *v, int n) {
+    int i = 0;
+    double lanes[4] = {0.0, 0.0, 0.0, 0.0};
+#if NL_VEC_LANES == 4
+    nl_dvec acc = nl_dset(0.0);
+    for (; i + 4 <= n; i += 4) acc = _mm256_add_pd(acc, nl_dload(v + i));
+    nl_dstore(lanes, acc);
+#elif NL_VEC_LANES == 2
+    nl_dvec lo = nl_dset(0.0), hi = nl_dset(0.0);
+    for (; i + 4 <= n; i += 4) {
+        lo = _mm_add_pd(lo, nl_dload(v + i));
+        hi = _mm_add_pd(hi, nl_dload(v + i + 2));
+    }
+    nl_dstore(lanes, lo);
+    nl_dstore(lanes + 2, hi);
+#else
+    for (; i + 4 <= n; i += 4) {
+        for (int j = 0; j < 4; j++) lanes[j] += v[i + j];
+    }
+#endif
+    for (int j = 0; i < n; i++, j++) lanes[j] += v[i];
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+/*
+ * n > 0 ধরে নিয়ে smallest/largest; প্রতিটি ধাপ "x < best ? x : best"
+ * (SIMD min/max-ও তাই করে), ফলে NaN element বাদ পড়ে — শুধু প্রথমটি
+ * NaN হলে ফলাফল NaN।
+ */
+static double nl_decs_extreme(const double *v, int n, int largest) {
+    int i = 0;
+    double best = v[0];
+#ifdef NL_VEC_LANES
+    if (n >= NL_VEC_LANES) {
+        nl_dvec acc = nl_dset(v[0]);
+        for (; i + NL_VEC_LANES <= n; i += NL_VEC_LANES) {
+            nl_dvec x = nl_dload(v + i);
+            acc = largest ? nl_dmax(x, acc) : nl_dmin(x, acc);
+        }
+        double lanes[NL_VEC_LANES];
+        nl_dstore(lanes, acc);
+        for (int j = 0; j < NL_VEC_LANES; j++) {
+            if (largest ? lanes[j] > best : lanes[j] < best) best = lanes[j];
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        if (largest ? v[i] > best : v[i] < best) best = v[i];
+    }
+    return best;
+}
+
+/* অন্য element type-এর list: typed getter দিয়ে পড়ে একই কাজ (scalar)। */
+static int nl_list_find_num(NLList *list, long long value, int first_only) {
+    int count = 0;
     for (int i = 0; i < list->length; i++) {
         if (nl_list_get_num(list, i) == value) {
-            /* match মিললেই true return। */
-            return 1;
+            if (first_only) return i;
+            count++;
         }
     }
-    /* scan শেষে না পেলে false। */
-    return 0;
+    return first_only ? -1 : count;
 }
 
-int nl_list_contains_str(NLList *list, const char *value) {
-    /* list বা query string invalid হলে false। */
-    if (!list || !value) return 0;
-    /* সব item string compare করে containment check। */
+static int nl_list_find_dec(NLList *list, double value, int first_only) {
+    int count = 0;
     for (int i = 0; i < list->length; i++) {
-        char *item = nl_list_get_str(list, i);
-        if (item && strcmp(item, value) == 0) {
-            /* exact string match পেলে true। */
-            return 1;
+        if (nl_list_get_dec(list, i) == value) {
+            if (first_only) return i;
+            count++;
         }
     }
-    /* কোনো match না থাকলে false। */
-    return 0;
+    return first_only ? -1 : count;
+}
+
+static int nl_list_find_str(NLList *list, const char *value, int first_only) {
+    int count = 0;
+    /* text list ছাড়া কোনো string নেই। */
+    if (!list || !value || list->item_type != NL_LIST_TEXT) return first_only ? -1 : 0;
+    for (int i = 0; i < list->length; i++) {
+        if (strcmp(list->strs[i], value) == 0) {
+            if (first_only) return i;
+            count++;
+        }
+    }
+    return first_only ? -1 : count;
+}
+
+int nl_list_index_num(NLList *list, long long value) {
+    if (!list) return -1;
+    if (list->item_type == NL_LIST_NUMBER) return nl_nums_find(list->nums, list->length, value);
+    /* decimal list-এ value-কে decimal হিসেবে তুলনা করি (3.7 কে 3 ভাবি না)। */
+    if (list->item_type == NL_LIST_DECIMAL) return nl_decs_find(list->decs, list->length, (double)value);
+    return nl_list_find_num(list, value, 1);
+}
+
+int nl_list_index_dec(NLList *list, double value) {
+    if (!list) return -1;
+    if (list->item_type == NL_LIST_DECIMAL) return nl_decs_find(list->decs, list->length, value);
+    return nl_list_find_dec(list, value, 1);
+}
+
+int nl_list_index_str(NLList *list, const char *value) {
+    return nl_list_find_str(list, value, 1);
+}
+
+int nl_list_contains_num(NLList *list, long long value) {
+    return nl_list_index_num(list, value) >= 0;
+}
+
+int nl_list_contains_dec(NLList *list, double value) {
+    return nl_list_index_dec(list, value) >= 0;
+}
+
+int nl_list_contains_str(NLList *list, const char *value) {
+    return nl_list_find_str(list, value, 1) >= 0;
+}
+
+int nl_list_count_num(NLList *list, long long value) {
+    if (!list) return 0;
+    if (list->item_type == NL_LIST_NUMBER) return nl_nums_count(list->nums, list->length, value);
+    if (list->item_type == NL_LIST_DECIMAL) return nl_decs_count(list->decs, list->length, (double)value);
+    return nl_list_find_num(list, value, 0);
+}
+
+int nl_list_count_dec(NLList *list, double value) {
+    if (!list) return 0;
+    if (list->item_type == NL_LIST_DECIMAL) return nl_decs_count(list->decs, list->length, value);
+    return nl_list_find_dec(list, value, 0);
+}
+
+int nl_list_count_str(NLList *list, const char *value) {
+    return nl_list_find_str(list, value, 0);
+}
+
+long long nl_list_sum_num(NLList *list) {
+    if (!list) return 0;
+    if (list->item_type == NL_LIST_NUMBER) return nl_nums_sum(list->nums, list->length);
+    if (list->item_type == NL_LIST_DECIMAL) return (long long)nl_decs_sum(list->decs, list->length);
+    unsigned long long total = 0;
+    for (int i = 0; i < list->length; i++) total += (unsigned long long)nl_list_get_num(list, i);
+    return (long long)total;
+}
+
+double nl_list_sum_dec(NLList *list) {
+    if (!list) return 0.0;
+    if (list->item_type == NL_LIST_DECIMAL) return nl_decs_sum(list->decs, list->length);
+    if (list->item_type == NL_LIST_NUMBER) return (double)nl_nums_sum(list->nums, list->length);
+    double total = 0.0;
+    for (int i = 0; i < list->length; i++) total += nl_list_get_dec(list, i);
+    return total;
+}
+
+static long long nl_list_extreme_num(NLList *list, int largest) {
+    /* খালি list-এর smallest/largest 0, অন্য invalid read-এর মতো। */
+    if (!list || list->length == 0) return 0;
+    if (list->item_type == NL_LIST_NUMBER) return nl_nums_extreme(list->nums, list->length, largest);
+    if (list->item_type == NL_LIST_DECIMAL) return (long long)nl_decs_extreme(list->decs, list->length, largest);
+    long long best = nl_list_get_num(list, 0);
+    for (int i = 1; i < list->length; i++) {
+        long long x = nl_list_get_num(list, i);
+        if (largest ? x > best : x < best) best = x;
+    }
+    return best;
+}
+
+static double nl_list_extreme_dec(NLList *list, int largest) {
+    if (!list || list->length == 0) return 0.0;
+    if (list->item_type == NL_LIST_DECIMAL) return nl_decs_extreme(list->decs, list->length, largest);
+    return (double)nl_list_extreme_num(list, largest);
+}
+
+long long nl_list_min_num(NLList *list) { return nl_list_extreme_num(list, 0); }
+long long nl_list_max_num(NLList *list) { return nl_list_extreme_num(list, 1); }
+double nl_list_min_dec(NLList *list) { return nl_list_extreme_dec(list, 0); }
+double nl_list_max_dec(NLList *list) { return nl_list_extreme_dec(list, 1); }
+
+/* ============================================================================
+ * Number Formatting
+ * ============================================================================ */
+
+/* "00".."99": একবারে দুই digit লেখার জন্য। */
+static const char nl_digit_pairs[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+/* u-এর decimal digit সংখ্যা (u < 10^20 সবসময়)। */
+static int nl_digit_count(uint64_t u) {
+    int n = 1;
+    for (;;) {
+        if (u < 10) return n;
+        if (u < 100) return n + 1;
+        if (u < 1000) return n + 2;
+        if (u < 10000) return n + 3;
+        u /= 10000;
+        n += 4;
+    }
+}
+
+/* ঠিক `n` digit-এ u লিখি, শেষ দিক থেকে দুই digit করে। */
+static void nl_write_digits(char *out, uint64_t u, int n) {
+    char *p = out + n;
+    while (u >= 100) {
+        const char *pair = nl_digit_pairs + (u % 100) * 2;
+        u /= 100;
+        *--p = pair[1];
+        *--p = pair[0];
+    }
+    if (u >= 10) {
+        *--p = nl_digit_pairs[u * 2 + 1];
+        *--p = nl_digit_pairs[u * 2];
+    } else {
+        *--p = (char)('0' + u);
+    }
+}
+
+int nl_format_num(char *out, long long value) {
+    char *p = out;
+    uint64_t u = (uint64_t)value;
+    if (value < 0) {
+        *p++ = '-';
+        u = 0 - u;
+    }
+    int n = nl_digit_count(u);
+    nl_write_digits(p, u, n);
+    p[n] = '\0';
+    return (int)(p - out) + n;
+}
+
+/*
+ * Shortest round-trip decimal (Ryu, Ulf Adams, PLDI 2018): যে সবচেয়ে ছোট
+ * digit string আবার পড়লে ঠিক একই double ফেরত দেয় সেটা সরাসরি integer
+ * arithmetic-এ বের করি; power-of-five table naturelang_ryu_tables.h-এ।
+ */
+
+/* ceil(log2(5^e)) (e = 0 হলে 1), 0 <= e <= 3528 */
+static int nl_pow5_bits(int e) {
+    return (int)(((uint32_t)e * 1217359u) >> 19) + 1;
+}
+
+/* floor(log10(2^e)), 0 <= e <= 1650 */
+static int nl_log10_pow2(int e) {
+    return (int)(((uint32_t)e * 78913u) >> 18);
+}
+
+/* floor(log10(5^e)), 0 <= e <= 2620 */
+static int nl_log10_pow5(int e) {
+    return (int)(((uint32_t)e * 732923u) >> 20);
+}
+
+static int nl_pow5_factor(uint64_t value) {
+    int count = 0;
+    while (value % 5 == 0) {
+        value /= 5;
+        count++;
+    }
+    return count;
+}
+
+static int nl_multiple_of_pow5(uint64_t value, int p) {
+    return nl_pow5_factor(value) >= p;
+}
+
+static int nl_multiple_of_pow2(uint64_t value, int p) {
+    return (value & ((1ULL << p) - 1)) == 0;
+}
+
+/* a * b-এর নিচের 64 bit, উপরের 64 bit *high-এ। */
+static uint64_t nl_umul128(uint64_t a, uint64_t b, uint64_t *high) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 product = (unsigned __int128)a * b;
+    *high = (uint64_t)(product >> 64);
+    return (uint64_t)product;
+#else
+    uint64_t a_lo = a & 0xffffffffu, a_hi = a >> 32;
+    uint64_t b_lo = b & 0xffffffffu, b_hi = b >> 32;
+    uint64_t lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo;
+    uint64_t lo_hi = a_lo * b_hi, hi_hi = a_hi * b_hi;
+    uint64_t mid = (lo_lo >> 32) + (hi_lo & 0xffffffffu) + (lo_hi & 0xffffffffu);
+    *high = hi_hi + (hi_lo >> 32) + (lo_hi >> 32) + (mid >> 32);
+    return (mid << 32) | (lo_lo & 0xffffffffu);
+#endif
+}
+
+/* (m * mul) >> j, যেখানে mul একটি 128-bit table entry এবং 64 < j < 128 */
+static uint64_t nl_mul_shift64(uint64_t m, const uint64_t *mul, int j) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 b0 = (unsigned __int128)m * mul[0];
+    unsigned __int128 b2 = (unsigned __int128)m * mul[1];
+    return (uint64_t)(((b0 >> 64) + b2) >> (j - 64));
+#else
+    uint64_t high0, high1;
+    nl_umul128(m, mul[0], &high0);
+    uint64_t low1 = nl_umul128(m, mul[1], &high1);
+    uint64_t low = high0 + low1;
+    uint64_t high = high1 + (low < high0);
+    int shift = j - 64;  /* সবসময় 0 < shift < 64 */
+    return (high << (64 - shift)) | (low >> shift);
+#endif
+}
+
+/* finite, শূন্য নয় এমন double-কে digits * 10^exponent আকারে (digits সবচেয়ে কম)। */
+static void nl_shortest_decimal(uint64_t ieee_mantissa, int ieee_exponent,
+                                uint64_t *digits, int *exponent) {
+    int e2;
+    uint64_t m2;
+    if (ieee_exponent == 0) {
+        e2 = 1 - 1023 - 52 - 2;
+        m2 = ieee_mantissa;
+    } else {
+        e2 = ieee_exponent - 1023 - 52 - 2;
+        m2 = (1ULL << 52) | ieee_mantissa;
+    }
+    int accept_bounds = (m2 & 1) == 0;
+
+    /* value-এর চারপাশের rounding interval: [mv - mm_shift - 1, mv + 2] / 4 */
+    uint64_t mv = 4 * m2;
+    uint32_t mm_shift = ieee_mantissa != 0 || ieee_exponent <= 1;
+
+    uint64_t vr, vp, vm;
+    int e10;
+    int vm_trailing_zeros = 0, vr_trailing_zeros = 0;
+    if (e2 >= 0) {
+        int q = nl_log10_pow2(e2) - (e2 > 3);
+        e10 = q;
+        int k = NL_POW5_INV_BITCOUNT + nl_pow5_bits(q) - 1;
+        int i = -e2 + q + k;
+        vr = nl_mul_shift64(4 * m2, NL_POW5_INV_SPLIT[q], i);
+        vp = nl_mul_shift64(4 * m2 + 2, NL_POW5_INV_SPLIT[q], i);
+        vm = nl_mul_shift64(4 * m2 - 1 - mm_shift, NL_POW5_INV_SPLIT[q], i);
+        if (q <= 21) {
+            /* শুধু এখানে interval-এর কোনো প্রান্ত 10^q দিয়ে বিভাজ্য হতে পারে। */
+            if (mv % 5 == 0) {
+                vr_trailing_zeros = nl_multiple_of_pow5(mv, q);
+            } else if (accept_bounds) {
+                vm_trailing_zeros = nl_multiple_of_pow5(mv - 1 - mm_shift, q);
+            } else {
+                vp -= nl_multiple_of_pow5(mv + 2, q);
+            }
+        }
+    } else {
+        int q = nl_log10_pow5(-e2) - (-e2 > 1);
+        e10 = q + e2;
+        int i = -e2 - q;
+        int k = nl_pow5_bits(i) - NL_POW5_BITCOUNT;
+        int j = q - k;
+        vr = nl_mul_shift64(4 * m2, NL_POW5_SPLIT[i], j);
+        vp = nl_mul_shift64(4 * m2 + 2, NL_POW5_SPLIT[i], j);
+        vm = nl_mul_shift64(4 * m2 - 1 - mm_shift, NL_POW5_SPLIT[i], j);
+        if (q <= 1) {
+            /* mv-তে অন্তত q-টি trailing zero bit আছে (mv = 4 * m2)। */
+            vr_trailing_zeros = 1;
+            if (accept_bounds) {
+                vm_trailing_zeros = mm_shift == 1;
+            } else {
+                --vp;
+            }
+        } else if (q < 63) {
+            vr_trailing_zeros = nl_multiple_of_pow2(mv, q);
+        }
+    }
+
+    /* interval-এর ভিতরে থাকা অবস্থায় যত digit সম্ভব বাদ দিই। */
+    int removed = 0;
+    int last_removed = 0;
+    uint64_t output;
+    if (vm_trailing_zeros || vr_trailing_zeros) {
+        /* বিরল ক্ষেত্র: বাদ যাওয়া digit শূন্য কিনা খেয়াল রাখতে হয়। */
+        while (vp / 10 > vm / 10) {
+            vm_trailing_zeros &= vm % 10 == 0;
+            vr_trailing_zeros &= last_removed == 0;
+            last_removed = (int)(vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        if (vm_trailing_zeros) {
+            while (vm % 10 == 0) {
+                vr_trailing_zeros &= last_removed == 0;
+                last_removed = (int)(vr % 10);
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                removed++;
+            }
+        }
+        if (vr_trailing_zeros && last_removed == 5 && vr % 2 == 0) {
+            /* ঠিক মাঝখানে: জোড় দিকে round করি। */
+            last_removed = 4;
+        }
+        output = vr + ((vr == vm && (!accept_bounds || !vm_trailing_zeros)) || last_removed >= 5);
+    } else {
+        /* সাধারণ ক্ষেত্র (~99%): শুধু শেষ বাদ যাওয়া digit দিয়ে round। */
+        int round_up = 0;
+        if (vp / 100 > vm / 100) {
+            round_up = vr % 100 >= 50;
+            vr /= 100;
+            vp /= 100;
+            vm /= 100;
+            removed += 2;
+        }
+        while (vp / 10 > vm / 10) {
+            round_up = vr % 10 >= 5;
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        output = vr + (vr == vm || round_up);
+    }
+    *digits = output;
+    *exponent = e10 + removed;
+}
+
+int nl_format_dec(char *out, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    int sign = (int)(bits >> 63);
+    uint64_t ieee_mantissa = bits & ((1ULL << 52) - 1);
+    int ieee_exponent = (int)((bits >> 52) & 0x7ff);
+    char *p = out;
+
+    if (ieee_exponent == 0x7ff) {
+        /* %g-এর মতো inf / -inf / nan। */
+        const char *text = ieee_mantissa ? "nan" : sign ? "-inf" : "inf";
+        size_t n = strlen(text);
+        memcpy(out, text, n + 1);
+        return (int)n;
+    }
+    if (sign) *p++ = '-';
+    if (ieee_exponent == 0 && ieee_mantissa == 0) {
+        *p++ = '0';
+        *p = '\0';
+        return (int)(p - out);
+    }
+
+    uint64_t digits;
+    int exponent;
+    nl_shortest_decimal(ieee_mantissa, ieee_exponent, &digits, &exponent);
+    int n = nl_digit_count(digits);
+    /* প্রথম digit-এর দশমিক স্থান: value = d.ddd x 10^point */
+    int point = exponent + n - 1;
+
+    if (point < -4 || point >= 17) {
+        /* %g-এর মতো scientific: d.ddde+XX (exponent অন্তত দুই digit)। */
+        nl_write_digits(p + 1, digits, n);
+        p[0] = p[1];
+        if (n > 1) {
+            p[1] = '.';
+            p += n + 1;
+        } else {
+            p += 1;
+        }
+        *p++ = 'e';
+        *p++ = point < 0 ? '-' : '+';
+        int e = point < 0 ? -point : point;
+        if (e >= 100) {
+            *p++ = (char)('0' + e / 100);
+            e %= 100;
+        }
+        *p++ = nl_digit_pairs[e * 2];
+        *p++ = nl_digit_pairs[e * 2 + 1];
+    } else if (point < 0) {
+        /* 0.000ddd */
+        *p++ = '0';
+        *p++ = '.';
+        for (int i = -1; i > point; i--) *p++ = '0';
+        nl_write_digits(p, digits, n);
+        p += n;
+    } else if (point + 1 >= n) {
+        /* পূর্ণ সংখ্যা: ddd000 (দশমিক বিন্দু ছাড়া, %g-এর মতো) */
+        nl_write_digits(p, digits, n);
+        p += n;
+        for (int i = n; i <= point; i++) *p++ = '0';
+    } else {
+        /* ddd.ddd: integer অংশের পরে বিন্দু ঢোকাই। */
+        nl_write_digits(p, digits, n);
+        memmove(p + point + 2, p + point + 1, (size_t)(n - point - 1));
+        p[point + 1] = '.';
+        p += n + 1;
+    }
+    *p = '\0';
+    return (int)(p - out);
+}
+
+const char *nl_num_text(char *buffer, long long value) {
+    nl_format_num(buffer, value);
+    return buffer;
+}
+
+const char *nl_dec_text(char *buffer, double value) {
+    nl_format_dec(buffer, value);
+    return buffer;
+}
+
+const char *nl_flag_text(int value) {
+    return value ? "yes" : "no";
 }
 
 /* ============================================================================
@@ -257,7 +1063,7 @@ char *nl_concat(const char *a, const char *b) {
     size_t len_a = strlen(a);
     size_t len_b = strlen(b);
     /* concat result + trailing NUL এর জন্য heap buffer allocate। */
-    char *result = malloc(len_a + len_b + 1);
+    char *result = nl_malloc(len_a + len_b + 1);
     
     /* allocation successful হলে দুই অংশ copy করে final string তৈরি। */
     if (result) {
@@ -272,30 +1078,28 @@ char *nl_concat(const char *a, const char *b) {
 }
 
 char *nl_num_to_string(long long value) {
-    /* long long number stringে রূপান্তরের জন্য fixed-size buffer allocate। */
-    char *result = malloc(32);
-    /* allocation success হলে decimal text format-এ লিখি। */
-    if (result) {
-        snprintf(result, 32, "%lld", value);
-    }
+    /* stack-এ format করে exact length-এর একটিমাত্র allocation। */
+    char text[NL_NUM_CHARS];
+    int n = nl_format_num(text, value);
+    char *result = nl_malloc((size_t)n + 1);
+    if (result) memcpy(result, text, (size_t)n + 1);
     /* caller এই string পরে free করবে। */
     return result;
 }
 
 char *nl_dec_to_string(double value) {
-    /* floating value string render-এর জন্য তুলনামূলক বড় buffer allocate। */
-    char *result = malloc(64);
-    /* allocation success হলে %g format-এ compact decimal string লিখি। */
-    if (result) {
-        snprintf(result, 64, "%g", value);
-    }
+    /* shortest round-trip digit, stack buffer থেকে exact-size copy। */
+    char text[NL_DEC_CHARS];
+    int n = nl_format_dec(text, value);
+    char *result = nl_malloc((size_t)n + 1);
+    if (result) memcpy(result, text, (size_t)n + 1);
     /* allocated string pointer return। */
     return result;
 }
 
 char *nl_bool_to_string(int value) {
     /* boolean truth value-কে human-readable yes/no stringে map করি। */
-    return strdup(value ? "yes" : "no");
+    return nl_strdup(value ? "yes" : "no");
 }
 
 char *nl_to_string(long long value) {
@@ -303,6 +1107,96 @@ char *nl_to_string(long long value) {
     return nl_num_to_string(value);
 }
 
+/* ============================================================================
+ * String Builder
+ * ============================================================================ */
+
+void nl_strbuf_init(NLStrBuf *buf) {
+    /* শুরুতে inline storage ব্যবহার করি; ছোট message-এ heap লাগে না। */
+    buf->data = buf->inline_data;
+    buf->length = 0;
+    buf->capacity = sizeof(buf->inline_data);
+    buf->data[0] = '\0';
+}
+
+/* আরও `extra` byte (NUL বাদে) লেখার জায়গা নিশ্চিত করি। */
+static void nl_strbuf_reserve(NLStrBuf *buf, size_t extra) {
+    size_t needed = buf->length + extra + 1;
+    if (needed <= buf->capacity) return;
+    /* capacity দ্বিগুণ করে বাড়াই, যাতে বারবার append amortized O(1) থাকে। */
+    size_t capacity = buf->capacity * 2;
+    while (capacity < needed) capacity *= 2;
+    char *data;
+    if (buf->data == buf->inline_data) {
+        /* inline থেকে প্রথমবার heap-এ সরানো। */
+        data = nl_malloc(capacity);
+        if (data) memcpy(data, buf->inline_data, buf->length + 1);
+    } else {
+        data = nl_realloc(buf->data, capacity);
+    }
+    if (!data) {
+        fprintf(stderr, "Runtime Error: out of memory growing a string\n");
+        exit(1);
+    }
+    buf->data = data;
+    buf->capacity = capacity;
+}
+
+void nl_strbuf_append_str(NLStrBuf *buf, const char *s) {
+    if (!s) return;
+    size_t n = strlen(s);
+    nl_strbuf_reserve(buf, n);
+    /* NUL সহ copy, যাতে data সবসময় valid C string থাকে। */
+    memcpy(buf->data + buf->length, s, n + 1);
+    buf->length += n;
+}
+
+void nl_strbuf_append_num(NLStrBuf *buf, long long value) {
+    /* সরাসরি builder-এর buffer-এ format করি, মাঝখানে কোনো copy নেই। */
+    nl_strbuf_reserve(buf, NL_NUM_CHARS);
+    buf->length += (size_t)nl_format_num(buf->data + buf->length, value);
+}
+
+void nl_strbuf_append_dec(NLStrBuf *buf, double value) {
+    nl_strbuf_reserve(buf, NL_DEC_CHARS);
+    buf->length += (size_t)nl_format_dec(buf->data + buf->length, value);
+}
+
+void nl_strbuf_append_flag(NLStrBuf *buf, int value) {
+    /* nl_bool_to_string-এর মতো yes/no। */
+    nl_strbuf_append_str(buf, value ? "yes" : "no");
+}
+
+char *nl_strbuf_finish(NLStrBuf *buf) {
+    char *result;
+    if (buf->data == buf->inline_data) {
+        /* inline text: exact length-এর একটিমাত্র allocation। */
+        result = nl_malloc(buf->length + 1);
+        if (!result) {
+            fprintf(stderr, "Runtime Error: out of memory building a string\n");
+            exit(1);
+        }
+        memcpy(result, buf->data, buf->length + 1);
+    } else {
+        /* heap block-কে exact length-এ ছোট করে caller-কে দিয়ে দিই। */
+        result = nl_realloc(buf->data, buf->length + 1);
+        if (!result) result = buf->data;
+    }
+    nl_strbuf_init(buf);
+    return result;
+}
+
+char *nl_strbuf_text(const NLStrBuf *buf) {
+    /* loop চলাকালীন accumulator পড়া হলে: builder অক্ষত রেখে exact-size copy। */
+    char *result = nl_malloc(buf->length + 1);
+    if (!result) {
+        fprintf(stderr, "Runtime Error: out of memory building a string\n");
+        exit(1);
+    }
+    memcpy(result, buf->data, buf->length + 1);
+    return result;
+}
+
 int nl_string_equals(const char *a, const char *b) {
     /* কোনো একটি NULL হলে pointer identity rule apply (দুটোই NULL হলে equal)। */
     /*If either string pointer is NULL, the function does not do content comparison.
@@ -322,7 +1216,7 @@ int nl_string_length(const char *s) {
 
 char *nl_substring(const char *s, int start, int end) {
     /* source string NULL হলে empty string return। */
-    if (!s) return strdup("");
+    if (!s) return nl_strdup("");
     
     /* source length বের করে bounds normalize করার প্রস্তুতি। */
     int len = (int)strlen(s);
@@ -335,12 +1229,12 @@ clamp-এর পরে end = 5
 result হবে "ello" (1 থেকে শেষ পর্যন্ত)*/
     if (end > len) end = len;
     /* invalid/empty range হলে empty string return। */
-    if (start >= end) return strdup("");
+    if (start >= end) return nl_strdup("");
     
     /* substring effective length গণনা। */
     int sub_len = end - start;
     /* substring + NUL এর জন্য নতুন buffer allocate। */
-    char *result = malloc(sub_len + 1);
+    char *result = nl_malloc(sub_len + 1);
     /* allocation success হলে range copy করে terminator বসাই। */
     if (result) {
         memcpy(result, s + start, sub_len);
@@ -375,10 +1269,10 @@ int nl_string_contains(const char *haystack, const char *needle) {
 
 char *nl_string_upper(const char *s) {
     /* source NULL হলে empty string fallback। */
-    if (!s) return strdup("");
+    if (!s) return nl_strdup("");
     
     /* mutable copy বানাই যাতে inplace uppercase করা যায়। */
-    char *result = strdup(s);
+    char *result = nl_strdup(s);
     /* copy success হলে character-by-character uppercase transform। */
     if (result) {
         for (char *p = result; *p; p++) {
@@ -392,10 +1286,10 @@ char *nl_string_upper(const char *s) {
 
 char *nl_string_lower(const char *s) {
     /* source NULL হলে empty string return। */
-    if (!s) return strdup("");
+    if (!s) return nl_strdup("");
     
     /* writable duplicate তৈরি করি। */
-    char *result = strdup(s);
+    char *result = nl_strdup(s);
     /* duplicate success হলে lowercase conversion loop চালাই। */
     if (result) {
         for (char *p = result; *p; p++) {
@@ -409,14 +1303,14 @@ char *nl_string_lower(const char *s) {
 
 char *nl_string_trim(const char *s) {
     /* NULL source হলে empty result। */
-    if (!s) return strdup("");
+    if (!s) return nl_strdup("");
     
     /* Skip leading whitespace */
     /* শুরু থেকে whitespace skip করে first non-space-এ যাই। */
     while (*s && isspace((unsigned char)*s)) s++;
     
     /* পুরো string whitespace হলে empty string return। */
-    if (*s == '\0') return strdup("");
+    if (*s == '\0') return nl_strdup("");
     
     /* Find end of string */
     /* শেষ character থেকে reverse scan করে trailing whitespace trim point খুঁজি। */
@@ -451,7 +1345,7 @@ loop শেষে end গিয়ে 'o' তে দাঁড়ায়
     /* trimmed segment length নির্ণয়। */
     int len = end - s + 1;
     /* trimmed text + NUL buffer allocate। */
-    char *result = malloc(len + 1);
+    char *result = nl_malloc(len + 1);
     /* allocation success হলে trimmed অংশ copy ও terminate। */
     if (result) {
         memcpy(result, s, len);
@@ -520,131 +1414,454 @@ double nl_fmax(double a, double b) {
     return a > b ? a : b;
 }
 
-static int random_initialized = 0;
+/*
+ * Random numbers: xoshiro256** generator, প্রতিটি thread-এর নিজস্ব state-এ,
+ * তাই কোনো lock বা shared state নেই। প্রথম ব্যবহারে seed হয় — NL_SEED
+ * environment variable থাকলে তার মান দিয়ে (একই seed, একই sequence), নাহলে
+ * সময় ও state-এর address দিয়ে। NL_SEED-এর অধীনে k-তম thread তার stream
+ * k বার jump করে, ফলে thread-গুলোর sequence আলাদা অথচ reproducible।
+ */
+typedef struct {
+    uint64_t s[4];
+    int seeded;
+} NLRandomState;
 
-long long nl_random(long long min, long long max) {
-    /* RNG seed এখনো initialize না হলে একবার seed set করি। */
-    if (!random_initialized) {
-        /* current wall-clock time দিয়ে srand করে pseudo-random sequence শুরু। */
-        /*time(NULL) বর্তমান সময় (সেকেন্ডে, Unix epoch থেকে) রিটার্ন করে।
-(unsigned int) কাস্ট দিয়ে সেটাকে srand-এর উপযোগী টাইপে নেয়।
-srand(...) pseudo-random generator-এর seed সেট করে।
-এরপর rand() যে সংখ্যা দেবে, সেটা এই seed-এর ওপর নির্ভর করে sequence তৈরি করবে।
-কেন দরকার:
-
-seed না দিলে (বা সবসময় একই seed দিলে) rand() প্রতিবার program run-এ একই sequence দিতে পারে।
-current time দিয়ে seed দিলে run ভেদে sequence বদলায়।*/
-/*ধরা যাক এখন সময় 1711622400 (epoch seconds)
-তাহলে কার্যত এটা হবে:
-srand(1711622400u);
-এরপর rand() থেকে একটি sequence আসবে, যেমন (ধারণাগত উদাহরণ):
-
-rand() → 83452341
-rand() → 1923345
-rand() → 99812377
-আর nl_random(10, 15) করলে ফর্মুলা:
-range = 15 - 10 + 1 = 6
-result = 10 + (rand() % 6)
-উদাহরণ:
-
-যদি rand()%6 = 4 হয়, result = 14
-যদি rand()%6 = 0 হয়, result = 10
-যদি rand()%6 = 5 হয়, result = 15
-মানে output সবসময় 10..15 এর মধ্যে থাকবে (inclusive)।
-
-কেন time(NULL):
-
-প্রতিবার program run-এ seed বদলায়
-তাই random sequence-ও বদলায়
-কেন একবারই srand:
-
-বারবার srand দিলে (বিশেষ করে দ্রুত loop-এ) sequence খারাপ হতে পারে
-তাই random_initialized flag দিয়ে একবার seed করাই সঠিক approach।*/
-        srand((unsigned int)time(NULL));
-        /* seed initialization সম্পন্ন হয়েছে বলে flag raise। */
-        random_initialized = 1;
+static _Thread_local NLRandomState nl_rng;
+static atomic_uint nl_rng_threads;
+
+static inline uint64_t nl_rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+static inline uint64_t nl_rng_next(uint64_t *s) {
+    uint64_t result = nl_rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = nl_rotl(s[3], 45);
+    return result;
+}
+
+/* splitmix64 দিয়ে একটি 64-bit seed থেকে চারটি state word বানাই। */
+static void nl_rng_seed_state(uint64_t *s, uint64_t seed) {
+    for (int i = 0; i < 4; i++) {
+        uint64_t z = (seed += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        s[i] = z ^ (z >> 31);
     }
-    
-    /* caller min/max উল্টো দিলে swap করে valid range বানাই। */
-    if (min > max) {
-        /* temporary variable দিয়ে মান অদলবদল। */
-        long long tmp = min;
-        min = max;
-        max = tmp;
+}
+
+/* stream-কে 2^128 ধাপ এগিয়ে দিই, যাতে দুই thread-এর sequence overlap না করে। */
+static void nl_rng_jump(uint64_t *s) {
+    static const uint64_t jump[4] = {
+        0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+        0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+    };
+    uint64_t t[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 64; b++) {
+            if (jump[i] & (1ULL << b)) {
+                for (int k = 0; k < 4; k++) t[k] ^= s[k];
+            }
+            nl_rng_next(s);
+        }
     }
-    
-    /* inclusive range length: [min, max] তাই +1। */
-    long long range = max - min + 1;
-    /* rand()%range offset-কে min যোগ করে final bounded random ফেরত। */
-    return min + (rand() % range);
+    memcpy(s, t, sizeof(t));
+}
+
+/* বর্তমান thread-এর state; প্রথম ডাকে seed করি। */
+static uint64_t *nl_rng_state(void) {
+    if (!nl_rng.seeded) {
+        const char *env = getenv("NL_SEED");
+        if (env && *env) {
+            nl_rng_seed_state(nl_rng.s, (uint64_t)strtoll(env, NULL, 0));
+            unsigned index = atomic_fetch_add(&nl_rng_threads, 1);
+            for (unsigned i = 0; i < index; i++) nl_rng_jump(nl_rng.s);
+        } else {
+            struct timespec now;
+            clock_gettime(CLOCK_REALTIME, &now);
+            uint64_t seed = (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+            seed ^= (uint64_t)(uintptr_t)&nl_rng;
+            seed ^= (uint64_t)getpid() << 32;
+            nl_rng_seed_state(nl_rng.s, seed);
+        }
+        nl_rng.seeded = 1;
+    }
+    return nl_rng.s;
+}
+
+/* [0, range) থেকে unbiased মান (Lemire-এর multiply-shift, বিরল rejection সহ)। */
+static inline uint64_t nl_rng_below(uint64_t *s, uint64_t range) {
+    uint64_t high;
+    uint64_t low = nl_umul128(nl_rng_next(s), range, &high);
+    if (low < range) {
+        uint64_t threshold = (0 - range) % range;
+        while (low < threshold) {
+            low = nl_umul128(nl_rng_next(s), range, &high);
+        }
+    }
+    return high;
+}
+
+/* [min, max] থেকে একটি মান; range 0 মানে পুরো 64-bit পরিসর। */
+static inline long long nl_rng_between(uint64_t *s, long long min, uint64_t range) {
+    uint64_t offset = range ? nl_rng_below(s, range) : nl_rng_next(s);
+    return (long long)((uint64_t)min + offset);
+}
+
+/* inclusive [min, max]-এর আকার; min > max হলে আগে swap। */
+static uint64_t nl_rng_range(long long *min, long long *max) {
+    if (*min > *max) {
+        long long tmp = *min;
+        *min = *max;
+        *max = tmp;
+    }
+    return (uint64_t)*max - (uint64_t)*min + 1;
+}
+
+void nl_seed_random(long long seed) {
+    nl_rng_seed_state(nl_rng.s, (uint64_t)seed);
+    nl_rng.seeded = 1;
+}
+
+long long nl_random(long long min, long long max) {
+    uint64_t range = nl_rng_range(&min, &max);
+    return nl_rng_between(nl_rng_state(), min, range);
+}
+
+double nl_random_dec(void) {
+    /* উপরের 53 bit → [0, 1)-এ সমান দূরত্বের double। */
+    return (double)(nl_rng_next(nl_rng_state()) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+void nl_random_fill(long long *values, size_t count, long long min, long long max) {
+    uint64_t range = nl_rng_range(&min, &max);
+    /* loop-এর সময় state local-এ রাখি, যাতে register-এ থাকে। */
+    uint64_t *state = nl_rng_state();
+    uint64_t s[4] = {state[0], state[1], state[2], state[3]};
+    for (size_t i = 0; i < count; i++) {
+        values[i] = nl_rng_between(s, min, range);
+    }
+    memcpy(state, s, sizeof(s));
+}
+
+NLList *nl_random_list(long long count, long long min, long long max) {
+    if (count < 0) count = 0;
+    if (count > INT_MAX) nl_error("Too many random numbers requested");
+    NLList *list = nl_list_new_typed(NL_LIST_NUMBER, (int)count);
+    if (!list) nl_error("Memory allocation failed");
+    nl_random_fill(list->nums, (size_t)count, min, max);
+    list->length = (int)count;
+    return list;
 }
 
 /* ============================================================================
  * I/O Support
  * ============================================================================ */
 
+static char nl_out_buffer[NL_OUT_BUFFER];
+static size_t nl_out_length;
+static int nl_out_registered;
+
+void nl_out_flush(void) {
+    if (nl_out_length > 0) {
+        fwrite(nl_out_buffer, 1, nl_out_length, stdout);
+        nl_out_length = 0;
+    }
+    fflush(stdout);
+}
+
+/* buffer-এ আরও `n` byte (n <= NL_OUT_BUFFER) লেখার জায়গা; না থাকলে আগে flush। */
+static char *nl_out_reserve(size_t n) {
+    if (!nl_out_registered) {
+        /* exit-এর সময় বাকি output যেন হারিয়ে না যায়। */
+        atexit(nl_out_flush);
+        nl_out_registered = 1;
+    }
+    if (nl_out_length + n > NL_OUT_BUFFER) nl_out_flush();
+    return nl_out_buffer + nl_out_length;
+}
+
+static void nl_out_text(const char *s, size_t n) {
+    if (n > NL_OUT_BUFFER / 2) {
+        /* বড় text buffer-এ copy না করে সরাসরি লিখি (আগের output আগে যায়)। */
+        nl_out_reserve(NL_OUT_BUFFER);
+        fwrite(s, 1, n, stdout);
+        return;
+    }
+    memcpy(nl_out_reserve(n), s, n);
+    nl_out_length += n;
+}
+
+void nl_out_str(const char *s) {
+    if (s) nl_out_text(s, strlen(s));
+}
+
 void nl_display(const char *message) {
     if (message) {
-        printf("%s\n", message);
+        nl_out_text(message, strlen(message));
+        *nl_out_reserve(1) = '\n';
+        nl_out_length++;
     }
 }
 
 void nl_display_num(long long value) {
-    printf("%lld\n", value);
+    /* output buffer-এ সরাসরি format করে newline জুড়ি। */
+    char *p = nl_out_reserve(NL_NUM_CHARS);
+    int n = nl_format_num(p, value);
+    p[n] = '\n';
+    nl_out_length += (size_t)n + 1;
 }
 
 void nl_display_dec(double value) {
-    printf("%g\n", value);
+    char *p = nl_out_reserve(NL_DEC_CHARS);
+    int n = nl_format_dec(p, value);
+    p[n] = '\n';
+    nl_out_length += (size_t)n + 1;
 }
 
 void nl_display_bool(int value) {
-    printf("%s\n", value ? "yes" : "no");
+    nl_out_text(value ? "yes\n" : "no\n", value ? 4 : 3);
 }
 
-static char nl_input_buffer[4096];
+/*
+ * Input layer: stdin পড়া হয় বড় block-এ (NL_IN_BLOCK) একটি buffer-এ; প্রতিটি
+ * line সেই buffer-এর ভিতরেই newline-এর জায়গায় NUL বসিয়ে দেওয়া হয়, copy ছাড়া।
+ * buffer একটি runtime-owned malloc block, NatureLang value নয়, তাই allocator
+ * (region mode) এটিকে কখনো ছাড়বে না।
+ */
+static char *nl_in_data;
+static size_t nl_in_start;
+static size_t nl_in_end;
+static size_t nl_in_capacity;
+static long nl_in_line_number;
+static int nl_in_exhausted;
+static int nl_in_eof;
+
+/* আরও input আনি; EOF হলে 0। block ভরে যাওয়া line-এর জন্য buffer বড় করি। */
+static int nl_in_fill(void) {
+    if (nl_in_eof) return 0;
+    /* পড়ার জন্য অপেক্ষা করার আগে prompt ও জমা output দেখাই। */
+    nl_out_flush();
+    if (nl_in_start > 0) {
+        /* অসম্পূর্ণ line buffer-এর শুরুতে সরাই। */
+        memmove(nl_in_data, nl_in_data + nl_in_start, nl_in_end - nl_in_start);
+        nl_in_end -= nl_in_start;
+        nl_in_start = 0;
+    }
+    if (nl_in_capacity - nl_in_end < NL_IN_BLOCK / 2) {
+        size_t capacity = nl_in_capacity ? nl_in_capacity * 2 : NL_IN_BLOCK;
+        char *data = realloc(nl_in_data, capacity);
+        if (!data) nl_error("Memory allocation failed");
+        nl_in_data = data;
+        nl_in_capacity = capacity;
+    }
+    /* NUL terminator-এর জন্য এক byte বাদ রাখি। */
+    ssize_t n;
+    do {
+        n = read(STDIN_FILENO, nl_in_data + nl_in_end, nl_in_capacity - nl_in_end - 1);
+    } while (n < 0 && errno == EINTR);
+    if (n <= 0) {
+        nl_in_eof = 1;
+        return 0;
+    }
+    nl_in_end += (size_t)n;
+    return 1;
+}
 
-char *nl_input(const char *prompt) {
-    /* prompt text দেওয়া থাকলে আগে সেটি print করি। */
-    if (prompt) {
-        /* prompt newline ছাড়া দেখাই যাতে user একই লাইনে input দিতে পারে। */
-        printf("%s", prompt);
-        /* stdout buffer flush করে prompt সাথে সাথে দৃশ্যমান করি। */
-        fflush(stdout);
+const char *nl_read_line(size_t *length) {
+    for (;;) {
+        char *line = nl_in_data + nl_in_start;
+        char *newline = nl_in_data ? memchr(line, '\n', nl_in_end - nl_in_start) : NULL;
+        if (newline) {
+            *newline = '\0';
+            nl_in_start = (size_t)(newline - nl_in_data) + 1;
+            nl_in_line_number++;
+            if (length) *length = (size_t)(newline - line);
+            nl_in_exhausted = 0;
+            return line;
+        }
+        if (!nl_in_fill()) break;
     }
-    
-    /* stdin থেকে একটি লাইন পড়ার চেষ্টা করি shared buffer-এ। */
-    if (fgets(nl_input_buffer, sizeof(nl_input_buffer), stdin)) {
-        /* Remove trailing newline */
-        /* input-এর শেষে থাকা '\n' থাকলে সেটিকে NUL দিয়ে trim করি। */
-        nl_input_buffer[strcspn(nl_input_buffer, "\n")] = '\0';
-        /* caller-owned copy ফেরত দিতে buffer content strdup করি। */
-        return strdup(nl_input_buffer);
+    if (nl_in_data && nl_in_start < nl_in_end) {
+        /* newline ছাড়া শেষ line। */
+        char *line = nl_in_data + nl_in_start;
+        nl_in_data[nl_in_end] = '\0';
+        if (length) *length = nl_in_end - nl_in_start;
+        nl_in_start = nl_in_end;
+        nl_in_line_number++;
+        nl_in_exhausted = 0;
+        return line;
     }
-    
-    /* EOF/error হলে empty string return করে safe fallback দিই। */
-    return strdup("");
+    /* input শেষ: empty line। */
+    if (length) *length = 0;
+    nl_in_exhausted = 1;
+    return "";
+}
+
+/* parse ব্যর্থ হলে কোন input line-এ কী পাওয়া গেল তা জানিয়ে বন্ধ করি। */
+static void nl_parse_error(const char *what, const char *s, size_t length) {
+    char message[160];
+    if (nl_in_exhausted) {
+        snprintf(message, sizeof(message), "expected %s, but input ended after line %ld",
+                 what, nl_in_line_number);
+    } else if (length == 0) {
+        snprintf(message, sizeof(message), "expected %s on input line %ld, got an empty line",
+                 what, nl_in_line_number);
+    } else {
+        snprintf(message, sizeof(message), "expected %s on input line %ld, got '%.*s'",
+                 what, nl_in_line_number, length > 60 ? 60 : (int)length, s);
+    }
+    nl_error(message);
+}
+
+/* দুই পাশের space/tab/CR বাদ দিয়ে [*s, *s + *length) সংকুচিত করি। */
+static void nl_parse_trim(const char **s, size_t *length) {
+    while (*length > 0 && isspace((unsigned char)**s)) { (*s)++; (*length)--; }
+    while (*length > 0 && isspace((unsigned char)(*s)[*length - 1])) (*length)--;
+}
+
+long long nl_parse_num(const char *s, size_t length) {
+    const char *start = s;
+    size_t total = length;
+    nl_parse_trim(&s, &length);
+    size_t i = 0;
+    int negative = 0;
+    if (i < length && (s[i] == '+' || s[i] == '-')) negative = s[i++] == '-';
+    if (i == length) nl_parse_error("a number", start, total);
+    /* magnitude unsigned-এ জমাই, যাতে LLONG_MIN-ও ধরা যায়। */
+    unsigned long long limit = negative ? (unsigned long long)LLONG_MAX + 1 : LLONG_MAX;
+    unsigned long long value = 0;
+    for (; i < length; i++) {
+        unsigned digit = (unsigned)(s[i] - '0');
+        if (digit > 9) nl_parse_error("a number", start, total);
+        if (value > (limit - digit) / 10) nl_parse_error("a number in range", start, total);
+        value = value * 10 + digit;
+    }
+    return negative ? (long long)(0ULL - value) : (long long)value;
+}
+
+double nl_parse_dec(const char *s, size_t length) {
+    static const double powers[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    const char *start = s;
+    size_t total = length;
+    nl_parse_trim(&s, &length);
+    size_t i = 0;
+    int negative = 0;
+    if (i < length && (s[i] == '+' || s[i] == '-')) negative = s[i++] == '-';
+
+    /* mantissa-র প্রথম ১৯টি significant digit ও দশমিকের অবস্থান থেকে exponent। */
+    unsigned long long mantissa = 0;
+    int digits = 0, significant = 0, exponent = 0;
+    for (; i < length && isdigit((unsigned char)s[i]); i++, digits++) {
+        if (significant < 19) {
+            mantissa = mantissa * 10 + (unsigned)(s[i] - '0');
+            if (mantissa) significant++;
+        } else {
+            exponent++;
+        }
+    }
+    if (i < length && s[i] == '.') {
+        for (i++; i < length && isdigit((unsigned char)s[i]); i++, digits++) {
+            if (significant < 19) {
+                mantissa = mantissa * 10 + (unsigned)(s[i] - '0');
+                if (mantissa) significant++;
+                exponent--;
+            }
+        }
+    }
+    if (digits == 0) nl_parse_error("a decimal", start, total);
+    if (i < length && (s[i] == 'e' || s[i] == 'E')) {
+        int exp_negative = 0, exp_value = 0;
+        i++;
+        if (i < length && (s[i] == '+' || s[i] == '-')) exp_negative = s[i++] == '-';
+        if (i == length) nl_parse_error("a decimal", start, total);
+        for (; i < length && isdigit((unsigned char)s[i]); i++) {
+            if (exp_value < 100000) exp_value = exp_value * 10 + (s[i] - '0');
+        }
+        exponent += exp_negative ? -exp_value : exp_value;
+    }
+    if (i != length) nl_parse_error("a decimal", start, total);
+
+    /* mantissa ও 10^|exponent| দুটোই double-এ exact হলে এক গুণ/ভাগেই সঠিক rounding। */
+    double value;
+    if (mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22) {
+        value = exponent < 0 ? (double)mantissa / powers[-exponent]
+                             : (double)mantissa * powers[exponent];
+        return negative ? -value : value;
+    }
+    /* বাকি (বিরল) ক্ষেত্রে libc-র correctly rounded conversion; grammar আগেই যাচাই হয়েছে। */
+    char copy[400];
+    if (length >= sizeof(copy)) return strtod(s, NULL);
+    memcpy(copy, s, length);
+    copy[length] = '\0';
+    return strtod(copy, NULL);
+}
+
+int nl_parse_flag(const char *s, size_t length) {
+    static const char *const words[] = { "yes", "true", "1", "no", "false", "0" };
+    const char *start = s;
+    size_t total = length;
+    nl_parse_trim(&s, &length);
+    for (int w = 0; w < 6; w++) {
+        size_t n = strlen(words[w]);
+        if (n != length) continue;
+        size_t k = 0;
+        while (k < n && tolower((unsigned char)s[k]) == words[w][k]) k++;
+        if (k == n) return w < 3;
+    }
+    nl_parse_error("yes or no", start, total);
+    return 0;
+}
+
+char *nl_read_text(void) {
+    /* line slice পরের read-এ বদলে যাবে, তাই value হিসেবে রাখতে একবার copy। */
+    size_t length;
+    const char *line = nl_read_line(&length);
+    char *copy = nl_malloc(length + 1);
+    memcpy(copy, line, length + 1);
+    return copy;
+}
+
+long long nl_read_num(void) {
+    size_t length;
+    const char *line = nl_read_line(&length);
+    return nl_parse_num(line, length);
+}
+
+double nl_read_dec(void) {
+    size_t length;
+    const char *line = nl_read_line(&length);
+    return nl_parse_dec(line, length);
+}
+
+int nl_read_flag(void) {
+    size_t length;
+    const char *line = nl_read_line(&length);
+    return nl_parse_flag(line, length);
+}
+
+char *nl_input(const char *prompt) {
+    /* prompt (থাকলে) output-এ দিয়ে পরের line পড়ি; পড়ার আগে output flush হয়। */
+    nl_out_str(prompt);
+    return nl_read_text();
 }
 
 long long nl_input_num(const char *prompt) {
-    /* raw text input সংগ্রহ করি prompt সহ। */
-    char *input = nl_input(prompt);
-    /* string-কে long long number-এ parse করি। */
-    long long result = atoll(input);
-    /* temporary input buffer copy মুক্ত করি। */
-    free(input);
-    /* parsed integer result caller-কে ফেরত। */
-    return result;
+    nl_out_str(prompt);
+    return nl_read_num();
 }
 
 double nl_input_dec(const char *prompt) {
-    /* prompt দেখিয়ে text input নেই। */
-    char *input = nl_input(prompt);
-    /* string input-কে double decimal-এ convert করি। */
-    double result = atof(input);
-    /* temporary copied string memory free। */
-    free(input);
-    /* parsed decimal value return। */
-    return result;
+    nl_out_str(prompt);
+    return nl_read_dec();
 }
 
 /* ============================================================================
@@ -667,25 +1884,215 @@ int nl_to_flag(long long value) {
  * Memory Management
  * ============================================================================ */
 
-char *nl_strdup(const char *s) {
-    /* input string valid হলে strdup copy, নাহলে NULL ফেরত। */
-    return s ? strdup(s) : NULL;
+#ifndef NL_ALLOC_DEFAULT
+#define NL_ALLOC_DEFAULT NL_ALLOC_SYSTEM
+#endif
+
+/*
+ * slab ও region mode-এ প্রতিটি block-এর আগে ৮ byte header থাকে, তাতে block-এর
+ * payload capacity। free/realloc এটি দেখে block কোথা থেকে এসেছে বোঝে।
+ */
+#define NL_BLOCK_HEADER 8
+#define NL_SLAB_MAX 256
+#define NL_SLAB_CLASSES 8
+#define NL_SLAB_CHUNK (64 * 1024)
+#define NL_REGION_CHUNK (256 * 1024)
+
+/* size class-এর payload size; (size + 15) / 16 দিয়ে class খুঁজি। */
+static const size_t nl_slab_size[NL_SLAB_CLASSES] = { 16, 32, 48, 64, 96, 128, 192, 256 };
+static const unsigned char nl_slab_class_of[NL_SLAB_MAX / 16 + 1] = {
+    0, 0, 1, 2, 3, 4, 4, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7
+};
+
+typedef struct NLRegionChunk {
+    struct NLRegionChunk *prev;
+    size_t size;
+    size_t used;
+    char *data;
+} NLRegionChunk;
+
+static int nl_alloc_mode_value = -1;
+static void *nl_slab_free_list[NL_SLAB_CLASSES];
+static char *nl_slab_next[NL_SLAB_CLASSES];
+static char *nl_slab_end[NL_SLAB_CLASSES];
+static NLRegionChunk *nl_region_top;
+static NLRegionChunk *nl_region_spare;
+static char *nl_region_last;
+
+NLAllocMode nl_alloc_mode(void) {
+    if (nl_alloc_mode_value < 0) {
+        /* প্রথম allocation-এ একবারই mode ঠিক করি; পরে বদলালে পুরনো block ভুল পথে free হবে। */
+        const char *env = getenv("NL_ALLOC");
+        nl_alloc_mode_value = NL_ALLOC_DEFAULT;
+        if (env && strcmp(env, "system") == 0) nl_alloc_mode_value = NL_ALLOC_SYSTEM;
+        else if (env && strcmp(env, "slab") == 0) nl_alloc_mode_value = NL_ALLOC_SLAB;
+        else if (env && strcmp(env, "region") == 0) nl_alloc_mode_value = NL_ALLOC_REGION;
+    }
+    return (NLAllocMode)nl_alloc_mode_value;
 }
 
-void *nl_alloc(size_t size) {
-    /* calloc দিয়ে requested size-এর zero-initialized memory allocate। */
-    void *ptr = calloc(1, size);
-    /* allocation fail হলে runtime error throw/exit path trigger। */
-    if (!ptr) {
-        nl_error("Memory allocation failed");
+static void *nl_checked(void *ptr) {
+    if (!ptr) nl_error("Memory allocation failed");
+    return ptr;
+}
+
+static size_t nl_block_capacity(const void *ptr) {
+    size_t capacity;
+    memcpy(&capacity, (const char *)ptr - NL_BLOCK_HEADER, sizeof(capacity));
+    return capacity;
+}
+
+static void *nl_block_init(char *block, size_t capacity) {
+    memcpy(block, &capacity, sizeof(capacity));
+    return block + NL_BLOCK_HEADER;
+}
+
+static void *nl_slab_malloc(size_t size) {
+    if (size > NL_SLAB_MAX) {
+        /* বড় block সরাসরি malloc; header-এ আসল size। */
+        return nl_block_init(nl_checked(malloc(NL_BLOCK_HEADER + size)), size);
+    }
+    int cls = nl_slab_class_of[(size + 15) / 16];
+    void *free_block = nl_slab_free_list[cls];
+    if (free_block) {
+        /* free list-এর মাথা থেকে নিই; পরের pointer block-এর payload-এ রাখা। */
+        memcpy(&nl_slab_free_list[cls], free_block, sizeof(void *));
+        return free_block;
+    }
+    size_t step = NL_BLOCK_HEADER + nl_slab_size[cls];
+    if (!nl_slab_next[cls] || (size_t)(nl_slab_end[cls] - nl_slab_next[cls]) < step) {
+        /* নতুন chunk: এই class-এর block এখান থেকে একে একে কেটে নিই। */
+        nl_slab_next[cls] = nl_checked(malloc(NL_SLAB_CHUNK));
+        nl_slab_end[cls] = nl_slab_next[cls] + NL_SLAB_CHUNK;
+    }
+    char *block = nl_slab_next[cls];
+    nl_slab_next[cls] += step;
+    return nl_block_init(block, nl_slab_size[cls]);
+}
+
+static void nl_slab_free(void *ptr) {
+    size_t capacity = nl_block_capacity(ptr);
+    if (capacity > NL_SLAB_MAX) {
+        free((char *)ptr - NL_BLOCK_HEADER);
+        return;
+    }
+    int cls = nl_slab_class_of[capacity / 16];
+    memcpy(ptr, &nl_slab_free_list[cls], sizeof(void *));
+    nl_slab_free_list[cls] = ptr;
+}
+
+static void *nl_region_malloc(size_t size) {
+    size_t capacity = (size + 7) & ~(size_t)7;
+    size_t need = NL_BLOCK_HEADER + capacity;
+    NLRegionChunk *chunk = nl_region_top;
+    if (!chunk || chunk->size - chunk->used < need) {
+        /* আগে ছেড়ে দেওয়া chunk যথেষ্ট বড় হলে সেটিই আবার ব্যবহার করি। */
+        chunk = nl_region_spare;
+        if (chunk && chunk->size >= need) {
+            nl_region_spare = chunk->prev;
+        } else {
+            size_t chunk_size = need > NL_REGION_CHUNK ? need : NL_REGION_CHUNK;
+            chunk = nl_checked(malloc(sizeof(NLRegionChunk) + chunk_size));
+            chunk->data = (char *)(chunk + 1);
+            chunk->size = chunk_size;
+        }
+        chunk->used = 0;
+        chunk->prev = nl_region_top;
+        nl_region_top = chunk;
     }
-    /* সফল allocation pointer caller-কে ফেরত। */
+    char *block = chunk->data + chunk->used;
+    chunk->used += need;
+    nl_region_last = block;
+    return nl_block_init(block, capacity);
+}
+
+void *nl_malloc(size_t size) {
+    switch (nl_alloc_mode()) {
+        case NL_ALLOC_SLAB:   return nl_slab_malloc(size);
+        case NL_ALLOC_REGION: return nl_region_malloc(size);
+        default:              return nl_checked(malloc(size ? size : 1));
+    }
+}
+
+void *nl_alloc(size_t size) {
+    /* requested size-এর zero-initialized memory। */
+    void *ptr = nl_malloc(size);
+    memset(ptr, 0, size);
     return ptr;
 }
 
+void *nl_realloc(void *ptr, size_t size) {
+    if (!ptr) return nl_malloc(size);
+    NLAllocMode mode = nl_alloc_mode();
+    if (mode == NL_ALLOC_SYSTEM) return nl_checked(realloc(ptr, size ? size : 1));
+
+    size_t capacity = nl_block_capacity(ptr);
+    if (size <= capacity) return ptr;
+    if (mode == NL_ALLOC_SLAB && capacity > NL_SLAB_MAX) {
+        /* malloc-এর বড় block: realloc নিজেই in-place বাড়াতে পারে। */
+        char *block = nl_checked(realloc((char *)ptr - NL_BLOCK_HEADER, NL_BLOCK_HEADER + size));
+        return nl_block_init(block, size);
+    }
+    if (mode == NL_ALLOC_REGION && (char *)ptr - NL_BLOCK_HEADER == nl_region_last) {
+        /* region-এর সর্বশেষ block হলে chunk-এ জায়গা থাকলে জায়গাতেই বাড়াই। */
+        size_t grown = (size + 7) & ~(size_t)7;
+        if (nl_region_top->size - nl_region_top->used >= grown - capacity) {
+            nl_region_top->used += grown - capacity;
+            return nl_block_init(nl_region_last, grown);
+        }
+    }
+    void *moved = nl_malloc(size);
+    memcpy(moved, ptr, capacity);
+    nl_free(ptr);
+    return moved;
+}
+
 void nl_free(void *ptr) {
-    /* generic free wrapper: caller দেওয়া pointer মুক্ত করি। */
-    free(ptr);
+    if (!ptr) return;
+    switch (nl_alloc_mode()) {
+        case NL_ALLOC_SLAB:
+            nl_slab_free(ptr);
+            break;
+        case NL_ALLOC_REGION:
+            /* region-এ শুধু সর্বশেষ block ফেরত নেওয়া যায়; বাকিরা region ছাড়লে যায়। */
+            if ((char *)ptr - NL_BLOCK_HEADER == nl_region_last) {
+                nl_region_top->used = (size_t)(nl_region_last - nl_region_top->data);
+                nl_region_last = NULL;
+            }
+            break;
+        default:
+            free(ptr);
+            break;
+    }
+}
+
+char *nl_strdup(const char *s) {
+    /* input string valid হলে allocator থেকে copy, নাহলে NULL ফেরত। */
+    if (!s) return NULL;
+    size_t n = strlen(s) + 1;
+    return memcpy(nl_malloc(n), s, n);
+}
+
+NLRegionMark nl_region_enter(void) {
+    NLRegionMark mark = { NULL, 0 };
+    if (nl_alloc_mode() == NL_ALLOC_REGION && nl_region_top) {
+        mark.chunk = nl_region_top;
+        mark.used = nl_region_top->used;
+    }
+    return mark;
+}
+
+void nl_region_leave(NLRegionMark mark) {
+    if (nl_alloc_mode() != NL_ALLOC_REGION) return;
+    /* mark-এর পরে খোলা chunk-গুলো spare list-এ যায়, পরের allocation আবার নেবে। */
+    while (nl_region_top && nl_region_top != mark.chunk) {
+        NLRegionChunk *chunk = nl_region_top;
+        nl_region_top = chunk->prev;
+        chunk->prev = nl_region_spare;
+        nl_region_spare = chunk;
+    }
+    if (nl_region_top) nl_region_top->used = mark.used;
+    nl_region_last = NULL;
 }
 
 /* ============================================================================
@@ -695,6 +2102,8 @@ void nl_free(void *ptr) {
 void nl_error(const char *message) {
     /* runtime error message stderr-এ নির্দিষ্ট format-এ print করি। */
     /* message NULL হলে fallback হিসেবে "Unknown error" ব্যবহার করি। */
+    /* আগের display output যেন error message-এর আগে দেখা যায়। */
+    nl_out_flush();
     fprintf(stderr, "Runtime Error: %s\n", message ? message : "Unknown error");
     /* fatal runtime error হওয়ায় non-zero status (1) দিয়ে program terminate করি। */
     exit(1);
@@ -711,23 +2120,12 @@ void nl_assert(int condition, const char *message) {
 /* ============================================================================
  * Initialization
  * ============================================================================ */
-/*Program startup-এ random generator seed set করে (srand(time(NULL)))।
-random_initialized = 1 করে দেয়, যাতে nl_random পরে গিয়ে আবার seed না করে।
-Initialization concern এক জায়গায় রাখে, ফলে runtime startup behavior predictable হয়।
-Future expansion point দেয়: পরে global cache, locale, IO state ইত্যাদি init দরকার হলে এখানেই যোগ করা যাবে।
-Important detail:
-
-এই codebase-এ nl_random নিজেও lazy seed করে (flag check করে), তাই strictly mandatory না।
-কিন্তু nl_runtime_init থাকলে startup contract পরিষ্কার হয়: “runtime ready before use”।*/
 void nl_runtime_init(void) {
-    /* runtime startup-এ pseudo-random generator seed initialize করি। */
-    /* time(NULL) ভিত্তিক seed দিলে প্রতিটি run-এ sequence সাধারণত আলাদা হয়। */
-    srand((unsigned int)time(NULL));
-    /* nl_random যেন আবার seed না করে, তাই initialized flag on করি। */
-    random_initialized = 1;
+    /* main thread-এর random state আগেভাগে seed করি (NL_SEED থাকলে stream 0)। */
+    nl_rng_state();
 }
 
 void nl_runtime_cleanup(void) {
-    /* বর্তমানে runtime-level global resource cleanup প্রয়োজন নেই। */
-    /* ভবিষ্যতে shared resource যোগ হলে cleanup logic এখানে বসবে। */
+    /* display buffer-এ জমে থাকা output stdout-এ পাঠাই। */
+    nl_out_flush();
 }
@@ -15,24 +15,52 @@
  * List Support
  * ============================================================================ */
 
+/*
+ * Element types. A list's element type is chosen when it is created and
+ * never changes; its payload is one contiguous array of that type.
+ * NL_LIST_UNTYPED is only held by an empty list made with nl_list_new(),
+ * which takes the type of whatever is appended to it first.
+ */
+typedef enum {
+    NL_LIST_UNTYPED = -1,
+    NL_LIST_NUMBER  = 0,   /* long long[] */
+    NL_LIST_DECIMAL = 1,   /* double[] */
+    NL_LIST_TEXT    = 2,   /* char*[], each string owned by the list */
+    NL_LIST_FLAG    = 3    /* bits, eight elements per byte */
+} NLListType;
+
 /* Dynamic list structure */
 typedef struct NLList {
-    void **items;
+    union {
+        long long *nums;
+        double *decs;
+        char **strs;
+        unsigned char *flags;
+        void *data;
+    };
     int length;
     int capacity;
-    int item_type;  /* 0=number, 1=decimal, 2=text, 3=flag */
+    int item_type;  /* NLListType */
 } NLList;
 
-/* Create a new list with initial elements (variadic) */
-/*... means those extra arguments are passed after count.
-So calls can look like:
-NLList *list = nl_list_create(3, (void*)1, (void*)2, (void*)3);
-Why it is used here:
-
-It lets the runtime create a list and optionally receive initial elements in one call.*/
+/*
+ * Create a number list holding `count` initial elements, passed as
+ * long long after count:
+ *     NLList *list = nl_list_create(3, 1LL, 2LL, 3LL);
+ * With count == 0 this is nl_list_new().
+ */
 NLList *nl_list_create(int count, ...);
 
-/* Create an empty list */
+/*
+ * Create a list of `count` elements of item_type, passed after count as
+ * long long (number), double (decimal), const char * (text) or int (flag).
+ */
+NLList *nl_list_of(int item_type, int count, ...);
+
+/* Create an empty list with a fixed element type and room for `capacity` elements */
+NLList *nl_list_new_typed(int item_type, int capacity);
+
+/* Create an empty untyped list */
 NLList *nl_list_new(void);
 
 /* Free a list */
@@ -41,29 +69,95 @@ void nl_list_free(NLList *list);
 /* Get list length */
 int nl_list_length(NLList *list);
 
-/* Append to list */
-void nl_list_append(NLList *list, void *item);
+/*
+ * Typed accessors. Reading or writing a list of another element type
+ * converts the value (number <-> decimal <-> flag, text parsed or
+ * formatted) instead of reinterpreting the storage; nl_list_get_str()
+ * returns "" for lists that do not hold text.
+ */
 void nl_list_append_num(NLList *list, long long value);
 void nl_list_append_dec(NLList *list, double value);
 void nl_list_append_str(NLList *list, const char *value);
+void nl_list_append_flag(NLList *list, int value);
 
-/* Get from list */
-void *nl_list_get(NLList *list, int index);
 long long nl_list_get_num(NLList *list, int index);
 double nl_list_get_dec(NLList *list, int index);
 char *nl_list_get_str(NLList *list, int index);
+int nl_list_get_flag(NLList *list, int index);
 
-/* Set in list */
-void nl_list_set(NLList *list, int index, void *item);
 void nl_list_set_num(NLList *list, int index, long long value);
+void nl_list_set_dec(NLList *list, int index, double value);
+void nl_list_set_str(NLList *list, int index, const char *value);
+void nl_list_set_flag(NLList *list, int index, int value);
+
+/*
+ * Generic pointer-slot API, kept for older generated code. An item is a
+ * number cast to a pointer (number and flag lists), a pointer to a double
+ * that is copied (decimal lists) or a heap string the list takes
+ * ownership of (text lists). nl_list_get() returns items the same way;
+ * for decimal lists the pointer is valid until the list next changes.
+ */
+void nl_list_append(NLList *list, void *item);
+void *nl_list_get(NLList *list, int index);
+void nl_list_set(NLList *list, int index, void *item);
 
 /* Remove from list */
 void nl_list_remove(NLList *list, int index);
 
-/* Check if list contains item */
+/*
+ * Search and reduction. Number and decimal lists are scanned in their
+ * typed storage with SIMD (AVX2 or SSE2, whichever the program is compiled
+ * for); lists of other element types are read through the accessors
+ * above, and a number is compared with a decimal list as a decimal.
+ * Positions start at 0, with -1 for a value the list does not hold. The
+ * smallest and largest of an empty list are 0. Number sums wrap around on
+ * overflow; decimal sums are added in four interleaved lanes, so they are
+ * the same on every machine.
+ */
 int nl_list_contains_num(NLList *list, long long value);
+int nl_list_contains_dec(NLList *list, double value);
 int nl_list_contains_str(NLList *list, const char *value);
 
+int nl_list_index_num(NLList *list, long long value);
+int nl_list_index_dec(NLList *list, double value);
+int nl_list_index_str(NLList *list, const char *value);
+
+int nl_list_count_num(NLList *list, long long value);
+int nl_list_count_dec(NLList *list, double value);
+int nl_list_count_str(NLList *list, const char *value);
+
+long long nl_list_sum_num(NLList *list);
+double nl_list_sum_dec(NLList *list);
+
+long long nl_list_min_num(NLList *list);
+long long nl_list_max_num(NLList *list);
+double nl_list_min_dec(NLList *list);
+double nl_list_max_dec(NLList *list);
+
+/* ============================================================================
+ * Number Formatting
+ * ============================================================================ */
+
+/*
+ * Numbers and decimals are formatted into a caller-provided buffer, so
+ * display, concatenation and string builders convert them without
+ * allocating. Decimals are written with the fewest significant digits
+ * that read back as the same double, in %g layout: plain notation for
+ * exponents -4 through 16, otherwise d.ddde+XX; inf, -inf and nan as %g
+ * writes them.
+ */
+#define NL_NUM_CHARS 24   /* "-9223372036854775808" and the NUL */
+#define NL_DEC_CHARS 32   /* "-2.2250738585072014e-308" and the NUL */
+
+/* Format into buffer (NL_NUM_CHARS / NL_DEC_CHARS bytes); returns the length */
+int nl_format_num(char *buffer, long long value);
+int nl_format_dec(char *buffer, double value);
+
+/* The same, returning the text, for use inside an expression */
+const char *nl_num_text(char *buffer, long long value);
+const char *nl_dec_text(char *buffer, double value);
+const char *nl_flag_text(int value);
+
 /* ============================================================================
  * String Support
  * ============================================================================ */
@@ -102,6 +196,38 @@ char *nl_string_lower(const char *s);
 /* String trim */
 char *nl_string_trim(const char *s);
 
+/*
+ * Growable string builder. Generated code fuses a chain of concatenations
+ *     "n=" plus n plus ", d=" plus d
+ * into appends on one builder instead of allocating every intermediate
+ * string. Short results stay in inline_data; nl_strbuf_finish() hands
+ * back a heap copy of exactly length + 1 bytes. A builder points into
+ * itself, so it must not be copied by value.
+ */
+#define NL_STRBUF_INLINE 128
+
+typedef struct NLStrBuf {
+    char *data;         /* inline_data or a heap block */
+    size_t length;
+    size_t capacity;
+    char inline_data[NL_STRBUF_INLINE];
+} NLStrBuf;
+
+/* Start an empty builder */
+void nl_strbuf_init(NLStrBuf *buf);
+
+/* Append text (NULL appends nothing) or a value formatted like display */
+void nl_strbuf_append_str(NLStrBuf *buf, const char *s);
+void nl_strbuf_append_num(NLStrBuf *buf, long long value);
+void nl_strbuf_append_dec(NLStrBuf *buf, double value);
+void nl_strbuf_append_flag(NLStrBuf *buf, int value);
+
+/* Return the text as a newly allocated string and leave the builder empty */
+char *nl_strbuf_finish(NLStrBuf *buf);
+
+/* Return a newly allocated copy of the text so far; the builder keeps it */
+char *nl_strbuf_text(const NLStrBuf *buf);
+
 /* ============================================================================
  * Math Support
  * ============================================================================ */
@@ -119,20 +245,79 @@ long long nl_max(long long a, long long b);
 double nl_fmin(double a, double b);
 double nl_fmax(double a, double b);
 
-/* Random number */
+/*
+ * Random numbers (xoshiro256**). Each thread has its own generator, seeded
+ * on first use from NL_SEED when that is set, otherwise from the clock.
+ * Under NL_SEED every thread gets its own reproducible, non-overlapping
+ * stream; nl_seed_random reseeds the calling thread only.
+ */
+void nl_seed_random(long long seed);
+
+/* Uniform in [min, max] inclusive (bounds may be given in either order) */
 long long nl_random(long long min, long long max);
 
+/* Uniform in [0, 1) */
+double nl_random_dec(void);
+
+/* Fill values[0..count) with uniform numbers in [min, max] */
+void nl_random_fill(long long *values, size_t count, long long min, long long max);
+
+/* New number list of `count` uniform numbers in [min, max] */
+NLList *nl_random_list(long long count, long long min, long long max);
+
 /* ============================================================================
  * I/O Support
  * ============================================================================ */
 
-/* Display functions */
+/*
+ * Output layer: display and prompts append to one large per-process
+ * buffer instead of going through printf. The buffer is written to stdout
+ * when the next value would not fit, before input is read, on runtime
+ * errors and at exit, so output is never lost or reordered.
+ */
+#define NL_OUT_BUFFER (64 * 1024)
+
+/* Append text without a newline (prompts) */
+void nl_out_str(const char *s);
+
+/* Write everything buffered so far to stdout */
+void nl_out_flush(void);
+
+/* Display functions: one value and a newline */
 void nl_display(const char *message);
 void nl_display_num(long long value);
 void nl_display_dec(double value);
 void nl_display_bool(int value);
 
-/* Input functions */
+/*
+ * Input layer: stdin is read in blocks of NL_IN_BLOCK bytes (or more, for
+ * longer lines) and handed out one line at a time, in place. Anything
+ * buffered for output is flushed before the runtime waits for input.
+ */
+#define NL_IN_BLOCK (64 * 1024)
+
+/*
+ * Next line of stdin without its newline, NUL-terminated. The slice is
+ * only valid until the next read; "" once the input is exhausted.
+ */
+const char *nl_read_line(size_t *length);
+
+/* Next line as a value; malformed numbers, decimals and flags are runtime errors */
+char *nl_read_text(void);
+long long nl_read_num(void);
+double nl_read_dec(void);
+int nl_read_flag(void);
+
+/*
+ * Parse a whole line (surrounding blanks allowed): an optionally signed
+ * integer, a decimal (digits, point, exponent), or a flag (yes/no,
+ * true/false, 1/0, any case). Anything else is reported as a runtime error.
+ */
+long long nl_parse_num(const char *s, size_t length);
+double nl_parse_dec(const char *s, size_t length);
+int nl_parse_flag(const char *s, size_t length);
+
+/* Input functions: show the prompt, then read a line */
 char *nl_input(const char *prompt);
 long long nl_input_num(const char *prompt);
 double nl_input_dec(const char *prompt);
@@ -154,15 +339,58 @@ int nl_to_flag(long long value);
  * Memory Management
  * ============================================================================ */
 
-/* Safe string duplication */
-char *nl_strdup(const char *s);
-
-/* Allocate and zero memory */
+/*
+ * Every runtime allocation (strings, lists, string builders, input lines)
+ * goes through the functions below, which serve it in one of three modes:
+ *
+ *   NL_ALLOC_SYSTEM  malloc, realloc and free
+ *   NL_ALLOC_SLAB    blocks of up to 256 bytes come from per-size-class
+ *                    slabs and are recycled through free lists; larger
+ *                    ones fall back to malloc
+ *   NL_ALLOC_REGION  bump allocation from large chunks; nl_free only takes
+ *                    back the most recent block, and nl_region_leave()
+ *                    releases everything allocated since the matching
+ *                    nl_region_enter() in one step
+ *
+ * The mode is fixed at the first allocation: the NL_ALLOC environment
+ * variable ("system", "slab" or "region") if set, else NL_ALLOC_DEFAULT,
+ * which the runtime can be compiled with (-DNL_ALLOC_DEFAULT=NL_ALLOC_SLAB).
+ * The generated code enters a region around function calls and secure
+ * zones whose allocations cannot outlive them; in the other modes regions
+ * cost nothing. The allocator is not thread-safe.
+ */
+typedef enum {
+    NL_ALLOC_SYSTEM = 0,
+    NL_ALLOC_SLAB   = 1,
+    NL_ALLOC_REGION = 2
+} NLAllocMode;
+
+/* Position in the region stack, taken by nl_region_enter() */
+typedef struct {
+    void *chunk;
+    size_t used;
+} NLRegionMark;
+
+/* Mode in effect */
+NLAllocMode nl_alloc_mode(void);
+
+/* Allocate memory (nl_alloc zeroes it) */
+void *nl_malloc(size_t size);
 void *nl_alloc(size_t size);
 
-/* Free memory */
+/* Resize a block from nl_malloc/nl_alloc (NULL allocates) */
+void *nl_realloc(void *ptr, size_t size);
+
+/* Free memory from nl_malloc/nl_alloc/nl_realloc/nl_strdup */
 void nl_free(void *ptr);
 
+/* Safe string duplication */
+char *nl_strdup(const char *s);
+
+/* Start a region / release everything allocated since it started */
+NLRegionMark nl_region_enter(void);
+void nl_region_leave(NLRegionMark mark);
+
 /* ============================================================================
  * Error Handling
  * ============================================================================ */
@@ -38,8 +38,24 @@ static char *safe_strdup(const char *str) {
     return dup;
 }
 
+/*
+ * Names are copied into the current arena while a parse is building the
+ * tree, and onto the heap otherwise.
+ */
+static char *ast_strdup(const char *str) {
+    ASTArena *arena = ast_arena_current();
+    return arena != NULL ? ast_arena_strdup(arena, str) : safe_strdup(str);
+}
+
 static ASTNode *create_node(ASTNodeType type, SourceLocation loc) {
-    ASTNode *node = (ASTNode *)safe_malloc(sizeof(ASTNode));
+    ASTArena *arena = ast_arena_current();
+    ASTNode *node;
+    if (arena != NULL) {
+        node = (ASTNode *)ast_arena_alloc(arena, sizeof(ASTNode));
+        node->in_arena = 1;
+    } else {
+        node = (ASTNode *)safe_malloc(sizeof(ASTNode));
+    }
     node->type = type;
     node->loc = loc;
     node->data_type = TYPE_UNKNOWN;
@@ -54,17 +70,32 @@ static ASTNode *create_node(ASTNodeType type, SourceLocation loc) {
 #define INITIAL_LIST_CAPACITY 8
 
 ASTNodeList *ast_node_list_create(void) {
-    ASTNodeList *list = (ASTNodeList *)safe_malloc(sizeof(ASTNodeList));
-    list->nodes = (ASTNode **)safe_malloc(sizeof(ASTNode *) * INITIAL_LIST_CAPACITY);
+    ASTArena *arena = ast_arena_current();
+    ASTNodeList *list;
+    if (arena != NULL) {
+        list = (ASTNodeList *)ast_arena_alloc(arena, sizeof(ASTNodeList));
+        list->nodes = (ASTNode **)ast_arena_alloc(arena, sizeof(ASTNode *) * INITIAL_LIST_CAPACITY);
+    } else {
+        list = (ASTNodeList *)safe_malloc(sizeof(ASTNodeList));
+        list->nodes = (ASTNode **)safe_malloc(sizeof(ASTNode *) * INITIAL_LIST_CAPACITY);
+    }
     list->count = 0;
     list->capacity = INITIAL_LIST_CAPACITY;
+    list->arena = arena;
     return list;
 }
 
 void ast_node_list_append(ASTNodeList *list, ASTNode *node) {
     if (list == NULL) return;
     
-    if (list->count >= list->capacity) {
+    if (list->count >= list->capacity && list->arena != NULL) {
+        /* Arena arrays cannot grow in place: copy into a twice-as-large one */
+        ASTNode **grown = (ASTNode **)ast_arena_alloc(list->arena,
+                                                      sizeof(ASTNode *) * list->capacity * 2);
+        memcpy(grown, list->nodes, sizeof(ASTNode *) * list->count);
+        list->nodes = grown;
+        list->capacity *= 2;
+    } else if (list->count >= list->capacity) {
         list->capacity *= 2;
         list->nodes = (ASTNode **)realloc(list->nodes, 
                                           sizeof(ASTNode *) * list->capacity);
@@ -78,7 +109,8 @@ void ast_node_list_append(ASTNodeList *list, ASTNode *node) {
 }
 
 void ast_node_list_free(ASTNodeList *list) {
-    if (list == NULL) return;
+    /* Arena lists go away with their arena */
+    if (list == NULL || list->arena != NULL) return;
     
     for (size_t i = 0; i < list->count; i++) {
         ast_free(list->nodes[i]);
@@ -107,7 +139,7 @@ ASTNode *ast_create_program(ASTNodeList *statements, SourceLocation loc) {
 ASTNode *ast_create_var_decl(const char *name, DataType type, ASTNode *init,
                               int is_const, SourceLocation loc) {
     ASTNode *node = create_node(AST_VAR_DECL, loc);
-    node->data.var_decl.name = safe_strdup(name);
+    node->data.var_decl.name = ast_strdup(name);
     node->data.var_decl.var_type = type;
     node->data.var_decl.initializer = init;
     node->data.var_decl.is_const = is_const;
@@ -118,7 +150,7 @@ ASTNode *ast_create_var_decl(const char *name, DataType type, ASTNode *init,
 ASTNode *ast_create_func_decl(const char *name, ASTNodeList *params,
                                DataType return_type, ASTNode *body, SourceLocation loc) {
     ASTNode *node = create_node(AST_FUNC_DECL, loc);
-    node->data.func_decl.name = safe_strdup(name);
+    node->data.func_decl.name = ast_strdup(name);
     node->data.func_decl.params = params;
     node->data.func_decl.return_type = return_type;
     node->data.func_decl.body = body;
@@ -128,7 +160,7 @@ ASTNode *ast_create_func_decl(const char *name, ASTNodeList *params,
 
 ASTNode *ast_create_param_decl(const char *name, DataType type, SourceLocation loc) {
     ASTNode *node = create_node(AST_PARAM_DECL, loc);
-    node->data.param_decl.name = safe_strdup(name);
+    node->data.param_decl.name = ast_strdup(name);
     node->data.param_decl.param_type = type;
     node->data_type = type;
     return node;
@@ -178,7 +210,7 @@ ASTNode *ast_create_repeat(ASTNode *count, ASTNode *body, SourceLocation loc) {
 ASTNode *ast_create_for_each(const char *iter_name, ASTNode *iterable,
                               ASTNode *body, SourceLocation loc) {
     ASTNode *node = create_node(AST_FOR_EACH, loc);
-    node->data.for_each_stmt.iterator_name = safe_strdup(iter_name);
+    node->data.for_each_stmt.iterator_name = ast_strdup(iter_name);
     node->data.for_each_stmt.iterable = iterable;
     node->data.for_each_stmt.body = body;
     return node;
@@ -218,13 +250,13 @@ ASTNode *ast_create_display(ASTNode *value, SourceLocation loc) {
 ASTNode *ast_create_ask(ASTNode *prompt, const char *target_var, SourceLocation loc) {
     ASTNode *node = create_node(AST_ASK, loc);
     node->data.ask_stmt.prompt = prompt;
-    node->data.ask_stmt.target_var = safe_strdup(target_var);
+    node->data.ask_stmt.target_var = ast_strdup(target_var);
     return node;
 }
 
 ASTNode *ast_create_read(const char *target_var, SourceLocation loc) {
     ASTNode *node = create_node(AST_READ, loc);
-    node->data.read_stmt.target_var = safe_strdup(target_var);
+    node->data.read_stmt.target_var = ast_strdup(target_var);
     return node;
 }
 
@@ -288,7 +320,7 @@ ASTNode *ast_create_literal_float(double value, SourceLocation loc) {
 
 ASTNode *ast_create_literal_string(const char *value, SourceLocation loc) {
     ASTNode *node = create_node(AST_LITERAL_STRING, loc);
-    node->data.literal_string.value = safe_strdup(value);
+    node->data.literal_string.value = ast_strdup(value);
     node->data_type = TYPE_TEXT;
     return node;
 }
@@ -302,13 +334,13 @@ ASTNode *ast_create_literal_bool(int value, SourceLocation loc) {
 
 ASTNode *ast_create_identifier(const char *name, SourceLocation loc) {
     ASTNode *node = create_node(AST_IDENTIFIER, loc);
-    node->data.identifier.name = safe_strdup(name);
+    node->data.identifier.name = ast_strdup(name);
     return node;
 }
 
 ASTNode *ast_create_func_call(const char *name, ASTNodeList *args, SourceLocation loc) {
     ASTNode *node = create_node(AST_FUNC_CALL, loc);
-    node->data.func_call.name = safe_strdup(name);
+    node->data.func_call.name = ast_strdup(name);
     node->data.func_call.args = args;
     return node;
 }
@@ -332,130 +364,99 @@ ASTNode *ast_create_list(ASTNodeList *elements, SourceLocation loc) {
  * ============================================================================
  */
 
-void ast_free(ASTNode *node) {
-    if (node == NULL) return;
-    
+/*
+ * Release what a heap node owns besides its children (names and the
+ * arrays of its node lists) and then the node itself. The children have
+ * been released already.
+ */
+static void release_list(ASTNodeList *list) {
+    if (list == NULL || list->arena != NULL) return;
+    free(list->nodes);
+    free(list);
+}
+
+static void release_node(ASTNode *node) {
     switch (node->type) {
         case AST_PROGRAM:
-            ast_node_list_free(node->data.program.statements);
+            release_list(node->data.program.statements);
             break;
-            
         case AST_VAR_DECL:
             free(node->data.var_decl.name);
-            ast_free(node->data.var_decl.initializer);
             break;
-            
         case AST_FUNC_DECL:
             free(node->data.func_decl.name);
-            ast_node_list_free(node->data.func_decl.params);
-            ast_free(node->data.func_decl.body);
+            release_list(node->data.func_decl.params);
             break;
-            
         case AST_PARAM_DECL:
             free(node->data.param_decl.name);
             break;
-            
         case AST_BLOCK:
-            ast_node_list_free(node->data.block.statements);
-            break;
-            
-        case AST_ASSIGN:
-            ast_free(node->data.assign.target);
-            ast_free(node->data.assign.value);
+            release_list(node->data.block.statements);
             break;
-            
-        case AST_IF:
-            ast_free(node->data.if_stmt.condition);
-            ast_free(node->data.if_stmt.then_branch);
-            ast_free(node->data.if_stmt.else_branch);
-            break;
-            
-        case AST_WHILE:
-            ast_free(node->data.while_stmt.condition);
-            ast_free(node->data.while_stmt.body);
-            break;
-            
-        case AST_REPEAT:
-            ast_free(node->data.repeat_stmt.count);
-            ast_free(node->data.repeat_stmt.body);
-            break;
-            
         case AST_FOR_EACH:
             free(node->data.for_each_stmt.iterator_name);
-            ast_free(node->data.for_each_stmt.iterable);
-            ast_free(node->data.for_each_stmt.body);
-            break;
-            
-        case AST_RETURN:
-            ast_free(node->data.return_stmt.value);
-            break;
-            
-        case AST_DISPLAY:
-            ast_free(node->data.display_stmt.value);
             break;
-            
         case AST_ASK:
-            ast_free(node->data.ask_stmt.prompt);
             free(node->data.ask_stmt.target_var);
             break;
-            
         case AST_READ:
             free(node->data.read_stmt.target_var);
             break;
-            
-        case AST_SECURE_ZONE:
-            ast_free(node->data.secure_zone.body);
-            break;
-            
-        case AST_BINARY_OP:
-            ast_free(node->data.binary_op.left);
-            ast_free(node->data.binary_op.right);
-            break;
-            
-        case AST_UNARY_OP:
-            ast_free(node->data.unary_op.operand);
-            break;
-
-        case AST_TERNARY_OP:
-            ast_free(node->data.ternary_op.operand);
-            ast_free(node->data.ternary_op.lower);
-            ast_free(node->data.ternary_op.upper);
-            break;
-            
         case AST_LITERAL_STRING:
             free(node->data.literal_string.value);
             break;
-            
         case AST_IDENTIFIER:
             free(node->data.identifier.name);
             break;
-            
         case AST_FUNC_CALL:
             free(node->data.func_call.name);
-            ast_node_list_free(node->data.func_call.args);
+            release_list(node->data.func_call.args);
             break;
-            
-        case AST_INDEX:
-            ast_free(node->data.index_expr.array);
-            ast_free(node->data.index_expr.index);
-            break;
-            
         case AST_LIST:
-            ast_node_list_free(node->data.list_literal.elements);
-            break;
-            
-        case AST_EXPR_STMT:
-            ast_free(node->data.expr_stmt.expr);
+            release_list(node->data.list_literal.elements);
             break;
-            
         default:
             /* Nodes with no dynamic data */
             break;
     }
-    
     free(node);
 }
 
+/*
+ * Arena nodes are released all at once: freeing the program node that
+ * owns the arena drops the whole tree, anything else is a no-op. Returns
+ * 1 if the node was handled that way.
+ */
+static int free_arena_node(ASTNode *node) {
+    if (!node->in_arena) return 0;
+    if (node->type == AST_PROGRAM && node->data.program.arena != NULL) {
+        ast_arena_destroy(node->data.program.arena);
+    }
+    return 1;
+}
+
+void ast_free(ASTNode *node) {
+    if (node == NULL || free_arena_node(node)) return;
+
+    /* Post-order walk: a node is released once all its children are */
+    ASTWalkStack stack;
+    ast_walk_init(&stack);
+    ast_walk_push(&stack, node);
+    while (stack.count > 0) {
+        ASTWalkFrame *frame = ast_walk_top(&stack);
+        if (frame->next < ast_child_count(frame->node)) {
+            ASTNode *child = ast_child(frame->node, frame->next++);
+            if (child != NULL && !free_arena_node(child)) {
+                ast_walk_push(&stack, child);
+            }
+            continue;
+        }
+        release_node(frame->node);
+        ast_walk_pop(&stack);
+    }
+    ast_walk_free(&stack);
+}
+
 /* ============================================================================
  * STRING CONVERSION FUNCTIONS
  * ============================================================================
@@ -568,10 +569,12 @@ void ast_print(ASTNode *node, int indent) {
             break;
             
         case AST_VAR_DECL:
-            printf(" name=%s type=%s const=%d\n",
-                   node->data.var_decl.name,
-                   ast_data_type_to_string(node->data.var_decl.var_type),
-                   node->data.var_decl.is_const);
+            printf(" name=%s type=%s", node->data.var_decl.name,
+                   ast_data_type_to_string(node->data.var_decl.var_type));
+            if (node->elem_type != TYPE_UNKNOWN) {
+                printf(" of %s", ast_data_type_to_string(node->elem_type));
+            }
+            printf(" const=%d\n", node->data.var_decl.is_const);
             if (node->data.var_decl.initializer) {
                 print_indent(indent + 1);
                 printf("initializer:\n");
@@ -778,125 +781,246 @@ void ast_print(ASTNode *node, int indent) {
 
 void ast_visit(ASTNode *node, ASTVisitor *visitor) {
     if (node == NULL || visitor == NULL) return;
-    
-    /* Pre-visit */
-    if (visitor->visit_pre) {
-        visitor->visit_pre(visitor, node);
+
+    ASTWalkStack stack;
+    ast_walk_init(&stack);
+    ast_walk_push(&stack, node);
+    while (stack.count > 0) {
+        ASTWalkFrame *frame = ast_walk_top(&stack);
+        ASTNode *current = frame->node;
+
+        /* Pre-visit */
+        if (frame->next == 0 && visitor->visit_pre) {
+            visitor->visit_pre(visitor, current);
+        }
+
+        /* Children in source order; absent optional children are skipped */
+        size_t count = ast_child_count(current);
+        ASTNode *child = NULL;
+        while (frame->next < count && child == NULL) {
+            child = ast_child(current, frame->next++);
+        }
+        if (child != NULL) {
+            ast_walk_push(&stack, child);
+            continue;
+        }
+
+        /* Post-visit */
+        if (visitor->visit_post) {
+            visitor->visit_post(visitor, current);
+        }
+        ast_walk_pop(&stack);
     }
+    ast_walk_free(&stack);
+}
+
+/* ============================================================================
+ * ITERATIVE TRAVERSAL
+ * ============================================================================
+ */
+
+void ast_walk_init(ASTWalkStack *stack) {
+    stack->frames = stack->inline_frames;
+    stack->count = 0;
+    stack->capacity = AST_WALK_INLINE;
+}
+
+void ast_walk_free(ASTWalkStack *stack) {
+    if (stack->frames != stack->inline_frames) {
+        free(stack->frames);
+    }
+    ast_walk_init(stack);
+}
+
+ASTWalkFrame *ast_walk_push(ASTWalkStack *stack, ASTNode *node) {
+    if (stack->count == stack->capacity) {
+        size_t capacity = stack->capacity * 2;
+        ASTWalkFrame *frames;
+        if (stack->frames == stack->inline_frames) {
+            frames = malloc(capacity * sizeof(ASTWalkFrame));
+            if (frames != NULL) {
+                memcpy(frames, stack->inline_frames, stack->count * sizeof(ASTWalkFrame));
+            }
+        } else {
+            frames = realloc(stack->frames, capacity * sizeof(ASTWalkFrame));
+        }
+        if (frames == NULL) {
+            fprintf(stderr, "Error: Failed to allocate memory (%zu bytes)\n",
+                    capacity * sizeof(ASTWalkFrame));
+            exit(1);
+        }
+        stack->frames = frames;
+        stack->capacity = capacity;
+    }
+    ASTWalkFrame *frame = &stack->frames[stack->count++];
+    frame->node = node;
+    frame->next = 0;
+    frame->aux.num = 0;
+    frame->aux.ptr = NULL;
+    return frame;
+}
+
+ASTWalkFrame *ast_walk_top(ASTWalkStack *stack) {
+    return stack->count > 0 ? &stack->frames[stack->count - 1] : NULL;
+}
+
+void ast_walk_pop(ASTWalkStack *stack) {
+    if (stack->count > 0) {
+        stack->count--;
+    }
+}
+
+/* The node list a node carries, if any */
+static const ASTNodeList *child_list(const ASTNode *node) {
+    switch (node->type) {
+        case AST_PROGRAM:   return node->data.program.statements;
+        case AST_BLOCK:     return node->data.block.statements;
+        case AST_FUNC_DECL: return node->data.func_decl.params;
+        case AST_FUNC_CALL: return node->data.func_call.args;
+        case AST_LIST:      return node->data.list_literal.elements;
+        default:            return NULL;
+    }
+}
+
+/* Number of pointer-field children of each node type */
+static size_t field_count(ASTNodeType type) {
+    switch (type) {
+        case AST_VAR_DECL:    return 1;
+        case AST_FUNC_DECL:   return 1;
+        case AST_ASSIGN:      return 2;
+        case AST_IF:          return 3;
+        case AST_WHILE:       return 2;
+        case AST_REPEAT:      return 2;
+        case AST_FOR_EACH:    return 2;
+        case AST_RETURN:      return 1;
+        case AST_DISPLAY:     return 1;
+        case AST_ASK:         return 1;
+        case AST_SECURE_ZONE: return 1;
+        case AST_BINARY_OP:   return 2;
+        case AST_UNARY_OP:    return 1;
+        case AST_TERNARY_OP:  return 3;
+        case AST_INDEX:       return 2;
+        case AST_EXPR_STMT:   return 1;
+        default:              return 0;
+    }
+}
+
+size_t ast_child_count(const ASTNode *node) {
+    if (node == NULL) return 0;
+    const ASTNodeList *list = child_list(node);
+    return (list != NULL ? list->count : 0) + field_count(node->type);
+}
+
+ASTNode *ast_child(const ASTNode *node, size_t index) {
+    if (node == NULL) return NULL;
+    const ASTNodeList *list = child_list(node);
+    size_t items = list != NULL ? list->count : 0;
+    if (index < items) {
+        return list->nodes[index];
+    }
+    index -= items;
+
+    switch (node->type) {
+        case AST_VAR_DECL:    return node->data.var_decl.initializer;
+        case AST_FUNC_DECL:   return node->data.func_decl.body;
+        case AST_ASSIGN:      return index == 0 ? node->data.assign.target
+                                                : node->data.assign.value;
+        case AST_IF:          return index == 0 ? node->data.if_stmt.condition
+                                   : index == 1 ? node->data.if_stmt.then_branch
+                                                : node->data.if_stmt.else_branch;
+        case AST_WHILE:       return index == 0 ? node->data.while_stmt.condition
+                                                : node->data.while_stmt.body;
+        case AST_REPEAT:      return index == 0 ? node->data.repeat_stmt.count
+                                                : node->data.repeat_stmt.body;
+        case AST_FOR_EACH:    return index == 0 ? node->data.for_each_stmt.iterable
+                                                : node->data.for_each_stmt.body;
+        case AST_RETURN:      return node->data.return_stmt.value;
+        case AST_DISPLAY:     return node->data.display_stmt.value;
+        case AST_ASK:         return node->data.ask_stmt.prompt;
+        case AST_SECURE_ZONE: return node->data.secure_zone.body;
+        case AST_BINARY_OP:   return index == 0 ? node->data.binary_op.left
+                                                : node->data.binary_op.right;
+        case AST_UNARY_OP:    return node->data.unary_op.operand;
+        case AST_TERNARY_OP:  return index == 0 ? node->data.ternary_op.operand
+                                   : index == 1 ? node->data.ternary_op.lower
+                                                : node->data.ternary_op.upper;
+        case AST_INDEX:       return index == 0 ? node->data.index_expr.array
+                                                : node->data.index_expr.index;
+        case AST_EXPR_STMT:   return node->data.expr_stmt.expr;
+        default:              return NULL;
+    }
+}
+
+/* ============================================================================
+ * AST MEMORY ACCOUNTING
+ * ============================================================================
+ */
+
+static size_t list_memory(const ASTNodeList *list) {
+    if (list == NULL) return 0;
+    return sizeof(ASTNodeList) + list->capacity * sizeof(ASTNode *);
+}
+
+static size_t string_memory(const char *str) {
+    return str ? strlen(str) + 1 : 0;
+}
+
+static void memory_visit(ASTVisitor *visitor, ASTNode *node) {
+    size_t bytes = sizeof(ASTNode);
     
-    /* Visit children based on node type */
     switch (node->type) {
         case AST_PROGRAM:
-            if (node->data.program.statements) {
-                for (size_t i = 0; i < node->data.program.statements->count; i++) {
-                    ast_visit(node->data.program.statements->nodes[i], visitor);
-                }
-            }
+            bytes += list_memory(node->data.program.statements);
             break;
-            
         case AST_VAR_DECL:
-            ast_visit(node->data.var_decl.initializer, visitor);
+            bytes += string_memory(node->data.var_decl.name);
             break;
-            
         case AST_FUNC_DECL:
-            if (node->data.func_decl.params) {
-                for (size_t i = 0; i < node->data.func_decl.params->count; i++) {
-                    ast_visit(node->data.func_decl.params->nodes[i], visitor);
-                }
-            }
-            ast_visit(node->data.func_decl.body, visitor);
-            break;
-            
-        case AST_BLOCK:
-            if (node->data.block.statements) {
-                for (size_t i = 0; i < node->data.block.statements->count; i++) {
-                    ast_visit(node->data.block.statements->nodes[i], visitor);
-                }
-            }
+            bytes += string_memory(node->data.func_decl.name);
+            bytes += list_memory(node->data.func_decl.params);
             break;
-            
-        case AST_ASSIGN:
-            ast_visit(node->data.assign.target, visitor);
-            ast_visit(node->data.assign.value, visitor);
-            break;
-            
-        case AST_IF:
-            ast_visit(node->data.if_stmt.condition, visitor);
-            ast_visit(node->data.if_stmt.then_branch, visitor);
-            ast_visit(node->data.if_stmt.else_branch, visitor);
-            break;
-            
-        case AST_WHILE:
-            ast_visit(node->data.while_stmt.condition, visitor);
-            ast_visit(node->data.while_stmt.body, visitor);
+        case AST_PARAM_DECL:
+            bytes += string_memory(node->data.param_decl.name);
             break;
-            
-        case AST_REPEAT:
-            ast_visit(node->data.repeat_stmt.count, visitor);
-            ast_visit(node->data.repeat_stmt.body, visitor);
+        case AST_BLOCK:
+            bytes += list_memory(node->data.block.statements);
             break;
-            
         case AST_FOR_EACH:
-            ast_visit(node->data.for_each_stmt.iterable, visitor);
-            ast_visit(node->data.for_each_stmt.body, visitor);
-            break;
-            
-        case AST_RETURN:
-            ast_visit(node->data.return_stmt.value, visitor);
-            break;
-            
-        case AST_DISPLAY:
-            ast_visit(node->data.display_stmt.value, visitor);
+            bytes += string_memory(node->data.for_each_stmt.iterator_name);
             break;
-            
         case AST_ASK:
-            ast_visit(node->data.ask_stmt.prompt, visitor);
+            bytes += string_memory(node->data.ask_stmt.target_var);
             break;
-            
-        case AST_SECURE_ZONE:
-            ast_visit(node->data.secure_zone.body, visitor);
+        case AST_READ:
+            bytes += string_memory(node->data.read_stmt.target_var);
             break;
-            
-        case AST_BINARY_OP:
-            ast_visit(node->data.binary_op.left, visitor);
-            ast_visit(node->data.binary_op.right, visitor);
+        case AST_LITERAL_STRING:
+            bytes += string_memory(node->data.literal_string.value);
             break;
-            
-        case AST_UNARY_OP:
-            ast_visit(node->data.unary_op.operand, visitor);
+        case AST_IDENTIFIER:
+            bytes += string_memory(node->data.identifier.name);
             break;
-            
         case AST_FUNC_CALL:
-            if (node->data.func_call.args) {
-                for (size_t i = 0; i < node->data.func_call.args->count; i++) {
-                    ast_visit(node->data.func_call.args->nodes[i], visitor);
-                }
-            }
-            break;
-            
-        case AST_INDEX:
-            ast_visit(node->data.index_expr.array, visitor);
-            ast_visit(node->data.index_expr.index, visitor);
+            bytes += string_memory(node->data.func_call.name);
+            bytes += list_memory(node->data.func_call.args);
             break;
-            
         case AST_LIST:
-            if (node->data.list_literal.elements) {
-                for (size_t i = 0; i < node->data.list_literal.elements->count; i++) {
-                    ast_visit(node->data.list_literal.elements->nodes[i], visitor);
-                }
-            }
+            bytes += list_memory(node->data.list_literal.elements);
             break;
-            
-        case AST_EXPR_STMT:
-            ast_visit(node->data.expr_stmt.expr, visitor);
-            break;
-            
         default:
             break;
     }
     
-    /* Post-visit */
-    if (visitor->visit_post) {
-        visitor->visit_post(visitor, node);
+    *(size_t *)visitor->user_data += bytes;
+}
+
+size_t ast_memory_usage(ASTNode *node) {
+    /* An arena tree holds exactly what its arena handed out */
+    if (node != NULL && node->type == AST_PROGRAM && node->data.program.arena != NULL) {
+        return ast_arena_used(node->data.program.arena);
     }
+    size_t total = 0;
+    ASTVisitor visitor = {&total, memory_visit, NULL};
+    ast_visit(node, &visitor);
+    return total;
 }
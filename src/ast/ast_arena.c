@@ -0,0 +1,173 @@
+/*
+ * NatureLang Compiler
+ * Copyright (c) 2026
+ *
+ * AST Arena Allocator
+ *
+ * A chain of large blocks carved up by bumping a pointer. Building an AST
+ * node costs a pointer increment instead of a malloc call, nodes created
+ * together sit next to each other in memory, and releasing a tree frees a
+ * handful of blocks instead of visiting every node.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "ast.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdalign.h>
+
+/* Block sizes double from the first size up to the maximum */
+#define ARENA_FIRST_BLOCK   (64 * 1024)
+#define ARENA_MAX_BLOCK     (4 * 1024 * 1024)
+
+/* Every allocation is aligned for any object type */
+#define ARENA_ALIGN         alignof(max_align_t)
+#define ARENA_ROUND(n)      (((n) + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1))
+
+typedef struct ArenaBlock {
+    struct ArenaBlock *next;    /* Older block */
+    size_t size;                /* Usable bytes after the header */
+    size_t used;
+} ArenaBlock;
+
+#define BLOCK_HEADER        ARENA_ROUND(sizeof(ArenaBlock))
+#define BLOCK_DATA(b)       ((char *)(b) + BLOCK_HEADER)
+
+struct ASTArena {
+    ArenaBlock *head;           /* Block currently being filled */
+    size_t next_block;          /* Size of the next block to allocate */
+    size_t used;                /* Bytes handed out */
+    size_t reserved;            /* Bytes in all blocks */
+};
+
+/* Arena of the parse running on this thread (see ast_arena_set_current) */
+static _Thread_local ASTArena *current_arena = NULL;
+
+ASTArena *ast_arena_create(void) {
+    ASTArena *arena = calloc(1, sizeof(ASTArena));
+    if (arena == NULL) {
+        fprintf(stderr, "Fatal: Memory allocation failed\n");
+        exit(1);
+    }
+    arena->next_block = ARENA_FIRST_BLOCK;
+    return arena;
+}
+
+void ast_arena_destroy(ASTArena *arena) {
+    if (arena == NULL) return;
+
+    ArenaBlock *block = arena->head;
+    while (block != NULL) {
+        ArenaBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+    if (current_arena == arena) {
+        current_arena = NULL;
+    }
+    free(arena);
+}
+
+void ast_arena_reset(ASTArena *arena) {
+    if (arena == NULL || arena->head == NULL) return;
+
+    ArenaBlock *keep = arena->head;
+    ArenaBlock *block = keep->next;
+    while (block != NULL) {
+        ArenaBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+    keep->next = NULL;
+    keep->used = 0;
+    arena->used = 0;
+    arena->reserved = keep->size;
+}
+
+ASTArena *ast_arena_set_current(ASTArena *arena) {
+    ASTArena *previous = current_arena;
+    current_arena = arena;
+    return previous;
+}
+
+ASTArena *ast_arena_current(void) {
+    return current_arena;
+}
+
+static ArenaBlock *arena_new_block(size_t size) {
+    ArenaBlock *block = malloc(BLOCK_HEADER + size);
+    if (block == NULL) {
+        fprintf(stderr, "Fatal: Memory allocation failed (%zu bytes)\n", BLOCK_HEADER + size);
+        exit(1);
+    }
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+    return block;
+}
+
+/*
+ * Carve size bytes aligned to align (a power of two) out of the arena.
+ * Strings take align 1 so short names are not padded to ARENA_ALIGN.
+ */
+static void *arena_take(ASTArena *arena, size_t size, size_t align) {
+    ArenaBlock *head = arena->head;
+    size_t start = head != NULL ? (head->used + align - 1) & ~(align - 1) : 0;
+
+    if (head == NULL || start > head->size || head->size - start < size) {
+        if (size > arena->next_block / 4) {
+            /*
+             * Big request (a long statement list): give it a block of its
+             * own behind the current one, so the rest of the current block
+             * is not wasted.
+             */
+            ArenaBlock *big = arena_new_block(size);
+            big->used = size;
+            if (head != NULL) {
+                big->next = head->next;
+                head->next = big;
+            } else {
+                arena->head = big;
+            }
+            arena->used += size;
+            arena->reserved += size;
+            return BLOCK_DATA(big);
+        }
+
+        head = arena_new_block(arena->next_block);
+        head->next = arena->head;
+        arena->head = head;
+        arena->reserved += head->size;
+        if (arena->next_block < ARENA_MAX_BLOCK) {
+            arena->next_block *= 2;
+        }
+        start = 0;
+    }
+
+    head->used = start + size;
+    arena->used += size;
+    return BLOCK_DATA(head) + start;
+}
+
+void *ast_arena_alloc(ASTArena *arena, size_t size) {
+    void *ptr = arena_take(arena, size > 0 ? size : 1, ARENA_ALIGN);
+    memset(ptr, 0, size);
+    return ptr;
+}
+
+char *ast_arena_strdup(ASTArena *arena, const char *str) {
+    if (str == NULL) return NULL;
+    size_t len = strlen(str);
+    char *dup = arena_take(arena, len + 1, 1);
+    memcpy(dup, str, len + 1);
+    return dup;
+}
+
+size_t ast_arena_used(const ASTArena *arena) {
+    return arena != NULL ? arena->used : 0;
+}
+
+size_t ast_arena_reserved(const ASTArena *arena) {
+    return arena != NULL ? arena->reserved : 0;
+}
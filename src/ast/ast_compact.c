@@ -0,0 +1,897 @@
+/*
+ * NatureLang Compiler
+ * Copyright (c) 2026
+ *
+ * Compact AST Encoding
+ *
+ * Flattens a pointer tree into index-addressed pools (see ast_compact.h).
+ * Nodes are laid out in pre-order, so a parent and its first children sit
+ * next to each other and a walk over the tree moves forward through memory.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "ast_compact.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================================
+ * PAYLOAD LAYOUT
+ * ============================================================================
+ * Payload words per node kind:
+ *
+ *   program, block, list   n, item...
+ *   var_decl               name, initializer
+ *   func_decl              name, body, n, param...
+ *   param_decl, read,
+ *   identifier             name
+ *   func_call              name, n, arg...
+ *   for_each               name, iterable, body
+ *   ask                    name, prompt
+ *   literal_int/float      low 32 bits, high 32 bits
+ *   literal_string         string
+ *   break, continue,
+ *   literal_bool, type     (none)
+ *   everything else        its children, in struct ASTNode field order
+ */
+
+typedef struct {
+    int8_t words;           /* Payload words before the list items */
+    int8_t name;            /* Word holding a name, or -1 */
+    int8_t child_first;     /* Words [child_first, child_end) hold child refs */
+    int8_t child_end;
+    int8_t list;            /* Word holding the item count, or -1 */
+} NodeLayout;
+
+static const NodeLayout layouts[AST_NODE_COUNT] = {
+    [AST_PROGRAM]        = {1, -1, 0, 0,  0},
+    [AST_VAR_DECL]       = {2,  0, 1, 2, -1},
+    [AST_FUNC_DECL]      = {3,  0, 1, 2,  2},
+    [AST_PARAM_DECL]     = {1,  0, 0, 0, -1},
+    [AST_BLOCK]          = {1, -1, 0, 0,  0},
+    [AST_ASSIGN]         = {2, -1, 0, 2, -1},
+    [AST_IF]             = {3, -1, 0, 3, -1},
+    [AST_WHILE]          = {2, -1, 0, 2, -1},
+    [AST_REPEAT]         = {2, -1, 0, 2, -1},
+    [AST_FOR_EACH]       = {3,  0, 1, 3, -1},
+    [AST_RETURN]         = {1, -1, 0, 1, -1},
+    [AST_BREAK]          = {0, -1, 0, 0, -1},
+    [AST_CONTINUE]       = {0, -1, 0, 0, -1},
+    [AST_EXPR_STMT]      = {1, -1, 0, 1, -1},
+    [AST_SECURE_ZONE]    = {1, -1, 0, 1, -1},
+    [AST_DISPLAY]        = {1, -1, 0, 1, -1},
+    [AST_ASK]            = {2,  0, 1, 2, -1},
+    [AST_READ]           = {1,  0, 0, 0, -1},
+    [AST_BINARY_OP]      = {2, -1, 0, 2, -1},
+    [AST_UNARY_OP]       = {1, -1, 0, 1, -1},
+    [AST_TERNARY_OP]     = {3, -1, 0, 3, -1},
+    [AST_LITERAL_INT]    = {2, -1, 0, 0, -1},
+    [AST_LITERAL_FLOAT]  = {2, -1, 0, 0, -1},
+    [AST_LITERAL_STRING] = {1, -1, 0, 0, -1},
+    [AST_LITERAL_BOOL]   = {0, -1, 0, 0, -1},
+    [AST_IDENTIFIER]     = {1,  0, 0, 0, -1},
+    [AST_FUNC_CALL]      = {2,  0, 0, 0,  1},
+    [AST_INDEX]          = {2, -1, 0, 2, -1},
+    [AST_LIST]           = {1, -1, 0, 0,  0},
+    [AST_TYPE]           = {0, -1, 0, 0, -1},
+};
+
+/* Payload word of a named field, or -1 if the node kind has no such field */
+static int field_word(ASTNodeType type, ASTCompactField field) {
+    switch (field) {
+        case AST_FIELD_INITIALIZER:
+            return type == AST_VAR_DECL ? 1 : -1;
+        case AST_FIELD_BODY:
+            switch (type) {
+                case AST_FUNC_DECL:   return 1;
+                case AST_WHILE:       return 1;
+                case AST_REPEAT:      return 1;
+                case AST_FOR_EACH:    return 2;
+                case AST_SECURE_ZONE: return 0;
+                default:              return -1;
+            }
+        case AST_FIELD_TARGET:
+            return type == AST_ASSIGN ? 0 : -1;
+        case AST_FIELD_VALUE:
+            switch (type) {
+                case AST_ASSIGN:  return 1;
+                case AST_RETURN:  return 0;
+                case AST_DISPLAY: return 0;
+                default:          return -1;
+            }
+        case AST_FIELD_CONDITION:
+            return (type == AST_IF || type == AST_WHILE) ? 0 : -1;
+        case AST_FIELD_THEN:
+            return type == AST_IF ? 1 : -1;
+        case AST_FIELD_ELSE:
+            return type == AST_IF ? 2 : -1;
+        case AST_FIELD_COUNT:
+            return type == AST_REPEAT ? 0 : -1;
+        case AST_FIELD_ITERABLE:
+            return type == AST_FOR_EACH ? 1 : -1;
+        case AST_FIELD_PROMPT:
+            return type == AST_ASK ? 1 : -1;
+        case AST_FIELD_LEFT:
+            return type == AST_BINARY_OP ? 0 : -1;
+        case AST_FIELD_RIGHT:
+            return type == AST_BINARY_OP ? 1 : -1;
+        case AST_FIELD_OPERAND:
+            return (type == AST_UNARY_OP || type == AST_TERNARY_OP) ? 0 : -1;
+        case AST_FIELD_LOWER:
+            return type == AST_TERNARY_OP ? 1 : -1;
+        case AST_FIELD_UPPER:
+            return type == AST_TERNARY_OP ? 2 : -1;
+        case AST_FIELD_ARRAY:
+            return type == AST_INDEX ? 0 : -1;
+        case AST_FIELD_INDEX:
+            return type == AST_INDEX ? 1 : -1;
+        case AST_FIELD_EXPR:
+            return type == AST_EXPR_STMT ? 0 : -1;
+    }
+    return -1;
+}
+
+/* ============================================================================
+ * BUILDER
+ * ============================================================================
+ */
+
+static void *grow(void *ptr, uint32_t *capacity, uint32_t needed, size_t elem) {
+    if (needed <= *capacity) return ptr;
+    uint64_t cap = *capacity > 0 ? *capacity : 64;
+    while (cap < needed) cap *= 2;
+    if (cap > UINT32_MAX) cap = UINT32_MAX;
+    if (needed > cap) {
+        fprintf(stderr, "Fatal: AST too large for the compact encoding\n");
+        exit(1);
+    }
+    void *grown = realloc(ptr, (size_t)cap * elem);
+    if (grown == NULL) {
+        fprintf(stderr, "Fatal: Memory allocation failed (%zu bytes)\n", (size_t)cap * elem);
+        exit(1);
+    }
+    *capacity = (uint32_t)cap;
+    return grown;
+}
+
+typedef struct {
+    ASTCompact *ac;
+    uint32_t *intern;       /* Open-addressed string offsets (0 = empty) */
+    uint32_t intern_size;   /* Power of two */
+    uint32_t intern_used;
+} Builder;
+
+static uint32_t hash_string(const char *str) {
+    uint32_t h = 2166136261u;
+    for (const unsigned char *p = (const unsigned char *)str; *p; p++) {
+        h = (h ^ *p) * 16777619u;
+    }
+    return h;
+}
+
+static void intern_insert(Builder *b, uint32_t offset) {
+    uint32_t mask = b->intern_size - 1;
+    uint32_t i = hash_string(b->ac->strings + offset) & mask;
+    while (b->intern[i] != 0) {
+        i = (i + 1) & mask;
+    }
+    b->intern[i] = offset;
+}
+
+/* Offset of str in the string pool, adding it on first use (0 for NULL) */
+static uint32_t intern_string(Builder *b, const char *str) {
+    if (str == NULL) return 0;
+    ASTCompact *ac = b->ac;
+
+    uint32_t mask = b->intern_size - 1;
+    uint32_t i = hash_string(str) & mask;
+    while (b->intern[i] != 0) {
+        if (strcmp(ac->strings + b->intern[i], str) == 0) {
+            return b->intern[i];
+        }
+        i = (i + 1) & mask;
+    }
+
+    size_t len = strlen(str) + 1;
+    if (len > UINT32_MAX - ac->string_size) {
+        fprintf(stderr, "Fatal: AST too large for the compact encoding\n");
+        exit(1);
+    }
+    uint32_t offset = ac->string_size;
+    ac->strings = grow(ac->strings, &ac->string_capacity,
+                       (uint32_t)(ac->string_size + len), 1);
+    memcpy(ac->strings + offset, str, len);
+    ac->string_size += (uint32_t)len;
+
+    /* Keep the table at most half full */
+    if (2 * (b->intern_used + 1) > b->intern_size) {
+        uint32_t *old = b->intern;
+        uint32_t old_size = b->intern_size;
+        b->intern_size *= 2;
+        b->intern = calloc(b->intern_size, sizeof(uint32_t));
+        if (b->intern == NULL) {
+            fprintf(stderr, "Fatal: Memory allocation failed\n");
+            exit(1);
+        }
+        for (uint32_t j = 0; j < old_size; j++) {
+            if (old[j] != 0) intern_insert(b, old[j]);
+        }
+        free(old);
+    }
+    intern_insert(b, offset);
+    b->intern_used++;
+    return offset;
+}
+
+/* The node list of a list-carrying node (NULL lists read as empty) */
+static const ASTNodeList *node_list(const ASTNode *node) {
+    switch (node->type) {
+        case AST_PROGRAM:   return node->data.program.statements;
+        case AST_BLOCK:     return node->data.block.statements;
+        case AST_LIST:      return node->data.list_literal.elements;
+        case AST_FUNC_DECL: return node->data.func_decl.params;
+        case AST_FUNC_CALL: return node->data.func_call.args;
+        default:            return NULL;
+    }
+}
+
+/* Child pointers held in payload words [child_first, child_end) */
+static void fixed_children(const ASTNode *node, const ASTNode *out[3]) {
+    switch (node->type) {
+        case AST_VAR_DECL:    out[1] = node->data.var_decl.initializer; break;
+        case AST_FUNC_DECL:   out[1] = node->data.func_decl.body; break;
+        case AST_ASSIGN:      out[0] = node->data.assign.target;
+                              out[1] = node->data.assign.value; break;
+        case AST_IF:          out[0] = node->data.if_stmt.condition;
+                              out[1] = node->data.if_stmt.then_branch;
+                              out[2] = node->data.if_stmt.else_branch; break;
+        case AST_WHILE:       out[0] = node->data.while_stmt.condition;
+                              out[1] = node->data.while_stmt.body; break;
+        case AST_REPEAT:      out[0] = node->data.repeat_stmt.count;
+                              out[1] = node->data.repeat_stmt.body; break;
+        case AST_FOR_EACH:    out[1] = node->data.for_each_stmt.iterable;
+                              out[2] = node->data.for_each_stmt.body; break;
+        case AST_RETURN:      out[0] = node->data.return_stmt.value; break;
+        case AST_EXPR_STMT:   out[0] = node->data.expr_stmt.expr; break;
+        case AST_SECURE_ZONE: out[0] = node->data.secure_zone.body; break;
+        case AST_DISPLAY:     out[0] = node->data.display_stmt.value; break;
+        case AST_ASK:         out[1] = node->data.ask_stmt.prompt; break;
+        case AST_BINARY_OP:   out[0] = node->data.binary_op.left;
+                              out[1] = node->data.binary_op.right; break;
+        case AST_UNARY_OP:    out[0] = node->data.unary_op.operand; break;
+        case AST_TERNARY_OP:  out[0] = node->data.ternary_op.operand;
+                              out[1] = node->data.ternary_op.lower;
+                              out[2] = node->data.ternary_op.upper; break;
+        case AST_INDEX:       out[0] = node->data.index_expr.array;
+                              out[1] = node->data.index_expr.index; break;
+        default: break;
+    }
+}
+
+static const char *node_name(const ASTNode *node) {
+    switch (node->type) {
+        case AST_VAR_DECL:   return node->data.var_decl.name;
+        case AST_FUNC_DECL:  return node->data.func_decl.name;
+        case AST_PARAM_DECL: return node->data.param_decl.name;
+        case AST_FOR_EACH:   return node->data.for_each_stmt.iterator_name;
+        case AST_ASK:        return node->data.ask_stmt.target_var;
+        case AST_READ:       return node->data.read_stmt.target_var;
+        case AST_IDENTIFIER: return node->data.identifier.name;
+        case AST_FUNC_CALL:  return node->data.func_call.name;
+        default:             return NULL;
+    }
+}
+
+/* ---- Line table ---- */
+
+static void lines_from_source(ASTCompact *ac, const char *source, size_t length) {
+    uint32_t capacity = 0;
+    ac->line_starts = grow(NULL, &capacity, 1, sizeof(uint32_t));
+    ac->line_starts[0] = 0;
+    ac->line_count = 1;
+    for (size_t i = 0; i < length && i < UINT32_MAX; i++) {
+        if (source[i] == '\n') {
+            ac->line_starts = grow(ac->line_starts, &capacity, ac->line_count + 1,
+                                   sizeof(uint32_t));
+            ac->line_starts[ac->line_count++] = (uint32_t)(i + 1);
+        }
+    }
+}
+
+/* Widest column seen on each line, for a table built without the source */
+typedef struct {
+    uint32_t *widths;
+    uint32_t lines;
+    uint32_t capacity;
+} ColumnScan;
+
+static void scan_columns(ASTVisitor *visitor, ASTNode *node) {
+    ColumnScan *scan = visitor->user_data;
+    int line = node->loc.first_line;
+    if (line <= 0) return;
+    if ((uint32_t)line > scan->lines) {
+        scan->widths = grow(scan->widths, &scan->capacity, (uint32_t)line, sizeof(uint32_t));
+        memset(scan->widths + scan->lines, 0, ((uint32_t)line - scan->lines) * sizeof(uint32_t));
+        scan->lines = (uint32_t)line;
+    }
+    uint32_t column = node->loc.first_column > 0 ? (uint32_t)node->loc.first_column : 1;
+    if (column > scan->widths[line - 1]) scan->widths[line - 1] = column;
+}
+
+static void lines_from_tree(ASTCompact *ac, const ASTNode *root) {
+    ColumnScan scan = {NULL, 0, 0};
+    ASTVisitor visitor = {&scan, scan_columns, NULL};
+    if (root != NULL) {
+        ast_visit((ASTNode *)root, &visitor);
+    }
+    uint32_t *widths = scan.widths;
+    uint32_t lines = scan.lines;
+
+    ac->line_count = lines > 0 ? lines : 1;
+    ac->line_starts = malloc(ac->line_count * sizeof(uint32_t));
+    if (ac->line_starts == NULL) {
+        fprintf(stderr, "Fatal: Memory allocation failed\n");
+        exit(1);
+    }
+    /* Each line is one byte longer than its widest column (the newline) */
+    uint64_t offset = 0;
+    for (uint32_t i = 0; i < ac->line_count; i++) {
+        ac->line_starts[i] = offset < UINT32_MAX ? (uint32_t)offset : UINT32_MAX - 1;
+        offset += (i < lines && widths[i] > 0 ? widths[i] : 1) + 1;
+    }
+    free(widths);
+}
+
+static uint32_t encode_location(const ASTCompact *ac, SourceLocation loc) {
+    if (loc.first_line <= 0 || (uint32_t)loc.first_line > ac->line_count) {
+        return AST_LOC_NONE;
+    }
+    uint32_t start = ac->line_starts[loc.first_line - 1];
+    uint64_t offset = start + (uint64_t)(loc.first_column > 0 ? loc.first_column - 1 : 0);
+    /* A column past the end of its line would decode as a later line */
+    if ((uint32_t)loc.first_line < ac->line_count &&
+        offset >= ac->line_starts[loc.first_line]) {
+        offset = ac->line_starts[loc.first_line] - 1;
+    }
+    return offset < AST_LOC_NONE ? (uint32_t)offset : start;
+}
+
+/* ---- Nodes ---- */
+
+/* Append node without its children; their words are left AST_REF_NULL */
+static ASTRef encode_node(Builder *b, const ASTNode *node) {
+    ASTCompact *ac = b->ac;
+
+    if (ac->node_count == UINT32_MAX) {
+        fprintf(stderr, "Fatal: AST too large for the compact encoding\n");
+        exit(1);
+    }
+    ac->nodes = grow(ac->nodes, &ac->node_capacity, ac->node_count + 1,
+                     sizeof(ASTCompactNode));
+    ASTRef ref = ac->node_count++;
+
+    const NodeLayout *layout = &layouts[node->type];
+    const ASTNodeList *list = layout->list >= 0 ? node_list(node) : NULL;
+    uint32_t items = list != NULL ? (uint32_t)list->count : 0;
+    uint64_t words = (uint64_t)layout->words + items;
+    if (words > UINT32_MAX - ac->word_count) {
+        fprintf(stderr, "Fatal: AST too large for the compact encoding\n");
+        exit(1);
+    }
+    uint32_t base = ac->word_count;
+    ac->words = grow(ac->words, &ac->word_capacity, (uint32_t)(base + words),
+                     sizeof(uint32_t));
+    memset(ac->words + base, 0, (size_t)words * sizeof(uint32_t));
+    ac->word_count += (uint32_t)words;
+
+    ASTCompactNode *cn = &ac->nodes[ref];
+    cn->type = (uint8_t)node->type;
+    cn->data_type = (uint8_t)(node->data_type | node->elem_type << 4);
+    cn->op = 0;
+    cn->flag = 0;
+    cn->loc = encode_location(ac, node->loc);
+    if (node->loc.first_column > 0) ac->has_columns = 1;
+    cn->payload = base;
+
+    switch (node->type) {
+        case AST_VAR_DECL:
+            cn->op = (uint8_t)node->data.var_decl.var_type;
+            cn->flag = (uint8_t)(node->data.var_decl.is_const != 0);
+            break;
+        case AST_FUNC_DECL:
+            cn->op = (uint8_t)node->data.func_decl.return_type;
+            break;
+        case AST_PARAM_DECL:
+            cn->op = (uint8_t)node->data.param_decl.param_type;
+            break;
+        case AST_SECURE_ZONE:
+            cn->flag = (uint8_t)(node->data.secure_zone.is_safe != 0);
+            break;
+        case AST_BINARY_OP:
+            cn->op = (uint8_t)node->data.binary_op.op;
+            break;
+        case AST_UNARY_OP:
+            cn->op = (uint8_t)node->data.unary_op.op;
+            break;
+        case AST_TERNARY_OP:
+            cn->op = (uint8_t)node->data.ternary_op.op;
+            break;
+        case AST_LITERAL_BOOL:
+            cn->flag = (uint8_t)(node->data.literal_bool.value != 0);
+            break;
+        case AST_LITERAL_INT: {
+            uint64_t bits = (uint64_t)node->data.literal_int.value;
+            ac->words[base] = (uint32_t)bits;
+            ac->words[base + 1] = (uint32_t)(bits >> 32);
+            break;
+        }
+        case AST_LITERAL_FLOAT: {
+            uint64_t bits;
+            memcpy(&bits, &node->data.literal_float.value, sizeof(bits));
+            ac->words[base] = (uint32_t)bits;
+            ac->words[base + 1] = (uint32_t)(bits >> 32);
+            break;
+        }
+        case AST_LITERAL_STRING:
+            ac->words[base] = intern_string(b, node->data.literal_string.value);
+            break;
+        default:
+            break;
+    }
+    if (layout->name >= 0) {
+        ac->words[base + layout->name] = intern_string(b, node_name(node));
+    }
+    if (layout->list >= 0) {
+        ac->words[base + layout->list] = items;
+    }
+    return ref;
+}
+
+/*
+ * Encode the tree in pre-order with an explicit stack (see ast_walk_push),
+ * fixed children before list items. The pools may move while children are
+ * encoded, so a parent is found again by its ref, kept in the frame.
+ */
+static ASTRef encode_tree(Builder *b, const ASTNode *root) {
+    if (root == NULL) return AST_REF_NULL;
+    ASTCompact *ac = b->ac;
+
+    ASTWalkStack stack;
+    ast_walk_init(&stack);
+    ASTRef root_ref = encode_node(b, root);
+    ast_walk_push(&stack, (ASTNode *)root)->aux.num = (long)root_ref;
+
+    while (stack.count > 0) {
+        ASTWalkFrame *frame = ast_walk_top(&stack);
+        const ASTNode *node = frame->node;
+        ASTRef ref = (ASTRef)frame->aux.num;
+        const NodeLayout *layout = &layouts[node->type];
+        size_t fixed = (size_t)(layout->child_end - layout->child_first);
+        size_t index = frame->next++;
+
+        const ASTNodeList *list = layout->list >= 0 ? node_list(node) : NULL;
+        const ASTNode *child;
+        uint32_t word;
+        if (index < fixed) {
+            const ASTNode *children[3] = {NULL, NULL, NULL};
+            fixed_children(node, children);
+            word = (uint32_t)(layout->child_first + index);
+            child = children[word];
+        } else if (list != NULL && index - fixed < list->count) {
+            word = (uint32_t)(layout->words + (index - fixed));
+            child = list->nodes[index - fixed];
+        } else {
+            ast_walk_pop(&stack);
+            continue;
+        }
+        if (child == NULL) continue;
+
+        ASTRef child_ref = encode_node(b, child);
+        ac->words[ac->nodes[ref].payload + word] = child_ref;
+        ast_walk_push(&stack, (ASTNode *)child)->aux.num = (long)child_ref;
+    }
+    ast_walk_free(&stack);
+    return root_ref;
+}
+
+ASTCompact *ast_compact_build(const ASTNode *root, const char *source, size_t length) {
+    ASTCompact *ac = calloc(1, sizeof(ASTCompact));
+    Builder b = {ac, NULL, 1024, 0};
+    b.intern = calloc(b.intern_size, sizeof(uint32_t));
+    if (ac == NULL || b.intern == NULL) {
+        fprintf(stderr, "Fatal: Memory allocation failed\n");
+        exit(1);
+    }
+
+    /* Slot 0 of each pool stands for "none" */
+    ac->nodes = grow(NULL, &ac->node_capacity, 1, sizeof(ASTCompactNode));
+    memset(&ac->nodes[0], 0, sizeof(ASTCompactNode));
+    ac->node_count = 1;
+    ac->strings = grow(NULL, &ac->string_capacity, 1, 1);
+    ac->strings[0] = '\0';
+    ac->string_size = 1;
+
+    if (source != NULL) {
+        lines_from_source(ac, source, length);
+    } else {
+        lines_from_tree(ac, root);
+    }
+    if (root != NULL) {
+        ac->filename = root->loc.filename;
+    }
+
+    ac->root = encode_tree(&b, root);
+    free(b.intern);
+    return ac;
+}
+
+void ast_compact_free(ASTCompact *ac) {
+    if (ac == NULL) return;
+    free(ac->nodes);
+    free(ac->words);
+    free(ac->strings);
+    free(ac->line_starts);
+    free(ac);
+}
+
+size_t ast_compact_memory_usage(const ASTCompact *ac) {
+    if (ac == NULL) return 0;
+    return sizeof(ASTCompact) +
+           (size_t)ac->node_count * sizeof(ASTCompactNode) +
+           (size_t)ac->word_count * sizeof(uint32_t) +
+           (size_t)ac->string_size +
+           (size_t)ac->line_count * sizeof(uint32_t);
+}
+
+/* ============================================================================
+ * ACCESSORS
+ * ============================================================================
+ */
+
+static const ASTCompactNode *node_at(const ASTCompact *ac, ASTRef ref) {
+    return &ac->nodes[ref < ac->node_count ? ref : AST_REF_NULL];
+}
+
+static const uint32_t *payload(const ASTCompact *ac, ASTRef ref) {
+    return ac->words + node_at(ac, ref)->payload;
+}
+
+ASTNodeType ast_compact_type(const ASTCompact *ac, ASTRef ref) {
+    return (ASTNodeType)node_at(ac, ref)->type;
+}
+
+DataType ast_compact_data_type(const ASTCompact *ac, ASTRef ref) {
+    return (DataType)(node_at(ac, ref)->data_type & 0x0F);
+}
+
+void ast_compact_set_data_type(ASTCompact *ac, ASTRef ref, DataType type) {
+    if (ref != AST_REF_NULL && ref < ac->node_count) {
+        uint8_t *packed = &ac->nodes[ref].data_type;
+        *packed = (uint8_t)((*packed & 0xF0) | type);
+    }
+}
+
+DataType ast_compact_elem_type(const ASTCompact *ac, ASTRef ref) {
+    return (DataType)(node_at(ac, ref)->data_type >> 4);
+}
+
+/* Index of the line holding offset (binary search over line_starts) */
+static uint32_t line_index(const ASTCompact *ac, uint32_t offset) {
+    uint32_t lo = 0, hi = ac->line_count;
+    while (hi - lo > 1) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (ac->line_starts[mid] <= offset) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+SourceLocation ast_compact_location(const ASTCompact *ac, ASTRef ref) {
+    SourceLocation loc = {ac->filename, 0, 0, 0, 0};
+    uint32_t offset = node_at(ac, ref)->loc;
+    if (ref == AST_REF_NULL || offset == AST_LOC_NONE) return loc;
+
+    uint32_t line = line_index(ac, offset);
+    loc.first_line = (int)line + 1;
+    loc.first_column = ac->has_columns ? (int)(offset - ac->line_starts[line]) + 1 : 0;
+    loc.last_line = loc.first_line;
+    loc.last_column = loc.first_column;
+    return loc;
+}
+
+int ast_compact_line(const ASTCompact *ac, ASTRef ref) {
+    uint32_t offset = node_at(ac, ref)->loc;
+    if (ref == AST_REF_NULL || offset == AST_LOC_NONE) return 0;
+    return (int)line_index(ac, offset) + 1;
+}
+
+ASTRef ast_compact_field(const ASTCompact *ac, ASTRef ref, ASTCompactField field) {
+    if (ref == AST_REF_NULL) return AST_REF_NULL;
+    int word = field_word(ast_compact_type(ac, ref), field);
+    return word >= 0 ? payload(ac, ref)[word] : AST_REF_NULL;
+}
+
+uint32_t ast_compact_list_count(const ASTCompact *ac, ASTRef ref) {
+    const NodeLayout *layout = &layouts[ast_compact_type(ac, ref)];
+    if (ref == AST_REF_NULL || layout->list < 0) return 0;
+    return payload(ac, ref)[layout->list];
+}
+
+ASTRef ast_compact_list_item(const ASTCompact *ac, ASTRef ref, uint32_t index) {
+    if (index >= ast_compact_list_count(ac, ref)) return AST_REF_NULL;
+    return payload(ac, ref)[layouts[ast_compact_type(ac, ref)].words + index];
+}
+
+uint32_t ast_compact_child_count(const ASTCompact *ac, ASTRef ref) {
+    if (ref == AST_REF_NULL) return 0;
+    const NodeLayout *layout = &layouts[ast_compact_type(ac, ref)];
+    return ast_compact_list_count(ac, ref) +
+           (uint32_t)(layout->child_end - layout->child_first);
+}
+
+ASTRef ast_compact_child(const ASTCompact *ac, ASTRef ref, uint32_t index) {
+    if (ref == AST_REF_NULL) return AST_REF_NULL;
+    const NodeLayout *layout = &layouts[ast_compact_type(ac, ref)];
+    /* List items come first: a function's parameters precede its body */
+    uint32_t items = ast_compact_list_count(ac, ref);
+    if (index < items) {
+        return payload(ac, ref)[layout->words + index];
+    }
+    index -= items;
+    if (index < (uint32_t)(layout->child_end - layout->child_first)) {
+        return payload(ac, ref)[layout->child_first + index];
+    }
+    return AST_REF_NULL;
+}
+
+const char *ast_compact_name(const ASTCompact *ac, ASTRef ref) {
+    const NodeLayout *layout = &layouts[ast_compact_type(ac, ref)];
+    if (ref == AST_REF_NULL || layout->name < 0) return NULL;
+    uint32_t offset = payload(ac, ref)[layout->name];
+    return offset != 0 ? ac->strings + offset : NULL;
+}
+
+Operator ast_compact_operator(const ASTCompact *ac, ASTRef ref) {
+    return (Operator)node_at(ac, ref)->op;
+}
+
+DataType ast_compact_declared_type(const ASTCompact *ac, ASTRef ref) {
+    switch (ast_compact_type(ac, ref)) {
+        case AST_VAR_DECL:
+        case AST_FUNC_DECL:
+        case AST_PARAM_DECL:
+            return (DataType)node_at(ac, ref)->op;
+        default:
+            return TYPE_UNKNOWN;
+    }
+}
+
+int ast_compact_flag(const ASTCompact *ac, ASTRef ref) {
+    return node_at(ac, ref)->flag;
+}
+
+static uint64_t payload_bits(const ASTCompact *ac, ASTRef ref) {
+    const uint32_t *words = payload(ac, ref);
+    return (uint64_t)words[0] | ((uint64_t)words[1] << 32);
+}
+
+long long ast_compact_int_value(const ASTCompact *ac, ASTRef ref) {
+    if (ast_compact_type(ac, ref) != AST_LITERAL_INT || ref == AST_REF_NULL) return 0;
+    return (long long)payload_bits(ac, ref);
+}
+
+double ast_compact_float_value(const ASTCompact *ac, ASTRef ref) {
+    if (ast_compact_type(ac, ref) != AST_LITERAL_FLOAT || ref == AST_REF_NULL) return 0.0;
+    uint64_t bits = payload_bits(ac, ref);
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+const char *ast_compact_string_value(const ASTCompact *ac, ASTRef ref) {
+    if (ast_compact_type(ac, ref) != AST_LITERAL_STRING || ref == AST_REF_NULL) return NULL;
+    uint32_t offset = payload(ac, ref)[0];
+    return offset != 0 ? ac->strings + offset : NULL;
+}
+
+/* ============================================================================
+ * EXPANSION
+ * ============================================================================
+ */
+
+/*
+ * Children of ref arrive already expanded, in ast_compact_child() order:
+ * list items first, then the fixed children.
+ */
+static ASTNodeList *expand_list(const ASTCompact *ac, ASTRef ref, ASTNode **kids) {
+    ASTNodeList *list = ast_node_list_create();
+    uint32_t count = ast_compact_list_count(ac, ref);
+    for (uint32_t i = 0; i < count; i++) {
+        ast_node_list_append(list, kids[i]);
+    }
+    return list;
+}
+
+static ASTNode *expand_field(const ASTCompact *ac, ASTRef ref, ASTNode **kids,
+                             ASTCompactField field) {
+    ASTNodeType type = ast_compact_type(ac, ref);
+    int word = field_word(type, field);
+    if (word < 0) return NULL;
+    return kids[ast_compact_list_count(ac, ref) + (uint32_t)(word - layouts[type].child_first)];
+}
+
+static ASTNode *expand_node(const ASTCompact *ac, ASTRef ref, ASTNode **kids) {
+    SourceLocation loc = ast_compact_location(ac, ref);
+    const char *name = ast_compact_name(ac, ref);
+    Operator op = ast_compact_operator(ac, ref);
+    DataType declared = ast_compact_declared_type(ac, ref);
+    int flag = ast_compact_flag(ac, ref);
+    ASTNode *node = NULL;
+
+    switch (ast_compact_type(ac, ref)) {
+        case AST_PROGRAM:
+            node = ast_create_program(expand_list(ac, ref, kids), loc);
+            break;
+        case AST_VAR_DECL:
+            node = ast_create_var_decl(name, declared,
+                                       expand_field(ac, ref, kids, AST_FIELD_INITIALIZER),
+                                       flag, loc);
+            break;
+        case AST_FUNC_DECL: {
+            ASTNodeList *params = expand_list(ac, ref, kids);
+            node = ast_create_func_decl(name, params, declared,
+                                        expand_field(ac, ref, kids, AST_FIELD_BODY), loc);
+            break;
+        }
+        case AST_PARAM_DECL:
+            node = ast_create_param_decl(name, declared, loc);
+            break;
+        case AST_BLOCK:
+            node = ast_create_block(expand_list(ac, ref, kids), loc);
+            break;
+        case AST_ASSIGN: {
+            ASTNode *target = expand_field(ac, ref, kids, AST_FIELD_TARGET);
+            node = ast_create_assign(target, expand_field(ac, ref, kids, AST_FIELD_VALUE), loc);
+            break;
+        }
+        case AST_IF: {
+            ASTNode *cond = expand_field(ac, ref, kids, AST_FIELD_CONDITION);
+            ASTNode *then_branch = expand_field(ac, ref, kids, AST_FIELD_THEN);
+            node = ast_create_if(cond, then_branch, expand_field(ac, ref, kids, AST_FIELD_ELSE), loc);
+            break;
+        }
+        case AST_WHILE: {
+            ASTNode *cond = expand_field(ac, ref, kids, AST_FIELD_CONDITION);
+            node = ast_create_while(cond, expand_field(ac, ref, kids, AST_FIELD_BODY), loc);
+            break;
+        }
+        case AST_REPEAT: {
+            ASTNode *count = expand_field(ac, ref, kids, AST_FIELD_COUNT);
+            node = ast_create_repeat(count, expand_field(ac, ref, kids, AST_FIELD_BODY), loc);
+            break;
+        }
+        case AST_FOR_EACH: {
+            ASTNode *iterable = expand_field(ac, ref, kids, AST_FIELD_ITERABLE);
+            node = ast_create_for_each(name, iterable,
+                                       expand_field(ac, ref, kids, AST_FIELD_BODY), loc);
+            break;
+        }
+        case AST_RETURN:
+            node = ast_create_return(expand_field(ac, ref, kids, AST_FIELD_VALUE), loc);
+            break;
+        case AST_BREAK:
+            node = ast_create_break(loc);
+            break;
+        case AST_CONTINUE:
+            node = ast_create_continue(loc);
+            break;
+        case AST_EXPR_STMT:
+            node = ast_create_expr_stmt(expand_field(ac, ref, kids, AST_FIELD_EXPR), loc);
+            break;
+        case AST_SECURE_ZONE:
+            node = ast_create_secure_zone(expand_field(ac, ref, kids, AST_FIELD_BODY), flag, loc);
+            break;
+        case AST_DISPLAY:
+            node = ast_create_display(expand_field(ac, ref, kids, AST_FIELD_VALUE), loc);
+            break;
+        case AST_ASK:
+            node = ast_create_ask(expand_field(ac, ref, kids, AST_FIELD_PROMPT), name, loc);
+            break;
+        case AST_READ:
+            node = ast_create_read(name, loc);
+            break;
+        case AST_BINARY_OP: {
+            ASTNode *left = expand_field(ac, ref, kids, AST_FIELD_LEFT);
+            node = ast_create_binary_op(op, left, expand_field(ac, ref, kids, AST_FIELD_RIGHT), loc);
+            break;
+        }
+        case AST_UNARY_OP:
+            node = ast_create_unary_op(op, expand_field(ac, ref, kids, AST_FIELD_OPERAND), loc);
+            break;
+        case AST_TERNARY_OP: {
+            ASTNode *operand = expand_field(ac, ref, kids, AST_FIELD_OPERAND);
+            ASTNode *lower = expand_field(ac, ref, kids, AST_FIELD_LOWER);
+            node = ast_create_ternary_op(op, operand, lower,
+                                         expand_field(ac, ref, kids, AST_FIELD_UPPER), loc);
+            break;
+        }
+        case AST_LITERAL_INT:
+            node = ast_create_literal_int(ast_compact_int_value(ac, ref), loc);
+            break;
+        case AST_LITERAL_FLOAT:
+            node = ast_create_literal_float(ast_compact_float_value(ac, ref), loc);
+            break;
+        case AST_LITERAL_STRING:
+            node = ast_create_literal_string(ast_compact_string_value(ac, ref), loc);
+            break;
+        case AST_LITERAL_BOOL:
+            node = ast_create_literal_bool(flag, loc);
+            break;
+        case AST_IDENTIFIER:
+            node = ast_create_identifier(name, loc);
+            break;
+        case AST_FUNC_CALL:
+            node = ast_create_func_call(name, expand_list(ac, ref, kids), loc);
+            break;
+        case AST_INDEX: {
+            ASTNode *array = expand_field(ac, ref, kids, AST_FIELD_ARRAY);
+            node = ast_create_index(array, expand_field(ac, ref, kids, AST_FIELD_INDEX), loc);
+            break;
+        }
+        case AST_LIST:
+            node = ast_create_list(expand_list(ac, ref, kids), loc);
+            break;
+        case AST_TYPE:
+        case AST_NODE_COUNT:
+            return NULL;
+    }
+
+    node->data_type = ast_compact_data_type(ac, ref);
+    node->elem_type = ast_compact_elem_type(ac, ref);
+    return node;
+}
+
+/*
+ * Post-order with an explicit stack: each finished node waits on the done
+ * stack until its parent is built from the top entries.
+ */
+ASTNode *ast_compact_expand(const ASTCompact *ac, ASTRef ref) {
+    if (ref == AST_REF_NULL) return NULL;
+
+    ASTNode **done = NULL;
+    uint32_t done_count = 0, done_capacity = 0;
+    ASTWalkStack stack;
+    ast_walk_init(&stack);
+    ast_walk_push(&stack, NULL)->aux.num = (long)ref;
+
+    while (stack.count > 0) {
+        ASTWalkFrame *frame = ast_walk_top(&stack);
+        ASTRef current = (ASTRef)frame->aux.num;
+        uint32_t count = ast_compact_child_count(ac, current);
+
+        if (frame->next < count) {
+            ASTRef child = ast_compact_child(ac, current, (uint32_t)frame->next++);
+            if (child != AST_REF_NULL) {
+                ast_walk_push(&stack, NULL)->aux.num = (long)child;
+                continue;
+            }
+            done = grow(done, &done_capacity, done_count + 1, sizeof(ASTNode *));
+            done[done_count++] = NULL;
+            continue;
+        }
+
+        ASTNode *node = expand_node(ac, current, done + done_count - count);
+        done_count -= count;
+        done = grow(done, &done_capacity, done_count + 1, sizeof(ASTNode *));
+        done[done_count++] = node;
+        ast_walk_pop(&stack);
+    }
+
+    ASTNode *root = done[0];
+    free(done);
+    ast_walk_free(&stack);
+    return root;
+}
@@ -168,7 +168,6 @@ CodegenContext *codegen_create(SymbolTable *symtab, CodegenOptions *options) {
     /* loop scope state শুরুতে false। */
     ctx->in_loop = 0;
     /* input buffer feature flag শুরুতে off। */
-    ctx->needs_input_buffer = 0;
     /* list support feature flag শুরুতে off। */
     ctx->needs_list_support = 0;
     
@@ -201,6 +200,58 @@ const char *naturelang_type_to_c(DataType type) {
     }
 }
 
+/* Runtime element type constant of a list of type (unknown -> untyped) */
+static const char *list_type_to_c(DataType type) {
+    switch (type) {
+        case TYPE_NUMBER:  return "NL_LIST_NUMBER";
+        case TYPE_DECIMAL: return "NL_LIST_DECIMAL";
+        case TYPE_TEXT:    return "NL_LIST_TEXT";
+        case TYPE_FLAG:    return "NL_LIST_FLAG";
+        default:           return "NL_LIST_UNTYPED";
+    }
+}
+
+/* Suffix of the typed nl_list_get_* accessor for an element of type */
+static const char *list_accessor_suffix(DataType type) {
+    switch (type) {
+        case TYPE_DECIMAL: return "dec";
+        case TYPE_TEXT:    return "str";
+        case TYPE_FLAG:    return "flag";
+        default:           return "num";
+    }
+}
+
+/*
+ * C name of the runtime function behind a builtin (builtins.def), or NULL;
+ * a list builtin's depends on the element type the call works on
+ */
+static const char *builtin_runtime_name(const char *name, DataType list_elem) {
+#define BUILTIN(builtin, runtime, ret, elem, params) \
+    if (strcmp(name, builtin) == 0) return runtime;
+#define LIST_BUILTIN(builtin, phrase, num, dec, text, ret, params) \
+    if (strcmp(name, builtin) == 0) { \
+        const char *typed = list_elem == TYPE_DECIMAL ? dec : list_elem == TYPE_TEXT ? text : num; \
+        return typed ? typed : num; \
+    }
+#include "builtins.def"
+#undef LIST_BUILTIN
+#undef BUILTIN
+    return NULL;
+}
+
+/*
+ * Runtime call (up to its value argument) that turns a non-text value into
+ * text; numbers are formatted into a compound-literal buffer on the stack,
+ * so the conversion does not allocate
+ */
+static const char *to_string_fn(DataType type) {
+    switch (type) {
+        case TYPE_DECIMAL: return "nl_dec_text((char[NL_DEC_CHARS]){0}, ";
+        case TYPE_FLAG:    return "nl_flag_text(";
+        default:           return "nl_num_text((char[NL_NUM_CHARS]){0}, ";
+    }
+}
+
 /* Generate temporary variable */
 char *codegen_temp_var(CodegenContext *ctx) {
     /* temporary identifier string-এর জন্য ছোট heap buffer allocate। */
@@ -253,16 +304,6 @@ static void emit_headers(CodegenContext *ctx) {
     emit_newline(ctx);
 }
 
-/* Emit input buffer if needed */
-static void emit_input_buffer(CodegenContext *ctx) {
-    /* input statement থাকলে global input buffer declaration emit করি। */
-    if (ctx->needs_input_buffer) {
-        emit_line(ctx, "/* Input buffer for reading user input */");
-        emit_line(ctx, "static char _nl_input_buffer[4096];");
-        emit_newline(ctx);
-    }
-}
-
 /* Convert identifier to valid C name */
 static void emit_identifier(CodegenContext *ctx, const char *name) {
     /* Replace spaces with underscores for multi-word identifiers */
@@ -305,22 +346,76 @@ static void emit_string_literal(CodegenContext *ctx, const char *str) {
     emit(ctx, "\"");
 }
 
-/* Generate expression */
-static void codegen_expression(CodegenContext *ctx, ASTNode *node) {
-    /* null expression node হলে কোনো code emit করব না। */
-    if (!node) return;
-    
-    /* AST expression kind অনুযায়ী target C expression emit। */
+/*
+ * Expression emission
+ *
+ * Expressions are emitted from an explicit work stack, not by recursion,
+ * since generated operator chains can be a million levels deep. A work
+ * item is either an expression or a text fragment. When an expression
+ * comes off the stack its leading text is emitted at once and the rest of
+ * its output (operands and the text between them) is pushed in reverse.
+ */
+typedef struct {
+    ASTNode *node;          /* Expression to generate, or NULL */
+    const char *text;       /* Fragment to emit as-is when node is NULL */
+} ExprWork;
+
+typedef struct {
+    ExprWork *items;
+    size_t count;
+    size_t capacity;
+    ExprWork inline_items[AST_WALK_INLINE];
+} ExprWorkStack;
+
+static void work_push(ExprWorkStack *work, ASTNode *node, const char *text) {
+    if (work->count == work->capacity) {
+        size_t capacity = work->capacity * 2;
+        ExprWork *items = work->items == work->inline_items
+                          ? malloc(capacity * sizeof(ExprWork))
+                          : realloc(work->items, capacity * sizeof(ExprWork));
+        if (!items) {
+            fprintf(stderr, "Fatal: Out of memory in code generator\n");
+            exit(1);
+        }
+        if (work->items == work->inline_items) {
+            memcpy(items, work->inline_items, work->count * sizeof(ExprWork));
+        }
+        work->items = items;
+        work->capacity = capacity;
+    }
+    work->items[work->count].node = node;
+    work->items[work->count].text = text;
+    work->count++;
+}
+
+static void work_node(ExprWorkStack *work, ASTNode *node) {
+    /* null operand হলে কোনো code emit করব না। */
+    if (node) work_push(work, node, NULL);
+}
+
+static void work_text(ExprWorkStack *work, const char *text) {
+    work_push(work, NULL, text);
+}
+
+/* Emit one expression's leading text and queue the rest of it */
+static void expand_expression(CodegenContext *ctx, ASTNode *node, ExprWorkStack *work) {
+    /* AST expression kind অনুযায়ী target C expression emit। */
     switch (node->type) {
         case AST_LITERAL_INT:
             /* integer literal সরাসরি emit। */
             emit(ctx, "%lld", node->data.literal_int.value);
             break;
             
-        case AST_LITERAL_FLOAT:
-            /* floating literal compact %g format-এ emit। */
-            emit(ctx, "%g", node->data.literal_float.value);
+        case AST_LITERAL_FLOAT: {
+            /* compact %g, তবে যত digit লাগে ততটা যাতে literal একই double-এ ফেরে। */
+            char text[32];
+            int precision = 6;
+            do {
+                snprintf(text, sizeof(text), "%.*g", precision, node->data.literal_float.value);
+            } while (strtod(text, NULL) != node->data.literal_float.value && ++precision <= 17);
+            emit(ctx, "%s", text);
             break;
+        }
             
         case AST_LITERAL_STRING:
             /* string literal safe escaped form-এ emit helper call। */
@@ -340,9 +435,7 @@ static void codegen_expression(CodegenContext *ctx, ASTNode *node) {
         case AST_BINARY_OP: {
             /* operator string এবং আচরণ flags প্রস্তুত করি। */
             const char *op_str;
-            int needs_parens = 1;
             int is_comparison = 0;
-            int is_string_concat = 0;
             /* binary op metadata shortcuts। */
             Operator op = node->data.binary_op.op;
             ASTNode *left = node->data.binary_op.left;
@@ -351,32 +444,27 @@ static void codegen_expression(CodegenContext *ctx, ASTNode *node) {
             /* Check for string concatenation */
             if (op == OP_ADD && 
                 (left->data_type == TYPE_TEXT || right->data_type == TYPE_TEXT)) {
-                /* text operand থাকলে '+' কে concat semantics ধরব। */
-                is_string_concat = 1;
-            }
-            
-            if (is_string_concat) {
                 /* Use runtime string concatenation */
                 /* nl_concat(left, right) call emit; non-text হলে আগে string-এ convert। */
                 emit(ctx, "nl_concat(");
-                if (left->data_type == TYPE_TEXT) {
-                    codegen_expression(ctx, left);
-                } else {
-                    /* non-text left operand কে nl_to_string দিয়ে wrap। */
-                    emit(ctx, "nl_to_string(");
-                    codegen_expression(ctx, left);
-                    emit(ctx, ")");
-                }
-                emit(ctx, ", ");
+                work_text(work, ")");
                 if (right->data_type == TYPE_TEXT) {
-                    codegen_expression(ctx, right);
+                    work_node(work, right);
                 } else {
                     /* non-text right operand-ও string conversion করে concat। */
-                    emit(ctx, "nl_to_string(");
-                    codegen_expression(ctx, right);
-                    emit(ctx, ")");
+                    work_text(work, ")");
+                    work_node(work, right);
+                    work_text(work, to_string_fn(right->data_type));
+                }
+                work_text(work, ", ");
+                if (left->data_type == TYPE_TEXT) {
+                    work_node(work, left);
+                } else {
+                    /* non-text left operand কে nl_to_string দিয়ে wrap। */
+                    work_text(work, ")");
+                    work_node(work, left);
+                    work_text(work, to_string_fn(left->data_type));
                 }
-                emit(ctx, ")");
                 /* concat path শেষ, binary op switch case শেষ। */
                 break;
             }
@@ -390,12 +478,12 @@ static void codegen_expression(CodegenContext *ctx, ASTNode *node) {
                 case OP_MOD: op_str = "%%"; break;
                 case OP_POW:
                     /* Use pow() for exponentiation */
-                    /* exponentiation-এ infix নয়, pow(left, right) call emit। */
+                    /* exponentiation-এ infix নয়, pow(left, right) call emit। */
                     emit(ctx, "pow(");
-                    codegen_expression(ctx, left);
-                    emit(ctx, ", ");
-                    codegen_expression(ctx, right);
-                    emit(ctx, ")");
+                    work_text(work, ")");
+                    work_node(work, right);
+                    work_text(work, ", ");
+                    work_node(work, left);
                     /* OP_POW case-এ immediate return; নিচের path লাগবে না। */
                     return;
                 case OP_EQ:  op_str = "=="; is_comparison = 1; break;
@@ -414,17 +502,21 @@ static void codegen_expression(CodegenContext *ctx, ASTNode *node) {
                 (left->data_type == TYPE_TEXT || right->data_type == TYPE_TEXT)) {
                 /* string comparison-এ lexical compare করতে strcmp ব্যবহার। */
                 emit(ctx, "(strcmp(");
-                codegen_expression(ctx, left);
-                emit(ctx, ", ");
-                codegen_expression(ctx, right);
-                emit(ctx, ") %s 0)", op_str);
+                work_text(work, " 0)");
+                work_text(work, op_str);
+                work_text(work, ") ");
+                work_node(work, right);
+                work_text(work, ", ");
+                work_node(work, left);
             } else {
                 /* সাধারণ arithmetic/logical/comparison infix expression emit। */
-                if (needs_parens) emit(ctx, "(");
-                codegen_expression(ctx, left);
-                emit(ctx, " %s ", op_str);
-                codegen_expression(ctx, right);
-                if (needs_parens) emit(ctx, ")");
+                emit(ctx, "(");
+                work_text(work, ")");
+                work_node(work, right);
+                work_text(work, " ");
+                work_text(work, op_str);
+                work_text(work, " ");
+                work_node(work, left);
             }
             break;
         }
@@ -438,18 +530,18 @@ static void codegen_expression(CodegenContext *ctx, ASTNode *node) {
                 case OP_NEG:
                     /* numeric negation wrapper emit। */
                     emit(ctx, "(-");
-                    codegen_expression(ctx, operand);
-                    emit(ctx, ")");
+                    work_text(work, ")");
+                    work_node(work, operand);
                     break;
                 case OP_NOT:
                     /* logical NOT wrapper emit। */
                     emit(ctx, "(!");
-                    codegen_expression(ctx, operand);
-                    emit(ctx, ")");
+                    work_text(work, ")");
+                    work_node(work, operand);
                     break;
                 default:
                     /* unknown unary হলে operand as-is emit। */
-                    codegen_expression(ctx, operand);
+                    work_node(work, operand);
                     break;
             }
             break;
@@ -463,32 +555,38 @@ static void codegen_expression(CodegenContext *ctx, ASTNode *node) {
             ASTNode *upper = node->data.ternary_op.upper;
             
             emit(ctx, "((");
-            codegen_expression(ctx, operand);
-            emit(ctx, " >= ");
-            codegen_expression(ctx, lower);
-            emit(ctx, ") && (");
-            codegen_expression(ctx, operand);
-            emit(ctx, " <= ");
-            codegen_expression(ctx, upper);
-            emit(ctx, "))");
+            work_text(work, "))");
+            work_node(work, upper);
+            work_text(work, " <= ");
+            work_node(work, operand);
+            work_text(work, ") && (");
+            work_node(work, lower);
+            work_text(work, " >= ");
+            work_node(work, operand);
             break;
         }
             
         case AST_FUNC_CALL: {
-            /* function call name emit। */
-            emit_identifier(ctx, node->data.func_call.name);
+            /* function call name emit; builtin হলে runtime function-এর নাম। */
+            const char *runtime = builtin_runtime_name(node->data.func_call.name,
+                                                       node->elem_type);
+            if (runtime) {
+                emit(ctx, "%s", runtime);
+            } else {
+                emit_identifier(ctx, node->data.func_call.name);
+            }
             /* argument list open। */
             emit(ctx, "(");
+            /* argument list close (শেষে emit হবে বলে আগে push)। */
+            work_text(work, ")");
             ASTNodeList *args = node->data.func_call.args;
             if (args) {
-                /* argument list comma-separated emit। */
-                for (size_t i = 0; i < args->count; i++) {
-                    if (i > 0) emit(ctx, ", ");
-                    codegen_expression(ctx, args->nodes[i]);
+                /* argument list comma-separated emit (উল্টো ক্রমে push)। */
+                for (size_t i = args->count; i > 0; i--) {
+                    work_node(work, args->nodes[i - 1]);
+                    if (i > 1) work_text(work, ", ");
                 }
             }
-            /* argument list close। */
-            emit(ctx, ")");
             break;
         }
         
@@ -496,28 +594,33 @@ static void codegen_expression(CodegenContext *ctx, ASTNode *node) {
             /* list literal elements metadata। */
             ASTNodeList *elements = node->data.list_literal.elements;
             size_t count = elements ? elements->count : 0;
-            /* runtime list creation call শুরু; element count first arg। */
-            emit(ctx, "nl_list_create(%zu", count);
+            /* runtime typed list creation call শুরু; element type ও count প্রথম দুই arg। */
+            emit(ctx, "nl_list_of(%s, %zu", list_type_to_c(node->elem_type), count);
+            work_text(work, ")");
             if (elements) {
-                /* প্রতিটি element অতিরিক্ত argument হিসেবে append। */
-                for (size_t i = 0; i < elements->count; i++) {
-                    emit(ctx, ", ");
-                    codegen_expression(ctx, elements->nodes[i]);
+                /* প্রতিটি element list-এর C type-এ cast করে অতিরিক্ত argument হিসেবে দিই। */
+                const char *elem_c = naturelang_type_to_c(
+                    node->elem_type != TYPE_UNKNOWN ? node->elem_type : TYPE_NUMBER);
+                for (size_t i = elements->count; i > 0; i--) {
+                    work_text(work, ")");
+                    work_node(work, elements->nodes[i - 1]);
+                    work_text(work, ")(");
+                    work_text(work, elem_c);
+                    work_text(work, ", (");
                 }
             }
-            emit(ctx, ")");
             /* list runtime support লাগবে, feature flag সেট। */
             ctx->needs_list_support = 1;
             break;
         }
         
         case AST_INDEX: {
-            /* list index access-কে runtime helper call-এ নামাই। */
-            emit(ctx, "nl_list_get(");
-            codegen_expression(ctx, node->data.index_expr.array);
-            emit(ctx, ", ");
-            codegen_expression(ctx, node->data.index_expr.index);
-            emit(ctx, ")");
+            /* list index access-কে element type-এর typed runtime helper call-এ নামাই। */
+            emit(ctx, "nl_list_get_%s(", list_accessor_suffix(node->data_type));
+            work_text(work, ")");
+            work_node(work, node->data.index_expr.index);
+            work_text(work, ", ");
+            work_node(work, node->data.index_expr.array);
             break;
         }
         
@@ -529,6 +632,31 @@ static void codegen_expression(CodegenContext *ctx, ASTNode *node) {
     }
 }
 
+/* Generate expression */
+static void codegen_expression(CodegenContext *ctx, ASTNode *node) {
+    /* null expression node হলে কোনো code emit করব না। */
+    if (!node) return;
+    
+    ExprWorkStack work;
+    work.items = work.inline_items;
+    work.count = 0;
+    work.capacity = AST_WALK_INLINE;
+    
+    work_node(&work, node);
+    while (work.count > 0) {
+        ExprWork item = work.items[--work.count];
+        if (item.node) {
+            expand_expression(ctx, item.node, &work);
+        } else {
+            emit(ctx, "%s", item.text);
+        }
+    }
+    
+    if (work.items != work.inline_items) {
+        free(work.items);
+    }
+}
+
 /* Generate variable declaration */
 static void codegen_var_decl(CodegenContext *ctx, ASTNode *node) {
     /* statement line-এর শুরুতে indentation। */
@@ -567,6 +695,11 @@ static void codegen_var_decl(CodegenContext *ctx, ASTNode *node) {
             case TYPE_FLAG:
                 emit(ctx, " = 0");
                 break;
+            case TYPE_LIST:
+                /* ঘোষিত element type-এর খালি list। */
+                emit(ctx, " = nl_list_of(%s, 0)", list_type_to_c(node->elem_type));
+                ctx->needs_list_support = 1;
+                break;
             default:
                 break;
         }
@@ -579,6 +712,18 @@ static void codegen_var_decl(CodegenContext *ctx, ASTNode *node) {
 static void codegen_assignment(CodegenContext *ctx, ASTNode *node) {
     /* assignment statement indentation। */
     emit_indent(ctx);
+    ASTNode *target = node->data.assign.target;
+    if (target->type == AST_INDEX) {
+        /* list element assignment: value-এর type অনুযায়ী typed set helper call। */
+        emit(ctx, "nl_list_set_%s(", list_accessor_suffix(node->data.assign.value->data_type));
+        codegen_expression(ctx, target->data.index_expr.array);
+        emit(ctx, ", ");
+        codegen_expression(ctx, target->data.index_expr.index);
+        emit(ctx, ", ");
+        codegen_expression(ctx, node->data.assign.value);
+        emit(ctx, ");\n");
+        return;
+    }
     /* target lvalue emit। */
     codegen_expression(ctx, node->data.assign.target);
     emit(ctx, " = ");
@@ -597,7 +742,7 @@ static void codegen_display(CodegenContext *ctx, ASTNode *node) {
     ASTNode *value = node->data.display_stmt.value;
     if (!value) {
         /* value না থাকলে শুধু newline print। */
-        emit(ctx, "printf(\"\\n\");\n");
+        emit(ctx, "nl_display(\"\");\n");
         return;
     }
     
@@ -607,25 +752,25 @@ static void codegen_display(CodegenContext *ctx, ASTNode *node) {
     /* value type অনুযায়ী format string নির্বাচন। */
     switch (type) {
         case TYPE_NUMBER:
-            emit(ctx, "printf(\"%%lld\\n\", (long long)");
+            emit(ctx, "nl_display_num((long long)");
             codegen_expression(ctx, value);
             emit(ctx, ");\n");
             break;
         case TYPE_DECIMAL:
-            emit(ctx, "printf(\"%%g\\n\", (double)");
+            emit(ctx, "nl_display_dec((double)");
             codegen_expression(ctx, value);
             emit(ctx, ");\n");
             break;
         case TYPE_TEXT:
-            emit(ctx, "printf(\"%%s\\n\", ");
+            emit(ctx, "nl_display(");
             codegen_expression(ctx, value);
             emit(ctx, ");\n");
             break;
         case TYPE_FLAG:
             /* boolean true/false কে yes/no text হিসেবে দেখাই। */
-            emit(ctx, "printf(\"%%s\\n\", ");
+            emit(ctx, "nl_display_bool(");
             codegen_expression(ctx, value);
-            emit(ctx, " ? \"yes\" : \"no\");\n");
+            emit(ctx, ");\n");
             break;
         default:
             /* unknown/custom type হলে runtime display helper fallback। */
@@ -636,105 +781,56 @@ static void codegen_display(CodegenContext *ctx, ASTNode *node) {
     }
 }
 
-/* Generate ask statement (input with prompt) */
-static void codegen_ask(CodegenContext *ctx, ASTNode *node) {
-    /* ask/read path-এ shared input buffer দরকার। */
-    ctx->needs_input_buffer = 1;
-    /* current line indentation। */
-    emit_indent(ctx);
-    
-    /* Get target variable type */
-    DataType type = TYPE_TEXT;  /* Default */
-    /* target variable identifier। */
-    const char *target = node->data.ask_stmt.target_var;
-    /* symbol table থেকে target এর declared type খুঁজি। */
+/* Read the next input line into a variable, parsed as its type */
+static void codegen_read_value(CodegenContext *ctx, const char *target) {
+    /* target variable type symbol table থেকে resolve (না পেলে text)। */
+    DataType type = TYPE_TEXT;
     Symbol *sym = symtab_lookup(ctx->symtab, target);
     if (sym) {
-        /* symbol পাওয়া গেলে actual type override। */
         type = sym->type;
     }
     
-    /* Print prompt if provided */
-    if (node->data.ask_stmt.prompt) {
-        /* prompt থাকলে আগে সেটি print করে flush করি। */
-        emit(ctx, "printf(\"%%s\", ");
-        codegen_expression(ctx, node->data.ask_stmt.prompt);
-        emit(ctx, "); fflush(stdout);\n");
-        /* read statement লাইনের জন্য পুনরায় indentation। */
-        emit_indent(ctx);
-    }
-    
-    /* Read input based on type */
+    /* runtime input layer type অনুযায়ী line parse করে (ভুল input হলে runtime error)। */
+    emit_identifier(ctx, target);
     switch (type) {
         case TYPE_NUMBER:
-            /* string input পড়ে atoll দিয়ে integer parse। */
-            emit(ctx, "fgets(_nl_input_buffer, sizeof(_nl_input_buffer), stdin); ");
-            emit_identifier(ctx, target);
-            emit(ctx, " = atoll(_nl_input_buffer);\n");
+            emit(ctx, " = nl_read_num();\n");
             break;
         case TYPE_DECIMAL:
-            /* decimal target হলে atof parse ব্যবহার। */
-            emit(ctx, "fgets(_nl_input_buffer, sizeof(_nl_input_buffer), stdin); ");
-            emit_identifier(ctx, target);
-            emit(ctx, " = atof(_nl_input_buffer);\n");
+            emit(ctx, " = nl_read_dec();\n");
             break;
-        case TYPE_TEXT:
-            /* text input newline trim করে strdup দিয়ে assign। */
-            emit(ctx, "fgets(_nl_input_buffer, sizeof(_nl_input_buffer), stdin); ");
-            emit(ctx, "_nl_input_buffer[strcspn(_nl_input_buffer, \"\\n\")] = 0; ");
-            emit_identifier(ctx, target);
-            emit(ctx, " = strdup(_nl_input_buffer);\n");
+        case TYPE_FLAG:
+            emit(ctx, " = nl_read_flag();\n");
             break;
         default:
-            /* fallback: raw input read, conversion ছাড়া। */
-            emit(ctx, "fgets(_nl_input_buffer, sizeof(_nl_input_buffer), stdin);\n");
+            emit(ctx, " = nl_read_text();\n");
             break;
     }
 }
 
-/* Generate read statement (simple input) */
-static void codegen_read(CodegenContext *ctx, ASTNode *node) {
-    /* read statement-এও shared input buffer প্রয়োজন। */
-    ctx->needs_input_buffer = 1;
-    /* generated line indentation। */
+/* Generate ask statement (input with prompt) */
+static void codegen_ask(CodegenContext *ctx, ASTNode *node) {
+    /* current line indentation। */
     emit_indent(ctx);
     
-    const char *target = node->data.read_stmt.target_var;
-    
-    /* Get target variable type */
-    DataType type = TYPE_TEXT;  /* Default */
-    /* target variable type symbol table থেকে resolve। */
-    Symbol *sym = symtab_lookup(ctx->symtab, target);
-    if (sym) {
-        type = sym->type;
+    /* Print prompt if provided */
+    if (node->data.ask_stmt.prompt) {
+        /* prompt output buffer-এ যায়; runtime input পড়ার আগে flush করে। */
+        emit(ctx, "nl_out_str(");
+        codegen_expression(ctx, node->data.ask_stmt.prompt);
+        emit(ctx, ");\n");
+        /* read statement লাইনের জন্য পুনরায় indentation। */
+        emit_indent(ctx);
     }
     
-    /* Read input based on type */
-    switch (type) {
-        case TYPE_NUMBER:
-            /* integer parse path। */
-            emit(ctx, "fgets(_nl_input_buffer, sizeof(_nl_input_buffer), stdin); ");
-            emit_identifier(ctx, target);
-            emit(ctx, " = atoll(_nl_input_buffer);\n");
-            break;
-        case TYPE_DECIMAL:
-            /* decimal parse path। */
-            emit(ctx, "fgets(_nl_input_buffer, sizeof(_nl_input_buffer), stdin); ");
-            emit_identifier(ctx, target);
-            emit(ctx, " = atof(_nl_input_buffer);\n");
-            break;
-        case TYPE_TEXT:
-            /* text path: newline strip + strdup assignment। */
-            emit(ctx, "fgets(_nl_input_buffer, sizeof(_nl_input_buffer), stdin); ");
-            emit(ctx, "_nl_input_buffer[strcspn(_nl_input_buffer, \"\\n\")] = 0; ");
-            emit_identifier(ctx, target);
-            emit(ctx, " = strdup(_nl_input_buffer);\n");
-            break;
-        default:
-            /* unknown type fallback raw read। */
-            emit(ctx, "fgets(_nl_input_buffer, sizeof(_nl_input_buffer), stdin);\n");
-            break;
-    }
+    codegen_read_value(ctx, node->data.ask_stmt.target_var);
+}
+
+/* Generate read statement (simple input) */
+static void codegen_read(CodegenContext *ctx, ASTNode *node) {
+    /* generated line indentation। */
+    emit_indent(ctx);
+    codegen_read_value(ctx, node->data.read_stmt.target_var);
 }
 
 /* Generate if statement */
@@ -871,11 +967,12 @@ static void codegen_foreach(CodegenContext *ctx, ASTNode *node) {
     
     ctx->indent_level++;
     
-    /* বর্তমান element iterator variable-এ bind (numeric assumption path)। */
+    /* বর্তমান element iterator variable-এ bind; semantic phase iterator type node-এ রাখে। */
+    DataType item_type = node->data_type != TYPE_UNKNOWN ? node->data_type : TYPE_NUMBER;
     emit_indent(ctx);
-    emit(ctx, "long long ");  /* Assume numeric for now */
+    emit(ctx, "%s ", naturelang_type_to_c(item_type));
     emit_identifier(ctx, node->data.for_each_stmt.iterator_name);
-    emit(ctx, " = nl_list_get_num(%s, %s);\n", list_var, iter_var);
+    emit(ctx, " = nl_list_get_%s(%s, %s);\n", list_accessor_suffix(item_type), list_var, iter_var);
     
     /* foreach body emit। */
     ctx->in_loop++;
@@ -1269,17 +1366,9 @@ CodegenResult codegen_generate(CodegenContext *ctx, ASTNode *ast) {
     ctx->buffer_size = 0;
     ctx->buffer[0] = '\0';
     
-    /* First pass: scan for features used */
-    /* (This could be expanded to detect input/list usage) */
-    /* আপাতত input buffer সবসময় include করা হচ্ছে। */
-    ctx->needs_input_buffer = 1;  /* Always include for now */
-    
     /* Emit headers */
     emit_headers(ctx);
     
-    /* Emit global variables/buffers */
-    emit_input_buffer(ctx);
-    
     /* Emit forward declarations */
     emit_forward_declarations(ctx, ast);
     
@@ -22,6 +22,8 @@ It keeps behavior predictable across different libc implementations.
 #define _POSIX_C_SOURCE 200809L
 #include "ir_codegen.h"
 #include "ir.h"
+#include "ir_range.h"
+#include "ir_region.h"
 #include "ast.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -43,23 +45,22 @@ typedef struct {
     char error_message[1024];
 
     /* Track features used */
-    int needs_input_buffer;
     int needs_math;
     int needs_list;
 
-    /* Variable type table: track declared types */
-    #define MAX_VAR_TYPES 4096
-    struct { char name[256]; DataType type; } var_types[MAX_VAR_TYPES];
-    int var_type_count;
+    /* Number ranges of the function being emitted (NULL: everything is long long) */
+    int narrow_integers;
+    IRRangeInfo *ranges;
 
-    /* Temporary type table */
-    #define MAX_TEMP_TYPES 4096
-    DataType temp_types[MAX_TEMP_TYPES];
+    /* Functions and secure zones whose allocations die with them (NULL: none) */
+    IRRegionInfo *regions;
+    TACFunction *func;          /* Function being emitted */
+    int in_region;              /* It runs inside its own region */
+    int zone_count;             /* Secure zones seen so far in it */
+    int *zone_stack;            /* Open zones: region number, or -1 for none */
+    int zone_depth;
+    int zone_capacity;
 
-    /* Function return type table */
-    #define MAX_FUNC_TYPES 256
-    struct { char name[256]; DataType ret_type; } func_types[MAX_FUNC_TYPES];
-    int func_type_count;
 } IRCGCtx;
 
 static void ctx_init(IRCGCtx *ctx, int indent_size) {
@@ -82,152 +83,24 @@ static void ctx_init(IRCGCtx *ctx, int indent_size) {
     /* codegen error counter শুরুতে শূন্য। */
     ctx->error_count = 0;
     /* feature flags শুরুতে false/0: scan phase এগুলো set করবে। */
-    ctx->needs_input_buffer = 0;
     ctx->needs_math = 0;
     ctx->needs_list = 0;
-    /* variable type table empty ধরে count reset। */
-    ctx->var_type_count = 0;
-    /* temp type table clean করি যেন TYPE_UNKNOWN/0 দিয়ে শুরু হয়। */
-    memset(ctx->temp_types, 0, sizeof(ctx->temp_types));
-    /* function return type registryও empty অবস্থায় শুরু। */
-    ctx->func_type_count = 0;
-}
-
-static void ctx_register_func(IRCGCtx *ctx, const char *name, DataType ret_type) {
-    /* আগে থেকে function entry থাকলে সেটি update করব। */
-    for (int i = 0; i < ctx->func_type_count; i++) {
-        if (strcmp(ctx->func_types[i].name, name) == 0) {
-            /* একই function name পেলে return type overwrite/update। */
-            ctx->func_types[i].ret_type = ret_type;
-            /* update সম্পন্ন, নতুন entry দরকার নেই। */
-            return;
-        }
-    }
-    /* নতুন function হলে table capacity থাকলে append করি। */
-    if (ctx->func_type_count < MAX_FUNC_TYPES) {
-        /* bounded copy: name buffer overflow এড়াতে size-1 পর্যন্ত কপি। */
-        strncpy(ctx->func_types[ctx->func_type_count].name, name,
-                sizeof(ctx->func_types[0].name) - 1);
-        /* function-এর declared return type সংরক্ষণ। */
-        ctx->func_types[ctx->func_type_count].ret_type = ret_type;
-        /* registry size এক ধাপ বাড়াই। */
-        ctx->func_type_count++;
-    }
-}
-
-static DataType ctx_lookup_func_ret(IRCGCtx *ctx, const char *name) {
-    /* function return type table linear search। */
-    for (int i = 0; i < ctx->func_type_count; i++) {
-        if (strcmp(ctx->func_types[i].name, name) == 0) {
-            /* match পেলে stored return type ফেরত। */
-            return ctx->func_types[i].ret_type;
-        }
-    }
-    /* না পেলে unknown type দিয়ে caller-কে fallback signal দিই। */
-    return TYPE_UNKNOWN;
-}
-
-static void ctx_register_var(IRCGCtx *ctx, const char *name, DataType type) {
-    /* Update if already present */
-    /* variable আগে থাকলে redeclare না করে type update করি। */
-    for (int i = 0; i < ctx->var_type_count; i++) {
-        if (strcmp(ctx->var_types[i].name, name) == 0) {
-            /* existing entry type refresh। */
-            ctx->var_types[i].type = type;
-            return;
-        }
-    }
-    /* নতুন variable হলে capacity থাকলে table-এ append। */
-    if (ctx->var_type_count < MAX_VAR_TYPES) {
-        /* bounded copy দিয়ে name store করি। */
-        strncpy(ctx->var_types[ctx->var_type_count].name, name,
-                sizeof(ctx->var_types[0].name) - 1);
-        /* resolved/declared variable type save। */
-        ctx->var_types[ctx->var_type_count].type = type;
-        /* table size increment। */
-        ctx->var_type_count++;
-    }
-}
-
-static DataType ctx_lookup_var_type(IRCGCtx *ctx, const char *name) {
-    /* registered variable type table-এ linear search চালাই। */
-    for (int i = 0; i < ctx->var_type_count; i++) {
-        if (strcmp(ctx->var_types[i].name, name) == 0) {
-            /* নাম match হলে stored DataType caller-কে ফেরত দিই। */
-            return ctx->var_types[i].type;
-        }
-    }
-    /* table-এ না পেলে unknown type ফেরত (fallback signal)। */
-    return TYPE_UNKNOWN;
-}
-
-/* Resolve the effective type of an operand using context tables */
-static DataType resolve_type(IRCGCtx *ctx, TACOperand *op) {
-    /* If the operand already has a known type, use it */
-    /* operand-এর type যদি আগেই concrete হয়, context lookup ছাড়াই সেটিই authoritative। */
-    if (op->data_type != TYPE_UNKNOWN && op->data_type != TYPE_NUMBER) {
-        return op->data_type;
-    }
-    /* operand kind অনুযায়ী effective type infer/resolve করি। */
-    switch (op->kind) {
-        case OPERAND_STRING:
-            /* string literal/value সর্বদা TYPE_TEXT। */
-            return TYPE_TEXT;
-        case OPERAND_FLOAT:
-            /* floating operand হলে decimal type। */
-            return TYPE_DECIMAL;
-        case OPERAND_BOOL:
-            /* boolean operand হলে flag type। */
-            return TYPE_FLAG;
-        case OPERAND_INT:
-            /* integer operand হলে number type। */
-            return TYPE_NUMBER;
-        case OPERAND_VAR:
-            /* named variable-এর জন্য variable table থেকে type খুঁজি। */
-            if (op->val.name) {
-                DataType t = ctx_lookup_var_type(ctx, op->val.name);
-                /* table-এ পাওয়া গেলে inferred type ব্যবহার করি। */
-                if (t != TYPE_UNKNOWN) return t;
-            }
-            /* না পেলে operand metadata-তে থাকা type-এ fallback। */
-            return op->data_type;
-        case OPERAND_TEMP:
-            /* temp id valid range-এ হলে temp type table consult করি। */
-            if (op->val.temp_id >= 0 && op->val.temp_id < MAX_TEMP_TYPES) {
-                DataType t = ctx->temp_types[op->val.temp_id];
-                /* recorded temp type থাকলে সেটি return। */
-                if (t != TYPE_UNKNOWN) return t;
-            }
-            /* temp table-এ অজানা হলে operand-local type fallback। */
-            return op->data_type;
-        default:
-            /* unsupported/none operand kind হলে safest fallback: existing metadata। */
-            return op->data_type;
-    }
-}
-
-/* Record the type of a result operand.
- * For variables, only record if not already declared (DECL types are authoritative). */
-static void record_result_type(IRCGCtx *ctx, TACOperand *result, DataType type) {
-    /* result যদি temp হয় এবং id valid range-এ থাকে, temp type table-এ সরাসরি record করি। */
-    if (result->kind == OPERAND_TEMP && result->val.temp_id >= 0 &&
-        result->val.temp_id < MAX_TEMP_TYPES) {
-        /* temp id slot-এ inferred/known type লিখে রাখি ভবিষ্যৎ resolution-এর জন্য। */
-        ctx->temp_types[result->val.temp_id] = type;
-    } else if (result->kind == OPERAND_VAR && result->val.name) {
-        /* Only set if not already declared */
-        /* variable already declared কিনা দেখে authoritative DECL type preserve করি। */
-        DataType existing = ctx_lookup_var_type(ctx, result->val.name);
-        if (existing == TYPE_UNKNOWN) {
-            /* আগে declaration না থাকলে এখন inferred type registry-তে যোগ করি। */
-            ctx_register_var(ctx, result->val.name, type);
-        }
-    }
+    ctx->narrow_integers = 0;
+    ctx->ranges = NULL;
+    ctx->regions = NULL;
+    ctx->func = NULL;
+    ctx->in_region = 0;
+    ctx->zone_count = 0;
+    ctx->zone_stack = NULL;
+    ctx->zone_depth = 0;
+    ctx->zone_capacity = 0;
 }
 
 static void ctx_free(IRCGCtx *ctx) {
     /* context output buffer lifecycle শেষ হলে heap memory মুক্ত করি। */
     free(ctx->buf);
+    free(ctx->zone_stack);
+    ir_region_free(ctx->regions);
 }
 
 static void ensure_cap(IRCGCtx *ctx, size_t n) {
@@ -342,10 +215,16 @@ static void emit_operand(IRCGCtx *ctx, TACOperand *op) {
             /* integer literal C long long suffix সহ emit। */
             emit(ctx, "%lldLL", op->val.int_val);
             break;
-        case OPERAND_FLOAT:
-            /* floating literal compact %g format-এ emit। */
-            emit(ctx, "%g", op->val.float_val);
+        case OPERAND_FLOAT: {
+            /* compact %g, তবে যত digit লাগে ততটা যাতে literal একই double-এ ফেরে। */
+            char text[32];
+            int precision = 6;
+            do {
+                snprintf(text, sizeof(text), "%.*g", precision, op->val.float_val);
+            } while (strtod(text, NULL) != op->val.float_val && ++precision <= 17);
+            emit(ctx, "%s", text);
             break;
+        }
         case OPERAND_STRING:
             /* string literal শুরুতে opening quote বসাই। */
             emit(ctx, "\"");
@@ -416,8 +295,100 @@ static const char *type_to_c(DataType dt) {
     }
 }
 
+/*
+ * C name of the runtime function behind a builtin (builtins.def), or NULL;
+ * a list builtin's depends on the element type the call works on
+ */
+static const char *builtin_runtime_name(const char *name, DataType list_elem) {
+#define BUILTIN(builtin, runtime, ret, elem, params) \
+    if (strcmp(name, builtin) == 0) return runtime;
+#define LIST_BUILTIN(builtin, phrase, num, dec, text, ret, params) \
+    if (strcmp(name, builtin) == 0) { \
+        const char *typed = list_elem == TYPE_DECIMAL ? dec : list_elem == TYPE_TEXT ? text : num; \
+        return typed ? typed : num; \
+    }
+#include "builtins.def"
+#undef LIST_BUILTIN
+#undef BUILTIN
+    return NULL;
+}
+
+/* C type of an operand; numbers get the narrowest type their range allows */
+static const char *operand_type_to_c(IRCGCtx *ctx, TACOperand *op) {
+    if (op->data_type != TYPE_NUMBER) return type_to_c(op->data_type);
+    switch (ir_range_width(ctx->ranges, op)) {
+        case 8:  return "int8_t";
+        case 16: return "int16_t";
+        case 32: return "int32_t";
+        default: return "long long";
+    }
+}
+
+/* Runtime element type constant of a list of dt */
+static const char *list_type_to_c(DataType dt) {
+    switch (dt) {
+        case TYPE_DECIMAL: return "NL_LIST_DECIMAL";
+        case TYPE_TEXT:    return "NL_LIST_TEXT";
+        case TYPE_FLAG:    return "NL_LIST_FLAG";
+        default:           return "NL_LIST_NUMBER";
+    }
+}
+
+/* Suffix of the typed nl_list_* accessor for a value of type dt */
+static const char *list_accessor_suffix(DataType dt) {
+    switch (dt) {
+        case TYPE_DECIMAL: return "dec";
+        case TYPE_TEXT:    return "str";
+        case TYPE_FLAG:    return "flag";
+        default:           return "num";
+    }
+}
+
+/* C type of a string builder temp (compared by address) */
+static const char strbuf_c_type[] = "NLStrBuf";
+
+/* Whether `op` is the string builder slot of instruction `i` */
+static int is_strbuf_operand(const TACInstr *i, const TACOperand *op) {
+    if (i->opcode == TAC_STRBUF_BEGIN) return op == &i->result;
+    if (i->opcode == TAC_STRBUF_APPEND || i->opcode == TAC_STRBUF_END ||
+        i->opcode == TAC_STRBUF_TEXT) return op == &i->arg1;
+    return 0;
+}
+
+static int is_narrow(IRCGCtx *ctx, TACOperand *op) {
+    return op->data_type == TYPE_NUMBER && ir_range_width(ctx->ranges, op) < 64;
+}
+
+/* Operand passed to a function, returned or handed to the runtime: narrow numbers are widened back */
+static void emit_widened(IRCGCtx *ctx, TACOperand *op) {
+    if (is_narrow(ctx, op)) emit(ctx, "(long long)");
+    emit_operand(ctx, op);
+}
+
+/* Whether an arithmetic instruction must be computed in 64 bits */
+static int arith_is_wide(IRCGCtx *ctx, TACInstr *instr) {
+    /* INT_MIN % -1 traps in int although the result (0) fits */
+    return !is_narrow(ctx, &instr->result) || instr->opcode == TAC_MOD;
+}
+
+/*
+ * Arithmetic operand. A 64-bit result widens narrow operands first so the
+ * operation cannot overflow in int; a narrow result is proven to fit, so
+ * its literals drop the LL suffix and the whole expression stays 32-bit.
+ */
+static void emit_arith_operand(IRCGCtx *ctx, TACOperand *op, int wide) {
+    if (wide) {
+        emit_widened(ctx, op);
+    } else if (op->kind == OPERAND_INT &&
+               op->val.int_val >= -2147483647LL && op->val.int_val <= 2147483647LL) {
+        emit(ctx, "%lld", op->val.int_val);
+    } else {
+        emit_operand(ctx, op);
+    }
+}
+
 /* ============================================================================
- * FIRST PASS: scan IR for features used (input, math, lists)
+ * FIRST PASS: scan IR for features used (math, lists)
  * ============================================================================
  */
 static void scan_features(IRCGCtx *ctx, TACFunction *func) {
@@ -427,16 +398,12 @@ static void scan_features(IRCGCtx *ctx, TACFunction *func) {
         if (i->is_dead) continue;
         /* opcode দেখে কোন runtime সহায়তা দরকার তা flag করি। */
         switch (i->opcode) {
-            case TAC_ASK: case TAC_READ:
-                /* input-reading instruction থাকলে shared input buffer প্রয়োজন। */
-                ctx->needs_input_buffer = 1;
-                break;
             case TAC_POW:
                 /* pow ব্যবহার হলে generated C-তে math header/function লাগবে। */
                 ctx->needs_math = 1;
                 break;
             case TAC_LIST_CREATE: case TAC_LIST_APPEND:
-            case TAC_LIST_GET: case TAC_LIST_SET:
+            case TAC_LIST_GET: case TAC_LIST_SET: case TAC_LIST_ITEM:
                 /* list op পাওয়া গেলে list runtime support include করতে হবে। */
                 ctx->needs_list = 1;
                 break;
@@ -465,6 +432,7 @@ static void emit_headers(IRCGCtx *ctx) {
     emit_line(ctx, "#include <stdlib.h>");
     emit_line(ctx, "#include <string.h>");
     emit_line(ctx, "#include <stdbool.h>");
+    emit_line(ctx, "#include <stdint.h>");
     /* pow() দরকার হলে তবেই math.h include করি (feature-driven include)। */
     if (ctx->needs_math) {
         emit_line(ctx, "#include <math.h>");
@@ -472,12 +440,6 @@ static void emit_headers(IRCGCtx *ctx) {
     /* runtime helper API header সবসময় include। */
     emit_line(ctx, "#include \"naturelang_runtime.h\"");
     emit(ctx, "\n");
-
-    /* input opcode থাকলে shared input buffer declaration emit। */
-    if (ctx->needs_input_buffer) {
-        emit_line(ctx, "static char _nl_input_buffer[4096];");
-        emit(ctx, "\n");
-    }
 }
 
 /* ============================================================================
@@ -487,72 +449,32 @@ static void emit_headers(IRCGCtx *ctx) {
  * ============================================================================
  */
 static void emit_temp_declarations(IRCGCtx *ctx, TACFunction *func) {
-    /* First: do a pre-pass to compute types for all temps and vars */
-    /* pass-1: opcode semantics দেখে result type table populate করি। */
+    /* Collect all temp IDs used and their types */
+    /* আগে সর্বোচ্চ temp id খুঁজি, যেন dedup mark array-এর size জানা যায়। */
+    int max_tid = -1;
+    int slots = 0;
     for (TACInstr *i = func->first; i; i = i->next) {
-        /* dead instruction declaration analysis-এ ধরা হয় না। */
         if (i->is_dead) continue;
-        /* instruction class অনুযায়ী result type infer/record। */
-        switch (i->opcode) {
-            case TAC_LOAD_INT:
-                /* integer load → number temp/var type। */
-                record_result_type(ctx, &i->result, TYPE_NUMBER);
-                break;
-            case TAC_LOAD_FLOAT:
-                /* float load → decimal type। */
-                record_result_type(ctx, &i->result, TYPE_DECIMAL);
-                break;
-            case TAC_LOAD_STRING:
-                /* string load → text type। */
-                record_result_type(ctx, &i->result, TYPE_TEXT);
-                break;
-            case TAC_LOAD_BOOL:
-                /* bool load → flag type। */
-                record_result_type(ctx, &i->result, TYPE_FLAG);
-                break;
-            case TAC_DECL:
-                /* explicit declaration পাওয়া গেলে variable table authoritative update। */
-                if (i->result.kind == OPERAND_VAR && i->result.val.name)
-                    ctx_register_var(ctx, i->result.val.name, i->result.data_type);
-                break;
-            case TAC_CONCAT:
-                /* concat result সবসময় text। */
-                record_result_type(ctx, &i->result, TYPE_TEXT);
-                break;
-            case TAC_ASK: case TAC_READ:
-                /* ask/read এর result runtime string input → text। */
-                record_result_type(ctx, &i->result, TYPE_TEXT);
-                break;
-            case TAC_EQ: case TAC_NEQ: case TAC_LT: case TAC_GT:
-            case TAC_LTE: case TAC_GTE: case TAC_AND: case TAC_OR:
-            case TAC_NOT: case TAC_BETWEEN:
-                /* comparison/logical পরিবার → boolean flag result। */
-                record_result_type(ctx, &i->result, TYPE_FLAG);
-                break;
-            default:
-                /* এই pass-এ unhandled opcode থেকে type update করি না। */
-                break;
+        TACOperand *ops[] = { &i->result, &i->arg1, &i->arg2, &i->arg3 };
+        for (int j = 0; j < 4; j++) {
+            if (ops[j]->kind == OPERAND_TEMP && ops[j]->val.temp_id >= 0) {
+                if (ops[j]->val.temp_id > max_tid) max_tid = ops[j]->val.temp_id;
+                slots++;
+            }
         }
     }
-    /* Second pass: also propagate via assigns */
-    /* pass-2: assignment chain ধরে source type result-এ propagate করি। */
-    for (TACInstr *i = func->first; i; i = i->next) {
-        if (i->is_dead) continue;
-        if (i->opcode == TAC_ASSIGN) {
-            /* arg1-এর effective type resolve করি। */
-            DataType src = resolve_type(ctx, &i->arg1);
-            /* source type জানা থাকলে result operand-এ record। */
-            if (src != TYPE_UNKNOWN)
-                record_result_type(ctx, &i->result, src);
-        }
+    if (max_tid < 0) return;
+
+    /* temp id দিয়ে index করা mark array: dedup O(1), temp সংখ্যার কোনো সীমা নেই। */
+    unsigned char *marked = calloc((size_t)max_tid + 1, 1);
+    int *seen = malloc(sizeof(int) * (size_t)slots);
+    DataType *types = malloc(sizeof(DataType) * (size_t)slots);
+    const char **ctypes = malloc(sizeof(char *) * (size_t)slots);
+    if (!marked || !seen || !types || !ctypes) {
+        fprintf(stderr, "Fatal: Memory allocation failed\n");
+        exit(1);
     }
-
-    /* Collect all temp IDs used and their resolved types */
-    /* local scratch array: unique temp id ও তাদের chosen type জমাতে। */
-    #define MAX_TEMPS 4096
-    int seen[MAX_TEMPS];
-    DataType types[MAX_TEMPS];
-    /* কতগুলো unique temp পাওয়া গেছে। */
+    /* কতগুলো unique temp পাওয়া গেছে। */
     int count = 0;
 
     /* instruction scan করে result/arg1/arg2/arg3 সব operand থেকে temp collect। */
@@ -561,130 +483,135 @@ static void emit_temp_declarations(IRCGCtx *ctx, TACFunction *func) {
         TACOperand *ops[] = { &i->result, &i->arg1, &i->arg2, &i->arg3 };
         /* ৪টি operand slot একে একে পরীক্ষা। */
         for (int j = 0; j < 4; j++) {
-            if (ops[j]->kind == OPERAND_TEMP) {
+            if (ops[j]->kind == OPERAND_TEMP && ops[j]->val.temp_id >= 0) {
                 int tid = ops[j]->val.temp_id;
-                /* tid আগে collect হয়েছে কিনা দেখি (dedup)। */
-                int found = 0;
-                for (int k = 0; k < count; k++) {
-                    if (seen[k] == tid) { found = 1; break; }
-                }
-                if (!found && count < MAX_TEMPS) {
-                    /* নতুন temp id তালিকায় যোগ করি। */
-                    seen[count] = tid;
-                    /* Use resolved type from context */
-                    /* context table-এ type থাকলে সেটি priority পায়। */
-                    if (tid >= 0 && tid < MAX_TEMP_TYPES && ctx->temp_types[tid] != TYPE_UNKNOWN) {
-                        types[count] = ctx->temp_types[tid];
-                    } else {
-                        /* নাহলে operand metadata fallback type ব্যবহার। */
-                        types[count] = ops[j]->data_type;
-                    }
-                    /* unique temp count বাড়াই। */
-                    count++;
-                }
+                /* tid আগে collect হয়ে থাকলে skip (dedup)। */
+                if (marked[tid]) continue;
+                marked[tid] = 1;
+                /* নতুন temp id তালিকায় যোগ করি। */
+                seen[count] = tid;
+                /* IR generator semantic phase-এর resolved type operand-এই বসিয়ে দেয়। */
+                types[count] = ops[j]->data_type;
+                ctypes[count] = is_strbuf_operand(i, ops[j])
+                    ? strbuf_c_type : operand_type_to_c(ctx, ops[j]);
+                /* unique temp count বাড়াই। */
+                count++;
             }
         }
     }
 
-    /* unique temp পাওয়া গেলে function top-এ declaration emit করি। */
+    /* unique temp পাওয়া গেলে function top-এ declaration emit করি। */
     if (count > 0) {
         /* option enable থাকলে declaration section comment emit। */
         if (ctx->emit_comments) {
             emit_indent(ctx);
             emit(ctx, "/* temporaries */\n");
         }
-        /* প্রতিটি temp-এর জন্য inferred type অনুযায়ী declaration emit। */
+        /* প্রতিটি temp-এর জন্য তার type অনুযায়ী declaration emit। */
         for (int i = 0; i < count; i++) {
             emit_indent(ctx);
             DataType dt = types[i];
-            if (dt == TYPE_TEXT) {
-                /* text temp pointer হওয়ায় NULL init করা নিরাপদ। */
+            if (ctypes[i] == strbuf_c_type) {
+                /* string builder: STRBUF_BEGIN-এ nl_strbuf_init হয়। */
+                emit(ctx, "NLStrBuf _t%d;\n", seen[i]);
+            } else if (dt == TYPE_TEXT) {
+                /* text temp pointer হওয়ায় NULL init করা নিরাপদ। */
                 emit(ctx, "char* _t%d = NULL;\n", seen[i]);
             } else {
                 /* numeric/flag/list ইত্যাদি type default 0 init। */
-                emit(ctx, "%s _t%d = 0;\n", type_to_c(dt), seen[i]);
+                emit(ctx, "%s _t%d = 0;\n", ctypes[i], seen[i]);
             }
         }
         /* declaration block শেষে একটি ফাঁকা লাইন। */
         emit(ctx, "\n");
     }
-    /* local helper macro scope close। */
-    #undef MAX_TEMPS
+    free(marked);
+    free(seen);
+    free(types);
+    free(ctypes);
 }
 
 /* ============================================================================
- * EMIT A PRINTF FOR A DISPLAY INSTRUCTION
+ * EMIT A STRING BUILDER APPEND
  *
- * Determine the type from the operand and use the appropriate format.
+ * `builder` is the C name of an NLStrBuf; the value is formatted the way
+ * display would print it.
+ * ============================================================================
+ */
+static void emit_strbuf_append(IRCGCtx *ctx, const char *builder, TACOperand *val) {
+    const char *suffix;
+    switch (val->data_type) {
+        case TYPE_NUMBER:  suffix = "num"; break;
+        case TYPE_DECIMAL: suffix = "dec"; break;
+        case TYPE_FLAG:    suffix = "flag"; break;
+        default:           suffix = "str"; break;
+    }
+    emit_indent(ctx);
+    emit(ctx, "nl_strbuf_append_%s(&%s, ", suffix, builder);
+    emit_widened(ctx, val);
+    emit(ctx, ");\n");
+}
+
+/* ============================================================================
+ * EMIT A DISPLAY INSTRUCTION
+ *
+ * Each type has its own runtime output routine (nl_display_num, ...), which
+ * appends to the runtime's output buffer without going through printf.
  * ============================================================================
  */
 static void emit_display(IRCGCtx *ctx, TACOperand *val) {
-    /* operand-এর effective data type context/type-table দেখে resolve করি। */
-    DataType effective_type = resolve_type(ctx, val);
     /* display statement line শুরুতে current block indentation বসাই। */
     emit_indent(ctx);
-    /* resolved type অনুযায়ী সঠিক printf format/selective rendering বেছে নিই। */
-    switch (effective_type) {
-        case TYPE_NUMBER:
-            /* integer/number type হলে long long হিসেবে print করি। */
-            emit(ctx, "printf(\"%%lld\\n\", (long long)");
-            /* value operand-কে C expression হিসেবে emit করি। */
-            emit_operand(ctx, val);
-            /* printf call close করে statement terminate। */
-            emit(ctx, ");\n");
-            break;
+    /* resolved type অনুযায়ী type-specific runtime output routine বেছে নিই। */
+    switch (val->data_type) {
         case TYPE_DECIMAL:
-            /* decimal/floating type হলে %g format ব্যবহার করি। */
-            emit(ctx, "printf(\"%%g\\n\", (double)");
-            /* operand expression inline বসাই। */
+            emit(ctx, "nl_display_dec((double)");
             emit_operand(ctx, val);
-            /* generated C line শেষ করি। */
-            emit(ctx, ");\n");
             break;
         case TYPE_TEXT:
-            /* text/string value হলে %s formatter দিয়ে print। */
-            emit(ctx, "printf(\"%%s\\n\", ");
-            /* string operand emit করি (escaped literal/variable/temp)। */
+            emit(ctx, "nl_display(");
             emit_operand(ctx, val);
-            /* printf statement complete। */
-            emit(ctx, ");\n");
             break;
         case TYPE_FLAG:
-            /* boolean/flag type human-readable yes/no হিসেবে দেখাই। */
-            emit(ctx, "printf(\"%%s\\n\", ");
-            /* condition অংশে boolean operand বসাই। */
+            /* flag runtime-এ yes/no হিসেবে দেখানো হয়। */
+            emit(ctx, "nl_display_bool(");
             emit_operand(ctx, val);
-            /* ternary দিয়ে true->yes, false->no map করে line শেষ। */
-            emit(ctx, " ? \"yes\" : \"no\");\n");
             break;
+        case TYPE_NUMBER:
         default:
-            /* Generic: try as number */
-            /* fallback path: unknown type হলে number cast ধরে print করার চেষ্টা। */
-            emit(ctx, "printf(\"%%lld\\n\", (long long)");
-            /* unknown operandও generic expression হিসেবে emit। */
+            /* number, এবং unknown type হলে number ধরে নিই। */
+            emit(ctx, "nl_display_num((long long)");
             emit_operand(ctx, val);
-            /* fallback printf statement terminate। */
-            emit(ctx, ");\n");
             break;
     }
+    emit(ctx, ");\n");
 }
 
-/* Determine the target type for input-producing instructions (ASK/READ).
- * Prefer declared variable type when available; otherwise fall back to resolved operand type. */
-static DataType input_target_type(IRCGCtx *ctx, TACOperand *target) {
-    if (target && target->kind == OPERAND_VAR && target->val.name) {
-        DataType declared = ctx_lookup_var_type(ctx, target->val.name);
-        if (declared != TYPE_UNKNOWN) {
-            return declared;
-        }
-    }
-
-    if (!target) {
-        return TYPE_TEXT;
+/* ============================================================================
+ * EMIT AN INPUT READ
+ *
+ * The runtime's input layer parses the next stdin line as the target's
+ * type (reporting malformed input) and copies it only for text.
+ * ============================================================================
+ */
+static void emit_read_value(IRCGCtx *ctx, TACOperand *result) {
+    emit_indent(ctx);
+    emit_operand(ctx, result);
+    switch (result->data_type) {
+        case TYPE_NUMBER:
+            emit(ctx, " = nl_read_num();\n");
+            break;
+        case TYPE_DECIMAL:
+            emit(ctx, " = nl_read_dec();\n");
+            break;
+        case TYPE_FLAG:
+            emit(ctx, " = nl_read_flag();\n");
+            break;
+        case TYPE_TEXT:
+        default:
+            emit(ctx, " = nl_read_text();\n");
+            break;
     }
-
-    DataType t = resolve_type(ctx, target);
-    return (t == TYPE_UNKNOWN) ? TYPE_TEXT : t;
 }
 
 /* ============================================================================
@@ -696,70 +623,6 @@ static void emit_instruction(IRCGCtx *ctx, TACInstr *instr) {
     /* null pointer বা optimizer-marked dead instruction হলে code emit করব না। */
     if (!instr || instr->is_dead) return;
 
-    /* Record type information for result operands */
-    /* opcode অনুযায়ী result operand-এর inferred type আগেই context table-এ record করি। */
-    switch (instr->opcode) {
-        case TAC_LOAD_INT:
-            /* integer load result -> number type। */
-            record_result_type(ctx, &instr->result, TYPE_NUMBER);
-            break;
-        case TAC_LOAD_FLOAT:
-            /* float load result -> decimal type। */
-            record_result_type(ctx, &instr->result, TYPE_DECIMAL);
-            break;
-        case TAC_LOAD_STRING:
-            /* string load result -> text type। */
-            record_result_type(ctx, &instr->result, TYPE_TEXT);
-            break;
-        case TAC_LOAD_BOOL:
-            /* bool load result -> flag type। */
-            record_result_type(ctx, &instr->result, TYPE_FLAG);
-            break;
-        case TAC_DECL:
-            /* declaration instruction পেলে variable type table authoritative ভাবে update। */
-            if (instr->result.kind == OPERAND_VAR && instr->result.val.name) {
-                ctx_register_var(ctx, instr->result.val.name, instr->result.data_type);
-            }
-            break;
-        case TAC_ASSIGN: {
-            /* assignment source operand থেকে effective type resolve করি। */
-            DataType src_type = resolve_type(ctx, &instr->arg1);
-            /* source type জানা থাকলে assignment result-এ propagate করি। */
-            if (src_type != TYPE_UNKNOWN)
-                record_result_type(ctx, &instr->result, src_type);
-            break;
-        }
-        case TAC_CONCAT:
-            /* concat operation সবসময় text produce করে। */
-            record_result_type(ctx, &instr->result, TYPE_TEXT);
-            break;
-        case TAC_ASK: case TAC_READ:
-            /* input target type declaration অনুযায়ী ধরে রাখি (number/decimal/text/flag)। */
-            record_result_type(ctx, &instr->result,
-                               input_target_type(ctx, &instr->result));
-            break;
-        case TAC_EQ: case TAC_NEQ: case TAC_LT: case TAC_GT:
-        case TAC_LTE: case TAC_GTE: case TAC_AND: case TAC_OR:
-        case TAC_NOT: case TAC_BETWEEN:
-            /* comparison/logical পরিবার boolean flag return করে। */
-            record_result_type(ctx, &instr->result, TYPE_FLAG);
-            break;
-        case TAC_ADD: case TAC_SUB: case TAC_MUL: case TAC_DIV:
-        case TAC_MOD: case TAC_NEG: case TAC_POW: {
-            /* arithmetic result type: যেকোন operand decimal হলে decimal, নাহলে number। */
-            DataType lt = resolve_type(ctx, &instr->arg1);
-            DataType rt = resolve_type(ctx, &instr->arg2);
-            DataType res = (lt == TYPE_DECIMAL || rt == TYPE_DECIMAL)
-                           ? TYPE_DECIMAL : TYPE_NUMBER;
-            record_result_type(ctx, &instr->result, res);
-            break;
-        }
-        default:
-            /* অন্য opcode এই pre-record pass-এ type update করে না। */
-            break;
-    }
-
-    /* দ্বিতীয় switch-এ actual TAC -> C statement emission করা হয়। */
     switch (instr->opcode) {
 
         /* ---- Labels ---- */
@@ -828,9 +691,9 @@ static void emit_instruction(IRCGCtx *ctx, TACInstr *instr) {
             emit_indent(ctx);
             emit_operand(ctx, &instr->result);
             emit(ctx, " = ");
-            emit_operand(ctx, &instr->arg1);
+            emit_arith_operand(ctx, &instr->arg1, arith_is_wide(ctx, instr));
             emit(ctx, " + ");
-            emit_operand(ctx, &instr->arg2);
+            emit_arith_operand(ctx, &instr->arg2, arith_is_wide(ctx, instr));
             emit(ctx, ";\n");
             break;
 
@@ -839,9 +702,9 @@ static void emit_instruction(IRCGCtx *ctx, TACInstr *instr) {
             emit_indent(ctx);
             emit_operand(ctx, &instr->result);
             emit(ctx, " = ");
-            emit_operand(ctx, &instr->arg1);
+            emit_arith_operand(ctx, &instr->arg1, arith_is_wide(ctx, instr));
             emit(ctx, " - ");
-            emit_operand(ctx, &instr->arg2);
+            emit_arith_operand(ctx, &instr->arg2, arith_is_wide(ctx, instr));
             emit(ctx, ";\n");
             break;
 
@@ -850,9 +713,9 @@ static void emit_instruction(IRCGCtx *ctx, TACInstr *instr) {
             emit_indent(ctx);
             emit_operand(ctx, &instr->result);
             emit(ctx, " = ");
-            emit_operand(ctx, &instr->arg1);
+            emit_arith_operand(ctx, &instr->arg1, arith_is_wide(ctx, instr));
             emit(ctx, " * ");
-            emit_operand(ctx, &instr->arg2);
+            emit_arith_operand(ctx, &instr->arg2, arith_is_wide(ctx, instr));
             emit(ctx, ";\n");
             break;
 
@@ -861,9 +724,9 @@ static void emit_instruction(IRCGCtx *ctx, TACInstr *instr) {
             emit_indent(ctx);
             emit_operand(ctx, &instr->result);
             emit(ctx, " = ");
-            emit_operand(ctx, &instr->arg1);
+            emit_arith_operand(ctx, &instr->arg1, arith_is_wide(ctx, instr));
             emit(ctx, " / ");
-            emit_operand(ctx, &instr->arg2);
+            emit_arith_operand(ctx, &instr->arg2, arith_is_wide(ctx, instr));
             emit(ctx, ";\n");
             break;
 
@@ -872,9 +735,9 @@ static void emit_instruction(IRCGCtx *ctx, TACInstr *instr) {
             emit_indent(ctx);
             emit_operand(ctx, &instr->result);
             emit(ctx, " = ");
-            emit_operand(ctx, &instr->arg1);
+            emit_arith_operand(ctx, &instr->arg1, arith_is_wide(ctx, instr));
             emit(ctx, " %% ");
-            emit_operand(ctx, &instr->arg2);
+            emit_arith_operand(ctx, &instr->arg2, arith_is_wide(ctx, instr));
             emit(ctx, ";\n");
             break;
 
@@ -896,7 +759,7 @@ static void emit_instruction(IRCGCtx *ctx, TACInstr *instr) {
             emit_indent(ctx);
             emit_operand(ctx, &instr->result);
             emit(ctx, " = -(");
-            emit_operand(ctx, &instr->arg1);
+            emit_arith_operand(ctx, &instr->arg1, arith_is_wide(ctx, instr));
             emit(ctx, ");\n");
             break;
 
@@ -959,14 +822,56 @@ static void emit_instruction(IRCGCtx *ctx, TACInstr *instr) {
 
         /* ---- Concat ---- */
         case TAC_CONCAT:
-            /* runtime helper nl_concat দিয়ে string concatenation emit। */
+            if (instr->arg1.data_type == TYPE_TEXT && instr->arg2.data_type == TYPE_TEXT) {
+                /* দুই দিকই text: runtime helper nl_concat দিয়ে সরাসরি concatenation। */
+                emit_indent(ctx);
+                emit_operand(ctx, &instr->result);
+                emit(ctx, " = nl_concat(");
+                emit_operand(ctx, &instr->arg1);
+                emit(ctx, ", ");
+                emit_operand(ctx, &instr->arg2);
+                emit(ctx, ");\n");
+                break;
+            }
+            /* number/decimal/flag অংশ থাকলে local builder-এ format করে জুড়ি। */
+            emit_line(ctx, "{");
+            ctx->indent++;
+            emit_line(ctx, "NLStrBuf _sb;");
+            emit_line(ctx, "nl_strbuf_init(&_sb);");
+            emit_strbuf_append(ctx, "_sb", &instr->arg1);
+            emit_strbuf_append(ctx, "_sb", &instr->arg2);
             emit_indent(ctx);
             emit_operand(ctx, &instr->result);
-            emit(ctx, " = nl_concat(");
-            emit_operand(ctx, &instr->arg1);
-            emit(ctx, ", ");
-            emit_operand(ctx, &instr->arg2);
-            emit(ctx, ");\n");
+            emit(ctx, " = nl_strbuf_finish(&_sb);\n");
+            ctx->indent--;
+            emit_line(ctx, "}");
+            break;
+
+        /* ---- String builder (fused concat chain) ---- */
+        case TAC_STRBUF_BEGIN:
+            emit_indent(ctx);
+            emit(ctx, "nl_strbuf_init(&_t%d);\n", instr->result.val.temp_id);
+            break;
+
+        case TAC_STRBUF_APPEND: {
+            char builder[32];
+            snprintf(builder, sizeof(builder), "_t%d", instr->arg1.val.temp_id);
+            emit_strbuf_append(ctx, builder, &instr->arg2);
+            break;
+        }
+
+        case TAC_STRBUF_END:
+            /* সব অংশ জোড়া শেষ: exact length-এর একটিমাত্র allocation। */
+            emit_indent(ctx);
+            emit_operand(ctx, &instr->result);
+            emit(ctx, " = nl_strbuf_finish(&_t%d);\n", instr->arg1.val.temp_id);
+            break;
+
+        case TAC_STRBUF_TEXT:
+            /* loop-এর ভেতরে accumulator পড়া: builder-এর এখন পর্যন্ত text-এর copy। */
+            emit_indent(ctx);
+            emit_operand(ctx, &instr->result);
+            emit(ctx, " = nl_strbuf_text(&_t%d);\n", instr->arg1.val.temp_id);
             break;
 
         /* ---- Between ---- */
@@ -989,7 +894,7 @@ static void emit_instruction(IRCGCtx *ctx, TACInstr *instr) {
         case TAC_DECL:
             /* declared datatype অনুযায়ী C variable declaration emit। */
             emit_indent(ctx);
-            emit(ctx, "%s ", type_to_c(instr->result.data_type));
+            emit(ctx, "%s ", operand_type_to_c(ctx, &instr->result));
             emit_operand(ctx, &instr->result);
             /* Default initialization */
             /* type-specific safe default init দিই যাতে uninitialized use না হয়। */
@@ -1013,61 +918,20 @@ static void emit_instruction(IRCGCtx *ctx, TACInstr *instr) {
             break;
 
         case TAC_ASK:
-            /* ask/read path-এ shared input buffer লাগবে, তাই feature flag set। */
-            ctx->needs_input_buffer = 1;
             /* Print prompt */
-            /* optional prompt থাকলে আগে সেটি print করে flush করি। */
+            /* optional prompt থাকলে আগে output buffer-এ দিই; runtime input পড়ার আগে flush করে। */
             if (instr->arg1.kind != OPERAND_NONE) {
                 emit_indent(ctx);
-                emit(ctx, "printf(\"%%s\", ");
+                emit(ctx, "nl_out_str(");
                 emit_operand(ctx, &instr->arg1);
-                emit(ctx, "); fflush(stdout);\n");
-            }
-            /* Read input */
-            /* stdin থেকে line নিয়ে newline trim করে strdup করে result-এ দিই। */
-            emit_indent(ctx);
-            emit(ctx, "fgets(_nl_input_buffer, sizeof(_nl_input_buffer), stdin); ");
-            emit(ctx, "_nl_input_buffer[strcspn(_nl_input_buffer, \"\\n\")] = 0; ");
-            emit_operand(ctx, &instr->result);
-            switch (input_target_type(ctx, &instr->result)) {
-                case TYPE_NUMBER:
-                    emit(ctx, " = nl_to_number(_nl_input_buffer);\n");
-                    break;
-                case TYPE_DECIMAL:
-                    emit(ctx, " = nl_to_decimal(_nl_input_buffer);\n");
-                    break;
-                case TYPE_FLAG:
-                    emit(ctx, " = nl_to_bool(_nl_input_buffer);\n");
-                    break;
-                case TYPE_TEXT:
-                default:
-                    emit(ctx, " = strdup(_nl_input_buffer);\n");
-                    break;
+                emit(ctx, ");\n");
             }
+            emit_read_value(ctx, &instr->result);
             break;
 
         case TAC_READ:
-            /* prompt ছাড়া raw read path, ask-এর read অংশের সমতুল্য। */
-            ctx->needs_input_buffer = 1;
-            emit_indent(ctx);
-            emit(ctx, "fgets(_nl_input_buffer, sizeof(_nl_input_buffer), stdin); ");
-            emit(ctx, "_nl_input_buffer[strcspn(_nl_input_buffer, \"\\n\")] = 0; ");
-            emit_operand(ctx, &instr->result);
-            switch (input_target_type(ctx, &instr->result)) {
-                case TYPE_NUMBER:
-                    emit(ctx, " = nl_to_number(_nl_input_buffer);\n");
-                    break;
-                case TYPE_DECIMAL:
-                    emit(ctx, " = nl_to_decimal(_nl_input_buffer);\n");
-                    break;
-                case TYPE_FLAG:
-                    emit(ctx, " = nl_to_bool(_nl_input_buffer);\n");
-                    break;
-                case TYPE_TEXT:
-                default:
-                    emit(ctx, " = strdup(_nl_input_buffer);\n");
-                    break;
-            }
+            /* prompt ছাড়া raw read path, ask-এর read অংশের সমতুল্য। */
+            emit_read_value(ctx, &instr->result);
             break;
 
         /* ---- Functions ---- */
@@ -1102,17 +966,9 @@ static void emit_instruction(IRCGCtx *ctx, TACInstr *instr) {
                 nargs = (int)instr->arg2.val.int_val;
             }
 
-            /* Check if function returns void (don't assign result) */
-            /* return type void হলে assignment target বাদ দিতে হবে। */
-            int is_void_call = 0;
-            if (instr->arg1.kind == OPERAND_FUNC && instr->arg1.val.name) {
-                DataType ret = ctx_lookup_func_ret(ctx, instr->arg1.val.name);
-                if (ret == TYPE_NOTHING) is_void_call = 1;
-            }
-
             emit_indent(ctx);
-            /* non-void call এবং valid result operand থাকলে "result =" prefix emit। */
-            if (instr->result.kind != OPERAND_NONE && !is_void_call) {
+            /* result operand থাকলে "result =" prefix emit; nothing-return call-এর result থাকে না। */
+            if (instr->result.kind != OPERAND_NONE) {
                 emit_operand(ctx, &instr->result);
                 emit(ctx, " = ");
             }
@@ -1124,6 +980,10 @@ static void emit_instruction(IRCGCtx *ctx, TACInstr *instr) {
                 strcmp(instr->arg1.val.name, "__list_length") == 0) {
                 /* Special: list length */
                 emit(ctx, "nl_list_length(");
+            } else if (instr->arg1.kind == OPERAND_FUNC && instr->arg1.val.name &&
+                       builtin_runtime_name(instr->arg1.val.name, instr->elem_type)) {
+                /* language builtin: runtime function সরাসরি call। */
+                emit(ctx, "%s(", builtin_runtime_name(instr->arg1.val.name, instr->elem_type));
             } else {
                 /* generic function symbol emit করে call paren খুলি। */
                 emit_operand(ctx, &instr->arg1);
@@ -1149,7 +1009,7 @@ static void emit_instruction(IRCGCtx *ctx, TACInstr *instr) {
                 /* backward collect হওয়ায় reverse iterate করে original order restore করি। */
                 for (int i = found - 1; i >= 0; i--) {
                     if (i < found - 1) emit(ctx, ", ");
-                    emit_operand(ctx, &params[i]->arg1);
+                    emit_widened(ctx, &params[i]->arg1);
                 }
             }
 
@@ -1159,11 +1019,13 @@ static void emit_instruction(IRCGCtx *ctx, TACInstr *instr) {
         }
 
         case TAC_RETURN:
+            /* function নিজের region-এ চললে return-এর আগে region ছেড়ে দিই। */
+            if (ctx->in_region) emit_line(ctx, "nl_region_leave(_nl_region);");
             /* return operand থাকলে return value সহ, নাহলে bare return emit। */
             emit_indent(ctx);
             if (instr->arg1.kind != OPERAND_NONE) {
                 emit(ctx, "return ");
-                emit_operand(ctx, &instr->arg1);
+                emit_widened(ctx, &instr->arg1);
                 emit(ctx, ";\n");
             } else {
                 emit(ctx, "return;\n");
@@ -1185,15 +1047,36 @@ static void emit_instruction(IRCGCtx *ctx, TACInstr *instr) {
             emit(ctx, "}\n");
             break;
 
-        case TAC_SECURE_BEGIN:
-            /* secure zone markers শুধুই optional comments হিসেবে emit। */
+        case TAC_SECURE_BEGIN: {
+            /* secure zone markers optional comments হিসেবে emit। */
             if (ctx->emit_comments) {
                 emit_indent(ctx);
                 emit(ctx, "/* BEGIN SECURE ZONE */\n");
             }
+            /* zone-এর allocation বাইরে না গেলে zone নিজের region-এ চলে। */
+            int zone = -1;
+            if (ctx->regions && ir_region_zone(ctx->regions, ctx->func, instr)) {
+                zone = ctx->zone_count++;
+                emit_line(ctx, "NLRegionMark _nl_zone%d = nl_region_enter();", zone);
+            }
+            if (ctx->zone_depth == ctx->zone_capacity) {
+                ctx->zone_capacity = ctx->zone_capacity ? ctx->zone_capacity * 2 : 8;
+                ctx->zone_stack = realloc(ctx->zone_stack, sizeof(int) * (size_t)ctx->zone_capacity);
+                if (!ctx->zone_stack) {
+                    fprintf(stderr, "Fatal: Memory allocation failed\n");
+                    exit(1);
+                }
+            }
+            ctx->zone_stack[ctx->zone_depth++] = zone;
             break;
+        }
 
         case TAC_SECURE_END:
+            /* matching BEGIN region খুলে থাকলে zone শেষে তা ছেড়ে দিই। */
+            if (ctx->zone_depth > 0) {
+                int zone = ctx->zone_stack[--ctx->zone_depth];
+                if (zone >= 0) emit_line(ctx, "nl_region_leave(_nl_zone%d);", zone);
+            }
             /* secure zone end marker-ও optional comment। */
             if (ctx->emit_comments) {
                 emit_indent(ctx);
@@ -1207,41 +1090,79 @@ static void emit_instruction(IRCGCtx *ctx, TACInstr *instr) {
             ctx->needs_list = 1;
             emit_indent(ctx);
             emit_operand(ctx, &instr->result);
-            emit(ctx, " = nl_list_create(");
-            emit_operand(ctx, &instr->arg1);
-            emit(ctx, ");\n");
+            if (instr->elem_type == TYPE_UNKNOWN) {
+                /* element type অজানা: untyped list, প্রথম append type ঠিক করবে। */
+                emit(ctx, " = nl_list_new();\n");
+            } else {
+                /* element type অনুযায়ী contiguous typed storage, count = capacity hint। */
+                emit(ctx, " = nl_list_new_typed(%s, ", list_type_to_c(instr->elem_type));
+                emit_operand(ctx, &instr->arg1);
+                emit(ctx, ");\n");
+            }
             break;
 
         case TAC_LIST_APPEND:
-            /* list append helper call emit। */
+            /* value-এর নিজের type-এর typed append; runtime list-এর type-এ convert করে। */
             emit_indent(ctx);
-            emit(ctx, "nl_list_append(");
+            emit(ctx, "nl_list_append_%s(", list_accessor_suffix(instr->arg1.data_type));
             emit_operand(ctx, &instr->result);
             emit(ctx, ", ");
-            emit_operand(ctx, &instr->arg1);
+            emit_widened(ctx, &instr->arg1);
             emit(ctx, ");\n");
             break;
 
         case TAC_LIST_GET:
-            /* list index access number-get helper দিয়ে emit। */
+            /* result-এর element type অনুযায়ী typed get helper বেছে নিই। */
             emit_indent(ctx);
             emit_operand(ctx, &instr->result);
-            emit(ctx, " = nl_list_get_num(");
+            emit(ctx, " = nl_list_get_%s(", list_accessor_suffix(instr->result.data_type));
             emit_operand(ctx, &instr->arg1);
             emit(ctx, ", ");
-            emit_operand(ctx, &instr->arg2);
+            emit_widened(ctx, &instr->arg2);
             emit(ctx, ");\n");
             break;
 
+        case TAC_LIST_ITEM: {
+            /*
+             * for-each element: index আগেই range-এ যাচাই করা, তাই typed list হলে
+             * array সরাসরি index করি। list-এর runtime type ঘোষিত type থেকে আলাদা
+             * হতে পারে (untyped list assign হলে), তাই item_type check রাখি।
+             */
+            const char *field = NULL;
+            switch (instr->elem_type) {
+                case TYPE_NUMBER:  field = "nums"; break;
+                case TYPE_DECIMAL: field = "decs"; break;
+                case TYPE_TEXT:    field = "strs"; break;
+                default:           break;
+            }
+            emit_indent(ctx);
+            emit_operand(ctx, &instr->result);
+            emit(ctx, " = ");
+            if (field && instr->result.data_type == instr->elem_type) {
+                emit_operand(ctx, &instr->arg1);
+                emit(ctx, "->item_type == %s ? ", list_type_to_c(instr->elem_type));
+                emit_operand(ctx, &instr->arg1);
+                emit(ctx, "->%s[", field);
+                emit_operand(ctx, &instr->arg2);
+                emit(ctx, "] : ");
+            }
+            emit(ctx, "nl_list_get_%s(", list_accessor_suffix(instr->result.data_type));
+            emit_operand(ctx, &instr->arg1);
+            emit(ctx, ", ");
+            emit_widened(ctx, &instr->arg2);
+            emit(ctx, ");\n");
+            break;
+        }
+
         case TAC_LIST_SET:
-            /* list set helper-এ list, index, value তিনটি argument পাঠাই। */
+            /* list, index, value; value-এর type অনুযায়ী typed set helper। */
             emit_indent(ctx);
-            emit(ctx, "nl_list_set(");
+            emit(ctx, "nl_list_set_%s(", list_accessor_suffix(instr->arg2.data_type));
             emit_operand(ctx, &instr->result);
             emit(ctx, ", ");
-            emit_operand(ctx, &instr->arg1);
+            emit_widened(ctx, &instr->arg1);
             emit(ctx, ", ");
-            emit_operand(ctx, &instr->arg2);
+            emit_widened(ctx, &instr->arg2);
             emit(ctx, ");\n");
             break;
 
@@ -1307,17 +1228,32 @@ static void emit_function(IRCGCtx *ctx, TACFunction *func) {
 
     /* Declare temporaries */
     /* function instructions-এ ব্যবহৃত temporaries top-এ declare করি। */
+    if (ctx->narrow_integers) ctx->ranges = ir_range_analyze(func);
     emit_temp_declarations(ctx, func);
 
+    /* কোনো allocation call-এর পরে বাঁচে না: পুরো activation একটি region। */
+    ctx->func = func;
+    ctx->zone_count = 0;
+    ctx->in_region = ctx->regions && ir_region_function(ctx->regions, func);
+    if (ctx->in_region) emit_line(ctx, "NLRegionMark _nl_region = nl_region_enter();");
+
     /* Emit instructions (skip FUNC_BEGIN/FUNC_END) */
     /* linear TAC list iterate করে প্রতিটি instruction emit_instruction-এ পাঠাই। */
+    TACOpcode last_op = TAC_NOP;
     for (TACInstr *instr = func->first; instr; instr = instr->next) {
         /* function boundary marker TAC এখানে skip করা হয়। */
         if (instr->opcode == TAC_FUNC_BEGIN || instr->opcode == TAC_FUNC_END)
             continue;
         /* বাকি সব TAC instruction-কে target C statements-এ নামাই। */
         emit_instruction(ctx, instr);
+        if (!instr->is_dead) last_op = instr->opcode;
     }
+    ir_range_free(ctx->ranges);
+    ctx->ranges = NULL;
+
+    /* শেষ পর্যন্ত পৌঁছালে (return ছাড়া) region এখানে ছাড়ি। */
+    if (ctx->in_region && last_op != TAC_RETURN) emit_line(ctx, "nl_region_leave(_nl_region);");
+    ctx->in_region = 0;
 
     /* function body শেষ: indentation কমিয়ে closing brace emit। */
     ctx->indent--;
@@ -1408,13 +1344,18 @@ static void emit_main_func(IRCGCtx *ctx, TACFunction *main_func) {
 
     /* Declare temporaries */
     /* main TAC block-এ দরকারি temporaries function top-এ declare করি। */
+    if (ctx->narrow_integers) ctx->ranges = ir_range_analyze(main_func);
     emit_temp_declarations(ctx, main_func);
+    ctx->func = main_func;
+    ctx->zone_count = 0;
 
     /* Emit instructions */
     /* main function-এর TAC instruction list sequentially C code-এ নামাই। */
     for (TACInstr *instr = main_func->first; instr; instr = instr->next) {
         emit_instruction(ctx, instr);
     }
+    ir_range_free(ctx->ranges);
+    ctx->ranges = NULL;
 
     /* return এর আগে visual separation রাখি। */
     emit(ctx, "\n");
@@ -1442,6 +1383,10 @@ IRCodegenOptions ir_codegen_default_options(void) {
         .emit_debug_info = 0,
         /* indentation width default 4 spaces। */
         .indent_size = 4,
+        /* provably small number-কে int32_t/int16_t/int8_t হিসেবে declare। */
+        .narrow_integers = 1,
+        /* allocation বাইরে না যাওয়া function ও secure zone region-এ চালাই। */
+        .release_regions = 1,
     };
     /* caller-এর জন্য ready-to-use default options ফেরত দিই। */
     return opts;
@@ -1470,18 +1415,16 @@ IRCodegenResult ir_codegen_generate(TACProgram *program, IRCodegenOptions *opts)
     ctx_init(&ctx, options.indent_size);
     /* option থেকে comment emission behavior context-এ propagate। */
     ctx.emit_comments = options.emit_comments;
+    ctx.narrow_integers = options.narrow_integers;
+    if (options.release_regions) ctx.regions = ir_region_analyze(program);
 
-    /* Pass 1: scan all functions for features and register return types */
+    /* Pass 1: scan all functions for features */
     /* main function scan করে input/math/list feature flags নির্ধারণ। */
     scan_features(&ctx, program->main_func);
-    /* user functions iterate করে feature scan + return type registry পূরণ। */
+    /* user functions iterate করে feature scan। */
     TACFunction *f = program->functions;
     while (f) {
         scan_features(&ctx, f);
-        if (f->name) {
-            /* function নাম থাকলে return type lookup-table-এ register করি। */
-            ctx_register_func(&ctx, f->name, f->return_type);
-        }
         /* next function node-এ অগ্রসর হই। */
         f = f->next;
     }
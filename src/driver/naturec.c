@@ -3,7 +3,10 @@
  * Copyright (c) 2026
  *
  * End-to-end compiler driver:
- *   .nl source → Lex → Parse → AST → IR → Optimize → Codegen → .c file
+ *   .nl source → Lex → Parse → AST → Semantic → IR → Optimize → Codegen → .c file
+ *
+ * With --stream, Parse, Semantic and IR run fused: each top-level statement
+ * is checked and lowered as soon as it is parsed, and its AST is reused.
  *
  * Commands:
  *   naturec build <file.nl>    Compile to C (and optionally to binary)
@@ -21,13 +24,11 @@
 
 #include "parser.h"
 #include "ast.h"
+#include "semantic.h"
 #include "ir.h"
 #include "optimizer.h"
 #include "ir_codegen.h"
 
-/* External from Bison */
-extern FILE *yyin;
-
 /* ============================================================================
  * CONFIGURATION
  * ============================================================================
@@ -51,6 +52,12 @@ typedef struct {
     int keep_c;                   /* Keep .c file after compiling to binary */
     /* generated C-তে TAC debugging comments include করবে কিনা। */
     int emit_comments;
+    /* semantic analysis-এর function body check কয়টা thread-এ চলবে (0 = CPU প্রতি একটা)। */
+    int jobs;
+    /* type check-এর পর quadratic loop pattern-এর performance warning দেখাবে কিনা। */
+    int perf_lint;
+    /* parse/check/IR এক pass-এ, statement ধরে ধরে (পুরো AST কখনো তৈরি হয় না)। */
+    int stream;
 } NaturecConfig;
 
 /*
@@ -70,7 +77,7 @@ static void print_usage(const char *prog) {
     /* run command summary। */
     printf("  run     Compile and execute immediately\n");
     /* check command summary। */
-    printf("  check   Parse and validate only (no code output)\n");
+    printf("  check   Parse and type-check only (no code output)\n");
     /* section separator newline। */
     printf("\nOptions:\n");
     /* output file override option। */
@@ -85,6 +92,12 @@ static void print_usage(const char *prog) {
     printf("  -v, --verbose         Verbose output\n");
     /* TAC comments emit option। */
     printf("  --comments            Include TAC comments in generated C\n");
+    /* semantic analysis thread count option। */
+    printf("  -j, --jobs <N>        Threads for type checking [default: one per CPU]\n");
+    /* performance lint option। */
+    printf("  --perf-lint           Warn about loops with quadratic cost at the -O level\n");
+    /* streaming front end option। */
+    printf("  --stream              Check and lower each statement as soon as it is parsed\n");
     /* help option। */
     printf("  -h, --help            Show this help message\n");
     /* example section heading। */
@@ -98,7 +111,7 @@ static void print_usage(const char *prog) {
     /* run example। */
     printf("  %s run hello.nl               → compile + run\n", prog);
     /* check example। */
-    printf("  %s check hello.nl             → parse/validate only\n", prog);
+    printf("  %s check hello.nl             → parse/type-check only\n", prog);
 }
 
 /* Derive output filename from input: foo.nl → foo.c */
@@ -141,20 +154,14 @@ static char *derive_output(const char *input, const char *ext) {
  * example: "hello.nl" -> AST_PROGRAM root node
  */
 static ASTNode *stage_parse(const char *filename, int verbose) {
-    /* source file read mode-এ open করি। */
-    FILE *f = fopen(filename, "r");
-    /* open fail হলে error print করে stage fail return। */
-    if (!f) {
-        fprintf(stderr, "Error: cannot open '%s'\n", filename);
-        return NULL;
-    }
     /* verbose mode হলে current stage progress log। */
-    if (verbose) fprintf(stderr, "[1/4] Parsing %s...\n", filename);
+    if (verbose) fprintf(stderr, "[1/5] Parsing %s...\n", filename);
 
-    /* parser frontend চালিয়ে AST তৈরি করি। */
-    ASTNode *ast = naturelang_parse(f);
-    /* parse শেষ, input FILE handle close করি। */
-    fclose(f);
+    /*
+     * parser frontend চালিয়ে AST তৈরি করি।
+     * file mmap করে in-place scan হয়; open error parser নিজেই report করে।
+     */
+    ASTNode *ast = naturelang_parse_file(filename);
 
     /* parser failure হলে error report সহ NULL return। */
     if (!ast) {
@@ -171,7 +178,33 @@ static ASTNode *stage_parse(const char *filename, int verbose) {
     return ast;
 }
 
-/* Stage 2: AST → IR */
+/* Stage 2: Semantic analysis */
+/*
+ * stage_semantic
+ * কী করে: scope/type check চালায় এবং প্রতিটি expression node-এ resolved
+ * data_type বসায়; IR generator আর C backend এই type-ই ব্যবহার করে।
+ * example: "x plus 1.5" -> binary node-এর data_type = TYPE_DECIMAL
+ */
+static int stage_semantic(ASTNode *ast, int jobs, int perf_lint, int opt_level, int verbose) {
+    /* verbose mode-এ semantic stage শুরু log। */
+    if (verbose) fprintf(stderr, "[2/5] Checking types...\n");
+    /* analyzer নিজেই প্রতিটি error/warning line সহ print করে। */
+    SemanticResult result = semantic_analyze_jobs(ast, jobs);
+    int ok = result.success;
+    /* type ঠিক থাকলে lint চালাই; warning গুলো একই symbol table দিয়ে print হয়। */
+    if (ok && perf_lint) semantic_perf_lint(ast, &result, opt_level);
+    if (!ok) {
+        fprintf(stderr, "Error: semantic analysis failed with %d error(s)\n",
+                result.error_count);
+    } else if (verbose) {
+        fprintf(stderr, "       %d warning(s)\n", result.warning_count);
+    }
+    /* type গুলো AST-এ বসে গেছে, symbol table আর দরকার নেই। */
+    semantic_result_free(&result);
+    return ok;
+}
+
+/* Stage 3: AST → IR */
 /*
  * stage_ir
  * কী করে: parsed AST থেকে TAC/IR program তৈরি করে।
@@ -179,7 +212,7 @@ static ASTNode *stage_parse(const char *filename, int verbose) {
  */
 static TACProgram *stage_ir(ASTNode *ast, int verbose) {
     /* verbose mode-এ IR stage শুরু log। */
-    if (verbose) fprintf(stderr, "[2/4] Generating IR...\n");
+    if (verbose) fprintf(stderr, "[3/5] Generating IR...\n");
     /* AST থেকে IR generator invoke। */
     TACProgram *ir = ir_generate(ast);
     /* IR generation fail হলে error return। */
@@ -196,7 +229,70 @@ static TACProgram *stage_ir(ASTNode *ast, int verbose) {
     return ir;
 }
 
-/* Stage 3: Optimize IR */
+/* Stages 1-3 fused: streaming front end */
+/*
+ * streaming state: parser প্রতিটি top-level statement reduce করলেই
+ * stream_statement চলে; statement-এর AST memory পরের statement-এ reuse হয়।
+ */
+typedef struct {
+    SemanticResult sem;
+    IRStream *ir;               /* check-only mode-এ NULL */
+    int perf_lint;
+    int opt_level;
+    size_t statements;
+} StreamState;
+
+static void stream_statement(ASTNode *statement, void *data) {
+    StreamState *state = data;
+    state->statements++;
+    /* type error হলে statement-টা lower করি না; পরেরগুলো শুধু check হয়। */
+    if (!semantic_stream_statement(&state->sem, statement) || !state->sem.success) return;
+    if (state->perf_lint) semantic_perf_lint(statement, &state->sem, state->opt_level);
+    if (state->ir) ir_stream_statement(state->ir, statement);
+}
+
+/*
+ * stage_stream
+ * কী করে: parse, type check আর IR generation একসাথে, statement ধরে ধরে।
+ * function-এর শুধু signature symbol table-এ থাকে; পুরো AST কখনো memory-তে থাকে না।
+ * example: 1M line-এর flat script -> প্রতি statement-এ একটাই ছোট AST
+ */
+static int stage_stream(const NaturecConfig *cfg, TACProgram **ir_out, size_t *statements) {
+    /* verbose mode-এ fused stage শুরু log। */
+    if (cfg->verbose) fprintf(stderr, "[1/5] Parsing, checking and lowering %s (streaming)...\n",
+                              cfg->input_file);
+    StreamState state = {0};
+    state.sem = semantic_stream_begin();
+    state.ir = ir_out ? ir_stream_create() : NULL;
+    state.perf_lint = cfg->perf_lint;
+    state.opt_level = cfg->opt_level;
+
+    int parsed = naturelang_parse_file_stream(cfg->input_file, stream_statement, &state) == 0;
+    TACProgram *ir = state.ir ? ir_stream_finish(state.ir) : NULL;
+    int ok = parsed && state.sem.success;
+    if (!parsed) {
+        fprintf(stderr, "Error: parsing failed for '%s'\n", cfg->input_file);
+    } else if (!state.sem.success) {
+        fprintf(stderr, "Error: semantic analysis failed with %d error(s)\n",
+                state.sem.error_count);
+    } else if (cfg->verbose) {
+        fprintf(stderr, "       %zu top-level statement(s), %d warning(s)\n",
+                state.statements, state.sem.warning_count);
+        if (ir) fprintf(stderr, "       %d instructions generated\n", ir_count_total(ir));
+    }
+    semantic_result_free(&state.sem);
+
+    /* failure হলে আধা-তৈরি IR বাদ। */
+    if (!ok) {
+        ir_free(ir);
+        ir = NULL;
+    }
+    if (ir_out) *ir_out = ir;
+    *statements = state.statements;
+    return ok;
+}
+
+/* Stage 4: Optimize IR */
 /*
  * stage_optimize
  * কী করে: opt level > 0 হলে IR optimization pass চালায়।
@@ -206,7 +302,7 @@ static int stage_optimize(TACProgram *ir, int level, int verbose) {
     /* O0 (বা negative) হলে optimization skip করে success ধরি। */
     if (level <= 0) return 1;
     /* verbose mode-এ optimization stage header। */
-    if (verbose) fprintf(stderr, "[3/4] Optimizing (O%d)...\n", level);
+    if (verbose) fprintf(stderr, "[4/5] Optimizing (O%d)...\n", level);
 
     /* নির্বাচিত level থেকে optimizer option struct তৈরি। */
     OptOptions opts = opt_default_options((OptLevel)level);
@@ -228,20 +324,22 @@ static int stage_optimize(TACProgram *ir, int level, int verbose) {
     return 1;
 }
 
-/* Stage 4: IR → C code */
+/* Stage 5: IR → C code */
 /*
  * stage_codegen
  * কী করে: IR থেকে final C source text বানিয়ে heap string হিসেবে ফেরত দেয়।
  * example: TAC_DISPLAY -> generated printf call
  */
-static char *stage_codegen(TACProgram *ir, int emit_comments, int verbose) {
+static char *stage_codegen(TACProgram *ir, int opt_level, int emit_comments, int verbose) {
     /* verbose mode-এ codegen stage header। */
-    if (verbose) fprintf(stderr, "[4/4] Generating C code...\n");
+    if (verbose) fprintf(stderr, "[5/5] Generating C code...\n");
 
     /* codegen default options নিয়ে শুরু। */
     IRCodegenOptions opts = ir_codegen_default_options();
     /* CLI flag অনুযায়ী TAC comments include toggle। */
     opts.emit_comments = emit_comments;
+    /* -O0 হলে সব number long long থাকে; optimization level-এ narrowing চালু। */
+    opts.narrow_integers = opt_level > 0;
 
     /* IR -> C generation run করি। */
     IRCodegenResult result = ir_codegen_generate(ir, &opts);
@@ -267,6 +365,126 @@ static char *stage_codegen(TACProgram *ir, int emit_comments, int verbose) {
     return code;
 }
 
+/* Stages 4-5 and output: optimize, generate C, write it, optionally build/run */
+/*
+ * finish_pipeline
+ * কী করে: IR থেকে বাকি pipeline চালায়; batch আর streaming দুই path-ই এখানে মেলে।
+ * IR-এর মালিকানা এই function নেয়।
+ */
+static int finish_pipeline(const NaturecConfig *cfg, TACProgram *ir) {
+    /* Stage 4: Optimize */
+    /* নির্বাচিত level অনুযায়ী optimization pass চালাই। */
+    if (!stage_optimize(ir, cfg->opt_level, cfg->verbose)) {
+        /* optimize stage ব্যর্থ হলে IR free করে exit। */
+        ir_free(ir); return 1;
+    }
+
+    /* Stage 5: Codegen */
+    /* IR থেকে generated C source string পাই। */
+    char *c_code = stage_codegen(ir, cfg->opt_level, cfg->emit_comments, cfg->verbose);
+    /* codegen-এর পরে IR memory আর দরকার নেই। */
+    ir_free(ir);
+    /* codegen fail হলে exit। */
+    if (!c_code) return 1;
+
+    /* Write .c file */
+    /* output filename: explicit -o থাকলে সেটি, নাহলে auto derive। */
+    char *c_file = cfg->output_file
+                   ? strdup(cfg->output_file)
+                   : derive_output(cfg->input_file, ".c");
+
+    /* target .c file write mode-এ open। */
+    FILE *out = fopen(c_file, "w");
+    /* open fail হলে allocated buffer cleanup করে abort। */
+    if (!out) {
+        fprintf(stderr, "Error: cannot write '%s'\n", c_file);
+        free(c_code); free(c_file);
+        return 1;
+    }
+    /* generated C text file-এ লিখি। */
+    fputs(c_code, out);
+    /* write flush/close। */
+    fclose(out);
+    /* C source buffer free (file-এ persist হয়েছে)। */
+    free(c_code);
+
+    /* verbose হলে, অথবা শুধুই C generate mode হলে path report করি। */
+    if (cfg->verbose || !cfg->compile_c) {
+        fprintf(stderr, "Generated: %s\n", c_file);
+    }
+
+    /* Optionally compile to binary */
+    /* compile বা run mode হলে gcc invocation দরকার। */
+    if (cfg->compile_c || cfg->run_after) {
+        /* binary output name derive (no extension append)। */
+        char *bin_file = derive_output(cfg->input_file, "");
+        /* Remove trailing dot if any */
+        /* input name dot দিয়ে শেষ হলে trailing dot trim। */
+        size_t bl = strlen(bin_file);
+        if (bl > 0 && bin_file[bl - 1] == '.') bin_file[bl - 1] = '\0';
+
+        /* gcc command string রাখার fixed buffer। */
+        char cmd[4096];
+        /* runtime support C file link করে native binary build command বানাই। */
+        snprintf(cmd, sizeof(cmd),
+                 "gcc -std=c11 -O2 -o %s %s -Iruntime runtime/naturelang_runtime.c -lm",
+                 bin_file, c_file);
+
+        /* verbose হলে full gcc command print। */
+        if (cfg->verbose) fprintf(stderr, "Compiling: %s\n", cmd);
+
+        /* shell দিয়ে gcc command run। */
+        int rc = system(cmd);
+        /* compile fail হলে status print + cleanup + exit। */
+        if (rc != 0) {
+            fprintf(stderr, "Error: gcc compilation failed (exit %d)\n", rc);
+            free(c_file); free(bin_file);
+            return 1;
+        }
+
+        /* verbose mode-এ binary path announce। */
+        if (cfg->verbose) {
+            fprintf(stderr, "Binary: %s\n", bin_file);
+        }
+
+        /* Remove .c file if not keeping */
+        /* শুধু compile mode-এ (run নয়) keep_c false হলে .c delete করি। */
+        if (!cfg->keep_c && !cfg->run_after) {
+            unlink(c_file);
+        }
+
+        /* Run if requested */
+        /* run command হলে freshly built binary execute করি। */
+        if (cfg->run_after) {
+            /* "./binary" run command তৈরি। */
+            char run_cmd[4096];
+            snprintf(run_cmd, sizeof(run_cmd), "./%s", bin_file);
+            /* verbose mode-এ run command দেখাই। */
+            if (cfg->verbose) fprintf(stderr, "Running: %s\n\n", run_cmd);
+            /* program run করে exit status সংগ্রহ। */
+            rc = system(run_cmd);
+            /* Clean up */
+            /* run শেষে binary remove করি। */
+            unlink(bin_file);
+            /* keep_c false হলে generated .c-ও remove করি। */
+            if (!cfg->keep_c) unlink(c_file);
+            /* filename buffers free করি। */
+            free(c_file); free(bin_file);
+            /* child program-এর exit status propagate করি। */
+            return WEXITSTATUS(rc);
+        }
+
+        /* compile-only success summary print। */
+        fprintf(stderr, "Compiled: %s → %s\n", cfg->input_file, bin_file);
+        /* binary filename buffer release। */
+        free(bin_file);
+    }
+
+    /* normal completion path-এ c_file string free করে exit 0। */
+    free(c_file);
+    return 0;
+}
+
 /* ============================================================================
  * MAIN
  * ============================================================================
@@ -288,6 +506,9 @@ int main(int argc, char *argv[]) {
         .verbose = 0,
         .keep_c = 0,
         .emit_comments = 0,
+        .jobs = 0,
+        .perf_lint = 0,
+        .stream = 0,
     };
 
     /* command না দিলে usage দেখিয়ে error exit। */
@@ -332,13 +553,16 @@ int main(int argc, char *argv[]) {
         {"verbose",  no_argument,       0, 'v'},
         {"comments", no_argument,       0, 'C'},
         {"help",     no_argument,       0, 'h'},
+        {"jobs",     required_argument, 0, 'j'},
+        {"perf-lint", no_argument,      0, 'P'},
+        {"stream",   no_argument,       0, 'S'},
         {0, 0, 0, 0}
     };
 
     /* parsed short option char code রাখার variable। */
     int opt;
-    /* short options string: o/O arg নেয়, c/k/v/C/h arg নেয় না। */
-    while ((opt = getopt_long(argc, argv, "o:O:ckvCh", long_options, NULL)) != -1) {
+    /* short options string: o/O/j arg নেয়, c/k/v/C/h arg নেয় না। */
+    while ((opt = getopt_long(argc, argv, "o:O:ckvChj:", long_options, NULL)) != -1) {
         /* option অনুযায়ী config mutate করি। */
         switch (opt) {
             case 'o':
@@ -370,6 +594,22 @@ int main(int argc, char *argv[]) {
                 /* generated C-তে TAC comments include করা। */
                 cfg.emit_comments = 1;
                 break;
+            case 'j':
+                /* type checking thread count; অন্তত ১ হতে হবে। */
+                cfg.jobs = atoi(optarg);
+                if (cfg.jobs < 1) {
+                    fprintf(stderr, "Invalid job count (use 1 or more)\n");
+                    return 1;
+                }
+                break;
+            case 'P':
+                /* semantic analysis-এর পর performance lint চালাও। */
+                cfg.perf_lint = 1;
+                break;
+            case 'S':
+                /* streaming front end ব্যবহার করো। */
+                cfg.stream = 1;
+                break;
             case 'h':
                 /* help দেখিয়ে success return। */
                 print_usage(argv[0]);
@@ -400,142 +640,49 @@ int main(int argc, char *argv[]) {
 
     /* ---- Pipeline begins ---- */
 
+    /* Stages 1-3 (streaming): AST ছাড়াই সরাসরি IR পাই। */
+    if (cfg.stream) {
+        TACProgram *ir = NULL;
+        size_t n = 0;
+        if (!stage_stream(&cfg, cfg.check_only ? NULL : &ir, &n)) return 1;
+        if (cfg.check_only) {
+            fprintf(stderr, "OK: %s parsed and checked successfully (%zu statements)\n",
+                    cfg.input_file, n);
+            return 0;
+        }
+        return finish_pipeline(&cfg, ir);
+    }
+
     /* Stage 1: Parse */
     /* parser stage চালিয়ে AST পাই। */
     ASTNode *ast = stage_parse(cfg.input_file, cfg.verbose);
     /* parse fail হলে non-zero exit। */
     if (!ast) return 1;
 
+    /* Stage 2: Semantic */
+    /* type error থাকলে IR-এ যাওয়ার আগেই থামি। */
+    if (!stage_semantic(ast, cfg.jobs, cfg.perf_lint, cfg.opt_level, cfg.verbose)) { ast_free(ast); return 1; }
+
     /* If check-only, we're done */
-    /* check mode: parse success summary দেখিয়ে clean exit। */
+    /* check mode: parse + type-check success summary দেখিয়ে clean exit। */
     if (cfg.check_only) {
         /* top-level statement count defensive ভাবে বের করি। */
         size_t n = (ast->type == AST_PROGRAM && ast->data.program.statements)
                    ? ast->data.program.statements->count : 0;
-        fprintf(stderr, "OK: %s parsed successfully (%zu statements)\n",
+        fprintf(stderr, "OK: %s parsed and checked successfully (%zu statements)\n",
                 cfg.input_file, n);
         /* AST memory release করে return 0। */
         ast_free(ast);
         return 0;
     }
 
-    /* Stage 2: IR */
+    /* Stage 3: IR */
     /* AST থেকে TAC/IR generate করি। */
     TACProgram *ir = stage_ir(ast, cfg.verbose);
-    /* IR stage fail হলে AST free করে exit। */
-    if (!ir) { ast_free(ast); return 1; }
-
-    /* Stage 3: Optimize */
-    /* নির্বাচিত level অনুযায়ী optimization pass চালাই। */
-    if (!stage_optimize(ir, cfg.opt_level, cfg.verbose)) {
-        /* optimize stage ব্যর্থ হলে দুই resource free করে exit। */
-        ir_free(ir); ast_free(ast); return 1;
-    }
-
-    /* Stage 4: Codegen */
-    /* IR থেকে generated C source string পাই। */
-    char *c_code = stage_codegen(ir, cfg.emit_comments, cfg.verbose);
-    /* codegen-এর পরে IR memory আর দরকার নেই। */
-    ir_free(ir);
-    /* AST-ও codegen শেষে release করি। */
+    /* IR তৈরি হয়ে গেলে AST আর লাগে না। */
     ast_free(ast);
-    /* codegen fail হলে exit। */
-    if (!c_code) return 1;
-
-    /* Write .c file */
-    /* output filename: explicit -o থাকলে সেটি, নাহলে auto derive। */
-    char *c_file = cfg.output_file
-                   ? strdup(cfg.output_file)
-                   : derive_output(cfg.input_file, ".c");
-
-    /* target .c file write mode-এ open। */
-    FILE *out = fopen(c_file, "w");
-    /* open fail হলে allocated buffer cleanup করে abort। */
-    if (!out) {
-        fprintf(stderr, "Error: cannot write '%s'\n", c_file);
-        free(c_code); free(c_file);
-        return 1;
-    }
-    /* generated C text file-এ লিখি। */
-    fputs(c_code, out);
-    /* write flush/close। */
-    fclose(out);
-    /* C source buffer free (file-এ persist হয়েছে)। */
-    free(c_code);
-
-    /* verbose হলে, অথবা শুধুই C generate mode হলে path report করি। */
-    if (cfg.verbose || !cfg.compile_c) {
-        fprintf(stderr, "Generated: %s\n", c_file);
-    }
-
-    /* Optionally compile to binary */
-    /* compile বা run mode হলে gcc invocation দরকার। */
-    if (cfg.compile_c || cfg.run_after) {
-        /* binary output name derive (no extension append)। */
-        char *bin_file = derive_output(cfg.input_file, "");
-        /* Remove trailing dot if any */
-        /* input name dot দিয়ে শেষ হলে trailing dot trim। */
-        size_t bl = strlen(bin_file);
-        if (bl > 0 && bin_file[bl - 1] == '.') bin_file[bl - 1] = '\0';
-
-        /* gcc command string রাখার fixed buffer। */
-        char cmd[4096];
-        /* runtime support C file link করে native binary build command বানাই। */
-        snprintf(cmd, sizeof(cmd),
-                 "gcc -std=c11 -O2 -o %s %s -Iruntime runtime/naturelang_runtime.c -lm",
-                 bin_file, c_file);
-
-        /* verbose হলে full gcc command print। */
-        if (cfg.verbose) fprintf(stderr, "Compiling: %s\n", cmd);
-
-        /* shell দিয়ে gcc command run। */
-        int rc = system(cmd);
-        /* compile fail হলে status print + cleanup + exit। */
-        if (rc != 0) {
-            fprintf(stderr, "Error: gcc compilation failed (exit %d)\n", rc);
-            free(c_file); free(bin_file);
-            return 1;
-        }
-
-        /* verbose mode-এ binary path announce। */
-        if (cfg.verbose) {
-            fprintf(stderr, "Binary: %s\n", bin_file);
-        }
+    /* IR stage fail হলে exit। */
+    if (!ir) return 1;
 
-        /* Remove .c file if not keeping */
-        /* শুধু compile mode-এ (run নয়) keep_c false হলে .c delete করি। */
-        if (!cfg.keep_c && !cfg.run_after) {
-            unlink(c_file);
-        }
-
-        /* Run if requested */
-        /* run command হলে freshly built binary execute করি। */
-        if (cfg.run_after) {
-            /* "./binary" run command তৈরি। */
-            char run_cmd[4096];
-            snprintf(run_cmd, sizeof(run_cmd), "./%s", bin_file);
-            /* verbose mode-এ run command দেখাই। */
-            if (cfg.verbose) fprintf(stderr, "Running: %s\n\n", run_cmd);
-            /* program run করে exit status সংগ্রহ। */
-            rc = system(run_cmd);
-            /* Clean up */
-            /* run শেষে binary remove করি। */
-            unlink(bin_file);
-            /* keep_c false হলে generated .c-ও remove করি। */
-            if (!cfg.keep_c) unlink(c_file);
-            /* filename buffers free করি। */
-            free(c_file); free(bin_file);
-            /* child program-এর exit status propagate করি। */
-            return WEXITSTATUS(rc);
-        }
-
-        /* compile-only success summary print। */
-        fprintf(stderr, "Compiled: %s → %s\n", cfg.input_file, bin_file);
-        /* binary filename buffer release। */
-        free(bin_file);
-    }
-
-    /* normal completion path-এ c_file string free করে exit 0। */
-    free(c_file);
-    return 0;
+    return finish_pipeline(&cfg, ir);
 }
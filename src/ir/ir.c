@@ -313,6 +313,23 @@ TACInstr *tac_emit3(TACFunction *func, TACOpcode op,
     return instr;
 }
 /*
+optimizer pass-এর জন্য: নতুন instruction `at`-এর ঠিক আগে linked list-এ বসায়।
+source line হিসেবে `at`-এর line নেয়।
+*/
+
+TACInstr *tac_insert_before(TACFunction *func, TACInstr *at, TACOpcode op,
+                            TACOperand result, TACOperand arg1, TACOperand arg2) {
+    TACInstr *instr = tac_instr_create(op, result, arg1, arg2);
+    instr->line_number = at->line_number;
+    instr->prev = at->prev;
+    instr->next = at;
+    if (at->prev) at->prev->next = instr;
+    else func->first = instr;
+    at->prev = instr;
+    func->instr_count++;
+    return instr;
+}
+/*
 wrapper function, TAC_LABEL emit করে।
 result slot-এ label operand যায়।
 arg1/arg2 unused, তাই tac_operand_none()।
@@ -517,6 +534,10 @@ const char *tac_opcode_to_string(TACOpcode op) {
         case TAC_DECL:          return "DECL";
         case TAC_BETWEEN:       return "BETWEEN";
         case TAC_CONCAT:        return "CONCAT";
+        case TAC_STRBUF_BEGIN:  return "STRBUF_BEGIN";
+        case TAC_STRBUF_APPEND: return "STRBUF_APPEND";
+        case TAC_STRBUF_END:    return "STRBUF_END";
+        case TAC_STRBUF_TEXT:   return "STRBUF_TEXT";
         case TAC_BREAK:         return "BREAK";
         case TAC_CONTINUE:      return "CONTINUE";
         case TAC_SCOPE_BEGIN:   return "SCOPE_BEGIN";
@@ -527,6 +548,7 @@ const char *tac_opcode_to_string(TACOpcode op) {
         case TAC_LIST_APPEND:   return "LIST_APPEND";
         case TAC_LIST_GET:      return "LIST_GET";
         case TAC_LIST_SET:      return "LIST_SET";
+        case TAC_LIST_ITEM:     return "LIST_ITEM";
         case TAC_NOP:           return "NOP";
         case TAC_OPCODE_COUNT:  return "???";
     }
@@ -725,6 +747,13 @@ instr->result-এ declaration-এর symbol থাকে (যেমন x)।
             printf("  SECURE_END\n");
             return;
 
+        case TAC_STRBUF_APPEND: {
+            char buf[256];
+            snprintf(buf, sizeof(buf), "%s", tac_operand_to_string(&instr->arg1));
+            printf("  STRBUF_APPEND %s, %s\n", buf, tac_operand_to_string(&instr->arg2));
+            return;
+        }
+
         case TAC_BREAK:
             printf("  BREAK\n");
             return;
@@ -745,6 +774,16 @@ instr->result-এ declaration-এর symbol থাকে (যেমন x)।
 The comment marks a fallback path for opcodes that are not handled in special switch cases.
 Without this block, many instructions would print nothing unless every opcode had a dedicated case.
 It keeps the printer maintainable and future-proof: new opcodes can still be shown in a readable form.*/
+    /* list opcode-এর সাথে element type দেখাই: LIST_GET<text> */
+    char op_buf[64];
+    if (instr->opcode >= TAC_LIST_CREATE && instr->opcode <= TAC_LIST_ITEM &&
+        instr->elem_type != TYPE_UNKNOWN) {
+        snprintf(op_buf, sizeof(op_buf), "%s<%s>", tac_opcode_to_string(instr->opcode),
+                 ast_data_type_to_string(instr->elem_type));
+    } else {
+        snprintf(op_buf, sizeof(op_buf), "%s", tac_opcode_to_string(instr->opcode));
+    }
+
     const char *res_str = tac_operand_to_string(&instr->result);
     /* Copy to local buf so second operand call doesn't clobber */
     char res_buf[256];
@@ -769,17 +808,17 @@ arg1/arg2 দুটিই না থাকলে শুধু opcode সহ:
     if (instr->arg2.kind != OPERAND_NONE) {
         printf("  %s = %s %s %s\n",
                res_buf, a1_buf,
-               tac_opcode_to_string(instr->opcode),
+               op_buf,
                tac_operand_to_string(&instr->arg2));
     } else if (instr->arg1.kind != OPERAND_NONE) {
         printf("  %s = %s %s\n",
                res_buf,
-               tac_opcode_to_string(instr->opcode),
+               op_buf,
                a1_buf);
     } else {
         printf("  %s = %s\n",
                res_buf,
-               tac_opcode_to_string(instr->opcode));
+               op_buf);
     }
 }
 
@@ -909,19 +948,63 @@ return left;
     return left;
 }
 
-static TACOperand ir_gen_expression(IRGenContext *ctx, ASTNode *node) {
+/*
+Expression lowering explicit stack দিয়ে হয়, C recursion দিয়ে না।
+কারণ: generated source-এ `a plus b plus c ...` chain লাখ লাখ level গভীর হতে পারে,
+recursive lowering-এ তখন C stack overflow হয়।
+
+কাজ তিন ধাপে ভাগ করা:
+ir_gen_enter      - operand-এর আগে (literal/identifier এখানেই শেষ; list-এর LIST_CREATE)
+ir_gen_after_arg  - প্রতিটি call argument / list element শেষ হলে (PARAM / LIST_APPEND)
+ir_gen_combine    - সব operand শেষ হলে instruction emit করে result operand দেয়
+operand-গুলো OperandStack-এ জমা থাকে, parent শেষ হলে pop করে।
+emit order আর temp numbering আগের recursive version-এর মতোই থাকে।
+*/
+
+typedef struct {
+    TACOperand *items;
+    size_t count;
+    size_t capacity;
+    TACOperand inline_items[AST_WALK_INLINE];
+} OperandStack;
+
+static void operand_stack_push(OperandStack *s, TACOperand op) {
+    if (s->count == s->capacity) {
+        size_t capacity = s->capacity * 2;
+        TACOperand *items = s->items == s->inline_items
+                            ? malloc(capacity * sizeof(TACOperand))
+                            : realloc(s->items, capacity * sizeof(TACOperand));
+        if (!items) {
+            fprintf(stderr, "Fatal: out of memory in IR generation\n");
+            exit(1);
+        }
+        if (s->items == s->inline_items) {
+            memcpy(items, s->inline_items, s->count * sizeof(TACOperand));
+        }
+        s->items = items;
+        s->capacity = capacity;
+    }
+    s->items[s->count++] = op;
+}
+
+static TACOperand operand_stack_pop(OperandStack *s) {
+    return s->count > 0 ? s->items[--s->count] : tac_operand_none();
+}
+
+/* Operand ছাড়া node (literal, identifier, অজানা kind): সরাসরি result দেয় */
+static TACOperand ir_gen_leaf(IRGenContext *ctx, ASTNode *node) {
     if (!node) return tac_operand_none();
-/*temp/label counter access করার জন্য program handle নেয়।
+/*temp/label counter access করার জন্য program handle নেয়।
 যেমন নতুন temp লাগলে tac_new_temp(prog) ব্যবহার হবে।*/
     TACProgram  *prog = ctx->program;
-    /*কোন function-এর instruction list-এ TAC emit হবে, সেটা নেয়।*/
+    /*কোন function-এর instruction list-এ TAC emit হবে, সেটা নেয়।*/
     TACFunction *func = ctx->current_func;
 
     switch (node->type) {
         /* ---- Literals ---- */
         case AST_LITERAL_INT: {
             int t = tac_new_temp(prog);
-            /*destination operand বানায় (t3, type number)।*/
+            /*destination operand বানায় (t3, type number)।*/
             TACOperand dst = tac_operand_temp(t, TYPE_NUMBER);
             /*tac_emit(func, TAC_LOAD_INT, dst, tac_operand_int(node->data.literal_int.value), tac_operand_none());
 instruction emit করে: integer literal-কে temp-এ load করা।
@@ -929,7 +1012,7 @@ conceptual TAC: t3 = LOAD_INT 42*/
             tac_emit(func, TAC_LOAD_INT, dst,
                      tac_operand_int(node->data.literal_int.value),
                      tac_operand_none());
-                     /*caller-কে বলে দেয় expression result কোথায় আছে: ওই temp-এ।*/
+                     /*caller-কে বলে দেয় expression result কোথায় আছে: ওই temp-এ।*/
             return tac_operand_temp(t, TYPE_NUMBER);
         }
 
@@ -967,22 +1050,85 @@ conceptual TAC: t3 = LOAD_INT 42*/
             return tac_operand_var(node->data.identifier.name, dt);
         }
 
+        default:
+            /* Unsupported expression – return none */
+            fprintf(stderr, "IR warning: unhandled expression node type %d\n",
+                    node->type);
+            return tac_operand_none();
+    }
+}
+
+/* Operand আছে এমন node হলে 1 (তখন operand-গুলো আগে lower হবে), নইলে 0 */
+static int ir_gen_enter(IRGenContext *ctx, ASTNode *node, ASTWalkFrame *frame) {
+    if (!node) return 0;
+
+    switch (node->type) {
+        case AST_BINARY_OP:
+        case AST_UNARY_OP:
+        case AST_TERNARY_OP:
+        case AST_FUNC_CALL:
+        case AST_INDEX:
+            return 1;
+
+        /* ---- List Literal ---- */
+        /*element-এর আগেই list temp বানায় (LIST_CREATE), temp id frame-এ রাখে,
+প্রতিটি element শেষ হলে ir_gen_after_arg ওই temp-এ LIST_APPEND করে।*/
+        case AST_LIST: {
+            ASTNodeList *elems = node->data.list_literal.elements;
+            int count = elems ? (int)elems->count : 0;
+            int t = tac_new_temp(ctx->program);
+            TACOperand dst = tac_operand_temp(t, TYPE_LIST);
+            tac_emit(ctx->current_func, TAC_LIST_CREATE, dst,
+                     tac_operand_int(count), tac_operand_none())->elem_type = node->elem_type;
+            frame->aux.num = t;
+            return 1;
+        }
+
+        default:
+            return 0;
+    }
+}
+
+/* Call argument বা list element lower হওয়ার পর তার operand consume করে */
+static void ir_gen_after_arg(IRGenContext *ctx, ASTNode *node, ASTWalkFrame *frame,
+                             OperandStack *operands) {
+    TACFunction *func = ctx->current_func;
+
+    if (node->type == AST_FUNC_CALL) {
+        /* Evaluate and push parameters in order */
+        TACOperand arg = operand_stack_pop(operands);
+        tac_emit(func, TAC_PARAM, tac_operand_none(), arg, tac_operand_none());
+    } else if (node->type == AST_LIST) {
+        TACOperand elem = operand_stack_pop(operands);
+        tac_emit(func, TAC_LIST_APPEND,
+                 tac_operand_temp((int)frame->aux.num, TYPE_LIST),
+                 elem, tac_operand_none())->elem_type = node->elem_type;
+    }
+}
+
+/* সব operand lower হওয়ার পর instruction emit করে result operand দেয় */
+static TACOperand ir_gen_combine(IRGenContext *ctx, ASTNode *node, ASTWalkFrame *frame,
+                                 OperandStack *operands) {
+    TACProgram  *prog = ctx->program;
+    TACFunction *func = ctx->current_func;
+
+    switch (node->type) {
         /* ---- Binary Operation ---- */
         /*op বের করে (+, -, *, == ইত্যাদি)।
-left আর right recursively generate করে।
-তাই nested expression (যেমন a + b * c) automaticভাবে আগে ভেঙে lower হয়।
-binop_result_type(...) দিয়ে result type infer করে।
+left আর right আগেই lower হয়ে operand stack-এ আছে (left নিচে, right উপরে)।
+তাই nested expression (যেমন a + b * c) automaticভাবে আগে ভেঙে lower হয়।
+binop_result_type(...) দিয়ে result type infer করে।
 special case:
 + এবং যেকোনো একপাশ text হলে numeric add না করে TAC_CONCAT emit করে।
 normal case:
-নতুন temp t নেয়
+নতুন temp t নেয়
 opcode map করে (operator_to_tac(op))
 t = left OP right style TAC emit করে
 শেষে ওই temp operand return করে, যাতে parent expression এটা use করতে পারে।*/
         case AST_BINARY_OP: {
             Operator op = node->data.binary_op.op;
-            TACOperand left  = ir_gen_expression(ctx, node->data.binary_op.left);
-            TACOperand right = ir_gen_expression(ctx, node->data.binary_op.right);
+            TACOperand right = operand_stack_pop(operands);
+            TACOperand left  = operand_stack_pop(operands);
 
             DataType res_type = binop_result_type(op, left.data_type, right.data_type);
 
@@ -1002,11 +1148,11 @@ t = left OP right style TAC emit করে
         }
 
         /* ---- Unary Operation ---- */
-        /*op নেয়: unary operator কোনটা (OP_NOT, OP_NEG ইত্যাদি)।
-operand expression recursively generate করে।
-তাই operand যদি complex হয়, আগে সেটা TAC-এ convert হয়ে আসে।
+        /*op নেয়: unary operator কোনটা (OP_NOT, OP_NEG ইত্যাদি)।
+operand আগেই lower হয়ে operand stack-এর মাথায় আছে।
+তাই operand যদি complex হয়, আগে সেটা TAC-এ convert হয়ে আসে।
 result type ঠিক করে:
-OP_NOT হলে result সবসময় TYPE_FLAG (true/false)
+OP_NOT হলে result সবসময় TYPE_FLAG (true/false)
 নাহলে operand-এর type-ই ধরে (যেমন numeric negate)।
 নতুন temp তৈরি করে (t)।
 unary instruction emit করে:
@@ -1015,7 +1161,7 @@ arg2 লাগে না, তাই tac_operand_none()।
 temp operand return করে, যাতে parent expression এটা ব্যবহার করতে পারে।*/
         case AST_UNARY_OP: {
             Operator op = node->data.unary_op.op;
-            TACOperand operand = ir_gen_expression(ctx, node->data.unary_op.operand);
+            TACOperand operand = operand_stack_pop(operands);
 
             DataType res_type = (op == OP_NOT) ? TYPE_FLAG : operand.data_type;
             int t = tac_new_temp(prog);
@@ -1025,13 +1171,13 @@ temp operand return করে, যাতে parent expression এটা ব্
         }
 
         /* ---- Ternary: "is between" ---- */
-        /*তিনটা sub-expression আলাদা করে evaluate করছে:
+        /*তিনটা sub-expression আগেই আলাদা করে evaluate হয়েছে:
 মূল value
 lower bound
 upper bound
 নতুন temp নিচ্ছে (t)।
 
-result operand বানাচ্ছে TYPE_FLAG দিয়ে, কারণ between check সবসময় true/false দেয়।
+result operand বানাচ্ছে TYPE_FLAG দিয়ে, কারণ between check সবসময় true/false দেয়।
 
 tac_emit3(...) ব্যবহার করছে, কারণ এই opcode-তে 3টা input লাগে:
 
@@ -1041,12 +1187,12 @@ arg3 = upper
 শেষে temp result return করছে, যাতে parent expression এটা ব্যবহার করতে পারে।
 কেন tac_emit3 দরকার:
 
-সাধারণ tac_emit শুধু 2টা arg নেয়।
-between operation inherently 3-operand, তাই extended emitter প্রয়োজন।*/
+সাধারণ tac_emit শুধু 2টা arg নেয়।
+between operation inherently 3-operand, তাই extended emitter প্রয়োজন।*/
         case AST_TERNARY_OP: {
-            TACOperand val   = ir_gen_expression(ctx, node->data.ternary_op.operand);
-            TACOperand lower = ir_gen_expression(ctx, node->data.ternary_op.lower);
-            TACOperand upper = ir_gen_expression(ctx, node->data.ternary_op.upper);
+            TACOperand upper = operand_stack_pop(operands);
+            TACOperand lower = operand_stack_pop(operands);
+            TACOperand val   = operand_stack_pop(operands);
 
             int t = tac_new_temp(prog);
             TACOperand dst = tac_operand_temp(t, TYPE_FLAG);
@@ -1055,14 +1201,12 @@ between operation inherently 3-operand, তাই extended emitter প্রয়
         }
 
         /* ---- Function Call ---- */
-        /*argument list নেয়, তারপর nargs বের করে।
-প্রতিটি arg recursively evaluate করে (nested expression support)।
-প্রতিটি evaluated arg এর জন্য TAC_PARAM emit করে।
-call convention অনুযায়ী arg pass preparation।
+        /*প্রতিটি arg আগেই evaluate হয়ে TAC_PARAM emit হয়ে গেছে (ir_gen_after_arg)।
+call convention অনুযায়ী arg pass preparation।
 return type ঠিক করে:
 semantic pass থেকে type জানা থাকলে সেটা
 না থাকলে fallback TYPE_NUMBER।
-return value ধরার জন্য নতুন temp নেয় (t)।
+return value ধরার জন্য নতুন temp নেয় (t)।
 TAC_CALL emit করে:
 result = dst (যেখানে return value যাবে)
 arg1 = function name
@@ -1072,65 +1216,97 @@ arg2 = nargs
             ASTNodeList *args = node->data.func_call.args;
             int nargs = args ? (int)args->count : 0;
 
-            /* Evaluate and push parameters in order */
-            for (int i = 0; i < nargs; i++) {
-                TACOperand arg = ir_gen_expression(ctx, args->nodes[i]);
-                tac_emit(func, TAC_PARAM, tac_operand_none(), arg, tac_operand_none());
-            }
-
             DataType ret_type = node->data_type != TYPE_UNKNOWN
                                 ? node->data_type : TYPE_NUMBER;
+            /* nothing return করা function-এর result রাখার temp লাগে না। */
+            if (ret_type == TYPE_NOTHING) {
+                tac_emit(func, TAC_CALL, tac_operand_none(),
+                         tac_operand_func(node->data.func_call.name),
+                         tac_operand_int(nargs));
+                return tac_operand_none();
+            }
             int t = tac_new_temp(prog);
             TACOperand dst = tac_operand_temp(t, ret_type);
+            /*
+             * list builtin (the sum of, contains, ...) কোন element type-এর
+             * kernel ডাকবে তা semantic pass call-এর elem_type-এ রেখেছে;
+             * instruction-এ তুলে রাখি, ir_codegen সেটা দেখে runtime function বাছে।
+             */
             tac_emit(func, TAC_CALL, dst,
                      tac_operand_func(node->data.func_call.name),
-                     tac_operand_int(nargs));
+                     tac_operand_int(nargs))->elem_type = node->elem_type;
             return tac_operand_temp(t, ret_type);
         }
 
         /* ---- List Literal ---- */
-        case AST_LIST: {
-            ASTNodeList *elems = node->data.list_literal.elements;
-            int count = elems ? (int)elems->count : 0;
-            int t = tac_new_temp(prog);
-            TACOperand dst = tac_operand_temp(t, TYPE_LIST);
-            tac_emit(func, TAC_LIST_CREATE, dst,
-                     tac_operand_int(count), tac_operand_none());
-
-            for (int i = 0; i < count; i++) {
-                TACOperand elem = ir_gen_expression(ctx, elems->nodes[i]);
-                tac_emit(func, TAC_LIST_APPEND,
-                         tac_operand_temp(t, TYPE_LIST),
-                         elem, tac_operand_none());
-            }
-            return tac_operand_temp(t, TYPE_LIST);
+        case AST_LIST:
+            return tac_operand_temp((int)frame->aux.num, TYPE_LIST);
             /*t0 = LIST_CREATE 3
 LIST_APPEND t0, e0
 LIST_APPEND t0, e1
 LIST_APPEND t0, e2
 result operand: t0*/
-        }
 
         /* ---- Index Access ---- */
         case AST_INDEX: {
-            TACOperand arr = ir_gen_expression(ctx, node->data.index_expr.array);
-            TACOperand idx = ir_gen_expression(ctx, node->data.index_expr.index);
+            TACOperand idx = operand_stack_pop(operands);
+            TACOperand arr = operand_stack_pop(operands);
             DataType elem_type = node->data_type != TYPE_UNKNOWN
                                  ? node->data_type : TYPE_NUMBER;
             int t = tac_new_temp(prog);
             TACOperand dst = tac_operand_temp(t, elem_type);
-            tac_emit(func, TAC_LIST_GET, dst, arr, idx);
+            tac_emit(func, TAC_LIST_GET, dst, arr, idx)->elem_type =
+                node->data.index_expr.array->elem_type;
             return tac_operand_temp(t, elem_type);
         }
 
         default:
-            /* Unsupported expression – return none */
-            fprintf(stderr, "IR warning: unhandled expression node type %d\n",
-                    node->type);
             return tac_operand_none();
     }
 }
 
+static TACOperand ir_gen_expression(IRGenContext *ctx, ASTNode *node) {
+    if (!node) return tac_operand_none();
+
+    ASTWalkStack stack;
+    OperandStack operands;
+    ast_walk_init(&stack);
+    operands.items = operands.inline_items;
+    operands.count = 0;
+    operands.capacity = AST_WALK_INLINE;
+
+    ast_walk_push(&stack, node);
+    while (stack.count > 0) {
+        ASTWalkFrame *frame = ast_walk_top(&stack);
+        ASTNode *current = frame->node;
+
+        if (frame->next == 0) {
+            if (!ir_gen_enter(ctx, current, frame)) {
+                operand_stack_push(&operands, ir_gen_leaf(ctx, current));
+                ast_walk_pop(&stack);
+                continue;
+            }
+        } else {
+            ir_gen_after_arg(ctx, current, frame, &operands);
+        }
+
+        if (frame->next < ast_child_count(current)) {
+            ast_walk_push(&stack, ast_child(current, frame->next++));
+            continue;
+        }
+
+        operand_stack_push(&operands, ir_gen_combine(ctx, current, frame, &operands));
+        ast_walk_pop(&stack);
+    }
+
+    TACOperand result = operand_stack_pop(&operands);
+    if (operands.items != operands.inline_items) {
+        free(operands.items);
+    }
+    ast_walk_free(&stack);
+    return result;
+}
+
 /* ============================================================================
  * AST -> TAC LOWERING  (Statement)
  * ============================================================================
@@ -1166,6 +1342,11 @@ static void ir_gen_statement(IRGenContext *ctx, ASTNode *node) {
                 tac_emit(func, TAC_ASSIGN,
                          tac_operand_var(node->data.var_decl.name, vt),
                          val, tac_operand_none());
+            } else if (vt == TYPE_LIST) {
+                /* initializer ছাড়া list: ঘোষিত element type-এর খালি list দিয়ে শুরু। */
+                tac_emit(func, TAC_LIST_CREATE,
+                         tac_operand_var(node->data.var_decl.name, vt),
+                         tac_operand_int(0), tac_operand_none())->elem_type = node->elem_type;
             }
             /* এই case-এর কাজ শেষ। */
             break;
@@ -1185,7 +1366,8 @@ static void ir_gen_statement(IRGenContext *ctx, ASTNode *node) {
                 /* target index expression evaluate করি। */
                 TACOperand idx = ir_gen_expression(ctx, target->data.index_expr.index);
                 /* LIST_SET pseudo-ternary opcode: result=list, arg1=idx, arg2=val */
-                tac_emit3(func, TAC_LIST_SET, arr, idx, val, tac_operand_none());
+                tac_emit3(func, TAC_LIST_SET, arr, idx, val, tac_operand_none())->elem_type =
+                    target->data.index_expr.array->elem_type;
             /* simple variable assignment: x = val */
             } else if (target->type == AST_IDENTIFIER) {
                 /* target type semantic phase থেকে পেলে সেটা, নাহলে fallback number। */
@@ -1220,8 +1402,9 @@ static void ir_gen_statement(IRGenContext *ctx, ASTNode *node) {
             TACOperand prompt = node->data.ask_stmt.prompt
                                 ? ir_gen_expression(ctx, node->data.ask_stmt.prompt)
                                 : tac_operand_none();
-            /* ask target variable string হিসেবে ধরা হচ্ছে (বর্তমান design)। */
-            TACOperand var_op = tac_operand_var(node->data.ask_stmt.target_var, TYPE_TEXT);
+            /* input target-এর declared type semantic phase ask node-এ রাখে; অজানা হলে text। */
+            DataType dt = node->data_type != TYPE_UNKNOWN ? node->data_type : TYPE_TEXT;
+            TACOperand var_op = tac_operand_var(node->data.ask_stmt.target_var, dt);
             /* result = ask(prompt) টাইপ IR emit। */
             tac_emit(func, TAC_ASK, var_op, prompt, tac_operand_none());
             /* ask case শেষ। */
@@ -1230,8 +1413,9 @@ static void ir_gen_statement(IRGenContext *ctx, ASTNode *node) {
 
         /* ---- Read (simple input) ---- */
         case AST_READ: {
-            /* read target variable operand। */
-            TACOperand var_op = tac_operand_var(node->data.read_stmt.target_var, TYPE_TEXT);
+            /* read target variable operand (ask-এর মতোই declared type)। */
+            DataType dt = node->data_type != TYPE_UNKNOWN ? node->data_type : TYPE_TEXT;
+            TACOperand var_op = tac_operand_var(node->data.read_stmt.target_var, dt);
             /* simple input read করে target-এ রাখার IR। */
             tac_emit(func, TAC_READ, var_op, tac_operand_none(), tac_operand_none());
             /* read case শেষ। */
@@ -1427,19 +1611,24 @@ static void ir_gen_statement(IRGenContext *ctx, ASTNode *node) {
             /* condition true হলে loop_end-এ exit। */
             tac_emit_if_goto(func, cond, loop_end);
 
-            /* iterator variable declare করি (বর্তমানে TYPE_NUMBER ধরে)। */
-            TACOperand item_var = tac_operand_var(node->data.for_each_stmt.iterator_name, TYPE_NUMBER);
+            /* iterator-এর type semantic phase for-each node-এ রেখে যায়; অজানা হলে number। */
+            DataType item_type = node->data_type != TYPE_UNKNOWN
+                                 ? node->data_type : TYPE_NUMBER;
+            /* iterator variable declare করি। */
+            TACOperand item_var = tac_operand_var(node->data.for_each_stmt.iterator_name, item_type);
             tac_emit(func, TAC_DECL, item_var, tac_operand_none(), tac_operand_none());
-            /* list[idx] element একটি temp-এ আনছি। */
+            /* list[idx] element একটি temp-এ আনছি; উপরের idx < len check-এর
+             * পরে index range-এর ভেতরে, তাই list হলে LIST_ITEM (bounds check ছাড়া)। */
+            ASTNode *iterable = node->data.for_each_stmt.iterable;
             int elem_t = tac_new_temp(prog);
-            tac_emit(func, TAC_LIST_GET,
-                     tac_operand_temp(elem_t, TYPE_NUMBER),
+            tac_emit(func, iterable->data_type == TYPE_LIST ? TAC_LIST_ITEM : TAC_LIST_GET,
+                     tac_operand_temp(elem_t, item_type),
                      list,
-                     tac_operand_temp(idx_t, TYPE_NUMBER));
+                     tac_operand_temp(idx_t, TYPE_NUMBER))->elem_type = iterable->elem_type;
             /* iterator variable-এ temp element assign করি। */
             tac_emit(func, TAC_ASSIGN,
-                     tac_operand_var(node->data.for_each_stmt.iterator_name, TYPE_NUMBER),
-                     tac_operand_temp(elem_t, TYPE_NUMBER),
+                     tac_operand_var(node->data.for_each_stmt.iterator_name, item_type),
+                     tac_operand_temp(elem_t, item_type),
                      tac_operand_none());
 
             /* for-each body generate করি। */
@@ -1627,6 +1816,65 @@ static void ir_gen_node(IRGenContext *ctx, ASTNode *node) {
  * ============================================================================
  */
 
+/*
+streaming lowering: parser প্রতিটি top-level statement reduce করলেই এখানে আসে।
+batch parser একাধিক top-level statement-কে একটা AST_BLOCK-এ রাখে, ফলে main
+SCOPE_BEGIN/SCOPE_END দিয়ে ঘেরা থাকে; একই output পেতে দ্বিতীয় statement
+এলে main-এর শুরুতে SCOPE_BEGIN বসাই আর finish-এ SCOPE_END দিই।
+*/
+struct IRStream {
+    TACProgram *program;
+    long statements;            /* top-level statements lowered so far */
+};
+
+IRStream *ir_stream_create(void) {
+    IRStream *stream = calloc(1, sizeof(IRStream));
+    if (!stream) {
+        fprintf(stderr, "Fatal: Out of memory in IR generation\n");
+        exit(1);
+    }
+    stream->program = tac_program_create();
+    return stream;
+}
+
+void ir_stream_statement(IRStream *stream, ASTNode *statement) {
+    if (!stream || !statement) return;
+
+    TACFunction *main_func = stream->program->main_func;
+    if (++stream->statements == 2) {
+        /* block-এর SCOPE_BEGIN প্রথম statement-এর instruction-গুলোর আগে যায়। */
+        TACInstr *open = tac_instr_create(TAC_SCOPE_BEGIN, tac_operand_none(),
+                                          tac_operand_none(), tac_operand_none());
+        open->next = main_func->first;
+        if (main_func->first) {
+            main_func->first->prev = open;
+        } else {
+            main_func->last = open;
+        }
+        main_func->first = open;
+        main_func->instr_count++;
+    }
+
+    /* statement-এর মাঝে context-এ কিছু বাকি থাকে না, তাই প্রতিবার নতুন context। */
+    IRGenContext ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.program = stream->program;
+    ctx.current_func = main_func;
+    ir_gen_statement(&ctx, statement);
+}
+
+TACProgram *ir_stream_finish(IRStream *stream) {
+    if (!stream) return NULL;
+    TACProgram *program = stream->program;
+    if (stream->statements >= 2) {
+        tac_emit(program->main_func, TAC_SCOPE_END,
+                 tac_operand_none(), tac_operand_none(), tac_operand_none());
+    }
+    program->total_instructions = ir_count_total(program);
+    free(stream);
+    return program;
+}
+
 TACProgram *ir_generate(ASTNode *ast) {
     /* entry guard: input AST না থাকলে IR generate করা সম্ভব নয়। */
     if (!ast) return NULL;
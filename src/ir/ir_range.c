@@ -0,0 +1,816 @@
+/*
+ * NatureLang Compiler
+ * Copyright (c) 2026
+ *
+ * Integer Range Analysis Implementation
+ *
+ * Interval analysis over the TAC of one function:
+ *
+ *  1. Every `number` temp and variable name is a value with one interval,
+ *     the union of what all of its definitions can produce. Temps start
+ *     at [0, 0] (the code generator declares them `= 0`), parameters are
+ *     unbounded.
+ *  2. Loops are found from backward jumps. A loop whose only way in is
+ *     its head label and whose head tests `v < b` (or `<=`, `>`, `>=`)
+ *     before anything else bounds every definition of v inside it, as
+ *     long as each of those is a step `v = v + k` in the same direction
+ *     executed at most once per iteration.
+ *  3. The intervals are iterated to a fixpoint, widening a bound that
+ *     keeps moving to the nearest loop bound (or to infinity), then
+ *     tightened by two descending rounds.
+ *
+ * Interval arithmetic saturates at LLONG_MIN/LLONG_MAX, which never fit
+ * a narrower type, so saturation only ever means "unbounded".
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "ir_range.h"
+#include "ir.h"
+#include "ast.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <stdint.h>
+
+/* Changes a bound may make before it is widened */
+#define WIDEN_AFTER      3
+/* Widenings to a loop bound before a bound goes straight to infinity */
+#define WIDEN_THRESHOLDS 4
+/* Safety net; widening normally converges in a handful of rounds */
+#define MAX_ROUNDS       100
+
+static const IRRange range_full = { LLONG_MIN, LLONG_MAX };
+static const IRRange range_empty = { 1, 0 };
+
+/* One definition of a value */
+typedef struct {
+    const TACInstr *instr;
+    int value;
+    int guard;              /* Loop bound applying to it, or -1 */
+    int next;               /* Next definition of the same value, or -1 */
+} RangeDef;
+
+/* `v = v + amount` (or `- amount`) inside a bounded loop */
+typedef struct {
+    const TACOperand *amount;
+    int negate;
+} RangeStep;
+
+/*
+ * Exit test of a loop head: while the loop runs, v < bound (upward) or
+ * v > bound (downward), or <= / >= when not strict. steps are all the
+ * definitions of v in the loop.
+ */
+typedef struct {
+    const TACOperand *bound;
+    int upward;
+    int strict;
+    int first_step;
+    int step_count;
+} RangeGuard;
+
+struct IRRangeInfo {
+    int temp_count;         /* Values [0, temp_count) are temps by id */
+
+    const char **names;     /* Variable names, value temp_count + i */
+    int name_count;
+    int name_capacity;
+    int *slots;             /* Open-addressing table of name indices, -1 empty */
+    int slot_capacity;
+
+    IRRange *ranges;        /* Per value */
+    int value_count;
+};
+
+/* ============================================================================
+ * SATURATING INTERVAL ARITHMETIC
+ * ============================================================================
+ */
+
+static int range_is_empty(IRRange r) {
+    return r.lo > r.hi;
+}
+
+static IRRange range_join(IRRange a, IRRange b) {
+    if (range_is_empty(a)) return b;
+    if (range_is_empty(b)) return a;
+    IRRange r = { a.lo < b.lo ? a.lo : b.lo, a.hi > b.hi ? a.hi : b.hi };
+    return r;
+}
+
+static long long sat_add(long long a, long long b) {
+    if (b > 0 && a > LLONG_MAX - b) return LLONG_MAX;
+    if (b < 0 && a < LLONG_MIN - b) return LLONG_MIN;
+    return a + b;
+}
+
+static long long sat_neg(long long a) {
+    return a == LLONG_MIN ? LLONG_MAX : -a;
+}
+
+static long long sat_sub(long long a, long long b) {
+    if (b == LLONG_MIN) return a >= 0 ? LLONG_MAX : a - LLONG_MIN;
+    return sat_add(a, -b);
+}
+
+static long long sat_mul(long long a, long long b) {
+    if (a == 0 || b == 0) return 0;
+    int negative = (a < 0) != (b < 0);
+    unsigned long long ua = a < 0 ? 0ULL - (unsigned long long)a : (unsigned long long)a;
+    unsigned long long ub = b < 0 ? 0ULL - (unsigned long long)b : (unsigned long long)b;
+    if (ua > (unsigned long long)LLONG_MAX / ub) return negative ? LLONG_MIN : LLONG_MAX;
+    long long p = (long long)(ua * ub);
+    return negative ? -p : p;
+}
+
+/* Largest absolute value in r (saturated) */
+static long long range_magnitude(IRRange r) {
+    long long a = sat_neg(r.lo);
+    return a > r.hi ? a : r.hi;
+}
+
+static IRRange range_add(IRRange a, IRRange b) {
+    if (range_is_empty(a) || range_is_empty(b)) return range_empty;
+    IRRange r = { sat_add(a.lo, b.lo), sat_add(a.hi, b.hi) };
+    return r;
+}
+
+static IRRange range_sub(IRRange a, IRRange b) {
+    if (range_is_empty(a) || range_is_empty(b)) return range_empty;
+    IRRange r = { sat_sub(a.lo, b.hi), sat_sub(a.hi, b.lo) };
+    return r;
+}
+
+static IRRange range_mul(IRRange a, IRRange b) {
+    if (range_is_empty(a) || range_is_empty(b)) return range_empty;
+    long long p[4] = {
+        sat_mul(a.lo, b.lo), sat_mul(a.lo, b.hi),
+        sat_mul(a.hi, b.lo), sat_mul(a.hi, b.hi)
+    };
+    IRRange r = { p[0], p[0] };
+    for (int i = 1; i < 4; i++) {
+        if (p[i] < r.lo) r.lo = p[i];
+        if (p[i] > r.hi) r.hi = p[i];
+    }
+    return r;
+}
+
+/* Truncating division never grows the magnitude of the dividend */
+static IRRange range_div(IRRange a, IRRange b) {
+    if (range_is_empty(a) || range_is_empty(b)) return range_empty;
+    long long m = range_magnitude(a);
+    IRRange r = { -m, m };
+    return r;
+}
+
+/* a % b is smaller than |b|, no larger than |a| and has the sign of a */
+static IRRange range_mod(IRRange a, IRRange b) {
+    if (range_is_empty(a) || range_is_empty(b)) return range_empty;
+    long long m = range_magnitude(a);
+    long long mb = range_magnitude(b);
+    if (mb > 0 && mb - 1 < m) m = mb - 1;
+    IRRange r = { a.lo < 0 ? -m : 0, a.hi > 0 ? m : 0 };
+    return r;
+}
+
+static IRRange range_neg(IRRange a) {
+    if (range_is_empty(a)) return range_empty;
+    IRRange r = { sat_neg(a.hi), sat_neg(a.lo) };
+    return r;
+}
+
+/* ============================================================================
+ * VALUES
+ * ============================================================================
+ */
+
+static unsigned long name_hash(const char *s) {
+    unsigned long h = 5381;
+    while (*s) h = h * 33 + (unsigned char)*s++;
+    return h;
+}
+
+static int name_find(const IRRangeInfo *info, const char *name) {
+    if (info->slot_capacity == 0) return -1;
+    unsigned long mask = (unsigned long)info->slot_capacity - 1;
+    for (unsigned long i = name_hash(name) & mask; ; i = (i + 1) & mask) {
+        int n = info->slots[i];
+        if (n < 0) return -1;
+        if (strcmp(info->names[n], name) == 0) return n;
+    }
+}
+
+static void name_slots_grow(IRRangeInfo *info) {
+    int capacity = info->slot_capacity ? info->slot_capacity * 2 : 64;
+    int *slots = malloc(sizeof(int) * (size_t)capacity);
+    if (!slots) {
+        fprintf(stderr, "Fatal: Memory allocation failed\n");
+        exit(1);
+    }
+    memset(slots, -1, sizeof(int) * (size_t)capacity);
+    unsigned long mask = (unsigned long)capacity - 1;
+    for (int n = 0; n < info->name_count; n++) {
+        unsigned long i = name_hash(info->names[n]) & mask;
+        while (slots[i] >= 0) i = (i + 1) & mask;
+        slots[i] = n;
+    }
+    free(info->slots);
+    info->slots = slots;
+    info->slot_capacity = capacity;
+}
+
+static int name_intern(IRRangeInfo *info, const char *name) {
+    int n = name_find(info, name);
+    if (n >= 0) return n;
+
+    if (info->name_count == info->name_capacity) {
+        info->name_capacity = info->name_capacity ? info->name_capacity * 2 : 32;
+        info->names = realloc(info->names, sizeof(char *) * (size_t)info->name_capacity);
+        if (!info->names) {
+            fprintf(stderr, "Fatal: Memory allocation failed\n");
+            exit(1);
+        }
+    }
+    /* Keep the table at most half full */
+    if ((info->name_count + 1) * 2 > info->slot_capacity) name_slots_grow(info);
+
+    n = info->name_count++;
+    info->names[n] = name;
+    unsigned long mask = (unsigned long)info->slot_capacity - 1;
+    unsigned long i = name_hash(name) & mask;
+    while (info->slots[i] >= 0) i = (i + 1) & mask;
+    info->slots[i] = n;
+    return n;
+}
+
+/* Value of a `number` temp or variable operand, or -1 */
+static int value_of(const IRRangeInfo *info, const TACOperand *op) {
+    if (op->data_type != TYPE_NUMBER) return -1;
+    if (op->kind == OPERAND_TEMP) {
+        return op->val.temp_id >= 0 && op->val.temp_id < info->temp_count
+            ? op->val.temp_id : -1;
+    }
+    if (op->kind == OPERAND_VAR && op->val.name) {
+        int n = name_find(info, op->val.name);
+        return n < 0 ? -1 : info->temp_count + n;
+    }
+    return -1;
+}
+
+static IRRange operand_range(const IRRangeInfo *info, const IRRange *ranges,
+                             const TACOperand *op) {
+    if (op->kind == OPERAND_INT) {
+        IRRange r = { op->val.int_val, op->val.int_val };
+        return r;
+    }
+    int v = value_of(info, op);
+    return v < 0 ? range_full : ranges[v];
+}
+
+/* Opcodes whose result operand receives a value */
+static int defines_result(TACOpcode op) {
+    switch (op) {
+        case TAC_ADD: case TAC_SUB: case TAC_MUL: case TAC_DIV: case TAC_MOD:
+        case TAC_POW: case TAC_NEG:
+        case TAC_EQ: case TAC_NEQ: case TAC_LT: case TAC_GT: case TAC_LTE: case TAC_GTE:
+        case TAC_AND: case TAC_OR: case TAC_NOT:
+        case TAC_ASSIGN: case TAC_LOAD_INT: case TAC_LOAD_FLOAT:
+        case TAC_LOAD_STRING: case TAC_LOAD_BOOL:
+        case TAC_CALL: case TAC_READ: case TAC_ASK: case TAC_DECL:
+        case TAC_BETWEEN: case TAC_CONCAT: case TAC_STRBUF_BEGIN: case TAC_STRBUF_END:
+        case TAC_STRBUF_TEXT:
+        case TAC_LIST_CREATE: case TAC_LIST_GET: case TAC_LIST_ITEM:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+static int is_jump(TACOpcode op) {
+    return op == TAC_GOTO || op == TAC_IF_GOTO || op == TAC_IF_FALSE_GOTO;
+}
+
+/* What one definition can produce, given the current ranges */
+static IRRange transfer(const IRRangeInfo *info, const IRRange *ranges,
+                        const TACInstr *instr) {
+    IRRange a = operand_range(info, ranges, &instr->arg1);
+    IRRange b = operand_range(info, ranges, &instr->arg2);
+    switch (instr->opcode) {
+        case TAC_LOAD_INT:
+        case TAC_ASSIGN:
+            return a;
+        case TAC_DECL: {
+            IRRange zero = { 0, 0 };
+            return zero;
+        }
+        case TAC_ADD: return range_add(a, b);
+        case TAC_SUB: return range_sub(a, b);
+        case TAC_MUL: return range_mul(a, b);
+        case TAC_DIV: return range_div(a, b);
+        case TAC_MOD: return range_mod(a, b);
+        case TAC_NEG: return range_neg(a);
+        case TAC_CALL:
+            /* nl_list_length() returns an int */
+            if (instr->arg1.kind == OPERAND_FUNC && instr->arg1.val.name &&
+                strcmp(instr->arg1.val.name, "__list_length") == 0) {
+                IRRange r = { 0, INT_MAX };
+                return r;
+            }
+            return range_full;
+        default:
+            return range_full;
+    }
+}
+
+/* ============================================================================
+ * LOOP BOUNDS
+ * ============================================================================
+ */
+
+typedef struct {
+    const TACInstr **code;  /* Live instructions in order */
+    int count;
+    int *def_at;            /* Definition index of each instruction, or -1 */
+    int *loop_end;          /* For a loop head: last back jump to it, else -1 */
+    int *inner_head;        /* Head of the innermost loop around each instruction */
+    int *label_pos;         /* Instruction index of each label, or -1 */
+    int *jump_min;          /* Per label: first and last jump to it */
+    int *jump_max;
+    int label_count;
+} LoopScan;
+
+/* Step of v at instruction k (`v = v + k`, `v = v - k` or a copy of one), or 0 */
+static int match_step(const IRRangeInfo *info, const TACInstr *instr, int v,
+                      RangeStep *step) {
+    if (instr->opcode == TAC_ADD || instr->opcode == TAC_SUB) {
+        const TACOperand *amount = NULL;
+        if (value_of(info, &instr->arg1) == v) amount = &instr->arg2;
+        else if (instr->opcode == TAC_ADD && value_of(info, &instr->arg2) == v)
+            amount = &instr->arg1;
+        if (!amount || (amount->kind != OPERAND_INT && value_of(info, amount) < 0))
+            return 0;
+        step->amount = amount;
+        step->negate = instr->opcode == TAC_SUB;
+        return 1;
+    }
+    return 0;
+}
+
+static int find_step(const IRRangeInfo *info, const LoopScan *s, int k, int guard_at,
+                     int v, RangeStep *step) {
+    const TACInstr *instr = s->code[k];
+    if (match_step(info, instr, v, step)) return 1;
+
+    /* v = ASSIGN t, where t = v + amount earlier in the same straight line */
+    if (instr->opcode != TAC_ASSIGN || instr->arg1.kind != OPERAND_TEMP) return 0;
+    int t = value_of(info, &instr->arg1);
+    if (t < 0 || t == v) return 0;
+    for (int m = k - 1; m > guard_at; m--) {
+        const TACInstr *prev = s->code[m];
+        if (prev->opcode == TAC_LABEL || is_jump(prev->opcode)) return 0;
+        if (s->def_at[m] >= 0 && value_of(info, &prev->result) == t)
+            return match_step(info, prev, v, step);
+    }
+    return 0;
+}
+
+/* Nothing outside [h, end] jumps into the loop past its head label */
+static int loop_is_closed(const LoopScan *s, int h, int end) {
+    for (int i = h + 1; i <= end; i++) {
+        const TACInstr *instr = s->code[i];
+        if (instr->opcode != TAC_LABEL) continue;
+        int label = instr->result.val.label_id;
+        if (s->jump_min[label] >= 0 &&
+            (s->jump_min[label] < h || s->jump_max[label] > end)) return 0;
+    }
+    return 1;
+}
+
+/*
+ * Try to bound value v in the loop [h, end] whose exit test is the jump at
+ * guard_at: every definition of v in the loop must come after the test,
+ * sit directly in this loop (not in a nested one) and step v the way the
+ * test bounds it.
+ */
+static void bound_loop_value(IRRangeInfo *info, const LoopScan *s, RangeDef *defs,
+                             int h, int end, int guard_at, int v,
+                             const TACOperand *bound, TACOpcode rel,
+                             RangeGuard **guards, int *guard_count, int *guard_capacity,
+                             RangeStep **steps, int *step_count, int *step_capacity) {
+    if (value_of(info, bound) == v) return;
+    if (bound->kind != OPERAND_INT && value_of(info, bound) < 0) return;
+
+    int first = *step_count;
+    int found = 0;
+    for (int k = h + 1; k <= end; k++) {
+        int d = s->def_at[k];
+        if (d < 0 || defs[d].value != v) continue;
+        RangeStep step;
+        if (k <= guard_at || s->inner_head[k] != h ||
+            !find_step(info, s, k, guard_at, v, &step)) {
+            *step_count = first;
+            return;
+        }
+        if (*step_count == *step_capacity) {
+            *step_capacity = *step_capacity ? *step_capacity * 2 : 16;
+            *steps = realloc(*steps, sizeof(RangeStep) * (size_t)*step_capacity);
+            if (!*steps) {
+                fprintf(stderr, "Fatal: Memory allocation failed\n");
+                exit(1);
+            }
+        }
+        (*steps)[(*step_count)++] = step;
+        found++;
+    }
+    if (found == 0) return;
+
+    if (*guard_count == *guard_capacity) {
+        *guard_capacity = *guard_capacity ? *guard_capacity * 2 : 8;
+        *guards = realloc(*guards, sizeof(RangeGuard) * (size_t)*guard_capacity);
+        if (!*guards) {
+            fprintf(stderr, "Fatal: Memory allocation failed\n");
+            exit(1);
+        }
+    }
+    RangeGuard *g = &(*guards)[*guard_count];
+    g->bound = bound;
+    g->upward = rel == TAC_LT || rel == TAC_LTE;
+    g->strict = rel == TAC_LT || rel == TAC_GT;
+    g->first_step = first;
+    g->step_count = found;
+    for (int k = h + 1; k <= end; k++) {
+        int d = s->def_at[k];
+        if (d >= 0 && defs[d].value == v) defs[d].guard = *guard_count;
+    }
+    (*guard_count)++;
+}
+
+static TACOpcode negate_relation(TACOpcode op) {
+    switch (op) {
+        case TAC_LT:  return TAC_GTE;
+        case TAC_LTE: return TAC_GT;
+        case TAC_GT:  return TAC_LTE;
+        default:      return TAC_LT;    /* TAC_GTE */
+    }
+}
+
+static TACOpcode swap_relation(TACOpcode op) {
+    switch (op) {
+        case TAC_LT:  return TAC_GT;
+        case TAC_LTE: return TAC_GTE;
+        case TAC_GT:  return TAC_LT;
+        default:      return TAC_LTE;   /* TAC_GTE */
+    }
+}
+
+/* Find the exit test at the top of loop [h, end] and bound what it tests */
+static void bound_loop(IRRangeInfo *info, const LoopScan *s, RangeDef *defs,
+                       int h, int end,
+                       RangeGuard **guards, int *guard_count, int *guard_capacity,
+                       RangeStep **steps, int *step_count, int *step_capacity) {
+    int g = h + 1;
+    for (; g <= end; g++) {
+        TACOpcode op = s->code[g]->opcode;
+        if (op == TAC_IF_GOTO || op == TAC_IF_FALSE_GOTO) break;
+        if (op == TAC_LABEL || op == TAC_GOTO || op == TAC_RETURN) return;
+    }
+    if (g > end) return;
+
+    const TACInstr *jump = s->code[g];
+    int label = jump->result.val.label_id;
+    if (label < 0 || label >= s->label_count) return;
+    int target = s->label_pos[label];
+    if (target >= h && target <= end) return;
+    if (jump->arg1.kind != OPERAND_TEMP) return;
+
+    /* The comparison that last set the condition */
+    const TACInstr *cmp = NULL;
+    for (int k = g - 1; k > h; k--) {
+        const TACInstr *instr = s->code[k];
+        if (defines_result(instr->opcode) && instr->result.kind == OPERAND_TEMP &&
+            instr->result.val.temp_id == jump->arg1.val.temp_id) {
+            cmp = instr;
+            break;
+        }
+    }
+    if (!cmp) return;
+    TACOpcode rel = cmp->opcode;
+    if (rel != TAC_LT && rel != TAC_LTE && rel != TAC_GT && rel != TAC_GTE) return;
+    if (cmp->arg1.data_type != TYPE_NUMBER || cmp->arg2.data_type != TYPE_NUMBER) return;
+
+    /* Relation that holds while the loop keeps running */
+    if (jump->opcode == TAC_IF_GOTO) rel = negate_relation(rel);
+
+    const TACOperand *sides[2] = { &cmp->arg1, &cmp->arg2 };
+    for (int side = 0; side < 2; side++) {
+        int v = value_of(info, sides[side]);
+        if (v < 0) continue;
+        /* v must not change between the loop head and the test */
+        int changed = 0;
+        for (int k = h + 1; k <= g; k++) {
+            int d = s->def_at[k];
+            if (d >= 0 && defs[d].value == v) changed = 1;
+        }
+        if (changed) continue;
+        bound_loop_value(info, s, defs, h, end, g, v, sides[1 - side],
+                         side == 0 ? rel : swap_relation(rel),
+                         guards, guard_count, guard_capacity,
+                         steps, step_count, step_capacity);
+    }
+}
+
+/* The range the loop test allows a guarded definition, or empty if it does not apply */
+static int guard_limit(const IRRangeInfo *info, const IRRange *ranges,
+                       const RangeGuard *g, const RangeStep *steps, long long *limit) {
+    IRRange bound = operand_range(info, ranges, g->bound);
+    if (range_is_empty(bound)) return 0;
+
+    long long total = 0;
+    for (int i = 0; i < g->step_count; i++) {
+        IRRange r = operand_range(info, ranges, steps[g->first_step + i].amount);
+        if (range_is_empty(r)) continue;
+        if (steps[g->first_step + i].negate) r = range_neg(r);
+        if (g->upward ? r.lo < 0 : r.hi > 0) return 0;
+        total = sat_add(total, g->upward ? r.hi : r.lo);
+    }
+    if (g->upward)
+        *limit = sat_add(g->strict ? sat_sub(bound.hi, 1) : bound.hi, total);
+    else
+        *limit = sat_add(g->strict ? sat_add(bound.lo, 1) : bound.lo, total);
+    return 1;
+}
+
+/* ============================================================================
+ * ANALYSIS
+ * ============================================================================
+ */
+
+typedef struct {
+    RangeDef *defs;
+    int def_count;
+    RangeGuard *guards;
+    RangeStep *steps;
+    IRRange *base;          /* Range every value has before any definition */
+} RangeProblem;
+
+static IRRange evaluate(const IRRangeInfo *info, const RangeProblem *p,
+                        const IRRange *ranges, const RangeDef *d) {
+    IRRange r = transfer(info, ranges, d->instr);
+    if (d->guard >= 0 && !range_is_empty(r)) {
+        const RangeGuard *g = &p->guards[d->guard];
+        long long limit;
+        if (guard_limit(info, ranges, g, p->steps, &limit)) {
+            if (g->upward && r.hi > limit) r.hi = limit;
+            if (!g->upward && r.lo < limit) r.lo = limit;
+        }
+    }
+    return r;
+}
+
+/* Loop bound nearest above (or below) a growing bound of v, else infinity */
+static long long widen_to(const IRRangeInfo *info, const RangeProblem *p,
+                          const IRRange *ranges, int first_def, int upward,
+                          long long from) {
+    long long best = upward ? LLONG_MAX : LLONG_MIN;
+    for (int d = first_def; d >= 0; d = p->defs[d].next) {
+        if (p->defs[d].guard < 0) continue;
+        const RangeGuard *g = &p->guards[p->defs[d].guard];
+        long long limit;
+        if (g->upward != upward || !guard_limit(info, ranges, g, p->steps, &limit)) continue;
+        if (upward && limit >= from && limit < best) best = limit;
+        if (!upward && limit <= from && limit > best) best = limit;
+    }
+    return best;
+}
+
+static void solve(IRRangeInfo *info, RangeProblem *p, const int *first_def) {
+    IRRange *ranges = info->ranges;
+    int n = info->value_count;
+    int *changes = calloc((size_t)n + 1, sizeof(int));
+    if (!changes) {
+        fprintf(stderr, "Fatal: Memory allocation failed\n");
+        exit(1);
+    }
+    memcpy(ranges, p->base, sizeof(IRRange) * (size_t)n);
+
+    int round = 0;
+    for (; round < MAX_ROUNDS; round++) {
+        int changed = 0;
+        for (int i = 0; i < p->def_count; i++) {
+            RangeDef *d = &p->defs[i];
+            IRRange old = ranges[d->value];
+            IRRange r = range_join(old, evaluate(info, p, ranges, d));
+            if (r.lo == old.lo && r.hi == old.hi) continue;
+
+            int c = ++changes[d->value];
+            if (!range_is_empty(old) && c > WIDEN_AFTER) {
+                int thresholds = c <= WIDEN_AFTER + WIDEN_THRESHOLDS;
+                if (r.hi > old.hi)
+                    r.hi = thresholds ? widen_to(info, p, ranges, first_def[d->value], 1, r.hi)
+                                      : LLONG_MAX;
+                if (r.lo < old.lo)
+                    r.lo = thresholds ? widen_to(info, p, ranges, first_def[d->value], 0, r.lo)
+                                      : LLONG_MIN;
+            }
+            ranges[d->value] = r;
+            changed = 1;
+        }
+        if (!changed) break;
+    }
+
+    if (round == MAX_ROUNDS) {
+        /* Did not settle: give up on every value */
+        for (int v = 0; v < n; v++) ranges[v] = range_full;
+    } else {
+        /* Descend: recompute every value from the fixpoint */
+        IRRange *next = malloc(sizeof(IRRange) * ((size_t)n + 1));
+        if (!next) {
+            fprintf(stderr, "Fatal: Memory allocation failed\n");
+            exit(1);
+        }
+        for (int step = 0; step < 2; step++) {
+            memcpy(next, p->base, sizeof(IRRange) * (size_t)n);
+            for (int i = 0; i < p->def_count; i++) {
+                RangeDef *d = &p->defs[i];
+                next[d->value] = range_join(next[d->value], evaluate(info, p, ranges, d));
+            }
+            memcpy(ranges, next, sizeof(IRRange) * (size_t)n);
+        }
+        free(next);
+    }
+    free(changes);
+}
+
+IRRangeInfo *ir_range_analyze(const TACFunction *func) {
+    IRRangeInfo *info = calloc(1, sizeof(IRRangeInfo));
+    if (!info) {
+        fprintf(stderr, "Fatal: Memory allocation failed\n");
+        exit(1);
+    }
+    if (!func) return info;
+
+    /* Live instructions, temp ids, variable names and labels */
+    LoopScan s;
+    memset(&s, 0, sizeof(s));
+    int max_temp = -1;
+    int max_label = -1;
+    for (const TACInstr *i = func->first; i; i = i->next) {
+        if (i->is_dead) continue;
+        s.count++;
+        const TACOperand *ops[] = { &i->result, &i->arg1, &i->arg2, &i->arg3 };
+        for (int j = 0; j < 4; j++) {
+            if (ops[j]->kind == OPERAND_TEMP && ops[j]->val.temp_id > max_temp)
+                max_temp = ops[j]->val.temp_id;
+            if (ops[j]->kind == OPERAND_VAR && ops[j]->val.name &&
+                ops[j]->data_type == TYPE_NUMBER)
+                name_intern(info, ops[j]->val.name);
+        }
+        if ((i->opcode == TAC_LABEL || is_jump(i->opcode)) &&
+            i->result.val.label_id > max_label)
+            max_label = i->result.val.label_id;
+    }
+    for (int k = 0; k < func->param_count; k++) {
+        if (func->param_names[k]) name_intern(info, func->param_names[k]);
+    }
+    info->temp_count = max_temp + 1;
+    info->value_count = info->temp_count + info->name_count;
+    info->ranges = malloc(sizeof(IRRange) * ((size_t)info->value_count + 1));
+
+    RangeProblem p;
+    memset(&p, 0, sizeof(p));
+    p.base = malloc(sizeof(IRRange) * ((size_t)info->value_count + 1));
+    int *first_def = malloc(sizeof(int) * ((size_t)info->value_count + 1));
+    s.label_count = max_label + 1;
+    s.code = malloc(sizeof(TACInstr *) * ((size_t)s.count + 1));
+    s.def_at = malloc(sizeof(int) * ((size_t)s.count + 1));
+    s.loop_end = malloc(sizeof(int) * ((size_t)s.count + 1));
+    s.inner_head = malloc(sizeof(int) * ((size_t)s.count + 1));
+    s.label_pos = malloc(sizeof(int) * ((size_t)s.label_count + 1));
+    s.jump_min = malloc(sizeof(int) * ((size_t)s.label_count + 1));
+    s.jump_max = malloc(sizeof(int) * ((size_t)s.label_count + 1));
+    p.defs = malloc(sizeof(RangeDef) * ((size_t)s.count + 1));
+    if (!info->ranges || !p.base || !first_def || !s.code || !s.def_at || !s.loop_end ||
+        !s.inner_head || !s.label_pos || !s.jump_min || !s.jump_max || !p.defs) {
+        fprintf(stderr, "Fatal: Memory allocation failed\n");
+        exit(1);
+    }
+
+    /* Temps are declared `= 0`, variables start empty, parameters unbounded */
+    for (int v = 0; v < info->value_count; v++) {
+        IRRange zero = { 0, 0 };
+        p.base[v] = v < info->temp_count ? zero : range_empty;
+        first_def[v] = -1;
+    }
+    for (int k = 0; k < func->param_count; k++) {
+        if (!func->param_names[k]) continue;
+        p.base[info->temp_count + name_find(info, func->param_names[k])] = range_full;
+    }
+    for (int l = 0; l < s.label_count; l++) {
+        s.label_pos[l] = -1;
+        s.jump_min[l] = -1;
+        s.jump_max[l] = -1;
+    }
+
+    /* Definitions, label positions and jump sources */
+    int n = 0;
+    int *last_def = malloc(sizeof(int) * ((size_t)info->value_count + 1));
+    if (!last_def) {
+        fprintf(stderr, "Fatal: Memory allocation failed\n");
+        exit(1);
+    }
+    for (int v = 0; v < info->value_count; v++) last_def[v] = -1;
+    for (const TACInstr *i = func->first; i; i = i->next) {
+        if (i->is_dead) continue;
+        s.code[n] = i;
+        s.def_at[n] = -1;
+        s.loop_end[n] = -1;
+        s.inner_head[n] = -1;
+        int v = defines_result(i->opcode) ? value_of(info, &i->result) : -1;
+        if (v >= 0) {
+            RangeDef *d = &p.defs[p.def_count];
+            d->instr = i;
+            d->value = v;
+            d->guard = -1;
+            d->next = -1;
+            if (last_def[v] >= 0) p.defs[last_def[v]].next = p.def_count;
+            else first_def[v] = p.def_count;
+            last_def[v] = p.def_count;
+            s.def_at[n] = p.def_count++;
+        }
+        int label = i->result.val.label_id;
+        if (i->opcode == TAC_LABEL && label >= 0) s.label_pos[label] = n;
+        if (is_jump(i->opcode) && label >= 0) {
+            if (s.jump_min[label] < 0) s.jump_min[label] = n;
+            s.jump_max[label] = n;
+        }
+        n++;
+    }
+    free(last_def);
+
+    /* Loops: a jump back to an earlier label closes one */
+    for (int k = 0; k < s.count; k++) {
+        const TACInstr *i = s.code[k];
+        if (!is_jump(i->opcode) || i->result.val.label_id < 0) continue;
+        int h = s.label_pos[i->result.val.label_id];
+        if (h >= 0 && h <= k && k > s.loop_end[h]) s.loop_end[h] = k;
+    }
+    for (int h = 0; h < s.count; h++) {
+        for (int k = h; k <= s.loop_end[h]; k++) s.inner_head[k] = h;
+    }
+
+    int guard_capacity = 0, step_count = 0, step_capacity = 0;
+    int guard_count = 0;
+    for (int h = 0; h < s.count; h++) {
+        if (s.loop_end[h] < 0 || !loop_is_closed(&s, h, s.loop_end[h])) continue;
+        bound_loop(info, &s, p.defs, h, s.loop_end[h],
+                   &p.guards, &guard_count, &guard_capacity,
+                   &p.steps, &step_count, &step_capacity);
+    }
+
+    solve(info, &p, first_def);
+
+    free(s.code);
+    free(s.def_at);
+    free(s.loop_end);
+    free(s.inner_head);
+    free(s.label_pos);
+    free(s.jump_min);
+    free(s.jump_max);
+    free(p.defs);
+    free(p.guards);
+    free(p.steps);
+    free(p.base);
+    free(first_def);
+    return info;
+}
+
+void ir_range_free(IRRangeInfo *info) {
+    if (!info) return;
+    free(info->names);
+    free(info->slots);
+    free(info->ranges);
+    free(info);
+}
+
+IRRange ir_range_of(const IRRangeInfo *info, const TACOperand *op) {
+    if (!info || !op) return range_full;
+    if (op->kind == OPERAND_INT) {
+        IRRange r = { op->val.int_val, op->val.int_val };
+        return r;
+    }
+    int v = value_of(info, op);
+    return v < 0 ? range_full : info->ranges[v];
+}
+
+int ir_range_width(const IRRangeInfo *info, const TACOperand *op) {
+    if (!info || !op || (op->kind != OPERAND_TEMP && op->kind != OPERAND_VAR)) return 64;
+    int v = value_of(info, op);
+    if (v < 0) return 64;
+    IRRange r = info->ranges[v];
+    if (range_is_empty(r)) return 64;
+    if (r.lo >= INT8_MIN && r.hi <= INT8_MAX) return 8;
+    if (r.lo >= INT16_MIN && r.hi <= INT16_MAX) return 16;
+    if (r.lo >= INT32_MIN && r.hi <= INT32_MAX) return 32;
+    return 64;
+}
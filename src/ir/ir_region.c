@@ -0,0 +1,440 @@
+/*
+ * NatureLang Compiler
+ * Copyright (c) 2026
+ *
+ * Region Analysis Implementation
+ *
+ * A function or secure zone is scanned twice:
+ *
+ *  1. Collect what it defines: the variables it declares, whether each is
+ *     only ever set to a freshly created list, and the text/list temps,
+ *     new lists and string builders it produces.
+ *  2. Walk it in order and reject anything that lets a text or list value
+ *     outlive it (see ir_region.h). A zone is also rejected when one of
+ *     its temps is read after the zone, or inside it before the zone
+ *     computes it (a value carried over from an earlier iteration).
+ *
+ * Calls inside functions are not judged in step 2; instead the calls form
+ * a graph over the program and "lets values escape" is propagated from
+ * callees to callers with a worklist. Zones then look up their callees
+ * in the finished result.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "ir_region.h"
+#include "ir.h"
+#include "ast.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct IRRegionInfo {
+    const TACFunction **funcs;  /* User functions, sorted by name */
+    bool *effects;              /* Per function: lets allocations escape */
+    int func_count;
+};
+
+/* A variable the scanned range writes or declares */
+typedef struct {
+    const char *name;
+    bool declared;          /* Declared (or a parameter) at this point of the walk */
+    bool fresh;             /* Only ever set to a new list */
+} RegionVar;
+
+/* Per-temp flags */
+enum {
+    TEMP_DEFINED  = 1,      /* Text/list temp or builder defined in the range */
+    TEMP_SEEN     = 2,      /* ... and already defined at this point of the walk */
+    TEMP_NEW_LIST = 4,      /* Defined by LIST_CREATE */
+    TEMP_REUSED   = 8,      /* Also defined by something else */
+    TEMP_BUILDER  = 16      /* Defined by STRBUF_BEGIN */
+};
+
+typedef struct {
+    RegionVar *vars;
+    int var_count;
+    int var_capacity;
+    int *slots;             /* Open-addressing table of var indices, -1 empty */
+    int slot_capacity;
+
+    unsigned char *temps;   /* Per temp id */
+    int temp_count;
+} RegionScan;
+
+static void *region_alloc(size_t count, size_t size) {
+    void *p = calloc(count ? count : 1, size);
+    if (!p) {
+        fprintf(stderr, "Fatal: Memory allocation failed\n");
+        exit(1);
+    }
+    return p;
+}
+
+/* Numbers, decimals and flags never point into the heap */
+static bool is_reference_type(DataType type) {
+    return type != TYPE_NUMBER && type != TYPE_DECIMAL && type != TYPE_FLAG &&
+           type != TYPE_NOTHING;
+}
+
+/* Whether the instruction overwrites its result operand */
+static bool writes_result(const TACInstr *instr) {
+    if (instr->result.kind != OPERAND_VAR && instr->result.kind != OPERAND_TEMP) return false;
+    return instr->opcode != TAC_DECL && instr->opcode != TAC_LIST_APPEND &&
+           instr->opcode != TAC_LIST_SET;
+}
+
+/* Operands the instruction reads, at most four */
+static int read_operands(const TACInstr *instr, const TACOperand **out) {
+    int n = 0;
+    if (instr->opcode == TAC_LIST_APPEND || instr->opcode == TAC_LIST_SET)
+        out[n++] = &instr->result;
+    out[n++] = &instr->arg1;
+    out[n++] = &instr->arg2;
+    out[n++] = &instr->arg3;
+    return n;
+}
+
+/* ============================================================================
+ * VARIABLE TABLE
+ * ============================================================================
+ */
+
+static unsigned long name_hash(const char *s) {
+    unsigned long h = 5381;
+    while (*s) h = h * 33 + (unsigned char)*s++;
+    return h;
+}
+
+static RegionVar *var_find(const RegionScan *s, const char *name) {
+    if (s->slot_capacity == 0) return NULL;
+    unsigned long mask = (unsigned long)s->slot_capacity - 1;
+    for (unsigned long i = name_hash(name) & mask; ; i = (i + 1) & mask) {
+        int n = s->slots[i];
+        if (n < 0) return NULL;
+        if (strcmp(s->vars[n].name, name) == 0) return &s->vars[n];
+    }
+}
+
+static void var_slots_grow(RegionScan *s) {
+    int capacity = s->slot_capacity ? s->slot_capacity * 2 : 64;
+    int *slots = region_alloc((size_t)capacity, sizeof(int));
+    memset(slots, -1, sizeof(int) * (size_t)capacity);
+    unsigned long mask = (unsigned long)capacity - 1;
+    for (int n = 0; n < s->var_count; n++) {
+        unsigned long i = name_hash(s->vars[n].name) & mask;
+        while (slots[i] >= 0) i = (i + 1) & mask;
+        slots[i] = n;
+    }
+    free(s->slots);
+    s->slots = slots;
+    s->slot_capacity = capacity;
+}
+
+/* Entry for a variable name, created undeclared and fresh */
+static RegionVar *var_get(RegionScan *s, const char *name) {
+    RegionVar *v = var_find(s, name);
+    if (v) return v;
+
+    if (s->var_count == s->var_capacity) {
+        s->var_capacity = s->var_capacity ? s->var_capacity * 2 : 32;
+        s->vars = realloc(s->vars, sizeof(RegionVar) * (size_t)s->var_capacity);
+        if (!s->vars) {
+            fprintf(stderr, "Fatal: Memory allocation failed\n");
+            exit(1);
+        }
+    }
+    /* Keep the table at most half full */
+    if ((s->var_count + 1) * 2 > s->slot_capacity) var_slots_grow(s);
+
+    int n = s->var_count++;
+    s->vars[n].name = name;
+    s->vars[n].declared = false;
+    s->vars[n].fresh = true;
+    unsigned long mask = (unsigned long)s->slot_capacity - 1;
+    unsigned long i = name_hash(name) & mask;
+    while (s->slots[i] >= 0) i = (i + 1) & mask;
+    s->slots[i] = n;
+    return &s->vars[n];
+}
+
+static void scan_init(RegionScan *s, const TACFunction *func) {
+    memset(s, 0, sizeof(*s));
+    int max_temp = -1;
+    for (const TACInstr *i = func->first; i; i = i->next) {
+        const TACOperand *ops[] = { &i->result, &i->arg1, &i->arg2, &i->arg3 };
+        for (int k = 0; k < 4; k++) {
+            if (ops[k]->kind == OPERAND_TEMP && ops[k]->val.temp_id > max_temp)
+                max_temp = ops[k]->val.temp_id;
+        }
+    }
+    s->temp_count = max_temp + 1;
+    s->temps = region_alloc((size_t)s->temp_count, 1);
+}
+
+static void scan_free(RegionScan *s) {
+    free(s->vars);
+    free(s->slots);
+    free(s->temps);
+}
+
+/* ============================================================================
+ * FUNCTION LOOKUP
+ * ============================================================================
+ */
+
+static int compare_funcs(const void *a, const void *b) {
+    const TACFunction *fa = *(const TACFunction *const *)a;
+    const TACFunction *fb = *(const TACFunction *const *)b;
+    return strcmp(fa->name, fb->name);
+}
+
+static int find_function(const IRRegionInfo *info, const char *name) {
+    int lo = 0, hi = info->func_count - 1;
+    while (lo <= hi) {
+        int mid = lo + (hi - lo) / 2;
+        int c = strcmp(info->funcs[mid]->name, name);
+        if (c == 0) return mid;
+        if (c < 0) lo = mid + 1;
+        else hi = mid - 1;
+    }
+    return -1;
+}
+
+/* Whether a call may let values escape: unknown callees count as yes */
+static bool call_escapes(const IRRegionInfo *info, const TACInstr *call) {
+    if (call->arg1.kind != OPERAND_FUNC || !call->arg1.val.name) return true;
+    const char *name = call->arg1.val.name;
+    if (strncmp(name, "__", 2) == 0) return false;     /* Runtime builtins */
+    int f = find_function(info, name);
+    return f < 0 || info->effects[f];
+}
+
+/* ============================================================================
+ * RANGE SCAN
+ * ============================================================================
+ */
+
+/*
+ * Whether a text or list value allocated in [first, stop) of func can be
+ * reached after it. A function range (zone = false) starts with the
+ * parameters declared and leaves calls to the call graph; a zone range
+ * judges its calls and the temps it shares with the rest of func.
+ */
+static bool range_escapes(const IRRegionInfo *info, const TACFunction *func,
+                          const TACInstr *first, const TACInstr *stop, bool zone) {
+    RegionScan s;
+    scan_init(&s, func);
+    bool escapes = false;
+
+    if (!zone) {
+        for (int p = 0; p < func->param_count; p++) {
+            RegionVar *v = var_get(&s, func->param_names[p]);
+            v->declared = true;
+            v->fresh = false;       /* The caller's list */
+        }
+    }
+
+    /* Step 1: what the range defines */
+    for (const TACInstr *i = first; i != stop; i = i->next) {
+        if (i->is_dead) continue;
+        if (i->opcode == TAC_DECL && i->result.kind == OPERAND_VAR) {
+            var_get(&s, i->result.val.name);
+        } else if (writes_result(i) && i->result.kind == OPERAND_VAR) {
+            RegionVar *v = var_get(&s, i->result.val.name);
+            if (i->opcode != TAC_LIST_CREATE) v->fresh = false;
+        } else if (writes_result(i)) {
+            unsigned char *t = &s.temps[i->result.val.temp_id];
+            if (i->opcode == TAC_STRBUF_BEGIN) *t |= TEMP_DEFINED | TEMP_BUILDER;
+            else if (is_reference_type(i->result.data_type)) *t |= TEMP_DEFINED;
+            *t |= i->opcode == TAC_LIST_CREATE ? TEMP_NEW_LIST : TEMP_REUSED;
+        }
+    }
+
+    /* Step 2: walk it in order */
+    for (const TACInstr *i = first; i != stop && !escapes; i = i->next) {
+        if (i->is_dead) continue;
+
+        if (zone) {
+            const TACOperand *reads[4];
+            int n = read_operands(i, reads);
+            for (int k = 0; k < n; k++) {
+                if (reads[k]->kind != OPERAND_TEMP) continue;
+                unsigned char t = s.temps[reads[k]->val.temp_id];
+                if ((t & TEMP_DEFINED) && !(t & TEMP_SEEN)) escapes = true;
+            }
+        }
+
+        switch (i->opcode) {
+            case TAC_DECL:
+                if (i->result.kind == OPERAND_VAR)
+                    var_get(&s, i->result.val.name)->declared = true;
+                break;
+
+            case TAC_LIST_APPEND:
+            case TAC_LIST_SET:
+                /* Only lists created in the range may take region memory */
+                if (i->result.kind == OPERAND_TEMP) {
+                    unsigned char t = s.temps[i->result.val.temp_id];
+                    if (!(t & TEMP_NEW_LIST) || (t & TEMP_REUSED)) escapes = true;
+                } else {
+                    const RegionVar *v = i->result.kind == OPERAND_VAR
+                                       ? var_find(&s, i->result.val.name) : NULL;
+                    if (!v || !v->declared || !v->fresh) escapes = true;
+                }
+                break;
+
+            case TAC_STRBUF_APPEND:
+            case TAC_STRBUF_END:
+            case TAC_STRBUF_TEXT:
+                if (i->arg1.kind != OPERAND_TEMP ||
+                    !(s.temps[i->arg1.val.temp_id] & TEMP_BUILDER))
+                    escapes = true;
+                break;
+
+            case TAC_CALL:
+                if (zone && call_escapes(info, i)) escapes = true;
+                break;
+
+            default:
+                break;
+        }
+
+        if (writes_result(i)) {
+            if (i->result.kind == OPERAND_TEMP) {
+                s.temps[i->result.val.temp_id] |= TEMP_SEEN;
+            } else if (is_reference_type(i->result.data_type) &&
+                       !var_find(&s, i->result.val.name)->declared) {
+                escapes = true;
+            }
+        }
+    }
+
+    /* A zone's temps must be dead after it */
+    if (zone && !escapes) {
+        bool inside = false;
+        for (const TACInstr *i = func->first; i && !escapes; i = i->next) {
+            if (i == first) inside = true;
+            if (i == stop) inside = false;
+            if (inside || i->is_dead) continue;
+            const TACOperand *reads[4];
+            int n = read_operands(i, reads);
+            for (int k = 0; k < n; k++) {
+                if (reads[k]->kind == OPERAND_TEMP &&
+                    (s.temps[reads[k]->val.temp_id] & TEMP_DEFINED))
+                    escapes = true;
+            }
+        }
+    }
+
+    scan_free(&s);
+    return escapes;
+}
+
+/* ============================================================================
+ * PUBLIC API
+ * ============================================================================
+ */
+
+IRRegionInfo *ir_region_analyze(const TACProgram *prog) {
+    IRRegionInfo *info = region_alloc(1, sizeof(IRRegionInfo));
+
+    for (const TACFunction *f = prog->functions; f; f = f->next) {
+        if (f->name) info->func_count++;
+    }
+    info->funcs = region_alloc((size_t)info->func_count, sizeof(TACFunction *));
+    info->effects = region_alloc((size_t)info->func_count, sizeof(bool));
+    int n = 0;
+    for (const TACFunction *f = prog->functions; f; f = f->next) {
+        if (f->name) info->funcs[n++] = f;
+    }
+    qsort(info->funcs, (size_t)n, sizeof(TACFunction *), compare_funcs);
+
+    /* Direct effects, and the call graph as (caller, callee) pairs */
+    int edge_count = 0, edge_capacity = 0;
+    int (*edges)[2] = NULL;
+    for (int f = 0; f < n; f++) {
+        const TACFunction *func = info->funcs[f];
+        info->effects[f] = range_escapes(info, func, func->first, NULL, false);
+        for (const TACInstr *i = func->first; i; i = i->next) {
+            if (i->is_dead || i->opcode != TAC_CALL) continue;
+            if (i->arg1.kind == OPERAND_FUNC && i->arg1.val.name &&
+                strncmp(i->arg1.val.name, "__", 2) == 0)
+                continue;
+            int callee = i->arg1.kind == OPERAND_FUNC && i->arg1.val.name
+                       ? find_function(info, i->arg1.val.name) : -1;
+            if (callee < 0) {
+                info->effects[f] = true;
+                continue;
+            }
+            if (edge_count == edge_capacity) {
+                edge_capacity = edge_capacity ? edge_capacity * 2 : 64;
+                edges = realloc(edges, sizeof(*edges) * (size_t)edge_capacity);
+                if (!edges) {
+                    fprintf(stderr, "Fatal: Memory allocation failed\n");
+                    exit(1);
+                }
+            }
+            edges[edge_count][0] = f;
+            edges[edge_count][1] = callee;
+            edge_count++;
+        }
+    }
+
+    /* Callers of each function, grouped by callee */
+    int *start = region_alloc((size_t)n + 1, sizeof(int));
+    int *callers = region_alloc((size_t)edge_count, sizeof(int));
+    for (int e = 0; e < edge_count; e++) start[edges[e][1] + 1]++;
+    for (int f = 0; f < n; f++) start[f + 1] += start[f];
+    int *fill = region_alloc((size_t)n + 1, sizeof(int));
+    memcpy(fill, start, sizeof(int) * ((size_t)n + 1));
+    for (int e = 0; e < edge_count; e++) callers[fill[edges[e][1]]++] = edges[e][0];
+
+    /* Propagate effects from callees to callers */
+    int *work = region_alloc((size_t)n, sizeof(int));
+    int top = 0;
+    for (int f = 0; f < n; f++) {
+        if (info->effects[f]) work[top++] = f;
+    }
+    while (top > 0) {
+        int f = work[--top];
+        for (int c = start[f]; c < start[f + 1]; c++) {
+            if (!info->effects[callers[c]]) {
+                info->effects[callers[c]] = true;
+                work[top++] = callers[c];
+            }
+        }
+    }
+
+    free(edges);
+    free(start);
+    free(callers);
+    free(fill);
+    free(work);
+    return info;
+}
+
+void ir_region_free(IRRegionInfo *info) {
+    if (!info) return;
+    free(info->funcs);
+    free(info->effects);
+    free(info);
+}
+
+bool ir_region_function(const IRRegionInfo *info, const TACFunction *func) {
+    if (!info || !func->name || is_reference_type(func->return_type)) return false;
+    int f = find_function(info, func->name);
+    return f >= 0 && info->funcs[f] == func && !info->effects[f];
+}
+
+bool ir_region_zone(const IRRegionInfo *info, const TACFunction *func,
+                    const TACInstr *zone) {
+    if (!info || zone->opcode != TAC_SECURE_BEGIN) return false;
+    int depth = 0;
+    const TACInstr *end = zone->next;
+    for (; end; end = end->next) {
+        if (end->opcode == TAC_SECURE_BEGIN) depth++;
+        else if (end->opcode == TAC_SECURE_END && depth-- == 0) break;
+    }
+    if (!end) return false;
+    return !range_escapes(info, func, zone->next, end, true);
+}
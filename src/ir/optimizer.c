@@ -12,6 +12,8 @@
  *  4. Strength Reduction      – x*2→x+x, pow(x,2)→x*x
  *  5. Redundant Load Elim.    – merge duplicate constant loads
  *  6. Dead Code Elimination   – remove instructions whose results are unused
+ *  7. Text Accumulators      – s = s + x in a loop appends to a builder
+ *  8. Concat Chain Fusion     – build a+b+c+... in one string builder
  *
  * All passes modify the TAC IR in-place and return a count of
  * transformations applied.
@@ -998,6 +1000,7 @@ static bool has_side_effect(TACOpcode op) {
         case TAC_DECL:
         case TAC_BREAK: case TAC_CONTINUE:
         case TAC_LIST_APPEND: case TAC_LIST_SET:
+        case TAC_STRBUF_APPEND:
             return true;
         default:
             /* তালিকার বাইরে থাকলে side-effect নেই ধরে false। */
@@ -1085,6 +1088,416 @@ int opt_dead_code_elimination(TACFunction *func, bool verbose) {
     return count;
 }
 
+/* ============================================================================
+ * PASS 7: LOOP TEXT ACCUMULATORS
+ *
+ * `report becomes report plus piece` in a loop copies all of report on
+ * every iteration, O(n^2) in its final length. When every write to a text
+ * variable inside a loop appends to it that way, the variable lives in a
+ * string builder for the whole loop:
+ *
+ *     t6 = STRBUF_BEGIN                 (in front of the loop head)
+ *     STRBUF_APPEND t6, report
+ *   L0: ...
+ *     STRBUF_APPEND t6, t5              (was t6 = report CONCAT t5;
+ *     ...                                    report = ASSIGN t6)
+ *     goto L0
+ *   L1:
+ *     report = STRBUF_END t6            (the loop's only exit)
+ *
+ * Any other read of the variable inside the loop is preceded by
+ * `report = STRBUF_TEXT t6`, a copy of the text so far. The loop must be
+ * entered only through its head, leave only to the label right after its
+ * back jump and not return. A call to a user function could see a
+ * variable that is not local to the function, which rules such variables
+ * out. Loops are tried outermost first, so the builder covers as many
+ * iterations as possible.
+ * ============================================================================
+ */
+
+/* A function's live instructions by position */
+typedef struct {
+    TACInstr **code;
+    int count;
+    int *def_pos;       /* temp -> position of its only definition, else -1 */
+    int *uses;          /* temp -> number of reads */
+    int *label_pos;     /* label -> position of the label */
+    int *jump_min;      /* label -> first and last position jumping to it */
+    int *jump_max;
+    int *loop_end;      /* position of a loop head label -> its back jump, else -1 */
+} AccumScan;
+
+static bool is_var_named(const TACOperand *op, const char *name) {
+    return op->kind == OPERAND_VAR && op->val.name && strcmp(op->val.name, name) == 0;
+}
+
+static bool is_jump(TACOpcode op) {
+    return op == TAC_GOTO || op == TAC_IF_GOTO || op == TAC_IF_FALSE_GOTO;
+}
+
+static void accum_scan_build(AccumScan *s, TACFunction *func) {
+    memset(s, 0, sizeof(*s));
+    int max_tid = -1, max_label = -1;
+    for (TACInstr *instr = func->first; instr; instr = instr->next) {
+        if (instr->is_dead) continue;
+        s->count++;
+        TACOperand *ops[] = { &instr->result, &instr->arg1, &instr->arg2, &instr->arg3 };
+        for (int j = 0; j < 4; j++) {
+            if (is_temp(ops[j]) && ops[j]->val.temp_id > max_tid)
+                max_tid = ops[j]->val.temp_id;
+        }
+        if ((instr->opcode == TAC_LABEL || is_jump(instr->opcode)) &&
+            instr->result.val.label_id > max_label)
+            max_label = instr->result.val.label_id;
+    }
+    size_t temps = (size_t)max_tid + 1, labels = (size_t)max_label + 1;
+    size_t count = (size_t)s->count + 1;
+    s->code = malloc(count * sizeof(TACInstr *));
+    s->loop_end = malloc(count * sizeof(int));
+    s->def_pos = malloc((temps + 1) * sizeof(int));
+    s->uses = calloc(temps + 1, sizeof(int));
+    s->label_pos = malloc((labels + 1) * sizeof(int));
+    s->jump_min = malloc((labels + 1) * sizeof(int));
+    s->jump_max = malloc((labels + 1) * sizeof(int));
+    if (!s->code || !s->loop_end || !s->def_pos || !s->uses ||
+        !s->label_pos || !s->jump_min || !s->jump_max) {
+        fprintf(stderr, "Fatal: Memory allocation failed\n");
+        exit(1);
+    }
+    for (size_t t = 0; t < temps; t++) s->def_pos[t] = -1;
+    for (size_t l = 0; l < labels; l++) {
+        s->label_pos[l] = -1;
+        s->jump_min[l] = -1;
+        s->jump_max[l] = -1;
+    }
+
+    int n = 0;
+    for (TACInstr *instr = func->first; instr; instr = instr->next) {
+        if (instr->is_dead) continue;
+        s->code[n] = instr;
+        s->loop_end[n] = -1;
+        if (is_temp(&instr->result)) {
+            int t = instr->result.val.temp_id;
+            /* একাধিক definition হলে -2: chain-এর অংশ হতে পারবে না। */
+            s->def_pos[t] = s->def_pos[t] == -1 ? n : -2;
+        }
+        TACOperand *args[] = { &instr->arg1, &instr->arg2, &instr->arg3 };
+        for (int j = 0; j < 3; j++) {
+            if (is_temp(args[j])) s->uses[args[j]->val.temp_id]++;
+        }
+        int label = instr->result.val.label_id;
+        if (instr->opcode == TAC_LABEL && label >= 0) s->label_pos[label] = n;
+        if (is_jump(instr->opcode) && label >= 0) {
+            if (s->jump_min[label] < 0) s->jump_min[label] = n;
+            s->jump_max[label] = n;
+        }
+        n++;
+    }
+
+    /* পেছনের label-এ unconditional goto একটি loop বন্ধ করে। */
+    for (int k = 0; k < s->count; k++) {
+        TACInstr *instr = s->code[k];
+        if (instr->opcode != TAC_GOTO || instr->result.val.label_id < 0) continue;
+        int h = s->label_pos[instr->result.val.label_id];
+        if (h >= 0 && h <= k && k > s->loop_end[h]) s->loop_end[h] = k;
+    }
+}
+
+static void accum_scan_free(AccumScan *s) {
+    free(s->code);
+    free(s->loop_end);
+    free(s->def_pos);
+    free(s->uses);
+    free(s->label_pos);
+    free(s->jump_min);
+    free(s->jump_max);
+}
+
+/*
+ * Whether the loop [h, e] has one entry (its head) and one exit (the label
+ * right after its back jump) and never returns; *has_call tells whether
+ * it calls a user function.
+ */
+static bool accum_loop_ok(const AccumScan *s, int h, int e, bool *has_call) {
+    if (s->code[e]->opcode != TAC_GOTO || e + 1 >= s->count) return false;
+    const TACInstr *after = s->code[e + 1];
+    if (after->opcode != TAC_LABEL || !after->next) return false;
+    int exit_label = after->result.val.label_id;
+    if (exit_label < 0 || s->jump_min[exit_label] < h || s->jump_max[exit_label] > e)
+        return false;
+
+    *has_call = false;
+    for (int k = h; k <= e; k++) {
+        const TACInstr *instr = s->code[k];
+        int label = instr->result.val.label_id;
+        switch (instr->opcode) {
+            case TAC_RETURN: case TAC_BREAK: case TAC_CONTINUE:
+                return false;
+            case TAC_LABEL:
+                /* loop-এর বাইরে থেকে ভেতরের কোনো label-এ jump চলবে না। */
+                if (label >= 0 && s->jump_min[label] >= 0 &&
+                    (s->jump_min[label] < h || s->jump_max[label] > e)) return false;
+                break;
+            case TAC_GOTO: case TAC_IF_GOTO: case TAC_IF_FALSE_GOTO:
+                /* বাইরে যাওয়ার একমাত্র পথ exit label। */
+                if (label != exit_label &&
+                    (label < 0 || s->label_pos[label] < h || s->label_pos[label] > e))
+                    return false;
+                break;
+            case TAC_CALL:
+                if (instr->arg1.kind == OPERAND_FUNC && instr->arg1.val.name &&
+                    strncmp(instr->arg1.val.name, "__", 2) != 0) *has_call = true;
+                break;
+            default:
+                break;
+        }
+    }
+    return true;
+}
+
+/* Whether `name` is a parameter or declared in a user function (not top-level) */
+static bool is_local_var(TACFunction *func, const char *name) {
+    if (!func->name) return false;
+    for (int k = 0; k < func->param_count; k++) {
+        if (func->param_names[k] && strcmp(func->param_names[k], name) == 0) return true;
+    }
+    for (TACInstr *instr = func->first; instr; instr = instr->next) {
+        if (instr->opcode == TAC_DECL && is_var_named(&instr->result, name)) return true;
+    }
+    return false;
+}
+
+/*
+ * Position of the head of the append chain
+ *     t1 = name CONCAT p1; t2 = t1 CONCAT p2; ...; name = ASSIGN tk
+ * ending in the write at k, all inside the loop starting at h; -1 when
+ * the write is anything else or the pieces read `name` themselves.
+ */
+static int accum_chain_head(const AccumScan *s, int h, int k, const char *name) {
+    const TACInstr *assign = s->code[k];
+    if (assign->opcode != TAC_ASSIGN || assign->arg1.kind != OPERAND_TEMP) return -1;
+    int t = assign->arg1.val.temp_id;
+    int head;
+    for (;;) {
+        int d = s->def_pos[t];
+        if (s->uses[t] != 1 || d < h || d >= k || s->code[d]->opcode != TAC_CONCAT) return -1;
+        head = d;
+        if (is_var_named(&s->code[d]->arg1, name)) break;
+        if (!is_temp(&s->code[d]->arg1)) return -1;
+        t = s->code[d]->arg1.val.temp_id;
+    }
+    for (int j = head; j < k; j++) {
+        const TACInstr *instr = s->code[j];
+        if ((j != head && is_var_named(&instr->arg1, name)) ||
+            is_var_named(&instr->arg2, name) || is_var_named(&instr->arg3, name) ||
+            is_var_named(&instr->result, name)) return -1;
+    }
+    return head;
+}
+
+/* Keep `name` in a builder across the loop [h, e] if every write appends to it */
+static bool lower_accumulator(TACFunction *func, const AccumScan *s, int h, int e,
+                              const char *name) {
+    int builder = -1;
+    for (int k = h; k <= e; k++) {
+        if (s->code[k]->is_dead || !is_var_named(&s->code[k]->result, name)) continue;
+        int head = accum_chain_head(s, h, k, name);
+        if (head < 0) return false;
+        if (builder < 0) builder = s->code[head]->result.val.temp_id;
+    }
+    if (builder < 0) return false;
+
+    TACOperand sb = tac_operand_temp(builder, TYPE_TEXT);
+    TACOperand var = tac_operand_var(name, TYPE_TEXT);
+
+    /* প্রতিটি append chain: link-গুলো builder-এ append, শেষের ASSIGN বাদ। */
+    for (int k = h; k <= e; k++) {
+        TACInstr *assign = s->code[k];
+        if (assign->is_dead || !is_var_named(&assign->result, name)) continue;
+        int t = assign->arg1.val.temp_id;
+        for (;;) {
+            TACInstr *link = s->code[s->def_pos[t]];
+            bool is_head = !is_temp(&link->arg1);
+            if (!is_head) t = link->arg1.val.temp_id;
+            release_operand(&link->arg1);
+            link->opcode = TAC_STRBUF_APPEND;
+            link->result = tac_operand_none();
+            link->arg1 = sb;
+            if (is_head) break;
+        }
+        assign->is_dead = true;
+    }
+
+    /* loop-এর ভেতরে অন্য যেকোনো read-এর আগে এখন পর্যন্ত জমা text materialize। */
+    for (int k = h; k <= e; k++) {
+        TACInstr *instr = s->code[k];
+        if (instr->is_dead) continue;
+        if (is_var_named(&instr->arg1, name) || is_var_named(&instr->arg2, name) ||
+            is_var_named(&instr->arg3, name))
+            tac_insert_before(func, instr, TAC_STRBUF_TEXT, var, sb, tac_operand_none());
+    }
+
+    tac_insert_before(func, s->code[h], TAC_STRBUF_BEGIN, sb,
+                      tac_operand_none(), tac_operand_none());
+    tac_insert_before(func, s->code[h], TAC_STRBUF_APPEND, tac_operand_none(), sb, var);
+    tac_insert_before(func, s->code[e + 1]->next, TAC_STRBUF_END, var, sb, tac_operand_none());
+    return true;
+}
+
+int opt_text_accumulators(TACFunction *func, bool verbose) {
+    int count = 0;
+    if (!func) return 0;
+
+    AccumScan s;
+    accum_scan_build(&s, func);
+
+    /* head position বাড়ার ক্রমে: বাইরের loop আগে। */
+    for (int h = 0; h < s.count; h++) {
+        int e = s.loop_end[h];
+        bool has_call;
+        if (e < 0 || !accum_loop_ok(&s, h, e, &has_call)) continue;
+
+        for (int k = h; k <= e; k++) {
+            TACInstr *write = s.code[k];
+            if (write->is_dead || write->opcode != TAC_ASSIGN ||
+                write->result.kind != OPERAND_VAR || write->result.data_type != TYPE_TEXT)
+                continue;
+            const char *name = write->result.val.name;
+            /* প্রতিটি variable একবারই বিচার করি: loop-এ তার প্রথম write-এ। */
+            bool seen = false;
+            for (int j = h; j < k && !seen; j++) {
+                seen = !s.code[j]->is_dead && is_var_named(&s.code[j]->result, name);
+            }
+            if (seen || (has_call && !is_local_var(func, name))) continue;
+            if (lower_accumulator(func, &s, h, e, name)) {
+                if (verbose) printf("  [accum] '%s' appended in a builder across loop\n", name);
+                count++;
+            }
+        }
+    }
+
+    accum_scan_free(&s);
+    return count;
+}
+
+/* ============================================================================
+ * PASS 8: CONCAT CHAIN FUSION
+ *
+ * "a" plus x plus "b" plus y lowers to a left-leaning chain
+ *     t1 = CONCAT "a", x;  t2 = CONCAT t1, "b";  t3 = CONCAT t2, y
+ * where every link allocates and copies the whole prefix again. When each
+ * intermediate temp is defined once and read only by the next link, the
+ * chain is rewritten to append into one string builder:
+ *     t1 = STRBUF_BEGIN
+ *     STRBUF_APPEND t1, "a";  STRBUF_APPEND t1, x
+ *     STRBUF_APPEND t1, "b";  STRBUF_APPEND t1, y
+ *     t3 = STRBUF_END t1
+ * Appends happen where the CONCATs were, so pieces are still evaluated in
+ * source order. A finished chain's builder is reused by the next one, so
+ * a function needs only as many builders as it has chains open at once.
+ * ============================================================================
+ */
+int opt_concat_fusion(TACFunction *func, bool verbose) {
+    int count = 0;
+    if (!func) return 0;
+
+    int max_tid = -1;
+    for (TACInstr *instr = func->first; instr; instr = instr->next) {
+        TACOperand *ops[] = { &instr->result, &instr->arg1, &instr->arg2, &instr->arg3 };
+        for (int j = 0; j < 4; j++) {
+            if (is_temp(ops[j]) && ops[j]->val.temp_id > max_tid)
+                max_tid = ops[j]->val.temp_id;
+        }
+    }
+    if (max_tid < 0) return 0;
+
+    /* temp প্রতি definition/use গণনা; CONCAT-এর result কিনা তাও রাখি। */
+    size_t n = (size_t)max_tid + 1;
+    int *defs = calloc(n, sizeof(int));
+    int *uses = calloc(n, sizeof(int));
+    unsigned char *from_concat = calloc(n, 1);
+    unsigned char *continued = calloc(n, 1);
+    int *builder_of = malloc(n * sizeof(int));
+    int *free_builders = malloc(n * sizeof(int));
+    if (!defs || !uses || !from_concat || !continued || !builder_of || !free_builders) {
+        fprintf(stderr, "Fatal: Memory allocation failed\n");
+        exit(1);
+    }
+    int free_count = 0;
+
+    for (TACInstr *instr = func->first; instr; instr = instr->next) {
+        if (instr->is_dead) continue;
+        if (is_temp(&instr->result)) {
+            defs[instr->result.val.temp_id]++;
+            if (instr->opcode == TAC_CONCAT) from_concat[instr->result.val.temp_id] = 1;
+        }
+        TACOperand *args[] = { &instr->arg1, &instr->arg2, &instr->arg3 };
+        for (int j = 0; j < 3; j++) {
+            if (is_temp(args[j])) uses[args[j]->val.temp_id]++;
+        }
+    }
+
+    /* কোন CONCAT result শুধু পরের link-এর arg1 হিসেবে পড়া হয়: সেটি chain-এর মাঝের অংশ। */
+    for (TACInstr *instr = func->first; instr; instr = instr->next) {
+        if (instr->is_dead || instr->opcode != TAC_CONCAT || !is_temp(&instr->arg1)) continue;
+        int t = instr->arg1.val.temp_id;
+        if (from_concat[t] && defs[t] == 1 && uses[t] == 1) continued[t] = 1;
+    }
+
+    for (size_t t = 0; t < n; t++) builder_of[t] = -1;
+
+    for (TACInstr *instr = func->first; instr; instr = instr->next) {
+        if (instr->is_dead || instr->opcode != TAC_CONCAT) continue;
+        int r = is_temp(&instr->result) ? instr->result.val.temp_id : -1;
+        int b = is_temp(&instr->arg1) ? builder_of[instr->arg1.val.temp_id] : -1;
+        bool more = r >= 0 && continued[r];
+
+        /* একক CONCAT (chain নয়) আগের মতোই থাকে। */
+        if (b < 0 && !more) continue;
+
+        if (b < 0) {
+            /* chain-এর প্রথম link: builder খুলে প্রথম দুই অংশ append। */
+            b = free_count > 0 ? free_builders[--free_count] : r;
+            TACOperand sb = tac_operand_temp(b, TYPE_TEXT);
+            tac_insert_before(func, instr, TAC_STRBUF_BEGIN, sb,
+                              tac_operand_none(), tac_operand_none());
+            tac_insert_before(func, instr, TAC_STRBUF_APPEND, tac_operand_none(),
+                              sb, instr->arg1);
+            release_operand(&instr->arg1);
+            instr->opcode = TAC_STRBUF_APPEND;
+            instr->result = tac_operand_none();
+            instr->arg1 = sb;
+            builder_of[r] = b;
+            count++;
+            if (verbose) printf("  [concat] chain from t%d built in t%d\n", r, b);
+        } else if (more) {
+            /* মাঝের link: শুধু নতুন অংশ append। */
+            instr->opcode = TAC_STRBUF_APPEND;
+            instr->result = tac_operand_none();
+            instr->arg1 = tac_operand_temp(b, TYPE_TEXT);
+            builder_of[r] = b;
+        } else {
+            /* শেষ link: শেষ অংশ append করে এক allocation-এ final string। */
+            TACOperand sb = tac_operand_temp(b, TYPE_TEXT);
+            tac_insert_before(func, instr, TAC_STRBUF_APPEND, tac_operand_none(),
+                              sb, instr->arg2);
+            release_operand(&instr->arg2);
+            instr->opcode = TAC_STRBUF_END;
+            instr->arg1 = sb;
+            instr->arg2 = tac_operand_none();
+            free_builders[free_count++] = b;
+        }
+    }
+
+    free(defs);
+    free(uses);
+    free(from_concat);
+    free(continued);
+    free(builder_of);
+    free(free_builders);
+    return count;
+}
+
 /* ============================================================================
  * SWEEP: Remove dead instructions from the linked list
  * ============================================================================
@@ -1177,6 +1590,8 @@ OptOptions opt_default_options(OptLevel level) {
             /* level 1: safe/basic subset (fold + dce) enable। */
             opts.constant_folding = true;
             opts.dead_code_elimination = true;
+            opts.text_accumulators = true;
+            opts.concat_fusion = true;
             break;
         case OPT_LEVEL_2:
             /* level 2: aggressive/general optimization pass set enable। */
@@ -1186,6 +1601,8 @@ OptOptions opt_default_options(OptLevel level) {
             opts.algebraic_simplification = true;
             opts.strength_reduction = true;
             opts.redundant_load_elimination = true;
+            opts.text_accumulators = true;
+            opts.concat_fusion = true;
             break;
     }
 
@@ -1269,6 +1686,18 @@ static void optimize_function(TACFunction *func, OptOptions *opts, OptStats *sta
     /* Sweep dead instructions */
     /* dead-marked node-গুলো physical list থেকে remove করি। */
     opt_sweep_dead(func);
+
+    /* Loop-এর text accumulator: chain fusion-এর আগে, যাতে append chain-গুলো এটিই পায়। */
+    if (opts->text_accumulators) {
+        int n = opt_text_accumulators(func, opts->verbose);
+        stats->text_accumulators_lowered += n;
+        if (n > 0) opt_sweep_dead(func);
+    }
+
+    /* Concat chain fusion: অন্য pass-এর পরে একবারই চালাই, যাতে ওরা শুধু CONCAT দেখে। */
+    if (opts->concat_fusion) {
+        stats->concat_chains_fused += opt_concat_fusion(func, opts->verbose);
+    }
 }
 
 OptStats ir_optimize(TACProgram *program, OptOptions *options) {
@@ -1338,6 +1767,8 @@ void opt_print_stats(OptStats *stats) {
     printf("  Strength reductions:     %d\n", stats->strength_reductions);
     printf("  Redundant loads removed: %d\n", stats->redundant_loads_removed);
     printf("  Dead code eliminated:    %d\n", stats->dead_instructions_removed);
+    printf("  Text accumulators:       %d\n", stats->text_accumulators_lowered);
+    printf("  Concat chains fused:     %d\n", stats->concat_chains_fused);
     printf("  Instructions before:     %d\n", stats->total_instructions_before);
     printf("  Instructions after:      %d\n", stats->total_instructions_after);
     int saved = stats->total_instructions_before - stats->total_instructions_after;
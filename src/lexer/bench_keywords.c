@@ -0,0 +1,174 @@
+/*
+ * NatureLang Compiler
+ * Copyright (c) 2026
+ *
+ * Keyword Lookup Microbenchmark
+ *
+ * Compares the generated perfect-hash lookup_keyword() against the
+ * previous implementation (lowercase copy + linear strcmp over the
+ * keyword table), which is reproduced here as lookup_keyword_linear().
+ *
+ * The workload mixes keywords in three casings with typical identifier
+ * lexemes, roughly the split seen when lexing real sources. Before
+ * timing, both lookups are run over the workload and must agree.
+ *
+ * Usage: bench_keywords [iterations]
+ * Build: make bench-keywords BUILD_TYPE=release
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+
+#include "tokens.h"
+
+/* ============================================================================
+ * BASELINE: the pre-hash lookup, kept verbatim for comparison
+ * ============================================================================
+ */
+static TokenType lookup_keyword_linear(const char *str) {
+    if (str == NULL) return TOK_IDENTIFIER;
+
+    char lower[256];
+    size_t i;
+    for (i = 0; str[i] && i < 255; i++) {
+        lower[i] = tolower((unsigned char)str[i]);
+    }
+    lower[i] = '\0';
+
+    const KeywordEntry *table = get_keyword_table();
+    size_t n = get_keyword_table_size();
+    for (i = 0; i < n; i++) {
+        if (strcmp(lower, table[i].keyword) == 0) {
+            return table[i].type;
+        }
+    }
+    return TOK_IDENTIFIER;
+}
+
+/* ============================================================================
+ * WORKLOAD
+ * ============================================================================
+ */
+static const char *identifiers[] = {
+    "x", "y", "i", "counter", "total", "score", "scores", "name", "result",
+    "age", "temperature", "is_valid", "maxValue", "student_count", "average",
+    "first_name", "Total", "index", "sum", "value", "numbers", "items",
+    "message", "greeting", "piece", "answer", "limit", "step", "ab", "tex",
+};
+
+static char **build_workload(size_t *out_count) {
+    const KeywordEntry *table = get_keyword_table();
+    size_t nkw = get_keyword_table_size();
+    size_t nid = sizeof(identifiers) / sizeof(identifiers[0]);
+    /* lowercase + Capitalized + UPPERCASE keywords, plus identifiers twice */
+    size_t count = nkw * 3 + nid * 2;
+    char **words = malloc(count * sizeof(char *));
+    if (!words) {
+        fprintf(stderr, "Fatal: out of memory\n");
+        exit(1);
+    }
+
+    size_t k = 0;
+    for (size_t i = 0; i < nkw; i++) {
+        char *lower = strdup(table[i].keyword);
+        char *cap = strdup(table[i].keyword);
+        char *upper = strdup(table[i].keyword);
+        if (!lower || !cap || !upper) {
+            fprintf(stderr, "Fatal: out of memory\n");
+            exit(1);
+        }
+        cap[0] = (char)toupper((unsigned char)cap[0]);
+        for (char *p = upper; *p; p++) *p = (char)toupper((unsigned char)*p);
+        words[k++] = lower;
+        words[k++] = cap;
+        words[k++] = upper;
+    }
+    for (int rep = 0; rep < 2; rep++) {
+        for (size_t i = 0; i < nid; i++) {
+            words[k++] = strdup(identifiers[i]);
+        }
+    }
+
+    *out_count = k;
+    return words;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+typedef TokenType (*LookupFn)(const char *);
+
+static double run(LookupFn fn, char **words, size_t count, long iterations,
+                  unsigned long *checksum) {
+    unsigned long sum = 0;
+    double start = now_seconds();
+    for (long it = 0; it < iterations; it++) {
+        for (size_t i = 0; i < count; i++) {
+            sum += (unsigned long)fn(words[i]);
+        }
+    }
+    double elapsed = now_seconds() - start;
+    *checksum = sum;
+    return elapsed;
+}
+
+/* ============================================================================
+ * MAIN
+ * ============================================================================
+ */
+int main(int argc, char *argv[]) {
+    long iterations = argc > 1 ? atol(argv[1]) : 20000;
+    if (iterations <= 0) {
+        fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    size_t count;
+    char **words = build_workload(&count);
+
+    /* Correctness first: both lookups must classify every lexeme alike */
+    int mismatches = 0;
+    for (size_t i = 0; i < count; i++) {
+        TokenType a = lookup_keyword_linear(words[i]);
+        TokenType b = lookup_keyword(words[i]);
+        if (a != b) {
+            fprintf(stderr, "Mismatch for '%s': linear=%s hash=%s\n", words[i],
+                    token_type_to_string(a), token_type_to_string(b));
+            mismatches++;
+        }
+    }
+    if (mismatches > 0) {
+        fprintf(stderr, "✗ %d mismatching lookups\n", mismatches);
+        return 1;
+    }
+
+    unsigned long sum_linear, sum_hash;
+    double t_linear = run(lookup_keyword_linear, words, count, iterations, &sum_linear);
+    double t_hash = run(lookup_keyword, words, count, iterations, &sum_hash);
+    double total = (double)count * (double)iterations;
+
+    printf("Keyword lookup benchmark\n");
+    printf("  keywords:        %zu\n", get_keyword_table_size());
+    printf("  lexemes/iter:    %zu\n", count);
+    printf("  iterations:      %ld\n", iterations);
+    printf("  linear (before): %12.0f lookups/sec  (%.3f s)\n",
+           total / t_linear, t_linear);
+    printf("  hash   (after):  %12.0f lookups/sec  (%.3f s)\n",
+           total / t_hash, t_hash);
+    printf("  speedup:         %.2fx\n", t_hash > 0 ? t_linear / t_hash : 0.0);
+    if (sum_linear != sum_hash) {
+        fprintf(stderr, "✗ checksum mismatch\n");
+        return 1;
+    }
+
+    for (size_t i = 0; i < count; i++) free(words[i]);
+    free(words);
+    return 0;
+}
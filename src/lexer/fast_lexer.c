@@ -0,0 +1,687 @@
+/*
+ * NatureLang Compiler
+ * Copyright (c) 2026
+ *
+ * Hand-Written Lexer
+ *
+ * A parser-mode lexer that mirrors the flex rules in naturelang.l rule by
+ * rule, including flex's longest-match / first-rule tie breaking:
+ *
+ *   - whitespace and newlines, "--" comment bodies and string bodies are
+ *     skipped with SSE2 (or AVX2 when built with -mavx2) block scans;
+ *   - a word is looked up once in the perfect hash generated from
+ *     lexer_words.def; if it starts multi-word phrases ("multiplied by",
+ *     "is greater than", filler phrases) those are tried and the longest
+ *     match wins, exactly like the {WHITESPACE}+ patterns in flex;
+ *   - everything else (numbers, operators, char literals, comments) is a
+ *     small hand-coded state machine.
+ *
+ * Deviations from flex are limited to diagnostics: lexer error messages
+ * report the true line (flex's column tracking counts newlines twice),
+ * and where flex would ECHO an unmatched byte to stdout (a backslash
+ * before a newline inside a string, a newline inside a char literal) the
+ * byte is silently dropped.
+ *
+ * Must be compiled with USE_BISON_TOKENS (token numbers come from the
+ * Bison header).
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#ifndef USE_BISON_TOKENS
+#error "fast_lexer.c is a parser-mode lexer; build it with -DUSE_BISON_TOKENS"
+#endif
+
+#include "fast_lexer.h"
+#include "keyword_hash.h"
+#include "lexer_word_tables.h"
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/* Forward declare keyword lookup (implemented in tokens.c), as naturelang.l does */
+int lookup_keyword_n(const char *str, size_t len);
+
+/* ============================================================================
+ * WORD TABLE (lexer_words.def)
+ * ============================================================================
+ */
+
+#define LW_SKIP      (-1)   /* Filler: consume, no token */
+#define LW_HEAD_ONLY (-2)   /* Phrase head that is an identifier on its own */
+
+#define LEXWORD(word, tok) word,
+#define LEXPHRASE(pattern, tok)
+static const char *const lw_words[] = {
+#include "lexer_words.def"
+};
+#undef LEXWORD
+#undef LEXPHRASE
+
+#define LEXWORD(word, tok) tok,
+#define LEXPHRASE(pattern, tok)
+static const int lw_word_token[] = {
+#include "lexer_words.def"
+};
+#undef LEXWORD
+#undef LEXPHRASE
+
+#define LEXWORD(word, tok)
+#define LEXPHRASE(pattern, tok) pattern,
+static const char *const lw_phrases[] = {
+#include "lexer_words.def"
+};
+#undef LEXWORD
+#undef LEXPHRASE
+
+#define LEXWORD(word, tok)
+#define LEXPHRASE(pattern, tok) tok,
+static const int lw_phrase_token[] = {
+#include "lexer_words.def"
+};
+#undef LEXWORD
+#undef LEXPHRASE
+
+_Static_assert(sizeof(lw_words) / sizeof(lw_words[0]) == KW_COUNT,
+               "lexer_word_tables.h is stale; rebuild it from lexer_words.def");
+_Static_assert(sizeof(lw_phrases) / sizeof(lw_phrases[0]) == KW_PHRASES,
+               "lexer_word_tables.h is stale; rebuild it from lexer_words.def");
+
+/* Perfect-hash lookup; returns the LEXWORD index or -1 */
+static int lw_lookup(const char *str, size_t len) {
+    if (len < KW_MIN_LEN || len > KW_MAX_LEN) {
+        return -1;
+    }
+    uint32_t h = kw_hash(str, len);
+    uint32_t slot = kw_displace(h, kw_bucket_disp[h % KW_BUCKETS]) % KW_COUNT;
+    if (kw_slot_len[slot] != len) {
+        return -1;
+    }
+    int index = kw_slot_index[slot];
+    const char *word = lw_words[index];
+    for (size_t i = 0; i < len; i++) {
+        if (kw_fold((unsigned char)str[i]) != (unsigned char)word[i]) {
+            return -1;
+        }
+    }
+    return index;
+}
+
+/*
+ * Match the rest of a phrase (after its first word) at p.
+ * ' ' in the pattern is {WHITESPACE}+ = [ \t\r]+; other bytes match
+ * case-insensitively. Returns the number of bytes matched, 0 on failure.
+ */
+static size_t match_phrase_tail(const char *p, const char *pattern) {
+    const char *start = p;
+    for (; *pattern; pattern++) {
+        if (*pattern == ' ') {
+            if (*p != ' ' && *p != '\t' && *p != '\r') return 0;
+            while (*p == ' ' || *p == '\t' || *p == '\r') p++;
+        } else {
+            if (kw_fold((unsigned char)*p) != (unsigned char)*pattern) return 0;
+            p++;
+        }
+    }
+    return (size_t)(p - start);
+}
+
+/* ============================================================================
+ * CHARACTER CLASSES
+ * ============================================================================
+ */
+
+static inline int is_ident_start(unsigned char c) {
+    return (unsigned)((c | 0x20) - 'a') < 26u || c == '_';
+}
+
+static inline int is_ident_char(unsigned char c) {
+    return is_ident_start(c) || (unsigned)(c - '0') < 10u;
+}
+
+static inline int is_digit(unsigned char c) {
+    return (unsigned)(c - '0') < 10u;
+}
+
+static inline int is_hex_digit(unsigned char c) {
+    return is_digit(c) || (unsigned)((c | 0x20) - 'a') < 6u;
+}
+
+/* ============================================================================
+ * BLOCK SCANS
+ * ============================================================================
+ * Loads are aligned to the block size, so a load never crosses a page
+ * boundary and cannot fault even when it extends past the end of the
+ * buffer; bytes before the start position are masked off. Every scan
+ * stops at a NUL, and the buffer always ends with NULs, so no scan runs
+ * off the end. AddressSanitizer would still flag the over-read inside
+ * the last aligned block, so the scans are excluded from instrumentation.
+ */
+
+#if defined(__SANITIZE_ADDRESS__)
+#define NO_ASAN __attribute__((no_sanitize_address))
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define NO_ASAN __attribute__((no_sanitize_address))
+#endif
+#endif
+#ifndef NO_ASAN
+#define NO_ASAN
+#endif
+
+#if defined(__AVX2__)
+#define SCAN_BLOCK 32
+typedef __m256i scan_vec;
+NO_ASAN
+static inline scan_vec scan_load(const char *p) {
+    return _mm256_load_si256((const __m256i *)p);
+}
+static inline uint32_t scan_eq(scan_vec v, char c) {
+    return (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(c)));
+}
+#elif defined(__SSE2__)
+#define SCAN_BLOCK 16
+typedef __m128i scan_vec;
+NO_ASAN
+static inline scan_vec scan_load(const char *p) {
+    return _mm_load_si128((const __m128i *)p);
+}
+static inline uint32_t scan_eq(scan_vec v, char c) {
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(c)));
+}
+#endif
+
+#ifdef SCAN_BLOCK
+#define SCAN_ALL_BITS ((uint32_t)((1ull << SCAN_BLOCK) - 1))
+
+static inline const char *scan_align(const char *p) {
+    return (const char *)((uintptr_t)p & ~(uintptr_t)(SCAN_BLOCK - 1));
+}
+#endif
+
+/* First byte at or after p equal to a, b, c or d (p must be NUL-bounded) */
+NO_ASAN
+static const char *scan_find4(const char *p, char a, char b, char c, char d) {
+#ifdef SCAN_BLOCK
+    const char *block = scan_align(p);
+    unsigned skip = (unsigned)(p - block);
+    for (;;) {
+        scan_vec v = scan_load(block);
+        uint32_t m = scan_eq(v, a) | scan_eq(v, b) | scan_eq(v, c) | scan_eq(v, d);
+        m &= SCAN_ALL_BITS << skip;
+        if (m != 0) {
+            return block + __builtin_ctz(m);
+        }
+        block += SCAN_BLOCK;
+        skip = 0;
+    }
+#else
+    while (*p != a && *p != b && *p != c && *p != d) p++;
+    return p;
+#endif
+}
+
+/*
+ * Skip [ \t\r\n]* starting at p, counting newlines into *lines and
+ * recording the byte after the last newline in *line_start.
+ */
+NO_ASAN
+static const char *scan_space(const char *p, int *lines, const char **line_start) {
+#ifdef SCAN_BLOCK
+    const char *block = scan_align(p);
+    uint32_t keep = (SCAN_ALL_BITS << (unsigned)(p - block)) & SCAN_ALL_BITS;
+    for (;;) {
+        scan_vec v = scan_load(block);
+        uint32_t nl = scan_eq(v, '\n');
+        uint32_t ws = scan_eq(v, ' ') | scan_eq(v, '\t') | scan_eq(v, '\r') | nl;
+        uint32_t stop = ~ws & keep;
+        uint32_t before = stop ? ((1u << __builtin_ctz(stop)) - 1) : SCAN_ALL_BITS;
+        nl &= keep & before;
+        if (nl != 0) {
+            *lines += __builtin_popcount(nl);
+            *line_start = block + (31 - __builtin_clz(nl)) + 1;
+        }
+        if (stop != 0) {
+            return block + __builtin_ctz(stop);
+        }
+        block += SCAN_BLOCK;
+        keep = SCAN_ALL_BITS;
+    }
+#else
+    for (;; p++) {
+        if (*p == '\n') {
+            (*lines)++;
+            *line_start = p + 1;
+        } else if (*p != ' ' && *p != '\t' && *p != '\r') {
+            return p;
+        }
+    }
+#endif
+}
+
+/* ============================================================================
+ * DIAGNOSTICS
+ * ============================================================================
+ */
+
+static void fast_lexer_error(FastLexer *lx, const char *at, const char *msg) {
+    lx->error_count++;
+    fprintf(stderr, "\033[1;31mLexer Error\033[0m at %s:%d:%d: %s\n",
+            lx->filename, lx->line, (int)(at - lx->line_start) + 1, msg);
+}
+
+/* ============================================================================
+ * PUBLIC API
+ * ============================================================================
+ */
+
+int fast_lexer_init(FastLexer *lx, char *base, size_t size, const char *filename) {
+    if (base == NULL || size < 2 || base[size - 2] != '\0' || base[size - 1] != '\0') {
+        return -1;
+    }
+    lx->cur = base;
+    lx->end = base + size - 2;
+    lx->line_start = base;
+    lx->tok_start = base;
+    lx->tok_len = 0;
+    lx->line = 1;
+    lx->mode = FAST_LEXER_NORMAL;
+    lx->filename = filename ? filename : "<buffer>";
+    lx->error_count = 0;
+    lx->text[0] = '\0';
+    return 0;
+}
+
+int fast_lexer_lineno(const FastLexer *lx) {
+    return lx->line;
+}
+
+const char *fast_lexer_text(FastLexer *lx) {
+    size_t n = lx->tok_len < FAST_LEXER_TEXT_MAX - 1 ? lx->tok_len : FAST_LEXER_TEXT_MAX - 1;
+    memcpy(lx->text, lx->tok_start, n);
+    lx->text[n] = '\0';
+    return lx->text;
+}
+
+/*
+ * NUL-terminated copy of a numeric lexeme (the source is not terminated
+ * after it), so the same atof/atoll conversions as the flex rules apply.
+ * Uses buf when it fits; otherwise the result must be freed.
+ */
+static char *lexeme_copy(const char *p, size_t len, char *buf, size_t buf_size) {
+    char *out = buf;
+    if (len >= buf_size) {
+        out = malloc(len + 1);
+        if (out == NULL) {
+            fprintf(stderr, "Fatal: Memory allocation failed\n");
+            exit(1);
+        }
+    }
+    memcpy(out, p, len);
+    out[len] = '\0';
+    return out;
+}
+
+/* Length of [eE][+-]?[0-9]+ at p, or 0 */
+static size_t exponent_length(const char *p) {
+    size_t n = 1;
+    if ((*p | 0x20) != 'e') return 0;
+    if (p[n] == '+' || p[n] == '-') n++;
+    if (!is_digit((unsigned char)p[n])) return 0;
+    while (is_digit((unsigned char)p[n])) n++;
+    return n;
+}
+
+/*
+ * String literal body after the opening quote (flex STRING_STATE).
+ * Decodes in place: the write position never passes the read position.
+ */
+static int lex_string(FastLexer *lx, YYSTYPE *lval) {
+    char *p = lx->cur;
+    char *out = p;
+    char *start = p;
+
+    for (;;) {
+        char *q = (char *)scan_find4(p, '"', '\\', '\n', '\0');
+        if (*q == '\0' && q != lx->end) {
+            /* NUL inside the file is an ordinary body byte */
+            q++;
+            memmove(out, p, (size_t)(q - p));
+            out += q - p;
+            p = q;
+            continue;
+        }
+        if (q != p) {
+            memmove(out, p, (size_t)(q - p));
+            out += q - p;
+            p = q;
+        }
+
+        if (*p == '"') {
+            *out = '\0';
+            lval->slice.ptr = start;
+            lval->slice.len = (int)(out - start);
+            lx->cur = p + 1;
+            return TOK_STRING;
+        }
+        if (*p == '\n') {
+            fast_lexer_error(lx, p, "Unterminated string (newline in string)");
+            lx->line++;
+            lx->cur = p + 1;
+            lx->line_start = lx->cur;
+            return TOK_ERROR;
+        }
+        if (*p == '\0') {
+            lx->cur = p;
+            lx->mode = FAST_LEXER_IN_STRING;
+            fast_lexer_error(lx, p, "Unterminated string (end of file)");
+            return TOK_ERROR;
+        }
+
+        /* Backslash escape (case-insensitive, like every flex rule) */
+        unsigned char e = (unsigned char)p[1];
+        switch (e) {
+            case 'n': case 'N':  *out++ = '\n'; p += 2; break;
+            case 't': case 'T':  *out++ = '\t'; p += 2; break;
+            case 'r': case 'R':  *out++ = '\r'; p += 2; break;
+            case '\\': *out++ = '\\'; p += 2; break;
+            case '"':  *out++ = '"';  p += 2; break;
+            case '\n':
+                /* No flex rule matches: flex ECHOes the backslash */
+                p += 1;
+                break;
+            default:
+                if (e >= '0' && e <= '7') {
+                    int val = 0;
+                    int n = 1;
+                    while (n <= 3 && p[n] >= '0' && p[n] <= '7') {
+                        val = val * 8 + (p[n] - '0');
+                        n++;
+                    }
+                    if (val > 255) {
+                        fast_lexer_error(lx, p, "Octal escape sequence out of range");
+                    }
+                    *out++ = (char)val;
+                    p += n;
+                } else if ((e | 0x20) == 'x' && is_hex_digit((unsigned char)p[2])) {
+                    int n = is_hex_digit((unsigned char)p[3]) ? 4 : 3;
+                    char hex[3] = {p[2], n == 4 ? p[3] : '\0', '\0'};
+                    *out++ = (char)strtol(hex, NULL, 16);
+                    p += n;
+                } else if (e == '\0' && p + 1 == lx->end) {
+                    /* Backslash at end of input: ECHOed, then end of file */
+                    p += 1;
+                } else {
+                    fast_lexer_error(lx, p, "Invalid escape sequence");
+                    *out++ = (char)e;
+                    p += 2;
+                }
+                break;
+        }
+    }
+}
+
+/*
+ * Character literal after the opening quote (flex CHAR_STATE).
+ * Returns a token, or -1 when the literal consumed nothing that yields
+ * one yet (newline inside the literal).
+ */
+static int lex_char(FastLexer *lx, YYSTYPE *lval) {
+    for (;;) {
+        char *p = lx->cur;
+        char e = (char)(p[1] | 0x20);
+        if (p[0] == '\\' && p[2] == '\'' &&
+            (e == 'n' || e == 't' || e == 'r' || p[1] == '\\' || p[1] == '\'')) {
+            char c = e == 'n' ? '\n' : e == 't' ? '\t' : e == 'r' ? '\r' : p[1];
+            lval->char_val = c;
+            lx->cur = p + 3;
+            return TOK_CHAR;
+        }
+        if (p == lx->end) {
+            /* No <<EOF>> rule for CHAR_STATE: flex ends the scan */
+            return 0;
+        }
+        if (p[0] != '\\' && p[0] != '\'' && p[0] != '\n' && p[1] == '\'') {
+            lval->char_val = p[0];
+            lx->cur = p + 2;
+            return TOK_CHAR;
+        }
+        if (p[0] == '\n') {
+            /* No flex rule matches a newline here; flex ECHOes it */
+            lx->line++;
+            lx->cur = p + 1;
+            lx->line_start = lx->cur;
+            continue;
+        }
+        fast_lexer_error(lx, p, "Invalid character literal");
+        lx->cur = p + 1;
+        return TOK_ERROR;
+    }
+}
+
+/* A word, with its phrases; returns a token or LW_SKIP */
+static int lex_word(FastLexer *lx, YYSTYPE *lval) {
+    char *start = lx->cur;
+    char *p = start + 1;
+    while (is_ident_char((unsigned char)*p)) p++;
+    size_t len = (size_t)(p - start);
+    int token = LW_HEAD_ONLY;
+
+    int index = lw_lookup(start, len);
+    if (index >= 0) {
+        token = lw_word_token[index];
+        size_t best = len;
+        int first = kw_phrase_first[index];
+        int count = kw_phrase_count[index];
+        for (int i = first; i < first + count; i++) {
+            int phrase = kw_phrase_order[i];
+            size_t tail = match_phrase_tail(p, lw_phrases[phrase] + len);
+            /* Longest match wins; on a tie the earlier rule (already kept) */
+            if (tail > 0 && len + tail > best) {
+                best = len + tail;
+                token = lw_phrase_token[phrase];
+            }
+        }
+        p = start + best;
+    }
+    lx->cur = p;
+
+    if (token != LW_HEAD_ONLY) {
+        return token;
+    }
+    /* {IDENTIFIER} rule */
+    int kw = lookup_keyword_n(start, len);
+    if (kw != TOK_IDENTIFIER) {
+        return kw;
+    }
+    lval->slice.ptr = start;
+    lval->slice.len = (int)len;
+    return TOK_IDENTIFIER;
+}
+
+/* {INTEGER}{EXPONENT} | {FLOAT}{EXPONENT}? | {INTEGER}, at a digit or '.' */
+static int lex_number(FastLexer *lx, YYSTYPE *lval) {
+    char *start = lx->cur;
+    char *p = start;
+    int is_float = 0;
+
+    while (is_digit((unsigned char)*p)) p++;
+    if (*p == '.' && (p != start || is_digit((unsigned char)p[1]))) {
+        p++;
+        while (is_digit((unsigned char)*p)) p++;
+        is_float = 1;
+    }
+    size_t exp = exponent_length(p);
+    if (exp > 0) {
+        p += exp;
+        is_float = 1;
+    }
+    lx->cur = p;
+
+    char buf[64];
+    char *text = lexeme_copy(start, (size_t)(p - start), buf, sizeof(buf));
+    int token;
+    if (is_float) {
+        lval->float_val = atof(text);
+        token = TOK_FLOAT;
+    } else {
+        lval->int_val = atoll(text);
+        token = TOK_INTEGER;
+    }
+    if (text != buf) {
+        free(text);
+    }
+    return token;
+}
+
+/* One rule application; returns a token, or -1 to keep scanning */
+static int lex_one(FastLexer *lx, YYSTYPE *lval) {
+    char *p = lx->cur;
+    unsigned char c = (unsigned char)*p;
+
+    if (is_ident_start(c)) {
+        int token = lex_word(lx, lval);
+        return token == LW_SKIP ? -1 : token;
+    }
+    if (is_digit(c) || (c == '.' && is_digit((unsigned char)p[1]))) {
+        return lex_number(lx, lval);
+    }
+
+    lx->cur = p + 1;
+    switch (c) {
+        case '"':
+            return lex_string(lx, lval);
+        case '\'':
+            return lex_char(lx, lval);
+        case '-':
+            if (p[1] == '-') {
+                /* Line comment: up to and including the newline */
+                const char *q = p + 2;
+                for (;;) {
+                    q = scan_find4(q, '\n', '\0', '\n', '\0');
+                    if (*q == '\0' && q != lx->end) { q++; continue; }
+                    break;
+                }
+                if (*q == '\n') {
+                    lx->line++;
+                    lx->line_start = (char *)q + 1;
+                    lx->cur = (char *)q + 1;
+                } else {
+                    lx->cur = (char *)q;
+                }
+                return -1;
+            }
+            if (p[1] == '>') { lx->cur = p + 2; return TOK_OP_ARROW; }
+            return TOK_OP_MINUS;
+        case '{':
+            if (p[1] == '-') {
+                /* Block comment (not nested) */
+                const char *q = p + 2;
+                for (;;) {
+                    q = scan_find4(q, '-', '\n', '\0', '-');
+                    if (*q == '-') {
+                        if (q[1] == '}') { lx->cur = (char *)q + 2; return -1; }
+                        q++;
+                    } else if (*q == '\n') {
+                        lx->line++;
+                        lx->line_start = (char *)q + 1;
+                        q++;
+                    } else if (q != lx->end) {
+                        q++;
+                    } else {
+                        lx->cur = (char *)q;
+                        lx->mode = FAST_LEXER_IN_COMMENT;
+                        fast_lexer_error(lx, q, "Unterminated block comment");
+                        return TOK_ERROR;
+                    }
+                }
+            }
+            return TOK_LBRACE;
+        case '+': return TOK_OP_PLUS;
+        case '*': return TOK_OP_STAR;
+        case '/': return TOK_OP_SLASH;
+        case '%': return TOK_OP_PERCENT;
+        case '^': return TOK_OP_CARET;
+        case '=':
+            if (p[1] == '=') { lx->cur = p + 2; return TOK_OP_EQEQ; }
+            return TOK_OP_EQ;
+        case '!':
+            if (p[1] == '=') { lx->cur = p + 2; return TOK_OP_NEQ; }
+            return TOK_OP_NOT;
+        case '<':
+            if (p[1] == '>') { lx->cur = p + 2; return TOK_OP_NEQ; }
+            if (p[1] == '=') { lx->cur = p + 2; return TOK_OP_LTE; }
+            return TOK_OP_LT;
+        case '>':
+            if (p[1] == '=') { lx->cur = p + 2; return TOK_OP_GTE; }
+            return TOK_OP_GT;
+        case '&':
+            if (p[1] == '&') { lx->cur = p + 2; return TOK_OP_AND; }
+            break;
+        case '|':
+            if (p[1] == '|') { lx->cur = p + 2; return TOK_OP_OR; }
+            break;
+        case ':': return TOK_OP_COLON;
+        case '(': return TOK_LPAREN;
+        case ')': return TOK_RPAREN;
+        case '[': return TOK_LBRACKET;
+        case ']': return TOK_RBRACKET;
+        case '}': return TOK_RBRACE;
+        case ',': return TOK_COMMA;
+        case '.': return TOK_DOT;
+        case ';': return TOK_SEMICOLON;
+        default:
+            break;
+    }
+
+    char msg[64];
+    snprintf(msg, sizeof(msg), "Unexpected character '%c' (0x%02X)", (char)c, c);
+    fast_lexer_error(lx, p, msg);
+    return TOK_ERROR;
+}
+
+int fast_lexer_next(FastLexer *lx, YYSTYPE *lval, YYLTYPE *lloc) {
+    /* flex keeps returning the <<EOF>> error of an unterminated construct */
+    if (lx->mode == FAST_LEXER_IN_STRING) {
+        fast_lexer_error(lx, lx->cur, "Unterminated string (end of file)");
+        return TOK_ERROR;
+    }
+    if (lx->mode == FAST_LEXER_IN_COMMENT) {
+        fast_lexer_error(lx, lx->cur, "Unterminated block comment");
+        return TOK_ERROR;
+    }
+
+    for (;;) {
+        const char *line_start = lx->line_start;
+        lx->cur = (char *)scan_space(lx->cur, &lx->line, &line_start);
+        lx->line_start = (char *)line_start;
+        if (lx->cur == lx->end) {
+            lx->tok_start = lx->cur;
+            lx->tok_len = 0;
+            return 0;
+        }
+
+        char *start = lx->cur;
+        int first_line = lx->line;
+        int first_column = (int)(start - lx->line_start) + 1;
+        int token = lex_one(lx, lval);
+        if (token < 0) {
+            continue;
+        }
+
+        lx->tok_start = start;
+        lx->tok_len = (size_t)(lx->cur - start);
+        if (lloc != NULL) {
+            lloc->first_line = first_line;
+            lloc->first_column = first_column;
+            lloc->last_line = lx->line;
+            lloc->last_column = (int)(lx->cur - lx->line_start) + 1;
+        }
+        return token;
+    }
+}
@@ -0,0 +1,49 @@
+/*
+ * NatureLang Compiler
+ * Copyright (c) 2026
+ *
+ * Hand-Written Lexer Bridge
+ *
+ * Provides the scanner interface the Bison parser expects from flex
+ * (yylex, yyget_lineno, yyget_text, lexer_scan_buffer, lexer_scan_end)
+ * on top of fast_lexer.c. Linked instead of parser_lex.yy.o when the
+ * compiler is built with `make LEXER_BACKEND=fast`; the yyscan_t handle
+ * is then a FastLexer.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+
+#include "fast_lexer.h"
+
+int yylex(YYSTYPE *yylval_param, YYLTYPE *yylloc_param, yyscan_t yyscanner) {
+    return fast_lexer_next((FastLexer *)yyscanner, yylval_param, yylloc_param);
+}
+
+int yyget_lineno(yyscan_t yyscanner) {
+    return fast_lexer_lineno((const FastLexer *)yyscanner);
+}
+
+char *yyget_text(yyscan_t yyscanner) {
+    return (char *)fast_lexer_text((FastLexer *)yyscanner);
+}
+
+int lexer_scan_buffer(yyscan_t *scanner, char *base, size_t size, const char *filename) {
+    *scanner = NULL;
+
+    FastLexer *lx = malloc(sizeof(FastLexer));
+    if (lx == NULL) {
+        return -1;
+    }
+    if (fast_lexer_init(lx, base, size, filename) != 0) {
+        free(lx);
+        return -1;
+    }
+
+    *scanner = lx;
+    return 0;
+}
+
+void lexer_scan_end(yyscan_t scanner) {
+    free(scanner);
+}
@@ -0,0 +1,307 @@
+/*
+ * NatureLang Compiler
+ * Copyright (c) 2026
+ *
+ * Keyword Perfect-Hash Generator
+ *
+ * Build-time tool that reads the keyword list from keywords.def and
+ * prints a C header with a minimal perfect hash for it (one slot per
+ * keyword, no empty slots). tokens.c includes the result as
+ * keyword_hash_tables.h.
+ *
+ * Method (hash, displace):
+ *   1. bucket = kw_hash(word) % KW_BUCKETS
+ *   2. buckets are placed largest-first; for each one, search the
+ *      smallest displacement d such that kw_displace(hash, d) % KW_COUNT
+ *      is a free, distinct slot for every word in the bucket
+ *   3. emit d per bucket and the slot -> keyword_table index map
+ *
+ * Usage: gen_keyword_hash > build/keyword_hash_tables.h
+ *
+ * Built with -DLEXER_WORDS it hashes lexer_words.def instead (the word
+ * table of the hand-written lexer) and additionally groups the LEXPHRASE
+ * entries by their first word:
+ *
+ * Usage: gen_lexer_word_hash > build/lexer_word_tables.h
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "keyword_hash.h"
+
+#ifdef LEXER_WORDS
+#define LEXWORD(word, tok) word,
+#define LEXPHRASE(pattern, tok)
+static const char *const words[] = {
+#include "lexer_words.def"
+};
+#undef LEXWORD
+#undef LEXPHRASE
+
+#define LEXWORD(word, tok)
+#define LEXPHRASE(pattern, tok) pattern,
+static const char *const phrases[] = {
+#include "lexer_words.def"
+};
+#undef LEXWORD
+#undef LEXPHRASE
+
+#define NPHRASES (sizeof(phrases) / sizeof(phrases[0]))
+#define DEF_FILE "src/lexer/lexer_words.def"
+#define TABLES_GUARD "NATURELANG_LEXER_WORD_TABLES_H"
+#else
+#define KEYWORD(word, tok) word,
+static const char *const words[] = {
+#include "keywords.def"
+};
+#undef KEYWORD
+
+#define DEF_FILE "src/lexer/keywords.def"
+#define TABLES_GUARD "NATURELANG_KEYWORD_HASH_TABLES_H"
+#endif
+
+#define NWORDS (sizeof(words) / sizeof(words[0]))
+#define MAX_DISPLACEMENT 65535u
+
+static int bucket_of[NWORDS];
+static int slot_of[NWORDS];
+
+/* Sort bucket ids by descending size (simple insertion sort; tiny input) */
+static void sort_buckets(int *order, const int *sizes, int nbuckets) {
+    for (int i = 1; i < nbuckets; i++) {
+        int v = order[i];
+        int j = i - 1;
+        while (j >= 0 && sizes[order[j]] < sizes[v]) {
+            order[j + 1] = order[j];
+            j--;
+        }
+        order[j + 1] = v;
+    }
+}
+
+static int check_words(void) {
+    for (size_t i = 0; i < NWORDS; i++) {
+        for (const char *p = words[i]; *p; p++) {
+            if (kw_fold((unsigned char)*p) != (unsigned char)*p) {
+                fprintf(stderr, "gen_keyword_hash: keyword '%s' is not lowercase\n",
+                        words[i]);
+                return 0;
+            }
+        }
+        for (size_t j = 0; j < i; j++) {
+            if (strcmp(words[i], words[j]) == 0) {
+                fprintf(stderr, "gen_keyword_hash: duplicate keyword '%s'\n",
+                        words[i]);
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+#ifdef LEXER_WORDS
+/* Index of the word a phrase starts with (its leading run of letters) */
+static int phrase_head(const char *phrase) {
+    size_t len = 0;
+    while (phrase[len] >= 'a' && phrase[len] <= 'z') len++;
+    for (size_t i = 0; i < NWORDS; i++) {
+        if (strlen(words[i]) == len && strncmp(words[i], phrase, len) == 0) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+/*
+ * Emit the phrases grouped by first word, keeping file order inside a
+ * group: kw_phrase_order[kw_phrase_first[w] .. + kw_phrase_count[w]]
+ * are the LEXPHRASE indices starting with word w.
+ */
+static int emit_phrase_groups(void) {
+    int first[NWORDS];
+    int count[NWORDS];
+    int order[NPHRASES];
+    int k = 0;
+
+    for (size_t w = 0; w < NWORDS; w++) {
+        first[w] = 0;
+        count[w] = 0;
+    }
+    for (size_t p = 0; p < NPHRASES; p++) {
+        if (phrase_head(phrases[p]) < 0) {
+            fprintf(stderr, "gen_keyword_hash: phrase '%s' does not start with a LEXWORD\n",
+                    phrases[p]);
+            return 0;
+        }
+    }
+    for (size_t w = 0; w < NWORDS; w++) {
+        first[w] = k;
+        for (size_t p = 0; p < NPHRASES; p++) {
+            if (phrase_head(phrases[p]) == (int)w) {
+                order[k++] = (int)p;
+                count[w]++;
+            }
+        }
+    }
+
+    printf("#define KW_PHRASES %zu\n\n", NPHRASES);
+    printf("/* Keyword index -> first entry of its phrase group in kw_phrase_order */\n");
+    printf("static const uint8_t kw_phrase_first[KW_COUNT] = {");
+    for (size_t w = 0; w < NWORDS; w++) {
+        printf("%s%d", w % 12 == 0 ? "\n    " : " ", first[w]);
+        if (w + 1 < NWORDS) printf(",");
+    }
+    printf("\n};\n\n");
+    printf("/* Keyword index -> number of phrases starting with it */\n");
+    printf("static const uint8_t kw_phrase_count[KW_COUNT] = {");
+    for (size_t w = 0; w < NWORDS; w++) {
+        printf("%s%d", w % 12 == 0 ? "\n    " : " ", count[w]);
+        if (w + 1 < NWORDS) printf(",");
+    }
+    printf("\n};\n\n");
+    printf("/* Grouped position -> LEXPHRASE index */\n");
+    printf("static const uint8_t kw_phrase_order[KW_PHRASES] = {");
+    for (int i = 0; i < k; i++) {
+        printf("%s%d", i % 12 == 0 ? "\n    " : " ", order[i]);
+        if (i + 1 < k) printf(",");
+    }
+    printf("\n};\n\n");
+    return 1;
+}
+#endif
+
+int main(void) {
+    const int n = (int)NWORDS;
+    const int nbuckets = (n + 1) / 2;
+
+    if (!check_words()) return 1;
+    /* kw_slot_index is emitted as uint8_t */
+    if (n > 255) {
+        fprintf(stderr, "gen_keyword_hash: too many keywords (%d)\n", n);
+        return 1;
+    }
+
+    int *sizes = calloc((size_t)nbuckets, sizeof(int));
+    int *order = malloc((size_t)nbuckets * sizeof(int));
+    unsigned *disp = calloc((size_t)nbuckets, sizeof(unsigned));
+    int *slot_owner = malloc((size_t)n * sizeof(int));
+    if (!sizes || !order || !disp || !slot_owner) {
+        fprintf(stderr, "gen_keyword_hash: out of memory\n");
+        return 1;
+    }
+
+    /* First level: distribute words into buckets */
+    size_t min_len = (size_t)-1, max_len = 0;
+    for (int i = 0; i < n; i++) {
+        size_t len = strlen(words[i]);
+        if (len < min_len) min_len = len;
+        if (len > max_len) max_len = len;
+        bucket_of[i] = (int)(kw_hash(words[i], len) % (uint32_t)nbuckets);
+        sizes[bucket_of[i]]++;
+    }
+    for (int b = 0; b < nbuckets; b++) order[b] = b;
+    sort_buckets(order, sizes, nbuckets);
+
+    for (int s = 0; s < n; s++) slot_owner[s] = -1;
+
+    /* Second level: find a displacement for each bucket, biggest first */
+    for (int oi = 0; oi < nbuckets; oi++) {
+        int b = order[oi];
+        if (sizes[b] == 0) break;
+
+        int placed = 0;
+        for (unsigned d = 0; d <= MAX_DISPLACEMENT && !placed; d++) {
+            int ok = 1;
+            for (int i = 0; i < n && ok; i++) {
+                if (bucket_of[i] != b) continue;
+                uint32_t h = kw_hash(words[i], strlen(words[i]));
+                int s = (int)(kw_displace(h, d) % (uint32_t)n);
+                if (slot_owner[s] != -1) {
+                    ok = 0;
+                    break;
+                }
+                /* Tentatively claim so two words of one bucket cannot collide */
+                slot_owner[s] = i;
+                slot_of[i] = s;
+            }
+            if (ok) {
+                disp[b] = d;
+                placed = 1;
+            } else {
+                /* Roll back the tentative claims of this attempt */
+                for (int i = 0; i < n; i++) {
+                    if (bucket_of[i] == b && slot_owner[slot_of[i]] == i) {
+                        slot_owner[slot_of[i]] = -1;
+                    }
+                }
+            }
+        }
+        if (!placed) {
+            fprintf(stderr, "gen_keyword_hash: no displacement for bucket %d\n", b);
+            return 1;
+        }
+    }
+
+    /* Self-check: every word must hash back to its own slot */
+    for (int i = 0; i < n; i++) {
+        uint32_t h = kw_hash(words[i], strlen(words[i]));
+        int s = (int)(kw_displace(h, disp[h % (uint32_t)nbuckets]) % (uint32_t)n);
+        if (slot_owner[s] != i) {
+            fprintf(stderr, "gen_keyword_hash: verification failed for '%s'\n",
+                    words[i]);
+            return 1;
+        }
+    }
+
+    printf("/*\n");
+    printf(" * Generated by gen_keyword_hash from " DEF_FILE ".\n");
+    printf(" * Do not edit this file directly.\n");
+    printf(" *\n");
+    printf(" * Minimal perfect hash: %d keywords, %d buckets, %d slots.\n",
+           n, nbuckets, n);
+    printf(" */\n\n");
+    printf("#ifndef " TABLES_GUARD "\n");
+    printf("#define " TABLES_GUARD "\n\n");
+    printf("#include <stdint.h>\n\n");
+    printf("#define KW_COUNT   %d\n", n);
+    printf("#define KW_BUCKETS %d\n", nbuckets);
+    printf("#define KW_MIN_LEN %zu\n", min_len);
+    printf("#define KW_MAX_LEN %zu\n\n", max_len);
+
+    printf("/* Per-bucket displacement for kw_displace() */\n");
+    printf("static const uint16_t kw_bucket_disp[KW_BUCKETS] = {");
+    for (int b = 0; b < nbuckets; b++) {
+        printf("%s%u", b % 12 == 0 ? "\n    " : " ", disp[b]);
+        if (b + 1 < nbuckets) printf(",");
+    }
+    printf("\n};\n\n");
+
+    printf("/* Slot -> keyword_table index */\n");
+    printf("static const uint8_t kw_slot_index[KW_COUNT] = {");
+    for (int s = 0; s < n; s++) {
+        printf("%s%d", s % 12 == 0 ? "\n    " : " ", slot_owner[s]);
+        if (s + 1 < n) printf(",");
+    }
+    printf("\n};\n\n");
+
+    printf("/* Slot -> keyword length, for a cheap reject before comparing */\n");
+    printf("static const uint8_t kw_slot_len[KW_COUNT] = {");
+    for (int s = 0; s < n; s++) {
+        printf("%s%zu", s % 12 == 0 ? "\n    " : " ", strlen(words[slot_owner[s]]));
+        if (s + 1 < n) printf(",");
+    }
+    printf("\n};\n\n");
+
+#ifdef LEXER_WORDS
+    if (!emit_phrase_groups()) return 1;
+#endif
+    printf("#endif /* " TABLES_GUARD " */\n");
+
+    free(sizes);
+    free(order);
+    free(disp);
+    free(slot_owner);
+    return 0;
+}
@@ -0,0 +1,134 @@
+/*
+ * NatureLang Compiler
+ * Copyright (c) 2026
+ *
+ * Lexer Differential Test
+ *
+ * Runs the flex scanner and the hand-written lexer side by side over the
+ * same sources and checks that they produce the same token stream: token
+ * numbers, semantic values (numbers, characters, identifier and decoded
+ * string text) and the line number after every token. Each lexer scans
+ * its own copy of the file, since both decode strings in place.
+ *
+ * Usage: lexer_diff file.nl...
+ * Build: make test-lexer-diff
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fast_lexer.h"
+#include "source_buffer.h"
+
+/* Flex scanner (parser_lex.yy.o) */
+int yylex(YYSTYPE *yylval_param, YYLTYPE *yylloc_param, yyscan_t yyscanner);
+int yyget_lineno(yyscan_t yyscanner);
+char *yyget_text(yyscan_t yyscanner);
+int lexer_scan_buffer(yyscan_t *scanner, char *base, size_t size, const char *filename);
+void lexer_scan_end(yyscan_t scanner);
+
+/* Stop after this many TOK_ERRORs at end of input (both lexers repeat them) */
+#define MAX_TRAILING_ERRORS 2
+
+static int same_value(int token, const YYSTYPE *a, const YYSTYPE *b) {
+    switch (token) {
+        case TOK_INTEGER:
+            return a->int_val == b->int_val;
+        case TOK_FLOAT:
+            return a->float_val == b->float_val ||
+                   (a->float_val != a->float_val && b->float_val != b->float_val);
+        case TOK_CHAR:
+            return a->char_val == b->char_val;
+        case TOK_IDENTIFIER:
+        case TOK_STRING:
+            return a->slice.len == b->slice.len &&
+                   memcmp(a->slice.ptr, b->slice.ptr, (size_t)a->slice.len) == 0;
+        default:
+            return 1;
+    }
+}
+
+/* Compare both lexers over one file; returns the number of tokens or -1 */
+static long diff_file(const char *filename) {
+    SourceBuffer flex_src, fast_src;
+    if (source_buffer_open(&flex_src, filename) != 0) {
+        fprintf(stderr, "Error: Cannot open file '%s'\n", filename);
+        return -1;
+    }
+    if (source_buffer_open(&fast_src, filename) != 0) {
+        fprintf(stderr, "Error: Cannot open file '%s'\n", filename);
+        source_buffer_close(&flex_src);
+        return -1;
+    }
+
+    yyscan_t scanner;
+    FastLexer lx;
+    size_t size = flex_src.length + SOURCE_BUFFER_PADDING;
+    if (lexer_scan_buffer(&scanner, flex_src.data, size, filename) != 0 ||
+        fast_lexer_init(&lx, fast_src.data, fast_src.length + SOURCE_BUFFER_PADDING,
+                        filename) != 0) {
+        fprintf(stderr, "Fatal: Cannot create lexer for '%s'\n", filename);
+        exit(1);
+    }
+
+    long count = 0;
+    int trailing_errors = 0;
+    long result = 0;
+    for (;;) {
+        YYSTYPE flex_val, fast_val;
+        YYLTYPE flex_loc, fast_loc;
+        memset(&flex_val, 0, sizeof(flex_val));
+        memset(&fast_val, 0, sizeof(fast_val));
+
+        int a = yylex(&flex_val, &flex_loc, scanner);
+        int b = fast_lexer_next(&lx, &fast_val, &fast_loc);
+        int line_a = yyget_lineno(scanner);
+        int line_b = fast_lexer_lineno(&lx);
+
+        if (a != b || !same_value(a, &flex_val, &fast_val) || line_a != line_b) {
+            fprintf(stderr, "%s: token %ld differs\n", filename, count + 1);
+            fprintf(stderr, "  flex: token %d '%s' (line %d)\n", a, yyget_text(scanner), line_a);
+            fprintf(stderr, "  fast: token %d '%s' (line %d)\n", b, fast_lexer_text(&lx), line_b);
+            result = -1;
+            break;
+        }
+        if (a == 0) {
+            break;
+        }
+        count++;
+        if (a == TOK_ERROR && lx.mode != FAST_LEXER_NORMAL &&
+            ++trailing_errors >= MAX_TRAILING_ERRORS) {
+            break;
+        }
+    }
+
+    lexer_scan_end(scanner);
+    source_buffer_close(&flex_src);
+    source_buffer_close(&fast_src);
+    return result < 0 ? -1 : count;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s file.nl...\n", argv[0]);
+        return 1;
+    }
+
+    int failed = 0;
+    for (int i = 1; i < argc; i++) {
+        long tokens = diff_file(argv[i]);
+        if (tokens < 0) {
+            failed++;
+        } else {
+            printf("✓ %s (%ld tokens)\n", argv[i], tokens);
+        }
+    }
+
+    if (failed > 0) {
+        fprintf(stderr, "✗ %d of %d files differ\n", failed, argc - 1);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,172 @@
+/*
+ * NatureLang Compiler
+ * Copyright (c) 2026
+ *
+ * Source Buffer Implementation
+ *
+ * Loads source text into memory for in-place scanning. Regular files are
+ * mmap'ed: POSIX zero-fills the tail of the last mapped page, so when the
+ * file does not end within SOURCE_BUFFER_PADDING bytes of a page boundary
+ * the flex end-of-buffer NULs are already there and nothing is copied.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "source_buffer.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define READ_CHUNK 65536
+
+static void source_buffer_reset(SourceBuffer *sb) {
+    sb->data = NULL;
+    sb->length = 0;
+    sb->map_length = 0;
+}
+
+/* Allocate a zeroed heap buffer large enough for length + padding */
+static int source_buffer_alloc(SourceBuffer *sb, size_t length) {
+    sb->data = calloc(length + SOURCE_BUFFER_PADDING, 1);
+    if (sb->data == NULL) {
+        return -1;
+    }
+    sb->length = length;
+    sb->map_length = 0;
+    return 0;
+}
+
+/* Read exactly length bytes from fd into the heap buffer */
+static int source_buffer_read_fd(SourceBuffer *sb, int fd, size_t length) {
+    if (source_buffer_alloc(sb, length) != 0) {
+        return -1;
+    }
+    size_t done = 0;
+    while (done < length) {
+        ssize_t n = read(fd, sb->data + done, length - done);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            source_buffer_close(sb);
+            return -1;
+        }
+        if (n == 0) break;  /* File shrank underneath us */
+        done += (size_t)n;
+    }
+    sb->length = done;
+    sb->data[done] = '\0';
+    sb->data[done + 1] = '\0';
+    return 0;
+}
+
+int source_buffer_open(SourceBuffer *sb, const char *filename) {
+    source_buffer_reset(sb);
+
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    /* Pipes, character devices, etc.: read until EOF */
+    if (!S_ISREG(st.st_mode)) {
+        FILE *f = fdopen(fd, "r");
+        if (f == NULL) {
+            close(fd);
+            return -1;
+        }
+        int rc = source_buffer_from_stream(sb, f);
+        fclose(f);
+        return rc;
+    }
+
+    size_t length = (size_t)st.st_size;
+    long page = sysconf(_SC_PAGESIZE);
+    size_t tail = page > 0 ? length % (size_t)page : 0;
+
+    /* Map only when the zero-filled page tail can hold the padding */
+    if (length > 0 && page > 0 && tail != 0 &&
+        (size_t)page - tail >= SOURCE_BUFFER_PADDING) {
+        size_t map_length = length + SOURCE_BUFFER_PADDING;
+        void *p = mmap(NULL, map_length, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+            close(fd);
+            sb->data = p;
+            sb->length = length;
+            sb->map_length = map_length;
+            return 0;
+        }
+    }
+
+    int rc = source_buffer_read_fd(sb, fd, length);
+    close(fd);
+    return rc;
+}
+
+int source_buffer_from_stream(SourceBuffer *sb, FILE *input) {
+    source_buffer_reset(sb);
+
+    size_t cap = READ_CHUNK;
+    size_t len = 0;
+    char *buf = malloc(cap);
+    if (buf == NULL) {
+        return -1;
+    }
+
+    for (;;) {
+        if (cap - len < READ_CHUNK) {
+            cap *= 2;
+            char *grown = realloc(buf, cap);
+            if (grown == NULL) {
+                free(buf);
+                return -1;
+            }
+            buf = grown;
+        }
+        size_t n = fread(buf + len, 1, cap - len - SOURCE_BUFFER_PADDING, input);
+        len += n;
+        if (n == 0) break;
+    }
+    if (ferror(input)) {
+        free(buf);
+        return -1;
+    }
+
+    /* The loop keeps at least SOURCE_BUFFER_PADDING bytes free */
+    buf[len] = '\0';
+    buf[len + 1] = '\0';
+    sb->data = buf;
+    sb->length = len;
+    sb->map_length = 0;
+    return 0;
+}
+
+int source_buffer_from_string(SourceBuffer *sb, const char *source, size_t length) {
+    source_buffer_reset(sb);
+    if (source_buffer_alloc(sb, length) != 0) {
+        return -1;
+    }
+    memcpy(sb->data, source, length);
+    return 0;
+}
+
+void source_buffer_close(SourceBuffer *sb) {
+    if (sb == NULL || sb->data == NULL) {
+        return;
+    }
+    if (sb->map_length > 0) {
+        munmap(sb->data, sb->map_length);
+    } else {
+        free(sb->data);
+    }
+    source_buffer_reset(sb);
+}
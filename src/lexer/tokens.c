@@ -35,158 +35,54 @@ typedef struct {
 /* ============================================================================
  * KEYWORD TABLE
  * ============================================================================
- * Sorted alphabetically for potential binary search optimization
+ * Generated from keywords.def. The perfect-hash tables in
+ * keyword_hash_tables.h index into this array, so both must come from
+ * the same keywords.def (the Makefile rebuilds them together).
  */
+#define KEYWORD(word, tok) {word, tok},
 static const KeywordEntry keyword_table[] = {
-    /* A */
-    {"a", TOK_A},
-    {"an", TOK_AN},
-    {"and", TOK_AND},
-    {"as", TOK_AS},
-    {"ask", TOK_ASK},
-    {"at", TOK_AT_LEAST},  /* Will be combined with "least" or "most" */
-    
-    /* B */
-    {"back", TOK_BACK},
-    {"becomes", TOK_BECOMES},
-    {"begin", TOK_BEGIN},
-    {"by", TOK_BY},
-    
-    /* C */
-    {"call", TOK_CALL},
-    {"called", TOK_CALLED},
-    {"create", TOK_CREATE},
-    
-    /* D */
-    {"decimal", TOK_TYPE_DECIMAL},
-    {"define", TOK_DEFINE},
-    {"display", TOK_DISPLAY},
-    {"divided", TOK_DIVIDED},
-    {"do", TOK_DO},
-    
-    /* E */
-    {"each", TOK_EACH},
-    {"else", TOK_ELSE},
-    {"end", TOK_END},
-    {"enter", TOK_ENTER},
-    {"equal", TOK_EQUAL},
-    {"equals", TOK_EQUALS},
-    
-    /* F */
-    {"false", TOK_FALSE},
-    {"flag", TOK_TYPE_FLAG},
-    {"for", TOK_FOR},
-    {"from", TOK_FROM},
-    {"function", TOK_FUNCTION},
-    
-    /* G */
-    {"give", TOK_GIVE},
-    {"greater", TOK_GREATER},
-    
-    /* I */
-    {"if", TOK_IF},
-    {"in", TOK_IN},
-    {"into", TOK_INTO},
-    {"is", TOK_IS},
-    {"it", TOK_IT},
-    
-    /* L */
-    {"less", TOK_LESS},
-    {"list", TOK_TYPE_LIST},
-    
-    /* M */
-    {"make", TOK_MAKE},
-    {"minus", TOK_MINUS},
-    {"modulo", TOK_MODULO},
-    {"multiplied", TOK_MULTIPLIED},
-    
-    /* N */
-    {"named", TOK_NAMED},
-    {"no", TOK_NO},
-    {"not", TOK_NOT},
-    {"nothing", TOK_TYPE_NOTHING},
-    {"number", TOK_TYPE_NUMBER},
-    
-    /* O */
-    {"of", TOK_OF},
-    {"or", TOK_OR},
-    {"otherwise", TOK_OTHERWISE},
-    
-    /* P */
-    {"plus", TOK_PLUS},
-    {"power", TOK_POWER},
-    {"print", TOK_PRINT},
-    
-    /* R */
-    {"read", TOK_READ},
-    {"remainder", TOK_REMAINDER},
-    {"remember", TOK_REMEMBER},
-    {"repeat", TOK_REPEAT},
-    {"returns", TOK_RETURNS},
-    {"risky", TOK_RISKY},
-    {"root", TOK_ROOT},
-    
-    /* S */
-    {"safe", TOK_SAFE},
-    {"safely", TOK_SAFELY},
-    {"save", TOK_SAVE},
-    {"secure", TOK_SECURE},
-    {"set", TOK_SET},
-    {"show", TOK_SHOW},
-    {"skip", TOK_SKIP},
-    {"square", TOK_SQUARE},
-    {"squared", TOK_SQUARED},
-    {"stop", TOK_STOP},
-    
-    /* T */
-    {"takes", TOK_TAKES},
-    {"text", TOK_TYPE_TEXT},
-    {"than", TOK_THAN},
-    {"that", TOK_THAT},
-    {"then", TOK_THEN},
-    {"times", TOK_TIMES},
-    {"to", TOK_TO},
-    {"true", TOK_TRUE},
-    
-    /* U */
-    {"until", TOK_UNTIL},
-    
-    /* W */
-    {"while", TOK_WHILE},
-    {"with", TOK_WITH},
-    
-    /* Y */
-    {"yes", TOK_YES},
-    
-    /* Z */
-    {"zone", TOK_ZONE},
+#include "keywords.def"
 };
+#undef KEYWORD
 
-static const size_t keyword_table_size = sizeof(keyword_table) / sizeof(keyword_table[0]);
+#define KEYWORD_TABLE_SIZE (sizeof(keyword_table) / sizeof(keyword_table[0]))
 
 /* ============================================================================
  * KEYWORD LOOKUP FUNCTION
  * ============================================================================
+ * Minimal perfect hash generated at build time by gen_keyword_hash.
+ * The hash folds ASCII case itself, so no lowercase copy is made; one
+ * length check and one folded compare confirm the single candidate slot.
  */
-TokenType lookup_keyword(const char *str) {
-    if (str == NULL) return TOK_IDENTIFIER;
-    
-    /* Convert to lowercase for case-insensitive matching */
-    char lower[256];
-    size_t i;
-    for (i = 0; str[i] && i < 255; i++) {
-        lower[i] = tolower((unsigned char)str[i]);
+#include "keyword_hash.h"
+#include "keyword_hash_tables.h"
+
+_Static_assert(KW_COUNT == KEYWORD_TABLE_SIZE,
+               "keyword_hash_tables.h is stale; rebuild it from keywords.def");
+
+TokenType lookup_keyword_n(const char *str, size_t len) {
+    if (str == NULL || len < KW_MIN_LEN || len > KW_MAX_LEN) {
+        return TOK_IDENTIFIER;
     }
-    lower[i] = '\0';
-    
-    /* Linear search (could be optimized with hash table or binary search) */
-    for (i = 0; i < keyword_table_size; i++) {
-        if (strcmp(lower, keyword_table[i].keyword) == 0) {
-            return keyword_table[i].type;
+
+    uint32_t h = kw_hash(str, len);
+    uint32_t slot = kw_displace(h, kw_bucket_disp[h % KW_BUCKETS]) % KW_COUNT;
+    if (kw_slot_len[slot] != len) {
+        return TOK_IDENTIFIER;
+    }
+
+    const KeywordEntry *entry = &keyword_table[kw_slot_index[slot]];
+    for (size_t i = 0; i < len; i++) {
+        if (kw_fold((unsigned char)str[i]) != (unsigned char)entry->keyword[i]) {
+            return TOK_IDENTIFIER;
         }
     }
-    
-    return TOK_IDENTIFIER;
+    return entry->type;
+}
+
+TokenType lookup_keyword(const char *str) {
+    if (str == NULL) return TOK_IDENTIFIER;
+    return lookup_keyword_n(str, strlen(str));
 }
 
 /* The following functions are only needed for standalone lexer mode */
@@ -197,7 +93,7 @@ const KeywordEntry *get_keyword_table(void) {
 }
 
 size_t get_keyword_table_size(void) {
-    return keyword_table_size;
+    return KEYWORD_TABLE_SIZE;
 }
 
 /* ============================================================================
@@ -241,6 +137,10 @@ static const char *token_type_strings[] = {
     [TOK_OTHERWISE] = "OTHERWISE",
     [TOK_ELSE] = "ELSE",
     [TOK_END] = "END",
+    [TOK_END_IF] = "END_IF",
+    [TOK_END_WHILE] = "END_WHILE",
+    [TOK_END_REPEAT] = "END_REPEAT",
+    [TOK_END_FOR] = "END_FOR",
     [TOK_REPEAT] = "REPEAT",
     [TOK_TIMES] = "TIMES",
     [TOK_WHILE] = "WHILE",
@@ -318,6 +218,18 @@ static const char *token_type_strings[] = {
     [TOK_SQUARE] = "SQUARE",
     [TOK_ROOT] = "ROOT",
     
+    /* Keywords - Random Numbers */
+    [TOK_RANDOM_NUMBER] = "RANDOM_NUMBER",
+    [TOK_RANDOM_NUMBERS] = "RANDOM_NUMBERS",
+    [TOK_RANDOM_DECIMAL] = "RANDOM_DECIMAL",
+    [TOK_SEED_RANDOM] = "SEED_RANDOM",
+    [TOK_CONTAINS] = "CONTAINS",
+    [TOK_SUM_OF] = "SUM_OF",
+    [TOK_LARGEST] = "LARGEST",
+    [TOK_SMALLEST] = "SMALLEST",
+    [TOK_COUNT_OF] = "COUNT_OF",
+    [TOK_POSITION_OF] = "POSITION_OF",
+    
     /* Operators - Symbolic */
     [TOK_OP_PLUS] = "OP_PLUS",
     [TOK_OP_MINUS] = "OP_MINUS",
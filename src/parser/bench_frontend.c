@@ -0,0 +1,514 @@
+/*
+ * NatureLang Compiler
+ * Copyright (c) 2026
+ *
+ * Front-End Throughput Benchmark
+ *
+ * Generates a synthetic NatureLang corpus and measures the front end on
+ * it: lexing alone (tokens/sec), lexing + parsing + AST construction
+ * (statements/sec, tokens/sec), the heap size of the resulting AST next
+ * to its compact encoding (and the time to walk each of them), and,
+ * for the GLR fallback parser (make PARSER_MODE=glr), how often it splits
+ * its stack on the corpus. The default LALR(1) parser never splits, so its
+ * GLR counters are all zero.
+ *
+ * Corpus mixes:
+ *   filler  - simple statements behind filler phrases ("please", "let's")
+ *   expr    - long arithmetic and comparison expressions
+ *   nested  - deeply nested if / repeat / while blocks
+ *   mixed   - all of the above, interleaved (default)
+ *
+ * Usage: bench_frontend [-m mix] [-n statements] [-d depth] [-i iterations]
+ *                       [-s seed] [-o corpus.nl] [-f file.nl]
+ *   -o writes the generated corpus out; -f benchmarks an existing file
+ *   instead of a generated corpus.
+ * Build: make bench-frontend BUILD_TYPE=release
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <time.h>
+
+#include "parser.h"
+#include "ast_compact.h"
+#include "source_buffer.h"
+#include "naturelang.tab.h"
+
+/* Scanner entry points (flex or hand-written backend) */
+int yylex(YYSTYPE *yylval_param, YYLTYPE *yylloc_param, yyscan_t yyscanner);
+int lexer_scan_buffer(yyscan_t *scanner, char *base, size_t size, const char *filename);
+void lexer_scan_end(yyscan_t scanner);
+
+/* ============================================================================
+ * CORPUS GENERATOR
+ * ============================================================================
+ */
+
+typedef enum {
+    MIX_FILLER,
+    MIX_EXPR,
+    MIX_NESTED,
+    MIX_MIXED
+} CorpusMix;
+
+static const char *mix_names[] = {"filler", "expr", "nested", "mixed"};
+
+#define CORPUS_VARS 16
+
+typedef struct {
+    char *data;             /* Source text + SOURCE_BUFFER_PADDING NULs */
+    size_t length;
+    size_t capacity;
+    long statements;        /* Statements generated (nested ones included) */
+    unsigned int rng;
+} Corpus;
+
+static const char *fillers[] = {
+    "please ", "I want to ", "can you ", "could you ", "would you ",
+    "let's ", "let me ", "go ahead and ", "just ", "simply ", "now ",
+    "proceed to ", "please just ",
+};
+
+static const char *arith_ops[] = {
+    " plus ", " minus ", " multiplied by ", " divided by ", " modulo ",
+    " + ", " - ", " * ", " / ",
+};
+
+static const char *compare_ops[] = {
+    " is greater than ", " is less than ", " equals ", " >= ", " <= ",
+    " is not equal to ",
+};
+
+#define COUNT_OF(a) (sizeof(a) / sizeof((a)[0]))
+
+static unsigned int corpus_rand(Corpus *c, unsigned int n) {
+    /* xorshift32: deterministic for a given seed, no libc state */
+    unsigned int x = c->rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    c->rng = x;
+    return x % n;
+}
+
+static void corpus_emit(Corpus *c, const char *fmt, ...) {
+    for (;;) {
+        va_list args;
+        va_start(args, fmt);
+        size_t room = c->capacity - c->length - SOURCE_BUFFER_PADDING;
+        int n = vsnprintf(c->data + c->length, room, fmt, args);
+        va_end(args);
+        if (n < 0) {
+            fprintf(stderr, "Fatal: corpus formatting failed\n");
+            exit(1);
+        }
+        if ((size_t)n < room) {
+            c->length += (size_t)n;
+            return;
+        }
+        c->capacity *= 2;
+        c->data = realloc(c->data, c->capacity);
+        if (c->data == NULL) {
+            fprintf(stderr, "Fatal: out of memory\n");
+            exit(1);
+        }
+    }
+}
+
+static void corpus_indent(Corpus *c, int level) {
+    corpus_emit(c, "%*s", level * 4, "");
+}
+
+static void gen_expr(Corpus *c, int depth) {
+    if (depth == 0 || corpus_rand(c, 4) == 0) {
+        if (corpus_rand(c, 3) == 0) {
+            corpus_emit(c, "%u", corpus_rand(c, 1000));
+        } else {
+            corpus_emit(c, "v%u", corpus_rand(c, CORPUS_VARS));
+        }
+        return;
+    }
+    int paren = corpus_rand(c, 4) == 0;
+    if (paren) corpus_emit(c, "(");
+    gen_expr(c, depth - 1);
+    corpus_emit(c, "%s", arith_ops[corpus_rand(c, COUNT_OF(arith_ops))]);
+    gen_expr(c, depth - 1);
+    if (paren) corpus_emit(c, ")");
+}
+
+static void gen_condition(Corpus *c, int depth) {
+    gen_expr(c, depth);
+    corpus_emit(c, "%s", compare_ops[corpus_rand(c, COUNT_OF(compare_ops))]);
+    gen_expr(c, depth);
+}
+
+static void gen_simple(Corpus *c, int level) {
+    corpus_indent(c, level);
+    switch (corpus_rand(c, 3)) {
+        case 0:
+            corpus_emit(c, "display v%u\n", corpus_rand(c, CORPUS_VARS));
+            break;
+        case 1:
+            corpus_emit(c, "v%u becomes v%u plus %u\n", corpus_rand(c, CORPUS_VARS),
+                        corpus_rand(c, CORPUS_VARS), corpus_rand(c, 100));
+            break;
+        default:
+            corpus_emit(c, "display \"step %u\"\n", corpus_rand(c, 1000));
+            break;
+    }
+    c->statements++;
+}
+
+static void gen_filler(Corpus *c, int level) {
+    corpus_indent(c, level);
+    corpus_emit(c, "%s", fillers[corpus_rand(c, COUNT_OF(fillers))]);
+    gen_simple(c, 0);
+}
+
+static void gen_expression_statement(Corpus *c, int level, int depth) {
+    corpus_indent(c, level);
+    if (corpus_rand(c, 3) == 0) {
+        corpus_emit(c, "if ");
+        gen_condition(c, depth / 2);
+        corpus_emit(c, " then\n");
+        gen_simple(c, level + 1);
+        corpus_indent(c, level);
+        corpus_emit(c, "end if\n");
+    } else {
+        corpus_emit(c, "v%u becomes ", corpus_rand(c, CORPUS_VARS));
+        gen_expr(c, depth);
+        corpus_emit(c, "\n");
+    }
+    c->statements++;
+}
+
+static void gen_nested(Corpus *c, int level, int depth) {
+    if (depth == 0) {
+        gen_simple(c, level);
+        return;
+    }
+    corpus_indent(c, level);
+    switch (corpus_rand(c, 3)) {
+        case 0:
+            corpus_emit(c, "if v%u is less than %u then\n",
+                        corpus_rand(c, CORPUS_VARS), corpus_rand(c, 100));
+            gen_nested(c, level + 1, depth - 1);
+            gen_simple(c, level + 1);
+            corpus_indent(c, level);
+            corpus_emit(c, "otherwise\n");
+            gen_nested(c, level + 1, depth - 1);
+            corpus_indent(c, level);
+            corpus_emit(c, "end if\n");
+            break;
+        case 1:
+            corpus_emit(c, "repeat %u times\n", corpus_rand(c, 10) + 1);
+            gen_nested(c, level + 1, depth - 1);
+            corpus_indent(c, level);
+            corpus_emit(c, "end repeat\n");
+            break;
+        default:
+            corpus_emit(c, "while v%u is less than %u do\n",
+                        corpus_rand(c, CORPUS_VARS), corpus_rand(c, 100));
+            gen_nested(c, level + 1, depth - 1);
+            gen_simple(c, level + 1);
+            corpus_indent(c, level);
+            corpus_emit(c, "end while\n");
+            break;
+    }
+    c->statements++;
+}
+
+static void corpus_generate(Corpus *c, CorpusMix mix, long target, int depth, unsigned int seed) {
+    c->capacity = 65536;
+    c->length = 0;
+    c->statements = 0;
+    c->rng = seed ? seed : 1;
+    c->data = malloc(c->capacity);
+    if (c->data == NULL) {
+        fprintf(stderr, "Fatal: out of memory\n");
+        exit(1);
+    }
+
+    corpus_emit(c, "-- bench_frontend corpus: %s, depth %d, seed %u\n",
+                mix_names[mix], depth, seed);
+    for (int i = 0; i < CORPUS_VARS; i++) {
+        corpus_emit(c, "create a number called v%d and set it to %d\n", i, i + 1);
+        c->statements++;
+    }
+
+    int turn = 0;
+    while (c->statements < target) {
+        CorpusMix kind = mix == MIX_MIXED ? (CorpusMix)(turn++ % 3) : mix;
+        switch (kind) {
+            case MIX_FILLER: gen_filler(c, 0); break;
+            case MIX_EXPR:   gen_expression_statement(c, 0, depth); break;
+            default:         gen_nested(c, 0, depth); break;
+        }
+    }
+
+    memset(c->data + c->length, 0, SOURCE_BUFFER_PADDING);
+}
+
+/* ============================================================================
+ * MEASUREMENT
+ * ============================================================================
+ */
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/* Fresh copy of the corpus: the scanner unescapes strings in place */
+static void reset_work(char *work, const Corpus *c) {
+    memcpy(work, c->data, c->length + SOURCE_BUFFER_PADDING);
+}
+
+static long lex_once(char *work, size_t size, double *elapsed) {
+    yyscan_t scanner;
+    if (lexer_scan_buffer(&scanner, work, size, "<bench>") != 0) {
+        fprintf(stderr, "Fatal: cannot create scanner\n");
+        exit(1);
+    }
+    long tokens = 0;
+    YYSTYPE value;
+    YYLTYPE loc;
+    double start = now_seconds();
+    while (yylex(&value, &loc, scanner) != 0) {
+        tokens++;
+    }
+    *elapsed += now_seconds() - start;
+    lexer_scan_end(scanner);
+    return tokens;
+}
+
+/* Walks that visit every node and read its type, to compare the two layouts */
+static void count_visit(ASTVisitor *visitor, ASTNode *node) {
+    *(long *)visitor->user_data += (long)node->type + 1;
+}
+
+static long walk_pointer(ASTNode *ast) {
+    long sum = 0;
+    ASTVisitor visitor = {&sum, count_visit, NULL};
+    ast_visit(ast, &visitor);
+    return sum;
+}
+
+static long walk_compact(const ASTCompact *ac, ASTRef ref) {
+    if (ref == AST_REF_NULL) return 0;
+    long sum = (long)ast_compact_type(ac, ref) + 1;
+    uint32_t count = ast_compact_child_count(ac, ref);
+    for (uint32_t i = 0; i < count; i++) {
+        sum += walk_compact(ac, ast_compact_child(ac, ref, i));
+    }
+    return sum;
+}
+
+static ASTNode *parse_once(char *work, size_t size, double *elapsed) {
+    ParseContext ctx;
+    parse_context_init(&ctx, "<bench>");
+    double start = now_seconds();
+    ASTNode *ast = naturelang_parse_ctx(&ctx, work, size);
+    *elapsed += now_seconds() - start;
+    parse_context_free(&ctx);
+    if (ast == NULL) {
+        fprintf(stderr, "✗ corpus failed to parse\n");
+        exit(1);
+    }
+    return ast;
+}
+
+/* ============================================================================
+ * MAIN
+ * ============================================================================
+ */
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-m filler|expr|nested|mixed] [-n statements] [-d depth]\n"
+                    "       %*s [-i iterations] [-s seed] [-o corpus.nl] [-f file.nl]\n",
+            prog, (int)strlen(prog), "");
+}
+
+int main(int argc, char *argv[]) {
+    CorpusMix mix = MIX_MIXED;
+    long target = 20000;
+    int depth = 6;
+    long iterations = 5;
+    unsigned int seed = 42;
+    const char *out_file = NULL;
+    const char *in_file = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        if (i + 1 >= argc || arg[0] != '-' || arg[1] == '\0' || arg[2] != '\0') {
+            usage(argv[0]);
+            return 1;
+        }
+        const char *val = argv[++i];
+        switch (arg[1]) {
+            case 'm': {
+                int found = 0;
+                for (int m = 0; m < (int)COUNT_OF(mix_names); m++) {
+                    if (strcmp(val, mix_names[m]) == 0) {
+                        mix = (CorpusMix)m;
+                        found = 1;
+                    }
+                }
+                if (!found) {
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+            }
+            case 'n': target = atol(val); break;
+            case 'd': depth = atoi(val); break;
+            case 'i': iterations = atol(val); break;
+            case 's': seed = (unsigned int)strtoul(val, NULL, 10); break;
+            case 'o': out_file = val; break;
+            case 'f': in_file = val; break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (target <= 0 || depth < 0 || iterations <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    Corpus corpus;
+    if (in_file != NULL) {
+        /* Read into a heap buffer (source_buffer_open may mmap), freed below */
+        SourceBuffer sb;
+        FILE *f = fopen(in_file, "rb");
+        if (f == NULL || source_buffer_from_stream(&sb, f) != 0) {
+            fprintf(stderr, "Error: Cannot open file '%s'\n", in_file);
+            return 1;
+        }
+        fclose(f);
+        corpus.data = sb.data;
+        corpus.length = sb.length;
+        corpus.statements = 0;
+    } else {
+        corpus_generate(&corpus, mix, target, depth, seed);
+    }
+
+    if (out_file != NULL) {
+        FILE *f = fopen(out_file, "w");
+        if (f == NULL) {
+            fprintf(stderr, "Error: Cannot write '%s'\n", out_file);
+            return 1;
+        }
+        fwrite(corpus.data, 1, corpus.length, f);
+        fclose(f);
+    }
+
+    size_t size = corpus.length + SOURCE_BUFFER_PADDING;
+    char *work = malloc(size);
+    if (work == NULL) {
+        fprintf(stderr, "Fatal: out of memory\n");
+        return 1;
+    }
+
+    /* Lexer alone */
+    long tokens = 0;
+    double t_lex = 0.0;
+    for (long it = 0; it < iterations; it++) {
+        reset_work(work, &corpus);
+        tokens = lex_once(work, size, &t_lex);
+    }
+
+    /* Lexer + parser + AST construction */
+    double t_parse = 0.0;
+    double t_free = 0.0;
+    size_t ast_bytes = 0;
+    for (long it = 0; it < iterations; it++) {
+        reset_work(work, &corpus);
+        ASTNode *ast = parse_once(work, size, &t_parse);
+        if (it == 0) {
+            ast_bytes = ast_memory_usage(ast);
+        }
+        double start = now_seconds();
+        ast_free(ast);
+        t_free += now_seconds() - start;
+    }
+
+    /* One instrumented parse for the GLR counters (not timed) */
+    reset_work(work, &corpus);
+    double t_unused = 0.0;
+    parse_glr_stats_begin();
+    ASTNode *ast = parse_once(work, size, &t_unused);
+    ParseGLRStats glr = parse_glr_stats_end();
+
+    /* Compact encoding of the same tree, and a walk over each layout */
+    ASTCompact *ac = ast_compact_build(ast, corpus.data, corpus.length);
+    size_t compact_bytes = ast_compact_memory_usage(ac);
+    double t_walk_pointer = 0.0, t_walk_compact = 0.0;
+    long walk_a = 0, walk_b = 0;
+    for (long it = 0; it < iterations; it++) {
+        double start = now_seconds();
+        walk_a = walk_pointer(ast);
+        t_walk_pointer += now_seconds() - start;
+        start = now_seconds();
+        walk_b = walk_compact(ac, ac->root);
+        t_walk_compact += now_seconds() - start;
+    }
+    if (walk_a != walk_b) {
+        fprintf(stderr, "✗ compact AST walk differs from the pointer tree\n");
+        return 1;
+    }
+    ast_compact_free(ac);
+    ast_free(ast);
+
+    double total_tokens = (double)tokens * (double)iterations;
+    double mb = (double)corpus.length * (double)iterations / (1024.0 * 1024.0);
+
+    printf("Front-end benchmark\n");
+    if (in_file != NULL) {
+        printf("  corpus:          %s\n", in_file);
+    } else {
+        printf("  corpus:          %s, depth %d, seed %u\n", mix_names[mix], depth, seed);
+    }
+    printf("  size:            %zu bytes, %ld tokens", corpus.length, tokens);
+    if (corpus.statements > 0) {
+        printf(", %ld statements", corpus.statements);
+    }
+    printf("\n");
+    printf("  iterations:      %ld\n", iterations);
+    printf("  lex:             %12.0f tokens/sec      (%.1f MB/s, %.3f s)\n",
+           total_tokens / t_lex, mb / t_lex, t_lex);
+    printf("  parse:           %12.0f tokens/sec      (%.1f MB/s, %.3f s)\n",
+           total_tokens / t_parse, mb / t_parse, t_parse);
+    if (corpus.statements > 0) {
+        printf("                   %12.0f statements/sec\n",
+               (double)corpus.statements * (double)iterations / t_parse);
+    }
+    printf("  AST:             %zu bytes", ast_bytes);
+    if (corpus.statements > 0) {
+        printf("  (%.1f bytes/statement)", (double)ast_bytes / (double)corpus.statements);
+    }
+    printf("\n");
+    printf("  compact AST:     %zu bytes", compact_bytes);
+    if (corpus.statements > 0) {
+        printf("  (%.1f bytes/statement)", (double)compact_bytes / (double)corpus.statements);
+    }
+    printf("\n");
+    printf("  AST walk:        %12.3f ms/tree pointer, %.3f ms/tree compact\n",
+           1000.0 * t_walk_pointer / (double)iterations,
+           1000.0 * t_walk_compact / (double)iterations);
+    printf("  AST teardown:    %12.3f ms/tree\n", 1000.0 * t_free / (double)iterations);
+    printf("  GLR splits:      %ld  (%.2f per 1000 tokens)\n",
+           glr.splits, tokens > 0 ? 1000.0 * (double)glr.splits / (double)tokens : 0.0);
+    printf("  GLR merges:      %ld\n", glr.merges);
+    printf("  dead stacks:     %ld\n", glr.dead_stacks);
+    printf("  deferred:        %ld  (semantic actions)\n", glr.deferred_actions);
+    printf("  back to LR:      %ld\n", glr.resolutions);
+
+    free(work);
+    free(corpus.data);
+    return 0;
+}
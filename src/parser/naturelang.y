@@ -25,53 +25,133 @@
  */
 %code requires {
 #include "ast.h"
+#include "parser.h"
+
+/*
+ * yyscan_t: reentrant flex scanner handle (lexer.h/lex.yy.c-র সাথে একই guard)।
+ * yyparse/yylex দুটোই scanner parameter নেয়, তাই header-এই লাগবে।
+ */
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void *yyscan_t;
+#endif
+
+/*
+ * TokenSlice: identifier/string token-এর text, scan buffer-এর ভেতরের view।
+ * lexer strdup করে না; parser action AST-তে কপি করার সময়ই শুধু copy হয়।
+ * ptr[len] সাধারণত NUL নয়, তাই len ছাড়া পড়া যাবে না।
+ */
+typedef struct {
+    const char *ptr;
+    int len;
+} TokenSlice;
 }
 
 %{
 /*
  * এই %{ ... %} অংশের C কোড parser implementation (.tab.c)-এ কপি হয়।
- * এখানে helper function, global parser state, extern symbols রাখা হয়।
+ * parser pure (api.pure): কোনো global parser state নেই; প্রতিটি parse-এর
+ * state ParseContext (ctx) আর reentrant scanner-এ থাকে।
  */
 #define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include "ast.h"
+#include "source_buffer.h"
 
 /*
- * Forward declarations:
- * - yylex: parser token চাইলে lexer এই function দিয়ে next token দেয়
- * - yylineno: lexer maintain করা current line number
- * - yytext: শেষ match হওয়া token-এর raw text
- * - yyin: lexer কোন FILE* থেকে পড়বে
+ * make_loc(scanner): বর্তমান token অবস্থান থেকে SourceLocation বানায়।
+ *
+ * বর্তমানে line-level তথ্য (first_line) প্রধানত ভরা হচ্ছে;
+ * ভবিষ্যতে চাইলে column/last_line/filename-ও lexer location tracking থেকে ভরা যাবে।
  */
-extern int yylex(void);
-extern int yylineno;
-extern char *yytext;
-extern FILE *yyin;
+%}
 
-/* Bison parse error হলে yyerror callback invoke হয় */
-void yyerror(const char *s);
+/* YYSTYPE/YYLTYPE/ParseContext জানা থাকতে হবে, তাই এগুলো %code block-এ */
+%code {
+/*
+ * Forward declarations (reentrant flex scanner):
+ * - yylex: parser token চাইলে lexer value/location pointer আর scanner নিয়ে
+ *   next token দেয় (bison-bridge, bison-locations)
+ * - yyget_lineno: ওই scanner-এর current line number
+ * - yyget_text: ওই scanner-এর শেষ match হওয়া token-এর raw text
+ *
+ * lexer সবসময় in-memory SourceBuffer scan করে (lexer_scan_buffer),
+ * তাই yyin এখানে দরকার নেই।
+ */
+int yylex(YYSTYPE *yylval_param, YYLTYPE *yylloc_param, yyscan_t yyscanner);
+int yyget_lineno(yyscan_t yyscanner);
+char *yyget_text(yyscan_t yyscanner);
+int lexer_scan_buffer(yyscan_t *scanner, char *base, size_t size, const char *filename);
+void lexer_scan_end(yyscan_t scanner);
+
+/* Bison parse error হলে yyerror callback invoke হয় */
+static void yyerror(YYLTYPE *llocp, yyscan_t scanner, ParseContext *ctx, const char *s);
 
+#ifdef NATURELANG_PARSE_STATS
 /*
- * parse_result:
- * - yyparse() int return করে (success/fail), AST সরাসরি return করে না
- * - তাই root ASTNode parser state-এ ধরে রাখা হয়
+ * bench_frontend build (-DYYDEBUG=1 -DNATURELANG_PARSE_STATS):
+ * Bison-এর GLR trace ("Splitting off stack ...", "Merging stack ...")
+ * stderr-এ না লিখে parse_stats_trace()-এ যায়, যেটা শুধু গুনে রাখে।
  */
-static ASTNode *parse_result = NULL;
+int parse_stats_trace(FILE *stream, const char *format, ...);
+#define YYFPRINTF parse_stats_trace
+#endif
 
 /*
- * make_loc(): বর্তমান token অবস্থান থেকে SourceLocation বানায়।
+ * make_loc(scanner): বর্তমান token অবস্থান থেকে SourceLocation বানায়।
  *
  * বর্তমানে line-level তথ্য (first_line) প্রধানত ভরা হচ্ছে;
  * ভবিষ্যতে চাইলে column/last_line/filename-ও lexer location tracking থেকে ভরা যাবে।
  */
-static SourceLocation make_loc(void) {
+static SourceLocation make_loc(yyscan_t scanner) {
     SourceLocation loc = {NULL, 0, 0, 0, 0};
-    loc.first_line = yylineno;
+    loc.first_line = yyget_lineno(scanner);
     return loc;
 }
-%}
+
+/*
+ * tok_text(): TokenSlice -> NUL-terminated C string (ast_create_* এর জন্য)।
+ *
+ * - string literal slice আগেই NUL-terminated (lexer closing quote-এ NUL বসায়),
+ *   তাই সরাসরি ptr ফেরত দেওয়া যায়
+ * - identifier slice-এর পরের byte source-এর অংশ, তাই ctx-এর reusable scratch
+ *   buffer-এ কপি করা হয়; ast_create_* নিজেই name কপি করে, ফলে পরের call-এ
+ *   scratch overwrite হওয়া নিরাপদ
+ */
+static const char *tok_text(ParseContext *ctx, TokenSlice t) {
+    size_t len = (size_t)t.len;
+    if (t.ptr[len] == '\0') {
+        return t.ptr;
+    }
+    if (len + 1 > ctx->scratch_cap) {
+        size_t cap = ctx->scratch_cap ? ctx->scratch_cap : 64;
+        while (cap < len + 1) cap *= 2;
+        char *grown = realloc(ctx->scratch, cap);
+        if (grown == NULL) {
+            fprintf(stderr, "Fatal: Memory allocation failed\n");
+            exit(1);
+        }
+        ctx->scratch = grown;
+        ctx->scratch_cap = cap;
+    }
+    memcpy(ctx->scratch, t.ptr, len);
+    ctx->scratch[len] = '\0';
+    return ctx->scratch;
+}
+
+/*
+ * list_call(): list builtin (builtins.def) call — name(list) বা
+ * name(list, value); value NULL হলে এক argument।
+ */
+static ASTNode *list_call(const char *name, ASTNode *list, ASTNode *value, SourceLocation loc) {
+    ASTNodeList *args = ast_node_list_create();
+    ast_node_list_append(args, list);
+    if (value) ast_node_list_append(args, value);
+    return ast_create_func_call(name, args, loc);
+}
+}
 
 /* ============================================================================
  * TOKEN AND TYPE DEFINITIONS
@@ -84,8 +164,8 @@ static SourceLocation make_loc(void) {
     long long int_val;
     /* float literal semantic value */
     double float_val;
-    /* string/identifier token text */
-    char *str_val;
+    /* string/identifier token text (scan buffer slice, owned নয়) */
+    TokenSlice slice;
     /* single character token value (প্রয়োজনে) */
     char char_val;
     /* boolean token value */
@@ -103,8 +183,8 @@ static SourceLocation make_loc(void) {
 /* Literals */
 %token <int_val> TOK_INTEGER
 %token <float_val> TOK_FLOAT
-%token <str_val> TOK_STRING
-%token <str_val> TOK_IDENTIFIER
+%token <slice> TOK_STRING
+%token <slice> TOK_IDENTIFIER
 %token <bool_val> TOK_TRUE TOK_FALSE TOK_YES TOK_NO
 
 /* Keywords - Declaration (match tokens.h) */
@@ -116,6 +196,8 @@ static SourceLocation make_loc(void) {
 
 /* Control flow (match tokens.h) */
 %token TOK_IF TOK_THEN TOK_OTHERWISE TOK_ELSE TOK_END
+/* Block closers - "end if", "end while", ... lexed as one token (match tokens.h) */
+%token TOK_END_IF TOK_END_WHILE TOK_END_REPEAT TOK_END_FOR
 %token TOK_REPEAT TOK_TIMES TOK_WHILE TOK_DO TOK_FOR TOK_EACH TOK_IN TOK_FROM TOK_UNTIL
 %token TOK_STOP TOK_SKIP
 
@@ -162,6 +244,10 @@ static SourceLocation make_loc(void) {
 %token TOK_ADD TOK_REMOVE TOK_GET TOK_ITEM TOK_AT TOK_POSITION TOK_LENGTH TOK_SIZE TOK_APPEND
 %token TOK_FIRST TOK_LAST
 
+/* Random numbers - multi-word tokens (match tokens.h) */
+%token TOK_RANDOM_NUMBER TOK_RANDOM_NUMBERS TOK_RANDOM_DECIMAL TOK_SEED_RANDOM
+%token TOK_CONTAINS TOK_SUM_OF TOK_LARGEST TOK_SMALLEST TOK_COUNT_OF TOK_POSITION_OF
+
 /* Type declarations for non-terminals */
 /*
  * %type mapping very important:
@@ -176,21 +262,22 @@ static SourceLocation make_loc(void) {
 %type <node> secure_zone_statement
 %type <node> expression term factor primary
 %type <node> comparison logic_expr
+%type <node> mul_tail add_tail comparison_tail logic_tail
 %type <node> opt_else
-%type <node> function_call list_literal
+%type <node> function_call call_with_args argument list_literal
+%type <node> random_number random_decimal list_aggregate
 %type <list> statement_block param_list arg_list expr_list
 %type <dtype> type_specifier
-%type <oper> add_op mul_op rel_op
+%type <oper> add_op mul_op cmp_op
 
 /*
- * GLR parser can build multiple parse branches and later discard losers.
- * These destructors prevent leaks for semantic values that are discarded
- * before becoming part of the final AST.
+ * Error recovery (and the GLR fallback build, when it discards a branch)
+ * pops semantic values that never become part of the final AST.
+ * These destructors prevent leaks for those values.
  */
-%destructor { free($$); } <str_val>
 %destructor { if ($$) ast_free($$); } <node>
 %destructor { if ($$) ast_node_list_free($$); } <list>
-/* Start symbol is handed to caller via parse_result; don't auto-destroy it. */
+/* Start symbol is handed to caller via ctx->result; don't auto-destroy it. */
 %destructor { } program
 
 /* Helper rules - no semantic value needed */
@@ -204,33 +291,40 @@ static SourceLocation make_loc(void) {
  *
  * উপরে থেকে নিচে যেতে precedence শক্তিশালী হয়।
  */
+%precedence TOK_WITH
+%precedence TOK_COMMA
 %left TOK_OR TOK_OP_OR
 %left TOK_AND TOK_OP_AND
 %nonassoc TOK_NOT TOK_OP_NOT
 %nonassoc TOK_IS TOK_EQUALS TOK_GREATER TOK_LESS TOK_OP_EQEQ TOK_OP_NEQ TOK_OP_LT TOK_OP_GT TOK_OP_LTE TOK_OP_GTE
-%nonassoc TOK_GREATER_THAN TOK_LESS_THAN TOK_EQUAL_TO TOK_NOT_EQUAL_TO TOK_AT_LEAST TOK_AT_MOST
+%nonassoc TOK_GREATER_THAN TOK_LESS_THAN TOK_EQUAL_TO TOK_NOT_EQUAL_TO TOK_AT_LEAST TOK_AT_MOST TOK_CONTAINS
 %left TOK_PLUS TOK_MINUS TOK_OP_PLUS TOK_OP_MINUS
 %left TOK_MULTIPLIED TOK_DIVIDED TOK_MODULO TOK_OP_STAR TOK_OP_SLASH TOK_OP_PERCENT TOK_BY
 %right TOK_POWER TOK_OP_CARET
 %right TOK_SQUARED
 
-/* Expect conflicts - NatureLang's flexible syntax causes many valid shift/reduce conflicts.
- * These are intentional due to optional terminators and flexible expression syntax.
- * We use a GLR parser to handle reduce/reduce conflicts from ambiguous rules. */
-%glr-parser
-%expect 88
-%expect-rr 66
+/*
+ * Deterministic LALR(1) grammar: কোনো conflict নেই (%expect 0)।
+ * Multi-word phrase ("end if", "and store", ...) lexer একটাই token দেয়,
+ * বাকি ambiguity precedence দিয়ে resolve হয়। একই grammar থেকে GLR parser-ও
+ * বানানো যায় (make PARSER_MODE=glr, bison -S glr.c) — fallback/তুলনার জন্য।
+ */
+
+/*
+ * Pure (reentrant) parser: yylval/yylloc local, global state নেই।
+ * - scanner: এই parse-এর flex scanner, yylex-এও পাঠানো হয়
+ * - ctx: parse result, error count, identifier scratch
+ */
+%define api.pure
+%locations
+%param {yyscan_t scanner}
+%parse-param {ParseContext *ctx}
+%expect 0
 
-/* Merge function to resolve ambiguous GLR parses - just pick the first one */
 %define parse.error verbose
 
 %start program
 
-%code {
-/* GLR merge function - when two ambiguous parses produce the same result, pick one */
-static YYSTYPE merge_nodes(YYSTYPE x0, YYSTYPE x1);
-}
-
 /*
  * NOTE on $$ / $n notation (global cheat-sheet):
  * - $$ = বর্তমান production reduce হওয়ার final semantic value
@@ -267,10 +361,10 @@ program
                 /* single statement/ব্লক যাই হোক, program statement list-এ ঢোকাও */
                 ast_node_list_append(stmts, $1);
             }
-            /* parse_result-এ root AST_PROGRAM node ধরে রাখা হয় */
-            parse_result = ast_create_program(stmts, make_loc());
+            /* ctx->result-এ root AST_PROGRAM node ধরে রাখা হয় */
+            ctx->result = ast_create_program(stmts, make_loc(scanner));
             /* program rule-এর আউটপুট হিসেবে root node ফেরত */
-            $$ = parse_result;
+            $$ = ctx->result;
         }
     ;
 
@@ -311,7 +405,20 @@ statement_list
              *   - $3: production-এর তৃতীয় অংশ (opt_terminator)
              *   - $$: পুরো rule reduce হওয়ার পরে final output value
              */
-            if ($1 == NULL) {
+            if (ctx->on_statement != NULL) {
+                /*
+                 * streaming mode: statement সাথে সাথে callback-এ যায়, তারপর
+                 * arena reset করে পরের statement একই memory-তে বানানো হয়।
+                 * parser stack-এ এর নিচে শুধু এই (NULL) statement_list, আর
+                 * lookahead token arena-তে থাকে না, তাই কোনো live node হারায় না।
+                 * syntax error-এর পরের statement আর পাঠানো হয় না।
+                 */
+                if ($2 != NULL && ctx->error_count == 0) {
+                    ctx->on_statement($2, ctx->on_statement_data);
+                }
+                ast_arena_reset(ctx->arena);
+                $$ = NULL;
+            } else if ($1 == NULL) {
                 /*
                  * এখন পর্যন্ত কোনো list তৈরি হয়নি।
                  * তাই বর্তমান statement-ই এই মুহূর্তে statement_list-এর result।
@@ -339,7 +446,7 @@ statement_list
                     ASTNodeList *stmts = ast_node_list_create();
                     ast_node_list_append(stmts, $1);
             ast_node_list_append(stmts, $2);
-            $$ = ast_create_block(stmts, make_loc());
+            $$ = ast_create_block(stmts, make_loc(scanner));
                 }
             } else {
                 /*
@@ -404,12 +511,24 @@ statement
     | secure_zone_statement
     | function_call
         /* function_call expression হলেও standalone statement হিসেবে wrap করা হয় */
-        { $$ = ast_create_expr_stmt($1, make_loc()); }    | TOK_STOP
+        { $$ = ast_create_expr_stmt($1, make_loc(scanner)); }
+    | call_with_args
+        /* "call f with ..." standalone statement হিসেবেও একইভাবে wrap হয় */
+        { $$ = ast_create_expr_stmt($1, make_loc(scanner)); }
+    | TOK_SEED_RANDOM TOK_WITH expression
+        {
+            /* seed random with N => __seed_random(N), একই N-এ একই sequence */
+            ASTNodeList *args = ast_node_list_create();
+            ast_node_list_append(args, $3);
+            $$ = ast_create_expr_stmt(ast_create_func_call("__seed_random", args, make_loc(scanner)),
+                                      make_loc(scanner));
+            }
+    | TOK_STOP
         /* stop => break statement AST */
-        { $$ = ast_create_break(make_loc()); }
+        { $$ = ast_create_break(make_loc(scanner)); }
     | TOK_SKIP
         /* skip => continue statement AST */
-        { $$ = ast_create_continue(make_loc()); }
+        { $$ = ast_create_continue(make_loc(scanner)); }
     ;
 
 /* ============================================================================
@@ -430,51 +549,68 @@ declaration
     : TOK_CREATE article type_specifier TOK_CALLED TOK_IDENTIFIER TOK_AND TOK_SET expression
         {
             /* $5=name, $3=type, $8=initializer expression, 0=non-constant */
-            $$ = ast_create_var_decl($5, $3, $8, 0, make_loc());
-            /* lexer allocated identifier string; AST constructor copy ধরে নেয় */
-            free($5);
+            $$ = ast_create_var_decl(tok_text(ctx, $5), $3, $8, 0, make_loc(scanner));
+            /* identifier slice AST constructor-এ কপি হয়ে যায় */
             }
     | TOK_CREATE article type_specifier TOK_CALLED TOK_IDENTIFIER
         {
             /* initializer নেই => NULL */
-            $$ = ast_create_var_decl($5, $3, NULL, 0, make_loc());
-            free($5);
+            $$ = ast_create_var_decl(tok_text(ctx, $5), $3, NULL, 0, make_loc(scanner));
             }
     | TOK_CREATE article type_specifier TOK_NAMED TOK_IDENTIFIER TOK_AND TOK_SET expression
         {
             /* called এর বদলে named syntax; mapping একই */
-            $$ = ast_create_var_decl($5, $3, $8, 0, make_loc());
-            free($5);
+            $$ = ast_create_var_decl(tok_text(ctx, $5), $3, $8, 0, make_loc(scanner));
             }
     | TOK_CREATE article type_specifier TOK_NAMED TOK_IDENTIFIER
         {
-            $$ = ast_create_var_decl($5, $3, NULL, 0, make_loc());
-            free($5);
+            $$ = ast_create_var_decl(tok_text(ctx, $5), $3, NULL, 0, make_loc(scanner));
             }
     | TOK_MAKE TOK_IDENTIFIER article TOK_CONSTANT type_specifier TOK_WITH TOK_VALUE expression
         {
             /* make ... constant ... => is_const = 1 */
-            $$ = ast_create_var_decl($2, $5, $8, 1, make_loc());
-            free($2);
+            $$ = ast_create_var_decl(tok_text(ctx, $2), $5, $8, 1, make_loc(scanner));
             }
     | TOK_CREATE article TOK_CONSTANT type_specifier TOK_CALLED TOK_IDENTIFIER TOK_AND TOK_SET expression
         {
             /* create constant syntax; type=$4, name=$6, init=$9 */
-            $$ = ast_create_var_decl($6, $4, $9, 1, make_loc());
-            free($6);
+            $$ = ast_create_var_decl(tok_text(ctx, $6), $4, $9, 1, make_loc(scanner));
             }
     | TOK_CREATE article TOK_TYPE_LIST TOK_OF type_specifier TOK_CALLED TOK_IDENTIFIER
         {
             /* list declaration without explicit initializer */
-            $$ = ast_create_var_decl($7, TYPE_LIST, NULL, 0, make_loc());
-            free($7);
+            $$ = ast_create_var_decl(tok_text(ctx, $7), TYPE_LIST, NULL, 0, make_loc(scanner));
+            /* "list of <type>" => element type declaration node-এ রাখি */
+            $$->elem_type = $5;
+            }
+    | TOK_CREATE article type_specifier TOK_CALLED TOK_IDENTIFIER TOK_WITH expr_list
+        {
+            /*
+             * type_specifier (শুধু TOK_TYPE_LIST নয়): তাহলে "create a list called x"
+             * আর "... called x with 1, 2" একই prefix শেয়ার করে, conflict হয় না।
+             * list ছাড়া অন্য type-এ initial element দেওয়া error।
+             */
+            if ($3 != TYPE_LIST) {
+                yyerror(&@$, scanner, ctx, "only a list can be created with initial elements");
             }
-    | TOK_CREATE article TOK_TYPE_LIST TOK_CALLED TOK_IDENTIFIER TOK_WITH expr_list
+            /* $7 = expr_list => list literal node বানিয়ে initializer হিসেবে দাও */
+            ASTNode *init = ast_create_list($7, make_loc(scanner));
+            $$ = ast_create_var_decl(tok_text(ctx, $5), TYPE_LIST, init, 0, make_loc(scanner));
+            }
+    | TOK_CREATE article type_specifier TOK_CALLED TOK_IDENTIFIER TOK_WITH expression
+      TOK_RANDOM_NUMBERS TOK_BETWEEN term TOK_AND term
         {
-            /* $7 = expr_list => list literal node বানিয়ে initializer হিসেবে দাও */
-            ASTNode *init = ast_create_list($7, make_loc());
-            $$ = ast_create_var_decl($5, TYPE_LIST, init, 0, make_loc());
-            free($5);
+            /* "... with 1000 random numbers between 1 and 6" => __random_list(n, low, high) */
+            if ($3 != TYPE_LIST) {
+                yyerror(&@$, scanner, ctx, "only a list can be created with random numbers");
+            }
+            ASTNodeList *args = ast_node_list_create();
+            ast_node_list_append(args, $7);
+            ast_node_list_append(args, $10);
+            ast_node_list_append(args, $12);
+            ASTNode *init = ast_create_func_call("__random_list", args, make_loc(scanner));
+            $$ = ast_create_var_decl(tok_text(ctx, $5), TYPE_LIST, init, 0, make_loc(scanner));
+            $$->elem_type = TYPE_NUMBER;
             }
     ;
 
@@ -521,38 +657,33 @@ assignment
     : TOK_SET TOK_IDENTIFIER TOK_TO expression
         {
             /* target variable node তৈরি */
-            ASTNode *target = ast_create_identifier($2, make_loc());
+            ASTNode *target = ast_create_identifier(tok_text(ctx, $2), make_loc(scanner));
             /* assignment node: target = value */
-            $$ = ast_create_assign(target, $4, make_loc());
-            free($2);
+            $$ = ast_create_assign(target, $4, make_loc(scanner));
             }
     | TOK_CHANGE TOK_THE TOK_VALUE TOK_OF TOK_IDENTIFIER TOK_TO expression
         {
-            ASTNode *target = ast_create_identifier($5, make_loc());
-            $$ = ast_create_assign(target, $7, make_loc());
-            free($5);
+            ASTNode *target = ast_create_identifier(tok_text(ctx, $5), make_loc(scanner));
+            $$ = ast_create_assign(target, $7, make_loc(scanner));
             }
     | TOK_SET TOK_IDENTIFIER TOK_AT expression TOK_TO expression
         {
             /* array identifier */
-            ASTNode *arr = ast_create_identifier($2, make_loc());
+            ASTNode *arr = ast_create_identifier(tok_text(ctx, $2), make_loc(scanner));
             /* indexed target: arr[index] */
-            ASTNode *target = ast_create_index(arr, $4, make_loc());
+            ASTNode *target = ast_create_index(arr, $4, make_loc(scanner));
             /* arr[index] = value */
-            $$ = ast_create_assign(target, $6, make_loc());
-            free($2);
+            $$ = ast_create_assign(target, $6, make_loc(scanner));
             }
     | TOK_IDENTIFIER TOK_BECOMES expression
         {
-            ASTNode *target = ast_create_identifier($1, make_loc());
-            $$ = ast_create_assign(target, $3, make_loc());
-            free($1);
+            ASTNode *target = ast_create_identifier(tok_text(ctx, $1), make_loc(scanner));
+            $$ = ast_create_assign(target, $3, make_loc(scanner));
             }
     | TOK_IDENTIFIER TOK_OP_EQ expression
         {
-            ASTNode *target = ast_create_identifier($1, make_loc());
-            $$ = ast_create_assign(target, $3, make_loc());
-            free($1);
+            ASTNode *target = ast_create_identifier(tok_text(ctx, $1), make_loc(scanner));
+            $$ = ast_create_assign(target, $3, make_loc(scanner));
             }
     ;
 
@@ -569,17 +700,17 @@ assignment
  * AST_IF node তৈরি করে।
  */
 if_statement
-    : TOK_IF expression TOK_THEN statement_block opt_else TOK_END TOK_IF
+    : TOK_IF expression TOK_THEN statement_block opt_else TOK_END_IF
         {
             /* $4 = statement_block (ASTNodeList*) => AST_BLOCK node */
-            ASTNode *then_block = ast_create_block($4, make_loc());
+            ASTNode *then_block = ast_create_block($4, make_loc(scanner));
             /* $2 = condition, $5 = optional else block */
-            $$ = ast_create_if($2, then_block, $5, make_loc());
+            $$ = ast_create_if($2, then_block, $5, make_loc(scanner));
             }
     | TOK_IF expression TOK_THEN statement_block opt_else TOK_END
         {
-            ASTNode *then_block = ast_create_block($4, make_loc());
-            $$ = ast_create_if($2, then_block, $5, make_loc());
+            ASTNode *then_block = ast_create_block($4, make_loc(scanner));
+            $$ = ast_create_if($2, then_block, $5, make_loc(scanner));
             }
     ;
 
@@ -595,11 +726,11 @@ opt_else
     | TOK_OTHERWISE statement_block
         {
             /* statement list-কে AST_BLOCK এ রূপান্তর */
-            $$ = ast_create_block($2, make_loc());
+            $$ = ast_create_block($2, make_loc(scanner));
             }
     | TOK_ELSE statement_block
         {
-            $$ = ast_create_block($2, make_loc());
+            $$ = ast_create_block($2, make_loc(scanner));
             }
     ;
 
@@ -610,16 +741,16 @@ opt_else
  * AST_WHILE node তৈরি করে।
  */
 while_statement
-    : TOK_WHILE expression TOK_DO statement_block TOK_END TOK_WHILE
+    : TOK_WHILE expression TOK_DO statement_block TOK_END_WHILE
         {
-            ASTNode *body = ast_create_block($4, make_loc());
+            ASTNode *body = ast_create_block($4, make_loc(scanner));
             /* $2 = loop condition, body = loop block */
-            $$ = ast_create_while($2, body, make_loc());
+            $$ = ast_create_while($2, body, make_loc(scanner));
             }
     | TOK_WHILE expression TOK_DO statement_block TOK_END
         {
-            ASTNode *body = ast_create_block($4, make_loc());
-            $$ = ast_create_while($2, body, make_loc());
+            ASTNode *body = ast_create_block($4, make_loc(scanner));
+            $$ = ast_create_while($2, body, make_loc(scanner));
             }
     ;
 
@@ -630,16 +761,16 @@ while_statement
  * count expression এবং body block মিলে AST_REPEAT node হয়।
  */
 repeat_statement
-    : TOK_REPEAT expression TOK_TIMES statement_block TOK_END TOK_REPEAT
+    : TOK_REPEAT expression TOK_TIMES statement_block TOK_END_REPEAT
         {
-            ASTNode *body = ast_create_block($4, make_loc());
+            ASTNode *body = ast_create_block($4, make_loc(scanner));
             /* $2 বার body execute করার semantic */
-            $$ = ast_create_repeat($2, body, make_loc());
+            $$ = ast_create_repeat($2, body, make_loc(scanner));
             }
     | TOK_REPEAT expression TOK_TIMES statement_block TOK_END
         {
-            ASTNode *body = ast_create_block($4, make_loc());
-            $$ = ast_create_repeat($2, body, make_loc());
+            ASTNode *body = ast_create_block($4, make_loc(scanner));
+            $$ = ast_create_repeat($2, body, make_loc(scanner));
             }
     ;
 
@@ -649,18 +780,16 @@ repeat_statement
  * iterator নাম, iterable expression, body block নিয়ে AST_FOR_EACH বানায়।
  */
 for_each_statement
-    : TOK_FOR TOK_EACH TOK_IDENTIFIER TOK_IN expression TOK_DO statement_block TOK_END TOK_FOR
+    : TOK_FOR TOK_EACH TOK_IDENTIFIER TOK_IN expression TOK_DO statement_block TOK_END_FOR
         {
-            ASTNode *body = ast_create_block($7, make_loc());
+            ASTNode *body = ast_create_block($7, make_loc(scanner));
             /* iterator নাম=$3, iterable expr=$5 */
-            $$ = ast_create_for_each($3, $5, body, make_loc());
-            free($3);
+            $$ = ast_create_for_each(tok_text(ctx, $3), $5, body, make_loc(scanner));
             }
     | TOK_FOR TOK_EACH TOK_IDENTIFIER TOK_IN expression TOK_DO statement_block TOK_END
         {
-            ASTNode *body = ast_create_block($7, make_loc());
-            $$ = ast_create_for_each($3, $5, body, make_loc());
-            free($3);
+            ASTNode *body = ast_create_block($7, make_loc(scanner));
+            $$ = ast_create_for_each(tok_text(ctx, $3), $5, body, make_loc(scanner));
             }
     ;
 
@@ -699,46 +828,40 @@ function_decl
     : TOK_DEFINE article TOK_FUNCTION TOK_CALLED TOK_IDENTIFIER TOK_THAT TOK_TAKES param_list TOK_AND TOK_RETURNS type_specifier TOK_OP_COLON statement_block TOK_END TOK_FUNCTION
         {
             /* $13 = body statements => block node */
-            ASTNode *body = ast_create_block($13, make_loc());
+            ASTNode *body = ast_create_block($13, make_loc(scanner));
             /* name=$5, params=$8, return_type=$11 */
-            $$ = ast_create_func_decl($5, $8, $11, body, make_loc());
-            free($5);
+            $$ = ast_create_func_decl(tok_text(ctx, $5), $8, $11, body, make_loc(scanner));
             }
     | TOK_DEFINE article TOK_FUNCTION TOK_CALLED TOK_IDENTIFIER TOK_THAT TOK_TAKES param_list TOK_OP_COLON statement_block TOK_END TOK_FUNCTION
         {
-            ASTNode *body = ast_create_block($10, make_loc());
+            ASTNode *body = ast_create_block($10, make_loc(scanner));
             /* return type omitted => TYPE_NOTHING */
-            $$ = ast_create_func_decl($5, $8, TYPE_NOTHING, body, make_loc());
-            free($5);
+            $$ = ast_create_func_decl(tok_text(ctx, $5), $8, TYPE_NOTHING, body, make_loc(scanner));
             }
     | TOK_DEFINE article TOK_FUNCTION TOK_CALLED TOK_IDENTIFIER TOK_OP_COLON statement_block TOK_END TOK_FUNCTION
         {
-            ASTNode *body = ast_create_block($7, make_loc());
+            ASTNode *body = ast_create_block($7, make_loc(scanner));
             /* params omitted => NULL, return omitted => nothing */
-            $$ = ast_create_func_decl($5, NULL, TYPE_NOTHING, body, make_loc());
-            free($5);
+            $$ = ast_create_func_decl(tok_text(ctx, $5), NULL, TYPE_NOTHING, body, make_loc(scanner));
             }
     /* Flexible syntax without "called" - "define a function NAME that takes..." */
     | TOK_DEFINE article TOK_FUNCTION TOK_IDENTIFIER TOK_THAT TOK_TAKES param_list TOK_AND TOK_RETURNS type_specifier statement_block TOK_END TOK_FUNCTION
         {
             /* symbol index recap: $4=name, $7=params, $10=return type, $11=body-list */
-            ASTNode *body = ast_create_block($11, make_loc());
-            $$ = ast_create_func_decl($4, $7, $10, body, make_loc());
-            free($4);
+            ASTNode *body = ast_create_block($11, make_loc(scanner));
+            $$ = ast_create_func_decl(tok_text(ctx, $4), $7, $10, body, make_loc(scanner));
             }
     | TOK_DEFINE article TOK_FUNCTION TOK_IDENTIFIER TOK_THAT TOK_TAKES param_list statement_block TOK_END TOK_FUNCTION
         {
             /* return type omitted => TYPE_NOTHING; body-list at $8 */
-            ASTNode *body = ast_create_block($8, make_loc());
-            $$ = ast_create_func_decl($4, $7, TYPE_NOTHING, body, make_loc());
-            free($4);
+            ASTNode *body = ast_create_block($8, make_loc(scanner));
+            $$ = ast_create_func_decl(tok_text(ctx, $4), $7, TYPE_NOTHING, body, make_loc(scanner));
             }
     | TOK_DEFINE article TOK_FUNCTION TOK_IDENTIFIER statement_block TOK_END TOK_FUNCTION
         {
             /* shortest form: only name + body; params=NULL, return=TYPE_NOTHING */
-            ASTNode *body = ast_create_block($5, make_loc());
-            $$ = ast_create_func_decl($4, NULL, TYPE_NOTHING, body, make_loc());
-            free($4);
+            ASTNode *body = ast_create_block($5, make_loc(scanner));
+            $$ = ast_create_func_decl(tok_text(ctx, $4), NULL, TYPE_NOTHING, body, make_loc(scanner));
             }
     ;
 
@@ -753,33 +876,29 @@ param_list
             /* প্রথম parameter আসলে নতুন list তৈরি */
             $$ = ast_node_list_create();
             /* $2=name, $1=type */
-            ASTNode *param = ast_create_param_decl($2, $1, make_loc());
+            ASTNode *param = ast_create_param_decl(tok_text(ctx, $2), $1, make_loc(scanner));
             ast_node_list_append($$, param);
-            free($2);
             }
     | TOK_IDENTIFIER
         {
             /* No type specifier - default to unknown */
             $$ = ast_node_list_create();
-            ASTNode *param = ast_create_param_decl($1, TYPE_UNKNOWN, make_loc());
+            ASTNode *param = ast_create_param_decl(tok_text(ctx, $1), TYPE_UNKNOWN, make_loc(scanner));
             ast_node_list_append($$, param);
-            free($1);
             }
     | param_list TOK_COMMA type_specifier TOK_IDENTIFIER
         {
             /* বিদ্যমান list ($1)-এ নতুন typed parameter append */
-            ASTNode *param = ast_create_param_decl($4, $3, make_loc());
+            ASTNode *param = ast_create_param_decl(tok_text(ctx, $4), $3, make_loc(scanner));
             ast_node_list_append($1, param);
             $$ = $1;
-            free($4);
             }
     | param_list TOK_COMMA TOK_IDENTIFIER
         {
             /* type না থাকায় TYPE_UNKNOWN ধরা হচ্ছে */
-            ASTNode *param = ast_create_param_decl($3, TYPE_UNKNOWN, make_loc());
+            ASTNode *param = ast_create_param_decl(tok_text(ctx, $3), TYPE_UNKNOWN, make_loc(scanner));
             ast_node_list_append($1, param);
             $$ = $1;
-            free($3);
             }
     ;
 
@@ -796,16 +915,16 @@ param_list
 return_statement
     : TOK_RETURN expression
         /* return <expr> */
-        { $$ = ast_create_return($2, make_loc()); }    | TOK_RETURN TOK_THE expression
+        { $$ = ast_create_return($2, make_loc(scanner)); }    | TOK_RETURN TOK_THE expression
         /* return the <expr> */
-        { $$ = ast_create_return($3, make_loc()); }    | TOK_RETURN TOK_TYPE_NOTHING
+        { $$ = ast_create_return($3, make_loc(scanner)); }    | TOK_RETURN TOK_TYPE_NOTHING
         /* explicit void return */
-        { $$ = ast_create_return(NULL, make_loc()); }
+        { $$ = ast_create_return(NULL, make_loc(scanner)); }
     | TOK_GIVE expression
         /* synonym: give <expr> */
-        { $$ = ast_create_return($2, make_loc()); }    | TOK_GIVE TOK_TYPE_NOTHING
+        { $$ = ast_create_return($2, make_loc(scanner)); }    | TOK_GIVE TOK_TYPE_NOTHING
         /* synonym form of void return */
-        { $$ = ast_create_return(NULL, make_loc()); }
+        { $$ = ast_create_return(NULL, make_loc(scanner)); }
     ;
 
 /* ============================================================================
@@ -824,8 +943,9 @@ return_statement
  * semantic-value quick reference (এই rule-এর context):
  * - $$ : display_statement rule reduce হওয়ার পর final ASTNode* result
  * - $2 : দ্বিতীয় symbol-এর semantic value (সাধারণত expression node)
- * - $5 : পঞ্চম symbol-এর semantic value (expression node)
- * - make_loc() : current parse location (line/position) থেকে SourceLocation বানায়,
+ * - "display the value of x" আলাদা rule নয়: primary-র "the value of" form
+ *   দিয়েই parse হয় (আগের আলাদা rule-টা primary-র সাথে reduce/reduce conflict দিত)
+ * - make_loc(scanner) : current parse location (line/position) থেকে SourceLocation বানায়,
  *   যাতে AST node-এ error-reporting metadata থাকে
  */
 display_statement
@@ -837,42 +957,30 @@ display_statement
          * এখানে expression দ্বিতীয় symbol, তাই value পাওয়া যায় $2 থেকে
          */
         /* $$ তে final display node রাখা হচ্ছে */
-        { $$ = ast_create_display($2, make_loc()); }    | TOK_DISPLAY TOK_THE TOK_VALUE TOK_OF expression
-        /*
-         * Natural-language long form: "display the value of <expr>"
-         * Symbols:
-         *   1: TOK_DISPLAY
-         *   2: TOK_THE
-         *   3: TOK_VALUE
-         *   4: TOK_OF
-         *   5: expression
-         * তাই expression-এর semantic value এখানে $5
-         */
-        /* $5 expression এবং make_loc() দিয়ে AST_DISPLAY node তৈরি */
-        { $$ = ast_create_display($5, make_loc()); }    | TOK_SHOW expression
+        { $$ = ast_create_display($2, make_loc(scanner)); }    | TOK_SHOW expression
         /* 'show <expr>' variant; expression দ্বিতীয় symbol => $2 */
-        { $$ = ast_create_display($2, make_loc()); }    | TOK_PRINT expression
+        { $$ = ast_create_display($2, make_loc(scanner)); }    | TOK_PRINT expression
         /* 'print <expr>' variant; expression দ্বিতীয় symbol => $2 */
-        { $$ = ast_create_display($2, make_loc()); }    ;
+        { $$ = ast_create_display($2, make_loc(scanner)); }    ;
 
 /* ask "What is your name?" and store in name */
 /* ask for user's name and store in name */
 /*
  * ask_statement prompt expression নিয়ে user input নেওয়ার statement।
  * target variable-এ ইনপুট সংরক্ষণ করার AST_ASK node তৈরি হয়।
+ * prompt comparison স্তরের expression: 'and' এখানে "and store"-এর অংশ,
+ * logical and নয় (logical prompt লাগলে bracket দিতে হয়)।
  */
 ask_statement
-    : TOK_ASK expression TOK_AND TOK_STORE TOK_IN TOK_IDENTIFIER
+    : TOK_ASK comparison TOK_AND TOK_STORE TOK_IN TOK_IDENTIFIER
         {
             /* $2 prompt, $6 target variable name */
-            $$ = ast_create_ask($2, $6, make_loc());
-            free($6);
+            $$ = ast_create_ask($2, tok_text(ctx, $6), make_loc(scanner));
             }
-    | TOK_ASK TOK_FROM TOK_USER expression TOK_AND TOK_STORE TOK_IN TOK_IDENTIFIER
+    | TOK_ASK TOK_FROM TOK_USER comparison TOK_AND TOK_STORE TOK_IN TOK_IDENTIFIER
         {
             /* long form-এ prompt expression পজিশন $4, target variable $8 */
-            $$ = ast_create_ask($4, $8, make_loc());
-            free($8);
+            $$ = ast_create_ask($4, tok_text(ctx, $8), make_loc(scanner));
             }
     ;
 
@@ -886,20 +994,17 @@ read_statement
     : TOK_READ TOK_FROM TOK_USER TOK_TO TOK_IDENTIFIER
         {
             /* read input and store into target variable */
-            $$ = ast_create_read($5, make_loc());
-            free($5);
+            $$ = ast_create_read(tok_text(ctx, $5), make_loc(scanner));
             }
     | TOK_READ TOK_IDENTIFIER TOK_FROM TOK_USER
         {
             /* read x from user -> target identifier at $2 */
-            $$ = ast_create_read($2, make_loc());
-            free($2);
+            $$ = ast_create_read(tok_text(ctx, $2), make_loc(scanner));
             }
     | TOK_READ TOK_IDENTIFIER
         {
             /* shortest form: read x */
-            $$ = ast_create_read($2, make_loc());
-            free($2);
+            $$ = ast_create_read(tok_text(ctx, $2), make_loc(scanner));
             }
     ;
 
@@ -918,33 +1023,33 @@ read_statement
 secure_zone_statement
     : TOK_BEGIN TOK_SECURE TOK_OP_COLON statement_block TOK_END TOK_SECURE
         {
-            ASTNode *body = ast_create_block($4, make_loc());
+            ASTNode *body = ast_create_block($4, make_loc(scanner));
             /* 1 => safe mode */
-            $$ = ast_create_secure_zone(body, 1, make_loc());
+            $$ = ast_create_secure_zone(body, 1, make_loc(scanner));
         }
     | TOK_BEGIN TOK_SECURE statement_block TOK_END TOK_SECURE
         {
-            ASTNode *body = ast_create_block($3, make_loc());
+            ASTNode *body = ast_create_block($3, make_loc(scanner));
             /* colon ছাড়া form-ও safe mode হিসেবে ধরা হয় */
-            $$ = ast_create_secure_zone(body, 1, make_loc());
+            $$ = ast_create_secure_zone(body, 1, make_loc(scanner));
         }
     | TOK_SAFELY TOK_DO statement_block TOK_END TOK_SAFELY
         {
-            ASTNode *body = ast_create_block($3, make_loc());
+            ASTNode *body = ast_create_block($3, make_loc(scanner));
             /* safely do ... => safe mode */
-            $$ = ast_create_secure_zone(body, 1, make_loc());
+            $$ = ast_create_secure_zone(body, 1, make_loc(scanner));
         }
     | TOK_RISKY TOK_DO statement_block TOK_END TOK_RISKY
         {
-            ASTNode *body = ast_create_block($3, make_loc());
+            ASTNode *body = ast_create_block($3, make_loc(scanner));
             /* 0 => risky mode */
-            $$ = ast_create_secure_zone(body, 0, make_loc());
+            $$ = ast_create_secure_zone(body, 0, make_loc(scanner));
         }
     | TOK_ENTER TOK_SECURE statement_block TOK_END TOK_SECURE
         {
-            ASTNode *body = ast_create_block($3, make_loc());
+            ASTNode *body = ast_create_block($3, make_loc(scanner));
             /* enter secure ... => safe mode */
-            $$ = ast_create_secure_zone(body, 1, make_loc());
+            $$ = ast_create_secure_zone(body, 1, make_loc(scanner));
         }
     ;
 
@@ -956,87 +1061,122 @@ secure_zone_statement
 /*
  * expression হলো expression parsing-এর entry point;
  * বর্তমান grammar-এ এটি logic_expr-এ delegate করে।
+ * "call f with ..." argument list-এর শেষ কোথায় তা token দেখে বোঝা যায় না,
+ * তাই natural call primary নয়: এটা শুধু শেষ (ডানদিকের) operand হতে পারে
+ * ("x plus call f with 2", নিচের *_tail rules দেখুন)। মাঝখানে লাগলে
+ * bracket: "(call f with 2) plus x"।
  */
 
 expression
     : logic_expr
+    | logic_tail
     ;
 
 /*
  * logic_expr logical AND/OR/NOT expression পার্স করে।
- * precedence hierarchy বজায় রাখতে নিচে comparison non-terminal ব্যবহৃত হয়।
+ * precedence hierarchy বজায় রাখতে নিচে comparison non-terminal ব্যবহৃত হয়।
  */
 
 logic_expr
     : logic_expr TOK_AND comparison
         /* $1 AND $3 */
-        { $$ = ast_create_binary_op(OP_AND, $1, $3, make_loc()); }    | logic_expr TOK_OR comparison
+        { $$ = ast_create_binary_op(OP_AND, $1, $3, make_loc(scanner)); }    | logic_expr TOK_OR comparison
         /* $1 OR $3 */
-        { $$ = ast_create_binary_op(OP_OR, $1, $3, make_loc()); }    | logic_expr TOK_OP_AND comparison
-        { $$ = ast_create_binary_op(OP_AND, $1, $3, make_loc()); }    | logic_expr TOK_OP_OR comparison
-        { $$ = ast_create_binary_op(OP_OR, $1, $3, make_loc()); }    | TOK_NOT comparison
+        { $$ = ast_create_binary_op(OP_OR, $1, $3, make_loc(scanner)); }    | logic_expr TOK_OP_AND comparison
+        { $$ = ast_create_binary_op(OP_AND, $1, $3, make_loc(scanner)); }    | logic_expr TOK_OP_OR comparison
+        { $$ = ast_create_binary_op(OP_OR, $1, $3, make_loc(scanner)); }    | TOK_NOT comparison
         /* NOT $2 */
-        { $$ = ast_create_unary_op(OP_NOT, $2, make_loc()); }    | TOK_OP_NOT comparison
-        { $$ = ast_create_unary_op(OP_NOT, $2, make_loc()); }    | comparison
+        { $$ = ast_create_unary_op(OP_NOT, $2, make_loc(scanner)); }    | TOK_OP_NOT comparison
+        { $$ = ast_create_unary_op(OP_NOT, $2, make_loc(scanner)); }    | comparison
     ;
 
 /*
  * comparison rule equality, relational, এবং natural-language comparison
  * variantগুলোকে একত্রে parse করে।
- * "between" এর জন্য ternary operator node তৈরি করা হয়।
+ * দুই operand-এর comparison phrase cmp_op থেকে operator enum আনে;
+ * "between" এর জন্য ternary operator node তৈরি করা হয়।
  */
 
 comparison
-    : comparison TOK_IS TOK_EQUAL TOK_TO term
-        /* phrase: <lhs> is equal to <rhs>; lhs=$1, rhs=$5 */
-        { $$ = ast_create_binary_op(OP_EQ, $1, $5, make_loc()); }    | comparison TOK_IS TOK_NOT TOK_EQUAL TOK_TO term
-        /* phrase: <lhs> is not equal to <rhs>; rhs এখানে $6 */
-        { $$ = ast_create_binary_op(OP_NEQ, $1, $6, make_loc()); }    | comparison TOK_EQUALS term
-        /* shorthand equals */
-        { $$ = ast_create_binary_op(OP_EQ, $1, $3, make_loc()); }    | comparison TOK_OP_EQEQ term
-        { $$ = ast_create_binary_op(OP_EQ, $1, $3, make_loc()); }    | comparison TOK_OP_NEQ term
-        { $$ = ast_create_binary_op(OP_NEQ, $1, $3, make_loc()); }    | comparison TOK_IS TOK_OP_GT term
-        /* symbolic greater-than with 'is' */
-        { $$ = ast_create_binary_op(OP_GT, $1, $4, make_loc()); }    | comparison TOK_IS TOK_OP_LT term
-        { $$ = ast_create_binary_op(OP_LT, $1, $4, make_loc()); }    | comparison TOK_OP_GT term
-        { $$ = ast_create_binary_op(OP_GT, $1, $3, make_loc()); }    | comparison TOK_OP_LT term
-        { $$ = ast_create_binary_op(OP_LT, $1, $3, make_loc()); }    | comparison TOK_OP_GTE term
-        { $$ = ast_create_binary_op(OP_GTE, $1, $3, make_loc()); }    | comparison TOK_OP_LTE term
-        { $$ = ast_create_binary_op(OP_LTE, $1, $3, make_loc()); }    /* Natural language comparisons */
-    | comparison TOK_IS TOK_GREATER TOK_THAN term
-        { $$ = ast_create_binary_op(OP_GT, $1, $5, make_loc()); }    | comparison TOK_IS TOK_LESS TOK_THAN term
-        { $$ = ast_create_binary_op(OP_LT, $1, $5, make_loc()); }    | comparison TOK_IS TOK_GREATER_THAN term
-        { $$ = ast_create_binary_op(OP_GT, $1, $4, make_loc()); }    | comparison TOK_IS TOK_LESS_THAN term
-        { $$ = ast_create_binary_op(OP_LT, $1, $4, make_loc()); }    | comparison TOK_GREATER_THAN term
-        { $$ = ast_create_binary_op(OP_GT, $1, $3, make_loc()); }    | comparison TOK_LESS_THAN term
-        { $$ = ast_create_binary_op(OP_LT, $1, $3, make_loc()); }    | comparison TOK_EQUAL_TO term
-        { $$ = ast_create_binary_op(OP_EQ, $1, $3, make_loc()); }    | comparison TOK_NOT_EQUAL_TO term
-        { $$ = ast_create_binary_op(OP_NEQ, $1, $3, make_loc()); }    | comparison TOK_IS TOK_EQUAL_TO term
-        { $$ = ast_create_binary_op(OP_EQ, $1, $4, make_loc()); }    | comparison TOK_IS TOK_NOT_EQUAL_TO term
-        { $$ = ast_create_binary_op(OP_NEQ, $1, $4, make_loc()); }    | comparison TOK_IS TOK_GREATER TOK_THAN TOK_OR TOK_EQUAL TOK_TO term
-        /* natural form of >= ; rhs is $8 কারণ phrase দীর্ঘ */
-        { $$ = ast_create_binary_op(OP_GTE, $1, $8, make_loc()); }    | comparison TOK_IS TOK_LESS TOK_THAN TOK_OR TOK_EQUAL TOK_TO term
-        /* natural form of <= ; rhs is $8 */
-        { $$ = ast_create_binary_op(OP_LTE, $1, $8, make_loc()); }    | comparison TOK_IS TOK_AT_LEAST term
-        { $$ = ast_create_binary_op(OP_GTE, $1, $4, make_loc()); }    | comparison TOK_IS TOK_AT_MOST term
-        { $$ = ast_create_binary_op(OP_LTE, $1, $4, make_loc()); }    | comparison TOK_AT_LEAST term
-        { $$ = ast_create_binary_op(OP_GTE, $1, $3, make_loc()); }    | comparison TOK_AT_MOST term
-        { $$ = ast_create_binary_op(OP_LTE, $1, $3, make_loc()); }    /* UNIQUE NATURELANG OPERATOR: "is between X and Y" */
+    : comparison cmp_op term
+        /* cmp_op rule থেকে $2 already OP_EQ/OP_GT/... enum দিয়ে আসে */
+        { $$ = ast_create_binary_op($2, $1, $3, make_loc(scanner)); }    /* UNIQUE NATURELANG OPERATOR: "is between X and Y" */
     | comparison TOK_IS TOK_BETWEEN term TOK_AND term
         /* between form: operand=$1, lower=$4, upper=$6 */
-        { $$ = ast_create_ternary_op(OP_BETWEEN, $1, $4, $6, make_loc()); }    | comparison TOK_BETWEEN term TOK_AND term
+        { $$ = ast_create_ternary_op(OP_BETWEEN, $1, $4, $6, make_loc(scanner)); }    | comparison TOK_BETWEEN term TOK_AND term
         /* shorthand between */
-        { $$ = ast_create_ternary_op(OP_BETWEEN, $1, $3, $5, make_loc()); }    | comparison rel_op term
-        /* rel_op rule থেকে $2 already OP_GT/OP_LT enum দিয়ে আসে */
-        { $$ = ast_create_binary_op($2, $1, $3, make_loc()); }    | term
+        { $$ = ast_create_ternary_op(OP_BETWEEN, $1, $3, $5, make_loc(scanner)); }    /* list membership: scores contains 7 */
+    | comparison TOK_CONTAINS term
+        { $$ = list_call("__list_contains", $1, $3, make_loc(scanner)); }    | term
     ;
 
 /*
- * rel_op helper non-terminal; token pair থেকে relational operator enum নেয়।
+ * cmp_op helper non-terminal; comparison phrase থেকে relational operator enum নেয়।
  */
 
-rel_op
-    : TOK_GREATER TOK_THAN
+cmp_op
+    : TOK_IS TOK_EQUAL TOK_TO
+        /* phrase: <lhs> is equal to <rhs> */
+        { $$ = OP_EQ; }
+    | TOK_IS TOK_NOT TOK_EQUAL TOK_TO
+        /* phrase: <lhs> is not equal to <rhs> */
+        { $$ = OP_NEQ; }
+    | TOK_EQUALS
+        /* shorthand equals */
+        { $$ = OP_EQ; }
+    | TOK_OP_EQEQ
+        { $$ = OP_EQ; }
+    | TOK_OP_NEQ
+        { $$ = OP_NEQ; }
+    | TOK_IS TOK_OP_GT
+        /* symbolic greater-than with 'is' */
+        { $$ = OP_GT; }
+    | TOK_IS TOK_OP_LT
+        { $$ = OP_LT; }
+    | TOK_OP_GT
+        { $$ = OP_GT; }
+    | TOK_OP_LT
+        { $$ = OP_LT; }
+    | TOK_OP_GTE
+        { $$ = OP_GTE; }
+    | TOK_OP_LTE
+        { $$ = OP_LTE; }
+    /* Natural language comparisons */
+    | TOK_IS TOK_GREATER TOK_THAN
+        { $$ = OP_GT; }
+    | TOK_IS TOK_LESS TOK_THAN
+        { $$ = OP_LT; }
+    | TOK_IS TOK_GREATER_THAN
+        { $$ = OP_GT; }
+    | TOK_IS TOK_LESS_THAN
+        { $$ = OP_LT; }
+    | TOK_GREATER_THAN
+        { $$ = OP_GT; }
+    | TOK_LESS_THAN
+        { $$ = OP_LT; }
+    | TOK_EQUAL_TO
+        { $$ = OP_EQ; }
+    | TOK_NOT_EQUAL_TO
+        { $$ = OP_NEQ; }
+    | TOK_IS TOK_EQUAL_TO
+        { $$ = OP_EQ; }
+    | TOK_IS TOK_NOT_EQUAL_TO
+        { $$ = OP_NEQ; }
+    | TOK_IS TOK_GREATER TOK_THAN TOK_OR TOK_EQUAL TOK_TO
+        /* natural form of >= ; "or" এখানে phrase-এর অংশ */
+        { $$ = OP_GTE; }
+    | TOK_IS TOK_LESS TOK_THAN TOK_OR TOK_EQUAL TOK_TO
+        /* natural form of <= */
+        { $$ = OP_LTE; }
+    | TOK_IS TOK_AT_LEAST
+        { $$ = OP_GTE; }
+    | TOK_IS TOK_AT_MOST
+        { $$ = OP_LTE; }
+    | TOK_AT_LEAST
+        { $$ = OP_GTE; }
+    | TOK_AT_MOST
+        { $$ = OP_LTE; }
+    | TOK_GREATER TOK_THAN
         /* greater than phrase => operator enum OP_GT */
         { $$ = OP_GT; }
     | TOK_LESS TOK_THAN
@@ -1052,9 +1192,9 @@ rel_op
 term
     : term add_op factor
         /* operator $2 (OP_ADD/OP_SUB) দিয়ে binary node */
-        { $$ = ast_create_binary_op($2, $1, $3, make_loc()); }    | term TOK_OP_PLUS factor
-        { $$ = ast_create_binary_op(OP_ADD, $1, $3, make_loc()); }    | term TOK_OP_MINUS factor
-        { $$ = ast_create_binary_op(OP_SUB, $1, $3, make_loc()); }    | factor
+        { $$ = ast_create_binary_op($2, $1, $3, make_loc(scanner)); }    | term TOK_OP_PLUS factor
+        { $$ = ast_create_binary_op(OP_ADD, $1, $3, make_loc(scanner)); }    | term TOK_OP_MINUS factor
+        { $$ = ast_create_binary_op(OP_SUB, $1, $3, make_loc(scanner)); }    | factor
     ;
 
 /*
@@ -1078,19 +1218,19 @@ add_op
 factor
     : factor mul_op primary
         /* operator $2 (OP_MUL/OP_DIV/OP_MOD) দিয়ে binary node */
-        { $$ = ast_create_binary_op($2, $1, $3, make_loc()); }    | factor TOK_MULTIPLIED TOK_BY primary
-        { $$ = ast_create_binary_op(OP_MUL, $1, $4, make_loc()); }    | factor TOK_DIVIDED TOK_BY primary
-        { $$ = ast_create_binary_op(OP_DIV, $1, $4, make_loc()); }    | factor TOK_OP_STAR primary
-        { $$ = ast_create_binary_op(OP_MUL, $1, $3, make_loc()); }    | factor TOK_OP_SLASH primary
-        { $$ = ast_create_binary_op(OP_DIV, $1, $3, make_loc()); }    | factor TOK_OP_PERCENT primary
-        { $$ = ast_create_binary_op(OP_MOD, $1, $3, make_loc()); }    | factor TOK_POWER TOK_OF primary
-        { $$ = ast_create_binary_op(OP_POW, $1, $4, make_loc()); }    | factor TOK_POWER primary
-        { $$ = ast_create_binary_op(OP_POW, $1, $3, make_loc()); }    | factor TOK_OP_CARET primary
-        { $$ = ast_create_binary_op(OP_POW, $1, $3, make_loc()); }    | factor TOK_SQUARED
+        { $$ = ast_create_binary_op($2, $1, $3, make_loc(scanner)); }    | factor TOK_MULTIPLIED TOK_BY primary
+        { $$ = ast_create_binary_op(OP_MUL, $1, $4, make_loc(scanner)); }    | factor TOK_DIVIDED TOK_BY primary
+        { $$ = ast_create_binary_op(OP_DIV, $1, $4, make_loc(scanner)); }    | factor TOK_OP_STAR primary
+        { $$ = ast_create_binary_op(OP_MUL, $1, $3, make_loc(scanner)); }    | factor TOK_OP_SLASH primary
+        { $$ = ast_create_binary_op(OP_DIV, $1, $3, make_loc(scanner)); }    | factor TOK_OP_PERCENT primary
+        { $$ = ast_create_binary_op(OP_MOD, $1, $3, make_loc(scanner)); }    | factor TOK_POWER TOK_OF primary
+        { $$ = ast_create_binary_op(OP_POW, $1, $4, make_loc(scanner)); }    | factor TOK_POWER primary
+        { $$ = ast_create_binary_op(OP_POW, $1, $3, make_loc(scanner)); }    | factor TOK_OP_CARET primary
+        { $$ = ast_create_binary_op(OP_POW, $1, $3, make_loc(scanner)); }    | factor TOK_SQUARED
         { 
             /* squared => power 2 */
-            ASTNode *two = ast_create_literal_int(2, make_loc());
-            $$ = ast_create_binary_op(OP_POW, $1, two, make_loc());
+            ASTNode *two = ast_create_literal_int(2, make_loc(scanner));
+            $$ = ast_create_binary_op(OP_POW, $1, two, make_loc(scanner));
             }
     | primary
     ;
@@ -1114,6 +1254,57 @@ mul_op
         { $$ = OP_MOD; }
     ;
 
+/*
+ * Natural call শেষ operand হিসেবে: "x plus call f with 2"।
+ * call-এর argument list greedy, তাই call-এর পরে আর কোনো operator বসে না।
+ * প্রতিটি precedence স্তরের *_tail মানে "সেই স্তরের expression যার
+ * ডানদিকের শেষ operand একটা natural call"; এগুলো কেবল expression বা
+ * argument-এর শেষে বসে, তাই grammar-এ নতুন conflict আসে না।
+ */
+
+mul_tail
+    : call_with_args
+    | factor mul_op call_with_args
+        { $$ = ast_create_binary_op($2, $1, $3, make_loc(scanner)); }    | factor TOK_MULTIPLIED TOK_BY call_with_args
+        { $$ = ast_create_binary_op(OP_MUL, $1, $4, make_loc(scanner)); }    | factor TOK_DIVIDED TOK_BY call_with_args
+        { $$ = ast_create_binary_op(OP_DIV, $1, $4, make_loc(scanner)); }    | factor TOK_OP_STAR call_with_args
+        { $$ = ast_create_binary_op(OP_MUL, $1, $3, make_loc(scanner)); }    | factor TOK_OP_SLASH call_with_args
+        { $$ = ast_create_binary_op(OP_DIV, $1, $3, make_loc(scanner)); }    | factor TOK_OP_PERCENT call_with_args
+        { $$ = ast_create_binary_op(OP_MOD, $1, $3, make_loc(scanner)); }    | factor TOK_POWER TOK_OF call_with_args
+        { $$ = ast_create_binary_op(OP_POW, $1, $4, make_loc(scanner)); }    | factor TOK_POWER call_with_args
+        { $$ = ast_create_binary_op(OP_POW, $1, $3, make_loc(scanner)); }    | factor TOK_OP_CARET call_with_args
+        { $$ = ast_create_binary_op(OP_POW, $1, $3, make_loc(scanner)); }
+    ;
+
+add_tail
+    : mul_tail
+    | term add_op mul_tail
+        /* "x plus y times call f with 2": $3-এর ভেতরে গুণ আগে */
+        { $$ = ast_create_binary_op($2, $1, $3, make_loc(scanner)); }    | term TOK_OP_PLUS mul_tail
+        { $$ = ast_create_binary_op(OP_ADD, $1, $3, make_loc(scanner)); }    | term TOK_OP_MINUS mul_tail
+        { $$ = ast_create_binary_op(OP_SUB, $1, $3, make_loc(scanner)); }
+    ;
+
+comparison_tail
+    : add_tail
+    | comparison cmp_op add_tail
+        { $$ = ast_create_binary_op($2, $1, $3, make_loc(scanner)); }    | comparison TOK_IS TOK_BETWEEN term TOK_AND add_tail
+        { $$ = ast_create_ternary_op(OP_BETWEEN, $1, $4, $6, make_loc(scanner)); }    | comparison TOK_BETWEEN term TOK_AND add_tail
+        { $$ = ast_create_ternary_op(OP_BETWEEN, $1, $3, $5, make_loc(scanner)); }    | comparison TOK_CONTAINS add_tail
+        { $$ = list_call("__list_contains", $1, $3, make_loc(scanner)); }
+    ;
+
+logic_tail
+    : comparison_tail
+    | logic_expr TOK_AND comparison_tail
+        { $$ = ast_create_binary_op(OP_AND, $1, $3, make_loc(scanner)); }    | logic_expr TOK_OR comparison_tail
+        { $$ = ast_create_binary_op(OP_OR, $1, $3, make_loc(scanner)); }    | logic_expr TOK_OP_AND comparison_tail
+        { $$ = ast_create_binary_op(OP_AND, $1, $3, make_loc(scanner)); }    | logic_expr TOK_OP_OR comparison_tail
+        { $$ = ast_create_binary_op(OP_OR, $1, $3, make_loc(scanner)); }    | TOK_NOT comparison_tail
+        { $$ = ast_create_unary_op(OP_NOT, $2, make_loc(scanner)); }    | TOK_OP_NOT comparison_tail
+        { $$ = ast_create_unary_op(OP_NOT, $2, make_loc(scanner)); }
+    ;
+
 /*
  * primary expression-এর সবচেয়ে atomic unitগুলো handle করে:
  * literals, identifiers, function call, list literal, index access,
@@ -1124,101 +1315,92 @@ primary
     /* Example: 42 */
     : TOK_INTEGER
         /* literal integer token value = $1 */
-        { $$ = ast_create_literal_int($1, make_loc()); }
+        { $$ = ast_create_literal_int($1, make_loc(scanner)); }
     /* Example: 3.14 */
     | TOK_FLOAT
         /* literal float token value = $1 */
-        { $$ = ast_create_literal_float($1, make_loc()); }
+        { $$ = ast_create_literal_float($1, make_loc(scanner)); }
     /* Example: "hello" */
     | TOK_STRING
         {
-            /* string literal copy করে AST node, তারপর lexer buffer মুক্ত */
-            $$ = ast_create_literal_string($1, make_loc());
-            free($1);
+            /* string literal slice (lexer in-place decode করেছে) AST node-এ কপি */
+            $$ = ast_create_literal_string(tok_text(ctx, $1), make_loc(scanner));
         }
     /* Example: true */
     | TOK_TRUE
         /* boolean literal true */
-        { $$ = ast_create_literal_bool(1, make_loc()); }
+        { $$ = ast_create_literal_bool(1, make_loc(scanner)); }
     /* Example: false */
     | TOK_FALSE
         /* boolean literal false */
-        { $$ = ast_create_literal_bool(0, make_loc()); }
+        { $$ = ast_create_literal_bool(0, make_loc(scanner)); }
     /* Example: yes */
     | TOK_YES
         /* yes synonym mapped to true */
-        { $$ = ast_create_literal_bool(1, make_loc()); }
+        { $$ = ast_create_literal_bool(1, make_loc(scanner)); }
     /* Example: no */
     | TOK_NO
         /* no synonym mapped to false */
-        { $$ = ast_create_literal_bool(0, make_loc()); }
+        { $$ = ast_create_literal_bool(0, make_loc(scanner)); }
     /* Example: total */
     | TOK_IDENTIFIER
         {
             /* identifier reference node */
-            $$ = ast_create_identifier($1, make_loc());
-            free($1);
+            $$ = ast_create_identifier(tok_text(ctx, $1), make_loc(scanner));
         }
     /* Example: the value of total */
-    | TOK_THE TOK_VALUE TOK_OF TOK_IDENTIFIER
-        {
-            /* verbose identifier form: the value of x => identifier(x) */
-            $$ = ast_create_identifier($4, make_loc());
-            free($4);
-        }
-    /* Example: call add with 5 and 10 */
+    | TOK_THE TOK_VALUE TOK_OF primary
+        /* verbose form: the value of x => x (display/return-এর long form-ও এটাই) */
+        { $$ = $4; }
+    /* Example: call add (no arguments), add(5, 10) */
     | function_call
     /* Example: [1, 2, 3] */
     | list_literal
     /* Example: arr[2] */
     | TOK_IDENTIFIER TOK_LBRACKET expression TOK_RBRACKET
         {
-            ASTNode *arr = ast_create_identifier($1, make_loc());
+            ASTNode *arr = ast_create_identifier(tok_text(ctx, $1), make_loc(scanner));
             /* arr[index] access */
-            $$ = ast_create_index(arr, $3, make_loc());
-            free($1);
+            $$ = ast_create_index(arr, $3, make_loc(scanner));
         }
     /* Example: arr at 2 */
-    | TOK_IDENTIFIER TOK_AT expression
+    | TOK_IDENTIFIER TOK_AT primary
         {
-            ASTNode *arr = ast_create_identifier($1, make_loc());
-            /* alternate indexing form: arr at idx */
-            $$ = ast_create_index(arr, $3, make_loc());
-            free($1);
+            ASTNode *arr = ast_create_identifier(tok_text(ctx, $1), make_loc(scanner));
+            /*
+             * alternate indexing form: arr at idx
+             * index একটি primary: "arr at i plus 1" = (arr at i) + 1;
+             * expression index চাইলে "arr at (i plus 1)" লিখতে হয়।
+             */
+            $$ = ast_create_index(arr, $3, make_loc(scanner));
         }
     /* Example: item 2 of arr */
     | TOK_ITEM expression TOK_OF TOK_IDENTIFIER
         {
-            ASTNode *arr = ast_create_identifier($4, make_loc());
+            ASTNode *arr = ast_create_identifier(tok_text(ctx, $4), make_loc(scanner));
             /* item <idx> of <arr> */
-            $$ = ast_create_index(arr, $2, make_loc());
-            free($4);
+            $$ = ast_create_index(arr, $2, make_loc(scanner));
         }
     /* Example: get item 2 from arr */
     | TOK_GET TOK_ITEM expression TOK_FROM TOK_IDENTIFIER
         {
-            ASTNode *arr = ast_create_identifier($5, make_loc());
+            ASTNode *arr = ast_create_identifier(tok_text(ctx, $5), make_loc(scanner));
             /* get item <idx> from <arr> */
-            $$ = ast_create_index(arr, $3, make_loc());
-            free($5);
+            $$ = ast_create_index(arr, $3, make_loc(scanner));
         }
     /* Example: length of names */
     | TOK_LENGTH TOK_OF TOK_IDENTIFIER
         {
-            /* length of x => builtin function call: length(x) */
-            ASTNodeList *args = ast_node_list_create();
-            ast_node_list_append(args, ast_create_identifier($3, make_loc()));
-            $$ = ast_create_func_call("length", args, make_loc());
-            free($3);
+            /* length of x => list builtin call: __list_length(x) */
+            ASTNode *list = ast_create_identifier(tok_text(ctx, $3), make_loc(scanner));
+            $$ = list_call("__list_length", list, NULL, make_loc(scanner));
         }
     /* Example: size of names */
     | TOK_SIZE TOK_OF TOK_IDENTIFIER
         {
-            /* size of x => same semantic as length(x) */
-            ASTNodeList *args = ast_node_list_create();
-            ast_node_list_append(args, ast_create_identifier($3, make_loc()));
-            $$ = ast_create_func_call("length", args, make_loc());
-            free($3);
+            /* size of x => same semantic as length of x */
+            ASTNode *list = ast_create_identifier(tok_text(ctx, $3), make_loc(scanner));
+            $$ = list_call("__list_length", list, NULL, make_loc(scanner));
         }
     /* Example: square root of 49 */
     | TOK_SQUARE TOK_ROOT TOK_OF primary
@@ -1226,7 +1408,7 @@ primary
             /* square root of expr => sqrt(expr) builtin call */
             ASTNodeList *args = ast_node_list_create();
             ast_node_list_append(args, $4);
-            $$ = ast_create_func_call("sqrt", args, make_loc());
+            $$ = ast_create_func_call("sqrt", args, make_loc(scanner));
         }
     /* Example: root 49 */
     | TOK_ROOT primary
@@ -1234,8 +1416,14 @@ primary
             /* root expr => sqrt(expr) shorthand */
             ASTNodeList *args = ast_node_list_create();
             ast_node_list_append(args, $2);
-            $$ = ast_create_func_call("sqrt", args, make_loc());
+            $$ = ast_create_func_call("sqrt", args, make_loc(scanner));
         }
+    /* Example: the sum of scores, the largest in scores */
+    | list_aggregate
+    /* Example: a random number between 1 and 6 */
+    | random_number
+    /* Example: a random decimal */
+    | random_decimal
     /* Example: (a + b) */
     | TOK_LPAREN expression TOK_RPAREN
         /* parentheses শুধু grouping; inner expression-ই result */
@@ -1243,11 +1431,59 @@ primary
     /* Example: -x (symbolic minus token) */
     | TOK_OP_MINUS primary
         /* unary negative */
-        { $$ = ast_create_unary_op(OP_NEG, $2, make_loc()); }
+        { $$ = ast_create_unary_op(OP_NEG, $2, make_loc(scanner)); }
     /* Example: minus x (word-form minus token) */
     | TOK_MINUS primary
         /* unary negative with word form */
-        { $$ = ast_create_unary_op(OP_NEG, $2, make_loc()); }
+        { $$ = ast_create_unary_op(OP_NEG, $2, make_loc(scanner)); }
+    ;
+
+/*
+ * random_number / random_decimal runtime builtin call-এ নামে:
+ * __random(low, high) এবং __random_decimal()। সামনের "a" ঐচ্ছিক।
+ * সীমা দুটি primary (term হলে পরের operator কার তা ambiguous হতো);
+ * expression লাগলে বন্ধনী: a random number between 1 and (n plus 1)।
+ */
+random_number
+    : TOK_RANDOM_NUMBER TOK_BETWEEN primary TOK_AND primary
+        {
+            ASTNodeList *args = ast_node_list_create();
+            ast_node_list_append(args, $3);
+            ast_node_list_append(args, $5);
+            $$ = ast_create_func_call("__random", args, make_loc(scanner));
+        }
+    | TOK_A TOK_RANDOM_NUMBER TOK_BETWEEN primary TOK_AND primary
+        {
+            ASTNodeList *args = ast_node_list_create();
+            ast_node_list_append(args, $4);
+            ast_node_list_append(args, $6);
+            $$ = ast_create_func_call("__random", args, make_loc(scanner));
+        }
+    ;
+
+random_decimal
+    : TOK_RANDOM_DECIMAL
+        { $$ = ast_create_func_call("__random_decimal", ast_node_list_create(), make_loc(scanner)); }
+    | TOK_A TOK_RANDOM_DECIMAL
+        { $$ = ast_create_func_call("__random_decimal", ast_node_list_create(), make_loc(scanner)); }
+    ;
+
+/*
+ * list_aggregate list builtin call-এ নামে (runtime-এ SIMD kernel):
+ * sum/largest/smallest একটি list নেয়, count/position একটি value ও list।
+ * value একটি term: "the count of n plus 1 in rolls" = (n + 1)-এর count।
+ */
+list_aggregate
+    : TOK_SUM_OF primary
+        { $$ = list_call("__list_sum", $2, NULL, make_loc(scanner)); }
+    | TOK_LARGEST primary
+        { $$ = list_call("__list_largest", $2, NULL, make_loc(scanner)); }
+    | TOK_SMALLEST primary
+        { $$ = list_call("__list_smallest", $2, NULL, make_loc(scanner)); }
+    | TOK_COUNT_OF term TOK_IN primary
+        { $$ = list_call("__list_count", $4, $2, make_loc(scanner)); }
+    | TOK_POSITION_OF term TOK_IN primary
+        { $$ = list_call("__list_position", $4, $2, make_loc(scanner)); }
     ;
 
 /* call add with 5 and 10 */
@@ -1257,29 +1493,33 @@ primary
  * conventional form (name(args)) উভয় syntax সমর্থন করে।
  */
 function_call
-    : TOK_CALL TOK_IDENTIFIER TOK_WITH arg_list
-        {
-            /* call name with arg_list */
-            $$ = ast_create_func_call($2, $4, make_loc());
-            free($2);
-            }
-    | TOK_CALL TOK_IDENTIFIER
+    : TOK_CALL TOK_IDENTIFIER
         {
             /* no-arg call: call fname */
-            $$ = ast_create_func_call($2, ast_node_list_create(), make_loc());
-            free($2);
+            $$ = ast_create_func_call(tok_text(ctx, $2), ast_node_list_create(), make_loc(scanner));
             }
     | TOK_IDENTIFIER TOK_LPAREN arg_list TOK_RPAREN
         {
             /* conventional C-like call: fname(args) */
-            $$ = ast_create_func_call($1, $3, make_loc());
-            free($1);
+            $$ = ast_create_func_call(tok_text(ctx, $1), $3, make_loc(scanner));
             }
     | TOK_IDENTIFIER TOK_LPAREN TOK_RPAREN
         {
             /* conventional no-arg call: fname() */
-            $$ = ast_create_func_call($1, ast_node_list_create(), make_loc());
-            free($1);
+            $$ = ast_create_func_call(tok_text(ctx, $1), ast_node_list_create(), make_loc(scanner));
+            }
+    ;
+
+/*
+ * call_with_args: natural form "call name with arg_list"।
+ * argument list greedy: পরের 'and'/comma সবসময় এই call-এর argument
+ * হিসেবে নেওয়া হয় (rule precedence TOK_WITH সবচেয়ে নিচে, তাই shift)।
+ */
+call_with_args
+    : TOK_CALL TOK_IDENTIFIER TOK_WITH arg_list
+        {
+            /* call name with arg_list */
+            $$ = ast_create_func_call(tok_text(ctx, $2), $4, make_loc(scanner));
             }
     ;
 
@@ -1289,19 +1529,19 @@ function_call
  */
 
 arg_list
-    : expression
+    : argument
         {
             /* প্রথম argument এ নতুন list তৈরি */
             $$ = ast_node_list_create();
             ast_node_list_append($$, $1);
             }
-    | arg_list TOK_AND expression
+    | arg_list TOK_AND argument
         {
             /* বিদ্যমান list ($1)-এ নতুন arg ($3) যোগ */
             ast_node_list_append($1, $3);
             $$ = $1;
             }
-    | arg_list TOK_COMMA expression
+    | arg_list TOK_COMMA argument
         {
             /* comma-separated argument যোগ */
             ast_node_list_append($1, $3);
@@ -1309,6 +1549,16 @@ arg_list
             }
     ;
 
+/*
+ * argument: 'and' এখানে separator, তাই argument comparison স্তরের
+ * expression (logical and/or/not লাগলে bracket: "call f with (p and q)")।
+ * nested natural call-ও argument বা তার শেষ operand হতে পারে।
+ */
+argument
+    : comparison
+    | comparison_tail
+    ;
+
 /* [1, 2, 3, 4, 5] */
 /*
  * list_literal bracket notation থেকে list node তৈরি করে;
@@ -1317,9 +1567,9 @@ arg_list
 list_literal
     : TOK_LBRACKET expr_list TOK_RBRACKET
         /* populated list literal */
-        { $$ = ast_create_list($2, make_loc()); }    | TOK_LBRACKET TOK_RBRACKET
+        { $$ = ast_create_list($2, make_loc(scanner)); }    | TOK_LBRACKET TOK_RBRACKET
         /* empty list literal [] */
-        { $$ = ast_create_list(ast_node_list_create(), make_loc()); }
+        { $$ = ast_create_list(ast_node_list_create(), make_loc(scanner)); }
     ;
 
 /*
@@ -1344,35 +1594,22 @@ expr_list
 
 %%
 
-/* ============================================================================
- * GLR MERGE FUNCTION
- * When ambiguous parses produce the same non-terminal, pick one
- * ============================================================================
- */
-
-static YYSTYPE merge_nodes(YYSTYPE x0, YYSTYPE x1) {
-    /*
-     * GLR parser ambiguity হলে একাধিক parse result আসতে পারে।
-     * এই merge function policy হিসেবে প্রথম result (x0) বেছে নেয়।
-     */
-    (void)x1; /* suppress unused warning */
-    return x0;
-}
-
 /* ============================================================================
  * ERROR HANDLING
  * ============================================================================
  */
 
-void yyerror(const char *s) {
+static void yyerror(YYLTYPE *llocp, yyscan_t scanner, ParseContext *ctx, const char *s) {
+    (void)llocp;
     /*
      * verbose error output:
-     * - yylineno: কোন লাইনে parse সমস্যা
+     * - yyget_lineno: কোন লাইনে parse সমস্যা
      * - s: bison generated error message
-     * - yytext: যে token-এর কাছে parser আটকে গেছে
+     * - yyget_text: যে token-এর কাছে parser আটকে গেছে
      */
+    ctx->error_count++;
     fprintf(stderr, "Parse error at line %d: %s (near '%s')\n", 
-            yylineno, s, yytext);
+            yyget_lineno(scanner), s, yyget_text(scanner));
 }
 
 /* ============================================================================
@@ -1380,46 +1617,199 @@ void yyerror(const char *s) {
  * ============================================================================
  */
 
-ASTNode *naturelang_parse(FILE *input) {
-    /* parser শুরু করার আগে lexer input stream সেট */
-    yyin = input;
+/*
+ * last_parse_result: get_parse_result()-এর জন্য, thread-local তাই
+ * আলাদা thread-এর parse একে অপরকে overwrite করে না।
+ */
+static _Thread_local ASTNode *last_parse_result = NULL;
+
+void parse_context_init(ParseContext *ctx, const char *filename) {
+    ctx->filename = filename;
+    ctx->result = NULL;
+    ctx->error_count = 0;
+    ctx->scratch = NULL;
+    ctx->scratch_cap = 0;
+    ctx->arena = NULL;
+    ctx->on_statement = NULL;
+    ctx->on_statement_data = NULL;
+}
+
+void parse_context_free(ParseContext *ctx) {
+    /* শুধু parser-internal memory; result AST caller-এর */
+    free(ctx->scratch);
+    ctx->scratch = NULL;
+    ctx->scratch_cap = 0;
+    ast_arena_destroy(ctx->arena);
+    ctx->arena = NULL;
+}
+
+/*
+ * naturelang_parse_ctx(): সব public entry point-এর common path।
+ * buffer-টি lexer সরাসরি in-place scan করে (yy_scan_buffer);
+ * parse শেষ না হওয়া পর্যন্ত buffer জীবিত থাকতে হবে কারণ token slice
+ * গুলো এর ভেতরেই point করে। প্রতিটি call নিজের scanner বানায়, তাই
+ * আলাদা ctx নিয়ে একাধিক thread একসাথে parse করতে পারে।
+ */
+ASTNode *naturelang_parse_ctx(ParseContext *ctx, char *buffer, size_t size) {
+    yyscan_t scanner;
+
     /* previous parse result clear করা জরুরি */
-    parse_result = NULL;
-    
-    /* yyparse non-zero হলে parse failure */
-    if (yyparse() != 0) {
+    ctx->result = NULL;
+    if (lexer_scan_buffer(&scanner, buffer, size, ctx->filename) != 0) {
+        fprintf(stderr, "Error: cannot scan source buffer (missing NUL padding?)\n");
+        return NULL;
+    }
+
+    /*
+     * এই parse-এর সব node, list, name ctx-এর arena থেকে আসে:
+     * parse চলাকালীন arena-টা এই thread-এর current arena।
+     */
+    ast_arena_destroy(ctx->arena);
+    ctx->arena = ast_arena_create();
+    ASTArena *previous = ast_arena_set_current(ctx->arena);
+
+    /*
+     * yyparse non-zero হলে parse failure; semantic action-ও yyerror দিয়ে
+     * error জানাতে পারে (parse চলতে থাকে), তাই error_count-ও দেখা হয়
+     */
+    int rc = yyparse(scanner, ctx);
+    lexer_scan_end(scanner);
+    ast_arena_set_current(previous);
+
+    if (rc != 0 || ctx->error_count > 0) {
+        /* failed parse-এর আধা-তৈরি AST arena-সহ একবারে বাদ */
+        ctx->result = NULL;
+        ast_arena_destroy(ctx->arena);
+        ctx->arena = NULL;
         return NULL;
     }
-    
-    /* success হলে program rule থেকে তৈরি root node ফেরত */
-    return parse_result;
+    /*
+     * success: arena-র মালিক এখন root program node; caller-এর
+     * ast_free(result) একবারে পুরো tree (arena) release করে
+     */
+    ctx->result->data.program.arena = ctx->arena;
+    ctx->arena = NULL;
+    return ctx->result;
+}
+
+/* default ctx দিয়ে parse; identifier scratch এখানেই release হয় */
+static ASTNode *parse_source_buffer(char *data, size_t length, const char *filename) {
+    ParseContext ctx;
+    parse_context_init(&ctx, filename);
+    ASTNode *result = naturelang_parse_ctx(&ctx, data, length + SOURCE_BUFFER_PADDING);
+    parse_context_free(&ctx);
+    last_parse_result = result;
+    return result;
+}
+
+ASTNode *naturelang_parse(FILE *input) {
+    /* stream (stdin/pipe সহ) একবারে memory-তে পড়ে buffer path-এ পাঠাই */
+    SourceBuffer sb;
+    if (source_buffer_from_stream(&sb, input) != 0) {
+        fprintf(stderr, "Error: Could not read input\n");
+        return NULL;
+    }
+    ASTNode *result = parse_source_buffer(sb.data, sb.length, "<stdin>");
+    source_buffer_close(&sb);
+    return result;
+}
+
+ASTNode *naturelang_parse_file(const char *filename) {
+    /* regular file হলে mmap (copy নেই), নাহলে একবার read */
+    SourceBuffer sb;
+    if (source_buffer_open(&sb, filename) != 0) {
+        fprintf(stderr, "Error: Cannot open file '%s'\n", filename);
+        return NULL;
+    }
+    ASTNode *result = parse_source_buffer(sb.data, sb.length, filename);
+    source_buffer_close(&sb);
+    return result;
+}
+
+int naturelang_parse_file_stream(const char *filename, ParseStatementFn on_statement,
+                                 void *data) {
+    SourceBuffer sb;
+    if (source_buffer_open(&sb, filename) != 0) {
+        fprintf(stderr, "Error: Cannot open file '%s'\n", filename);
+        return -1;
+    }
+    ParseContext ctx;
+    parse_context_init(&ctx, filename);
+    ctx.on_statement = on_statement;
+    ctx.on_statement_data = data;
+    /* statement গুলো callback-এ চলে গেছে; result শুধু খালি program node */
+    ASTNode *result = naturelang_parse_ctx(&ctx, sb.data, sb.length + SOURCE_BUFFER_PADDING);
+    parse_context_free(&ctx);
+    source_buffer_close(&sb);
+    ast_free(result);
+    return result != NULL ? 0 : -1;
+}
+
+ASTNode *naturelang_parse_buffer(char *buffer, size_t size) {
+    /* caller buffer সরাসরি scan হয়; size-এ trailing দুই NUL ধরা আছে */
+    if (buffer == NULL || size < SOURCE_BUFFER_PADDING) {
+        return NULL;
+    }
+    return parse_source_buffer(buffer, size - SOURCE_BUFFER_PADDING, "<buffer>");
 }
 
 ASTNode *naturelang_parse_string(const char *source) {
     /*
-     * string input parse করতে lexer-এর FILE* interface reuse করা হয়েছে:
-     * source string -> temporary file -> rewind -> existing FILE parser path
+     * const string in-place scan করা যায় না (lexer buffer-এ লেখে),
+     * তাই একবার padded heap buffer-এ কপি করি। কোনো file/tmpfile লাগে না।
      */
-    FILE *tmp = tmpfile();
-    if (tmp == NULL) {
-        fprintf(stderr, "Error: Could not create temporary file\n");
+    SourceBuffer sb;
+    if (source_buffer_from_string(&sb, source, strlen(source)) != 0) {
+        fprintf(stderr, "Fatal: Memory allocation failed\n");
         return NULL;
     }
-    
-    /* source text temp file-এ লেখা */
-    fputs(source, tmp);
-    /* parse শুরু করার আগে file pointer শুরুতে নেওয়া */
-    rewind(tmp);
-    
-    /* existing file-based parser reuse */
-    ASTNode *result = naturelang_parse(tmp);
-    
-    /* temp handle cleanup */
-    fclose(tmp);
+    ASTNode *result = parse_source_buffer(sb.data, sb.length, "<string>");
+    source_buffer_close(&sb);
     return result;
 }
 
 ASTNode *get_parse_result(void) {
-    /* external caller চাইলে latest parse root state পড়তে পারে */
-    return parse_result;
+    /* external caller চাইলে এই thread-এর latest parse root পড়তে পারে */
+    return last_parse_result;
+}
+
+#ifdef NATURELANG_PARSE_STATS
+/* ============================================================================
+ * GLR STATISTICS (bench_frontend only)
+ * ============================================================================
+ */
+
+/*
+ * counting চলাকালীন yydebug = 1 থাকে, তাই Bison প্রতিটি trace message
+ * YYFPRINTF (= parse_stats_trace) দিয়ে পাঠায়; format string দেখে
+ * split/merge ইত্যাদি গোনা হয়, কিছুই print হয় না।
+ * yydebug global, তাই এটা single-threaded benchmark-এর জন্যই।
+ */
+static ParseGLRStats glr_stats;
+
+int parse_stats_trace(FILE *stream, const char *format, ...) {
+    (void)stream;
+    if (strncmp(format, "Splitting off stack", 19) == 0) {
+        glr_stats.splits++;
+    } else if (strncmp(format, "Merging stack", 13) == 0) {
+        glr_stats.merges++;
+    } else if (strstr(format, "dies.") != NULL) {
+        glr_stats.dead_stacks++;
+    } else if (strstr(format, "action deferred") != NULL) {
+        glr_stats.deferred_actions++;
+    } else if (strncmp(format, "Returning to deterministic operation", 36) == 0) {
+        glr_stats.resolutions++;
+    }
+    return 0;
+}
+
+void parse_glr_stats_begin(void) {
+    memset(&glr_stats, 0, sizeof(glr_stats));
+    yydebug = 1;
+}
+
+ParseGLRStats parse_glr_stats_end(void) {
+    yydebug = 0;
+    return glr_stats;
 }
+#endif
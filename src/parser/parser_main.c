@@ -14,13 +14,13 @@
 #include <getopt.h>
 #include "parser.h"
 #include "ast.h"
+#include "ast_compact.h"
+#include "semantic.h"
+#include "codegen.h"
 #include "ir.h"
 #include "optimizer.h"
 #include "ir_codegen.h"
 
-/* External from Bison */
-extern FILE *yyin;
-
 /* ============================================================================
  * USAGE
  * ============================================================================
@@ -36,6 +36,11 @@ static void print_usage(const char *prog) {
     printf("  -O, --optimize N Optimize IR (0=none, 1=basic, 2=full)\n");
     printf("  -c, --codegen    Generate C code from IR\n");
     printf("  -q, --quiet      Suppress output (just check for errors)\n");
+    printf("  -k, --compact    Round-trip the AST through the compact encoding\n");
+    printf("  -s, --semantic   Run semantic analysis (implied by -r, -O, -c and -a)\n");
+    printf("  -a, --ast-codegen Generate C directly from the AST (codegen.c)\n");
+    printf("  -j, --jobs N     Threads for semantic analysis (default: one per CPU)\n");
+    printf("      --perf-lint  Warn about loops with quadratic cost (implies -s)\n");
     printf("\nIf no file is specified, reads from stdin.\n");
     printf("\nExamples:\n");
     printf("  %s program.nl              Parse a file\n", prog);
@@ -55,6 +60,11 @@ int main(int argc, char *argv[]) {
     int do_codegen = 0;
     int opt_level = -1;  /* -1 means not requested */
     int quiet = 0;
+    int compact = 0;
+    int do_semantic = 0;
+    int do_ast_codegen = 0;
+    int jobs = 0;
+    int perf_lint = 0;
     const char *filename = NULL;
     
     /* Parse command line options */
@@ -66,11 +76,16 @@ int main(int argc, char *argv[]) {
         {"optimize", required_argument, 0, 'O'},
         {"codegen",  no_argument,       0, 'c'},
         {"quiet",    no_argument,       0, 'q'},
+        {"compact",  no_argument,       0, 'k'},
+        {"semantic", no_argument,       0, 's'},
+        {"ast-codegen", no_argument,    0, 'a'},
+        {"jobs",     required_argument, 0, 'j'},
+        {"perf-lint", no_argument,      0, 'P'},
         {0, 0, 0, 0}
     };
     
     int opt;
-    while ((opt = getopt_long(argc, argv, "hvtrO:cq", long_options, NULL)) != -1) {
+    while ((opt = getopt_long(argc, argv, "hvtrO:cqksaj:", long_options, NULL)) != -1) {
         switch (opt) {
             case 'h':
                 print_usage(argv[0]);
@@ -83,6 +98,7 @@ int main(int argc, char *argv[]) {
                 break;
             case 'r':
                 print_ir = 1;
+                do_semantic = 1;  /* IR is generated from the typed AST */
                 break;
             case 'O':
                 opt_level = atoi(optarg);
@@ -91,13 +107,36 @@ int main(int argc, char *argv[]) {
                     return 1;
                 }
                 print_ir = 1;  /* Implicitly show IR when optimizing */
+                do_semantic = 1;
                 break;
             case 'c':
                 do_codegen = 1;
+                do_semantic = 1;
                 break;
             case 'q':
                 quiet = 1;
                 break;
+            case 'k':
+                compact = 1;
+                break;
+            case 's':
+                do_semantic = 1;
+                break;
+            case 'a':
+                do_ast_codegen = 1;
+                do_semantic = 1;  /* The AST backend needs the symbol table */
+                break;
+            case 'j':
+                jobs = atoi(optarg);
+                if (jobs < 1) {
+                    fprintf(stderr, "Invalid job count: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'P':
+                perf_lint = 1;
+                do_semantic = 1;
+                break;
             default:
                 print_usage(argv[0]);
                 return 1;
@@ -105,14 +144,8 @@ int main(int argc, char *argv[]) {
     }
     
     /* Get input file */
-    FILE *input = stdin;
     if (optind < argc) {
         filename = argv[optind];
-        input = fopen(filename, "r");
-        if (input == NULL) {
-            fprintf(stderr, "Error: Cannot open file '%s'\n", filename);
-            return 1;
-        }
         if (verbose) {
             printf("Parsing file: %s\n", filename);
         }
@@ -125,12 +158,9 @@ int main(int argc, char *argv[]) {
         printf("Starting parser...\n");
     }
     
-    ASTNode *ast = naturelang_parse(input);
-    
-    /* Close file if we opened one */
-    if (filename != NULL) {
-        fclose(input);
-    }
+    /* Files are mapped and scanned in place; stdin is read in one go */
+    ASTNode *ast = filename != NULL ? naturelang_parse_file(filename)
+                                    : naturelang_parse(stdin);
     
     /* Check result */
     if (ast == NULL) {
@@ -140,6 +170,19 @@ int main(int argc, char *argv[]) {
         return 1;
     }
     
+    /* Everything below then runs on the tree rebuilt from the compact form */
+    if (compact) {
+        ASTCompact *ac = ast_compact_build(ast, NULL, 0);
+        if (verbose) {
+            printf("Compact AST: %u nodes, %zu bytes (pointer tree: %zu bytes)\n",
+                   ac->node_count - 1, ast_compact_memory_usage(ac),
+                   ast_memory_usage(ast));
+        }
+        ast_free(ast);
+        ast = ast_compact_expand(ac, ac->root);
+        ast_compact_free(ac);
+    }
+
     if (!quiet && !do_codegen) {
         printf("Parsing successful!\n");
         
@@ -157,6 +200,42 @@ int main(int argc, char *argv[]) {
         printf("\n");
     }
 
+    /* Semantic analysis (fills in data_type on every expression) */
+    SemanticResult sem = {0};
+    if (do_semantic) {
+        sem = semantic_analyze_jobs(ast, jobs);
+        if (!sem.success) {
+            fprintf(stderr, "Semantic analysis failed with %d error(s)\n", sem.error_count);
+            semantic_result_free(&sem);
+            ast_free(ast);
+            return 1;
+        }
+        if (perf_lint) {
+            semantic_perf_lint(ast, &sem, opt_level);
+        }
+        if (verbose) {
+            printf("Semantic analysis passed (%d warning(s))\n", sem.warning_count);
+        }
+    }
+
+    /* Generate C from the AST if requested */
+    if (do_ast_codegen) {
+        CodegenOptions cg_opts = codegen_default_options();
+        CodegenContext *cg = codegen_create(sem.symtab, &cg_opts);
+        CodegenResult cg_result = codegen_generate(cg, ast);
+        if (cg_result.success) {
+            if (!quiet) {
+                printf("%s", cg_result.generated_code);
+            }
+        } else {
+            fprintf(stderr, "Code generation failed: %s\n",
+                    cg_result.error_message ? cg_result.error_message : "unknown error");
+        }
+        free(cg_result.generated_code);
+        free(cg_result.error_message);
+        codegen_destroy(cg);
+    }
+
     /* Generate and print IR if requested */
     if (print_ir || do_codegen) {
         TACProgram *ir = ir_generate(ast);
@@ -198,6 +277,9 @@ int main(int argc, char *argv[]) {
     }
     
     /* Clean up */
+    if (do_semantic) {
+        semantic_result_free(&sem);
+    }
     ast_free(ast);
     
     if (verbose) {
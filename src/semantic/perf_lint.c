@@ -0,0 +1,490 @@
+/*
+ * NatureLang Compiler
+ * Copyright (c) 2026
+ *
+ * Performance Lint
+ *
+ * Runs over a type-checked AST and warns about loops whose cost grows
+ * faster than their trip count:
+ *
+ *   text-concat-in-loop    `set s to s plus x` copies all of s on every
+ *                          iteration, O(n^2) for n iterations; from -O1
+ *                          on only where the optimizer cannot keep s in
+ *                          a string builder across the loop
+ *   length-in-condition    `while i is less than length of xs` measures xs
+ *                          again on every test although the body never
+ *                          changes it
+ *   search-in-loop         a `for each` that compares its element for
+ *                          equality, nested in another loop, is a linear
+ *                          search repeated per outer iteration, O(n*m)
+ *
+ * Each finding is a warning on the analysis' symbol table of the form
+ *
+ *   Warning at line L:C: performance [check]: what; complexity: O(..); suggestion: ...
+ *
+ * so that tools can split it on "; ".
+ */
+
+#include "semantic.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================================
+ * LINT CONTEXT
+ * ============================================================================
+ */
+
+/* A name declared in an enclosing scope */
+typedef struct {
+    const char *name;
+    size_t loop_depth;          /* Entries on the loop stack at its declaration */
+    int local;                  /* Declared inside a function */
+} LintName;
+
+typedef struct {
+    SymbolTable *symtab;
+    ASTNode **loops;            /* Enclosing loops, innermost last; NULL marks a function */
+    size_t loop_count;
+    size_t loop_capacity;
+    LintName *names;            /* Visible declarations, innermost last */
+    size_t name_count;
+    size_t name_capacity;
+    int opt_level;              /* Level the program is compiled at */
+    int warning_count;
+} LintContext;
+
+static void *lint_grow(void *array, size_t *capacity, size_t size) {
+    *capacity = *capacity ? *capacity * 2 : 16;
+    array = realloc(array, *capacity * size);
+    if (!array) {
+        fprintf(stderr, "Fatal: Out of memory in performance lint\n");
+        exit(1);
+    }
+    return array;
+}
+
+static void push_loop(LintContext *ctx, ASTNode *loop) {
+    if (ctx->loop_count == ctx->loop_capacity) {
+        ctx->loops = lint_grow(ctx->loops, &ctx->loop_capacity, sizeof(ASTNode *));
+    }
+    ctx->loops[ctx->loop_count++] = loop;
+}
+
+static void declare(LintContext *ctx, const char *name) {
+    if (!name) return;
+    if (ctx->name_count == ctx->name_capacity) {
+        ctx->names = lint_grow(ctx->names, &ctx->name_capacity, sizeof(LintName));
+    }
+    ctx->names[ctx->name_count].name = name;
+    ctx->names[ctx->name_count].loop_depth = ctx->loop_count;
+    ctx->names[ctx->name_count].local = 0;
+    for (size_t i = 0; i < ctx->loop_count; i++) {
+        if (!ctx->loops[i]) ctx->names[ctx->name_count].local = 1;
+    }
+    ctx->name_count++;
+}
+
+/* Innermost loop around the current statement, or NULL */
+static ASTNode *current_loop(const LintContext *ctx) {
+    return ctx->loop_count > 0 ? ctx->loops[ctx->loop_count - 1] : NULL;
+}
+
+/* Loop enclosing the innermost one within the same function, or NULL */
+static ASTNode *outer_loop(const LintContext *ctx) {
+    return ctx->loop_count > 1 && ctx->loops[ctx->loop_count - 1]
+           ? ctx->loops[ctx->loop_count - 2] : NULL;
+}
+
+/* Does `name` outlive one iteration of the innermost loop? */
+static int lives_across_iterations(const LintContext *ctx, const char *name) {
+    for (size_t i = ctx->name_count; i-- > 0;) {
+        if (strcmp(ctx->names[i].name, name) == 0) {
+            return ctx->names[i].loop_depth < ctx->loop_count;
+        }
+    }
+    return 1;   /* A global declared further down */
+}
+
+/* Is `name` a parameter or variable of the function around the statement? */
+static int is_local(const LintContext *ctx, const char *name) {
+    for (size_t i = ctx->name_count; i-- > 0;) {
+        if (strcmp(ctx->names[i].name, name) == 0) return ctx->names[i].local;
+    }
+    return 0;
+}
+
+static int is_identifier(const ASTNode *node, const char *name) {
+    return node && node->type == AST_IDENTIFIER &&
+           strcmp(node->data.identifier.name, name) == 0;
+}
+
+/* Does `name` occur anywhere under `node`? */
+static int mentions(ASTNode *node, const char *name) {
+    ASTWalkStack stack;
+    ast_walk_init(&stack);
+    ast_walk_push(&stack, node);
+    int found = 0;
+    while (stack.count > 0 && !found) {
+        ASTWalkFrame *frame = ast_walk_top(&stack);
+        if (frame->next == 0) found = is_identifier(frame->node, name);
+        if (frame->node && frame->next < ast_child_count(frame->node)) {
+            ast_walk_push(&stack, ast_child(frame->node, frame->next++));
+        } else {
+            ast_walk_pop(&stack);
+        }
+    }
+    ast_walk_free(&stack);
+    return found;
+}
+
+/* ============================================================================
+ * CHECKS
+ * ============================================================================
+ */
+
+/*
+ * `name plus p1 plus p2 ...` where p1 is not `name` itself and no later
+ * piece reads `name`: the CONCAT chain the optimizer turns into appends
+ * to a builder
+ */
+static int is_append_chain(ASTNode *value, const char *name) {
+    if (!value || value->type != AST_BINARY_OP || value->data.binary_op.op != OP_ADD ||
+        value->data_type != TYPE_TEXT) return 0;
+    if (is_identifier(value->data.binary_op.left, name))
+        return !is_identifier(value->data.binary_op.right, name);
+    return !mentions(value->data.binary_op.right, name) &&
+           is_append_chain(value->data.binary_op.left, name);
+}
+
+/*
+ * Does opt_text_accumulators (optimizer.c) keep `name` in a string builder
+ * across `loop`? It does when the loop never returns, calls no user
+ * function unless `name` is local, and every write to `name` inside it is
+ * an append chain. A loop is only ever entered at its head and left
+ * through its exit, so those rules are all that carry over to the AST.
+ */
+static int accumulates_in(ASTNode *loop, const char *name, int local) {
+    ASTWalkStack stack;
+    ast_walk_init(&stack);
+    /* The count of a repeat and the list of a for each are evaluated before the head */
+    if (loop->type == AST_WHILE) {
+        ast_walk_push(&stack, loop->data.while_stmt.condition);
+        ast_walk_push(&stack, loop->data.while_stmt.body);
+    } else if (loop->type == AST_REPEAT) {
+        ast_walk_push(&stack, loop->data.repeat_stmt.body);
+    } else {
+        ast_walk_push(&stack, loop->data.for_each_stmt.body);
+    }
+    int ok = 1, has_call = 0;
+    while (stack.count > 0 && ok) {
+        ASTWalkFrame *frame = ast_walk_top(&stack);
+        ASTNode *node = frame->node;
+        if (node && frame->next == 0) {
+            switch (node->type) {
+                case AST_RETURN:
+                    ok = 0;
+                    break;
+                case AST_FUNC_CALL:
+                    if (strncmp(node->data.func_call.name, "__", 2) != 0) has_call = 1;
+                    break;
+                case AST_ASSIGN:
+                    if (is_identifier(node->data.assign.target, name))
+                        ok = is_append_chain(node->data.assign.value, name);
+                    break;
+                case AST_VAR_DECL:
+                    ok = strcmp(node->data.var_decl.name, name) != 0;
+                    break;
+                case AST_ASK:
+                    ok = strcmp(node->data.ask_stmt.target_var, name) != 0;
+                    break;
+                case AST_READ:
+                    ok = strcmp(node->data.read_stmt.target_var, name) != 0;
+                    break;
+                case AST_FOR_EACH:
+                    ok = strcmp(node->data.for_each_stmt.iterator_name, name) != 0;
+                    break;
+                default:
+                    break;
+            }
+        }
+        if (node && frame->next < ast_child_count(node)) {
+            ast_walk_push(&stack, ast_child(node, frame->next++));
+        } else {
+            ast_walk_pop(&stack);
+        }
+    }
+    ast_walk_free(&stack);
+    return ok && (!has_call || local);
+}
+
+/* Is the append to `name` at the current statement made linear at -O1 and up? */
+static int optimized_accumulator(const LintContext *ctx, const char *name) {
+    if (ctx->opt_level < 1) return 0;
+    int local = is_local(ctx, name);
+    for (size_t i = ctx->loop_count; i-- > 0 && ctx->loops[i];) {
+        if (accumulates_in(ctx->loops[i], name, local)) return 1;
+    }
+    return 0;
+}
+
+/* `s becomes ... s ...` where the right side is a text `plus` chain */
+static void check_text_concat(LintContext *ctx, ASTNode *assign) {
+    ASTNode *target = assign->data.assign.target;
+    ASTNode *value = assign->data.assign.value;
+    if (!target || target->type != AST_IDENTIFIER) return;
+    if (!value || value->type != AST_BINARY_OP || value->data.binary_op.op != OP_ADD ||
+        value->data_type != TYPE_TEXT) return;
+    const char *name = target->data.identifier.name;
+    if (!lives_across_iterations(ctx, name)) return;
+
+    /* Look through the operands of the chain (not into nested calls) */
+    ASTWalkStack stack;
+    ast_walk_init(&stack);
+    ast_walk_push(&stack, value);
+    int found = 0;
+    while (stack.count > 0 && !found) {
+        ASTNode *node = ast_walk_top(&stack)->node;
+        ast_walk_pop(&stack);
+        if (is_identifier(node, name)) {
+            found = 1;
+        } else if (node && node->type == AST_BINARY_OP && node->data.binary_op.op == OP_ADD) {
+            ast_walk_push(&stack, node->data.binary_op.left);
+            ast_walk_push(&stack, node->data.binary_op.right);
+        }
+    }
+    ast_walk_free(&stack);
+    if (!found || optimized_accumulator(ctx, name)) return;
+
+    symtab_warning(ctx->symtab, assign->loc,
+                   "performance [text-concat-in-loop]: '%s' is copied in full to append to it "
+                   "on every iteration of the enclosing loop; complexity: O(n^2) in the final "
+                   "length of '%s'; suggestion: display the pieces as they are produced, or "
+                   "join them into fewer, larger pieces before appending",
+                   name, name);
+    ctx->warning_count++;
+}
+
+/* Is `name` assigned, redeclared or passed to a function anywhere under `body`? */
+static int assigns_name(ASTNode *body, const char *name) {
+    ASTWalkStack stack;
+    ast_walk_init(&stack);
+    ast_walk_push(&stack, body);
+    int found = 0;
+    while (stack.count > 0 && !found) {
+        ASTWalkFrame *frame = ast_walk_top(&stack);
+        ASTNode *node = frame->node;
+        if (node && frame->next == 0) {
+            if (node->type == AST_ASSIGN) {
+                ASTNode *target = node->data.assign.target;
+                if (target && target->type == AST_INDEX) target = target->data.index_expr.array;
+                found = is_identifier(target, name);
+            } else if (node->type == AST_VAR_DECL) {
+                found = strcmp(node->data.var_decl.name, name) == 0;
+            } else if (node->type == AST_ASK) {
+                found = strcmp(node->data.ask_stmt.target_var, name) == 0;
+            } else if (node->type == AST_READ) {
+                found = strcmp(node->data.read_stmt.target_var, name) == 0;
+            } else if (node->type == AST_FUNC_CALL && node->data.func_call.args) {
+                /* A list argument can be changed by the callee */
+                for (size_t i = 0; i < node->data.func_call.args->count && !found; i++) {
+                    found = is_identifier(node->data.func_call.args->nodes[i], name) &&
+                            strcmp(node->data.func_call.name, "__list_length") != 0;
+                }
+            }
+        }
+        if (node && frame->next < ast_child_count(node)) {
+            ast_walk_push(&stack, ast_child(node, frame->next++));
+        } else {
+            ast_walk_pop(&stack);
+        }
+    }
+    ast_walk_free(&stack);
+    return found;
+}
+
+/* `length of xs` (or `size of xs`) in a while condition, xs loop-invariant */
+static void check_length_condition(LintContext *ctx, ASTNode *loop) {
+    ASTWalkStack stack;
+    ast_walk_init(&stack);
+    ast_walk_push(&stack, loop->data.while_stmt.condition);
+    while (stack.count > 0) {
+        ASTWalkFrame *frame = ast_walk_top(&stack);
+        ASTNode *node = frame->node;
+        if (node && frame->next == 0 && node->type == AST_FUNC_CALL &&
+            strcmp(node->data.func_call.name, "__list_length") == 0 &&
+            node->data.func_call.args && node->data.func_call.args->count == 1) {
+            ASTNode *arg = node->data.func_call.args->nodes[0];
+            if (arg && arg->type == AST_IDENTIFIER &&
+                !assigns_name(loop->data.while_stmt.body, arg->data.identifier.name)) {
+                const char *name = arg->data.identifier.name;
+                symtab_warning(ctx->symtab, node->loc,
+                               "performance [length-in-condition]: the length of '%s' is "
+                               "recomputed on every test of the while loop although "
+                               "the loop never changes '%s'; complexity: O(n) length "
+                               "calls for n iterations; "
+                               "suggestion: store the length in a variable before the loop",
+                               name, name);
+                ctx->warning_count++;
+            }
+        }
+        if (node && frame->next < ast_child_count(node)) {
+            ast_walk_push(&stack, ast_child(node, frame->next++));
+        } else {
+            ast_walk_pop(&stack);
+        }
+    }
+    ast_walk_free(&stack);
+}
+
+/* Does `cond` test `name` for equality (possibly within and/or)? */
+static int tests_equality(ASTNode *cond, const char *name) {
+    while (cond && cond->type == AST_BINARY_OP &&
+           (cond->data.binary_op.op == OP_AND || cond->data.binary_op.op == OP_OR)) {
+        if (tests_equality(cond->data.binary_op.right, name)) return 1;
+        cond = cond->data.binary_op.left;
+    }
+    return cond && cond->type == AST_BINARY_OP && cond->data.binary_op.op == OP_EQ &&
+           (is_identifier(cond->data.binary_op.left, name) ||
+            is_identifier(cond->data.binary_op.right, name));
+}
+
+/* A `for each` nested in another loop whose body looks for one element */
+static void check_nested_search(LintContext *ctx, ASTNode *loop) {
+    if (!outer_loop(ctx)) return;
+    const char *name = loop->data.for_each_stmt.iterator_name;
+    ASTNode *iterable = loop->data.for_each_stmt.iterable;
+
+    ASTWalkStack stack;
+    ast_walk_init(&stack);
+    ast_walk_push(&stack, loop->data.for_each_stmt.body);
+    ASTNode *match = NULL;
+    while (stack.count > 0 && !match) {
+        ASTWalkFrame *frame = ast_walk_top(&stack);
+        ASTNode *node = frame->node;
+        if (!node || frame->next > 0 || node->type != AST_IF) {
+            /* Only statements can hold the test; skip expressions */
+            int statement = node && (node->type == AST_BLOCK || node->type == AST_IF ||
+                                     node->type == AST_SECURE_ZONE);
+            if (statement && frame->next < ast_child_count(node)) {
+                ast_walk_push(&stack, ast_child(node, frame->next++));
+            } else {
+                ast_walk_pop(&stack);
+            }
+            continue;
+        }
+        if (tests_equality(node->data.if_stmt.condition, name)) {
+            match = node;
+        } else {
+            frame->next++;  /* Past the condition, into the branches */
+        }
+    }
+    ast_walk_free(&stack);
+    if (!match) return;
+
+    symtab_warning(ctx->symtab, match->loc,
+                   "performance [search-in-loop]: the for each loop over %s searches it "
+                   "element by element on every iteration of the enclosing loop; "
+                   "complexity: O(n*m) for n outer iterations over m elements; suggestion: "
+                   "leave the inner loop with 'stop' at the first match, or search once "
+                   "before the outer loop when the value looked for does not change",
+                   iterable && iterable->type == AST_IDENTIFIER
+                   ? iterable->data.identifier.name : "its list");
+    ctx->warning_count++;
+}
+
+/* ============================================================================
+ * WALK
+ * ============================================================================
+ */
+
+static void enter_node(LintContext *ctx, ASTWalkFrame *frame) {
+    ASTNode *node = frame->node;
+    switch (node->type) {
+        case AST_BLOCK:
+            frame->aux.num = (long)ctx->name_count;
+            break;
+        case AST_FUNC_DECL:
+            /* Loops around a definition do not repeat its body */
+            declare(ctx, node->data.func_decl.name);
+            frame->aux.num = (long)ctx->name_count;
+            push_loop(ctx, NULL);
+            break;
+        case AST_PARAM_DECL:
+            declare(ctx, node->data.param_decl.name);
+            break;
+        case AST_VAR_DECL:
+            declare(ctx, node->data.var_decl.name);
+            break;
+        case AST_WHILE:
+            check_length_condition(ctx, node);
+            push_loop(ctx, node);
+            break;
+        case AST_REPEAT:
+            push_loop(ctx, node);
+            break;
+        case AST_FOR_EACH:
+            frame->aux.num = (long)ctx->name_count;
+            push_loop(ctx, node);
+            declare(ctx, node->data.for_each_stmt.iterator_name);
+            check_nested_search(ctx, node);
+            break;
+        case AST_ASSIGN:
+            if (current_loop(ctx)) check_text_concat(ctx, node);
+            break;
+        default:
+            break;
+    }
+}
+
+static void leave_node(LintContext *ctx, ASTWalkFrame *frame) {
+    ASTNode *node = frame->node;
+    switch (node->type) {
+        case AST_BLOCK:
+            ctx->name_count = (size_t)frame->aux.num;
+            break;
+        case AST_FUNC_DECL:
+        case AST_FOR_EACH:
+            ctx->name_count = (size_t)frame->aux.num;
+            ctx->loop_count--;
+            break;
+        case AST_WHILE:
+        case AST_REPEAT:
+            ctx->loop_count--;
+            break;
+        default:
+            break;
+    }
+}
+
+int semantic_perf_lint(ASTNode *program, SemanticResult *result, int opt_level) {
+    if (!program || !result || !result->symtab) return 0;
+
+    LintContext ctx = {0};
+    ctx.symtab = result->symtab;
+    ctx.opt_level = opt_level;
+
+    ASTWalkStack stack;
+    ast_walk_init(&stack);
+    ast_walk_push(&stack, program);
+    while (stack.count > 0) {
+        ASTWalkFrame *frame = ast_walk_top(&stack);
+        if (!frame->node) {
+            ast_walk_pop(&stack);
+            continue;
+        }
+        if (frame->next == 0) enter_node(&ctx, frame);
+        if (frame->next < ast_child_count(frame->node)) {
+            ast_walk_push(&stack, ast_child(frame->node, frame->next++));
+        } else {
+            leave_node(&ctx, frame);
+            ast_walk_pop(&stack);
+        }
+    }
+    ast_walk_free(&stack);
+
+    free(ctx.loops);
+    free(ctx.names);
+    result->warning_count += ctx.warning_count;
+    return ctx.warning_count;
+}
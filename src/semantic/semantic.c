@@ -6,26 +6,56 @@
  * 
  * Performs type checking, scope analysis, and validates the program
  * follows NatureLang's semantic rules.
+ *
+ * Analysis runs in two phases. The first walks the program in order,
+ * declaring every top-level function and global and checking the top-level
+ * code, but only queues the bodies of top-level functions. The second
+ * checks the queued bodies on worker threads, each in its own symbol table
+ * layered over the (now read-only) global one, and prints the buffered
+ * diagnostics in source order.
  */
 
+#define _POSIX_C_SOURCE 200809L
 #include "semantic.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
+#include <pthread.h>
+#include <unistd.h>
 
 /* ============================================================================
  * ANALYZER CONTEXT
  * ============================================================================
  */
+
+/* A top-level function body queued for the parallel phase */
+typedef struct {
+    ASTNode *node;              /* The AST_FUNC_DECL */
+    int group;                  /* Diagnostic group of its declaration */
+    unsigned long stamp;        /* Global symbols visible to the body */
+    SymbolTable *symtab;        /* The body's scopes and diagnostics */
+    bool had_error;
+} FunctionJob;
+
 typedef struct {
     SymbolTable *symtab;
     bool had_error;
+    int top_level_count;        /* Top-level statements seen so far */
+    
+    /* Top-level function bodies left for the parallel phase */
+    bool defer_functions;
+    FunctionJob *jobs;
+    size_t job_count;
+    size_t job_capacity;
 } AnalyzerContext;
 
 /* Forward declarations for recursive analysis */
 static void analyze_node(AnalyzerContext *ctx, ASTNode *node);
 static void analyze_statement(AnalyzerContext *ctx, ASTNode *node);
 static DataType analyze_expression(AnalyzerContext *ctx, ASTNode *node);
+static void analyze_function_body(AnalyzerContext *ctx, ASTNode *node);
+static void defer_function(AnalyzerContext *ctx, ASTNode *node);
 
 /* ============================================================================
  * TYPE UTILITIES
@@ -146,30 +176,123 @@ DataType get_unary_op_result_type(Operator op, DataType operand) {
     }
 }
 
+/* ============================================================================
+ * BUILTIN FUNCTIONS
+ * ============================================================================
+ */
+
+/* Parameter types shared by every builtin (all take numbers) */
+static DataType builtin_params[] = { TYPE_NUMBER, TYPE_NUMBER, TYPE_NUMBER };
+
+/* List builtins take the list, then a value checked against its elements */
+static DataType list_builtin_params[] = { TYPE_LIST, TYPE_UNKNOWN };
+
+/* builtins.def, as function symbols that calls are checked against */
+static Symbol builtin_symbols[] = {
+#define BUILTIN(id, runtime, ret, elem, params) \
+    { .name = id, .kind = SYMBOL_FUNCTION, .type = ret, .elem_type = elem, \
+      .is_initialized = true, .func_info = { builtin_params, params, ret, true } },
+#define LIST_BUILTIN(id, phrase, num, dec, text, ret, params) \
+    { .name = id, .kind = SYMBOL_FUNCTION, .type = ret, .elem_type = TYPE_UNKNOWN, \
+      .is_initialized = true, .func_info = { list_builtin_params, params, ret, true } },
+#include "builtins.def"
+#undef LIST_BUILTIN
+#undef BUILTIN
+};
+
+/* What a list builtin needs beyond its symbol */
+typedef struct {
+    const char *name;
+    const char *phrase;         /* How errors name the call */
+    const char *text_runtime;   /* NULL: not defined on text lists */
+} ListBuiltin;
+
+static const ListBuiltin list_builtins[] = {
+#define BUILTIN(id, runtime, ret, elem, params)
+#define LIST_BUILTIN(id, phrase, num, dec, text, ret, params) { id, phrase, text },
+#include "builtins.def"
+#undef LIST_BUILTIN
+#undef BUILTIN
+};
+
+/* The builtin called `name`, or NULL */
+static Symbol *lookup_builtin(const char *name) {
+    if (strncmp(name, "__", 2) != 0) return NULL;
+    for (size_t i = 0; i < sizeof(builtin_symbols) / sizeof(builtin_symbols[0]); i++) {
+        if (strcmp(builtin_symbols[i].name, name) == 0) return &builtin_symbols[i];
+    }
+    return NULL;
+}
+
+/* The list builtin called `name`, or NULL */
+static const ListBuiltin *lookup_list_builtin(const char *name) {
+    if (strncmp(name, "__list_", 7) != 0) return NULL;
+    for (size_t i = 0; i < sizeof(list_builtins) / sizeof(list_builtins[0]); i++) {
+        if (strcmp(list_builtins[i].name, name) == 0) return &list_builtins[i];
+    }
+    return NULL;
+}
+
 /* ============================================================================
  * EXPRESSION ANALYSIS
  * ============================================================================
  */
 
-static DataType analyze_expression(AnalyzerContext *ctx, ASTNode *node) {
-    if (!node) return TYPE_UNKNOWN;
-    
+/*
+ * Expressions are checked bottom-up with an explicit stack (generated
+ * operator chains can be a million levels deep). Each node is handled in
+ * up to three steps, in the order the recursive checker used to report
+ * errors:
+ *   enter_expression   before the operands (leaves are finished here)
+ *   check_argument     after each call argument
+ *   leave_expression   after all operands, whose types are in data_type
+ */
+
+/* A list can hold numbers, decimals, text or flags */
+static bool check_element_type(AnalyzerContext *ctx, SourceLocation loc, DataType type) {
+    if (type == TYPE_NUMBER || type == TYPE_DECIMAL || type == TYPE_TEXT ||
+        type == TYPE_FLAG || type == TYPE_UNKNOWN) {
+        return true;
+    }
+    symtab_error(ctx->symtab, loc, "A list cannot hold %s values",
+                datatype_to_string(type));
+    ctx->had_error = true;
+    return false;
+}
+
+/* A list of `source` elements must fit where a list of `target` is expected */
+static void check_list_elements(AnalyzerContext *ctx, SourceLocation loc,
+                                DataType target, DataType source) {
+    if (!types_compatible(target, source)) {
+        symtab_error(ctx->symtab, loc, "Cannot use a list of %s as a list of %s",
+                    datatype_to_string(source), datatype_to_string(target));
+        ctx->had_error = true;
+    }
+}
+
+/* Type an operand was given (absent operands are unknown) */
+static DataType operand_type(const ASTNode *node) {
+    return node ? node->data_type : TYPE_UNKNOWN;
+}
+
+/* Returns true if the node's operands still have to be analyzed */
+static bool enter_expression(AnalyzerContext *ctx, ASTNode *node, ASTWalkFrame *frame) {
     switch (node->type) {
         case AST_LITERAL_INT:
             node->data_type = TYPE_NUMBER;
-            return TYPE_NUMBER;
+            return false;
         
         case AST_LITERAL_FLOAT:
             node->data_type = TYPE_DECIMAL;
-            return TYPE_DECIMAL;
+            return false;
         
         case AST_LITERAL_STRING:
             node->data_type = TYPE_TEXT;
-            return TYPE_TEXT;
+            return false;
         
         case AST_LITERAL_BOOL:
             node->data_type = TYPE_FLAG;
-            return TYPE_FLAG;
+            return false;
         
         case AST_IDENTIFIER: {
             Symbol *sym = symtab_lookup(ctx->symtab, node->data.identifier.name);
@@ -178,7 +301,7 @@ static DataType analyze_expression(AnalyzerContext *ctx, ASTNode *node) {
                             "Undefined variable '%s'", node->data.identifier.name);
                 ctx->had_error = true;
                 node->data_type = TYPE_UNKNOWN;
-                return TYPE_UNKNOWN;
+                return false;
             }
             
             /* Warn if using uninitialized variable */
@@ -189,12 +312,114 @@ static DataType analyze_expression(AnalyzerContext *ctx, ASTNode *node) {
             }
             
             node->data_type = sym->type;
-            return sym->type;
+            node->elem_type = sym->elem_type;
+            return false;
+        }
+        
+        case AST_FUNC_CALL: {
+            Symbol *func = lookup_builtin(node->data.func_call.name);
+            if (!func) func = symtab_lookup_function(ctx->symtab, node->data.func_call.name);
+            if (!func) {
+                symtab_error(ctx->symtab, node->loc,
+                            "Undefined function '%s'", node->data.func_call.name);
+                ctx->had_error = true;
+                node->data_type = TYPE_UNKNOWN;
+                return false;
+            }
+            
+            /* Check argument count */
+            size_t expected_args = func->func_info.param_count;
+            size_t actual_args = node->data.func_call.args ? node->data.func_call.args->count : 0;
+            
+            if (expected_args != actual_args) {
+                symtab_error(ctx->symtab, node->loc,
+                            "Function '%s' expects %zu arguments, got %zu",
+                            node->data.func_call.name, expected_args, actual_args);
+                ctx->had_error = true;
+            }
+            
+            frame->aux.ptr = func;
+            return true;
         }
         
+        case AST_BINARY_OP:
+        case AST_UNARY_OP:
+        case AST_TERNARY_OP:
+        case AST_INDEX:
+        case AST_LIST:
+            return true;
+        
+        default:
+            return false;
+    }
+}
+
+/* Check argument i of a call against the parameter it is passed to */
+static void check_argument(AnalyzerContext *ctx, ASTNode *node, Symbol *func, size_t i) {
+    DataType arg_type = operand_type(node->data.func_call.args->nodes[i]);
+    
+    /* Check type compatibility with parameter if we have param info */
+    if (i < func->func_info.param_count) {
+        DataType param_type = func->func_info.param_types[i];
+        if (!types_compatible(param_type, arg_type)) {
+            symtab_error(ctx->symtab, node->loc,
+                        "Argument %zu type mismatch: expected %s, got %s",
+                        i + 1, datatype_to_string(param_type),
+                        datatype_to_string(arg_type));
+            ctx->had_error = true;
+        }
+    }
+}
+
+/*
+ * Type a call of a list builtin by what the list holds: the element type
+ * the call works on goes into the call's elem_type (see builtins.def), and
+ * sums, smallest and largest are decimals on decimal lists. Lists whose
+ * elements are not known here (list parameters) are taken as numbers.
+ */
+static void leave_list_builtin(AnalyzerContext *ctx, ASTNode *node, Symbol *func,
+                               const ListBuiltin *builtin) {
+    ASTNodeList *args = node->data.func_call.args;
+    size_t count = args ? args->count : 0;
+    DataType elem_type = count > 0 ? args->nodes[0]->elem_type : TYPE_UNKNOWN;
+    DataType value_type = count > 1 ? operand_type(args->nodes[1]) : TYPE_UNKNOWN;
+    
+    if (elem_type == TYPE_TEXT && !builtin->text_runtime) {
+        symtab_error(ctx->symtab, node->loc,
+                    "'%s' needs a number or decimal list, got a text list",
+                    builtin->phrase);
+        ctx->had_error = true;
+    } else if (elem_type == TYPE_TEXT && value_type != TYPE_TEXT && value_type != TYPE_UNKNOWN) {
+        symtab_error(ctx->symtab, node->loc,
+                    "'%s' on a text list needs a text value, got %s",
+                    builtin->phrase, datatype_to_string(value_type));
+        ctx->had_error = true;
+    } else if (elem_type != TYPE_TEXT && elem_type != TYPE_UNKNOWN && value_type == TYPE_TEXT) {
+        symtab_error(ctx->symtab, node->loc,
+                    "'%s' on a %s list needs a %s value, got text",
+                    builtin->phrase, datatype_to_string(elem_type),
+                    elem_type == TYPE_DECIMAL ? "decimal" : "number");
+        ctx->had_error = true;
+    }
+    
+    if (elem_type == TYPE_TEXT || value_type == TYPE_TEXT) {
+        node->elem_type = TYPE_TEXT;
+    } else if (elem_type == TYPE_DECIMAL || value_type == TYPE_DECIMAL) {
+        node->elem_type = TYPE_DECIMAL;
+    } else {
+        node->elem_type = TYPE_NUMBER;
+    }
+    node->data_type = func->func_info.return_type;
+    if (node->data_type == TYPE_UNKNOWN) {
+        node->data_type = node->elem_type == TYPE_DECIMAL ? TYPE_DECIMAL : TYPE_NUMBER;
+    }
+}
+
+static void leave_expression(AnalyzerContext *ctx, ASTNode *node, Symbol *func) {
+    switch (node->type) {
         case AST_BINARY_OP: {
-            DataType left_type = analyze_expression(ctx, node->data.binary_op.left);
-            DataType right_type = analyze_expression(ctx, node->data.binary_op.right);
+            DataType left_type = operand_type(node->data.binary_op.left);
+            DataType right_type = operand_type(node->data.binary_op.right);
             Operator op = node->data.binary_op.op;
             
             /* Check type compatibility based on operator */
@@ -203,7 +428,7 @@ static DataType analyze_expression(AnalyzerContext *ctx, ASTNode *node) {
                     /* Allow string concatenation */
                     if (left_type == TYPE_TEXT || right_type == TYPE_TEXT) {
                         node->data_type = TYPE_TEXT;
-                        return TYPE_TEXT;
+                        return;
                     }
                     /* FALLTHROUGH - for numeric addition */
                 case OP_SUB:
@@ -265,41 +490,41 @@ static DataType analyze_expression(AnalyzerContext *ctx, ASTNode *node) {
             }
             
             node->data_type = get_binary_op_result_type(op, left_type, right_type);
-            return node->data_type;
+            return;
         }
         
         case AST_UNARY_OP: {
-            DataType operand_type = analyze_expression(ctx, node->data.unary_op.operand);
+            DataType type = operand_type(node->data.unary_op.operand);
             Operator op = node->data.unary_op.op;
             
-            if ((op == OP_NEG || op == OP_POS) && !type_is_numeric(operand_type)) {
+            if ((op == OP_NEG || op == OP_POS) && !type_is_numeric(type)) {
                 symtab_error(ctx->symtab, node->loc,
                             "Unary '%s' requires numeric operand, got %s",
-                            operator_to_string(op), datatype_to_string(operand_type));
+                            operator_to_string(op), datatype_to_string(type));
                 ctx->had_error = true;
             }
             
-            if (op == OP_NOT && !type_is_boolean(operand_type)) {
+            if (op == OP_NOT && !type_is_boolean(type)) {
                 symtab_error(ctx->symtab, node->loc,
                             "'not' requires boolean operand, got %s",
-                            datatype_to_string(operand_type));
+                            datatype_to_string(type));
                 ctx->had_error = true;
             }
             
-            node->data_type = get_unary_op_result_type(op, operand_type);
-            return node->data_type;
+            node->data_type = get_unary_op_result_type(op, type);
+            return;
         }
         
         case AST_TERNARY_OP: {
             /* "is between" operator */
-            DataType operand_type = analyze_expression(ctx, node->data.ternary_op.operand);
-            DataType lower_type = analyze_expression(ctx, node->data.ternary_op.lower);
-            DataType upper_type = analyze_expression(ctx, node->data.ternary_op.upper);
+            DataType value_type = operand_type(node->data.ternary_op.operand);
+            DataType lower_type = operand_type(node->data.ternary_op.lower);
+            DataType upper_type = operand_type(node->data.ternary_op.upper);
             
-            if (!type_is_numeric(operand_type)) {
+            if (!type_is_numeric(value_type)) {
                 symtab_error(ctx->symtab, node->loc,
                             "'is between' requires numeric operand, got %s",
-                            datatype_to_string(operand_type));
+                            datatype_to_string(value_type));
                 ctx->had_error = true;
             }
             if (!type_is_numeric(lower_type)) {
@@ -316,60 +541,24 @@ static DataType analyze_expression(AnalyzerContext *ctx, ASTNode *node) {
             }
             
             node->data_type = TYPE_FLAG;
-            return TYPE_FLAG;
+            return;
         }
         
         case AST_FUNC_CALL: {
-            Symbol *func = symtab_lookup_function(ctx->symtab, node->data.func_call.name);
-            if (!func) {
-                symtab_error(ctx->symtab, node->loc,
-                            "Undefined function '%s'", node->data.func_call.name);
-                ctx->had_error = true;
-                node->data_type = TYPE_UNKNOWN;
-                return TYPE_UNKNOWN;
+            const ListBuiltin *list_builtin = lookup_list_builtin(node->data.func_call.name);
+            if (list_builtin) {
+                leave_list_builtin(ctx, node, func, list_builtin);
+                return;
             }
-            
-            /* Check argument count */
-            size_t expected_args = func->func_info.params ? func->func_info.params->count : 0;
-            size_t actual_args = node->data.func_call.args ? node->data.func_call.args->count : 0;
-            
-            if (expected_args != actual_args) {
-                symtab_error(ctx->symtab, node->loc,
-                            "Function '%s' expects %zu arguments, got %zu",
-                            node->data.func_call.name, expected_args, actual_args);
-                ctx->had_error = true;
-            }
-            
-            /* Analyze argument types */
-            if (node->data.func_call.args) {
-                for (size_t i = 0; i < node->data.func_call.args->count; i++) {
-                    DataType arg_type = analyze_expression(ctx, 
-                                                          node->data.func_call.args->nodes[i]);
-                    
-                    /* Check type compatibility with parameter if we have param info */
-                    if (func->func_info.params && i < func->func_info.params->count) {
-                        ASTNode *param = func->func_info.params->nodes[i];
-                        if (param && param->type == AST_PARAM_DECL) {
-                            DataType param_type = param->data.param_decl.param_type;
-                            if (!types_compatible(param_type, arg_type)) {
-                                symtab_error(ctx->symtab, node->loc,
-                                            "Argument %zu type mismatch: expected %s, got %s",
-                                            i + 1, datatype_to_string(param_type),
-                                            datatype_to_string(arg_type));
-                                ctx->had_error = true;
-                            }
-                        }
-                    }
-                }
-            }
-            
             node->data_type = func->func_info.return_type;
-            return func->func_info.return_type;
+            /* A builtin returning a list says what the list holds */
+            if (func->elem_type != TYPE_UNKNOWN) node->elem_type = func->elem_type;
+            return;
         }
         
         case AST_INDEX: {
-            DataType array_type = analyze_expression(ctx, node->data.index_expr.array);
-            DataType index_type = analyze_expression(ctx, node->data.index_expr.index);
+            DataType array_type = operand_type(node->data.index_expr.array);
+            DataType index_type = operand_type(node->data.index_expr.index);
             
             if (array_type != TYPE_LIST && array_type != TYPE_TEXT && 
                 array_type != TYPE_UNKNOWN) {
@@ -390,25 +579,77 @@ static DataType analyze_expression(AnalyzerContext *ctx, ASTNode *node) {
             if (array_type == TYPE_TEXT) {
                 node->data_type = TYPE_TEXT;  /* Single character as text */
             } else {
-                node->data_type = TYPE_UNKNOWN;  /* List element type unknown */
+                /* The list's element type, unknown for untyped lists */
+                node->data_type = node->data.index_expr.array->elem_type;
             }
-            return node->data_type;
+            return;
         }
         
         case AST_LIST: {
-            /* Analyze all list elements */
-            if (node->data.list_literal.elements) {
-                for (size_t i = 0; i < node->data.list_literal.elements->count; i++) {
-                    analyze_expression(ctx, node->data.list_literal.elements->nodes[i]);
+            /* Elements share one type; numbers mixed with decimals make decimals */
+            ASTNodeList *elements = node->data.list_literal.elements;
+            DataType elem_type = TYPE_UNKNOWN;
+            for (size_t i = 0; elements && i < elements->count; i++) {
+                DataType type = operand_type(elements->nodes[i]);
+                if (type == TYPE_UNKNOWN || type == elem_type) continue;
+                if (!check_element_type(ctx, elements->nodes[i]->loc, type)) {
+                    elem_type = TYPE_ERROR;
+                    break;
+                }
+                if (elem_type == TYPE_UNKNOWN) {
+                    elem_type = type;
+                } else if (type_is_numeric(elem_type) && type_is_numeric(type)) {
+                    elem_type = TYPE_DECIMAL;
+                } else {
+                    symtab_error(ctx->symtab, elements->nodes[i]->loc,
+                                "List elements must share one type, got %s and %s",
+                                datatype_to_string(elem_type),
+                                datatype_to_string(type));
+                    ctx->had_error = true;
+                    elem_type = TYPE_ERROR;
+                    break;
                 }
             }
             node->data_type = TYPE_LIST;
-            return TYPE_LIST;
+            node->elem_type = elem_type == TYPE_ERROR ? TYPE_UNKNOWN : elem_type;
+            return;
         }
         
         default:
-            return TYPE_UNKNOWN;
+            return;
+    }
+}
+
+static DataType analyze_expression(AnalyzerContext *ctx, ASTNode *node) {
+    if (!node) return TYPE_UNKNOWN;
+    
+    ASTWalkStack stack;
+    ast_walk_init(&stack);
+    ast_walk_push(&stack, node);
+    while (stack.count > 0) {
+        ASTWalkFrame *frame = ast_walk_top(&stack);
+        ASTNode *current = frame->node;
+        
+        if (frame->next == 0) {
+            if (!current || !enter_expression(ctx, current, frame)) {
+                ast_walk_pop(&stack);
+                continue;
+            }
+        } else if (current->type == AST_FUNC_CALL) {
+            check_argument(ctx, current, frame->aux.ptr, frame->next - 1);
+        }
+        
+        if (frame->next < ast_child_count(current)) {
+            ast_walk_push(&stack, ast_child(current, frame->next++));
+            continue;
+        }
+        
+        leave_expression(ctx, current, frame->aux.ptr);
+        ast_walk_pop(&stack);
     }
+    ast_walk_free(&stack);
+    
+    return node->data_type;
 }
 
 /* ============================================================================
@@ -416,6 +657,57 @@ static DataType analyze_expression(AnalyzerContext *ctx, ASTNode *node) {
  * ============================================================================
  */
 
+/* Parameters and body of a function, in a new function scope */
+static void analyze_function_body(AnalyzerContext *ctx, ASTNode *node) {
+    /* Enter function scope */
+    symtab_enter_function_scope(ctx->symtab, node->data.func_decl.return_type);
+    
+    /* Declare parameters */
+    if (node->data.func_decl.params) {
+        for (size_t i = 0; i < node->data.func_decl.params->count; i++) {
+            ASTNode *param = node->data.func_decl.params->nodes[i];
+            if (param && param->type == AST_PARAM_DECL) {
+                const char *error = symtab_declare_parameter(
+                    ctx->symtab,
+                    param->data.param_decl.name,
+                    param->data.param_decl.param_type,
+                    param->loc
+                );
+                if (error) {
+                    symtab_error(ctx->symtab, param->loc, "%s", error);
+                    ctx->had_error = true;
+                }
+            }
+        }
+    }
+    
+    /* Analyze function body */
+    if (node->data.func_decl.body) {
+        analyze_node(ctx, node->data.func_decl.body);
+    }
+    
+    /* Exit function scope */
+    symtab_exit_scope(ctx->symtab);
+}
+
+/* Queue a top-level function body, seeing the globals declared so far */
+static void defer_function(AnalyzerContext *ctx, ASTNode *node) {
+    if (ctx->job_count == ctx->job_capacity) {
+        ctx->job_capacity = ctx->job_capacity ? ctx->job_capacity * 2 : 16;
+        ctx->jobs = realloc(ctx->jobs, ctx->job_capacity * sizeof(FunctionJob));
+        if (!ctx->jobs) {
+            fprintf(stderr, "Fatal: Out of memory in semantic analysis\n");
+            exit(1);
+        }
+    }
+    FunctionJob *job = &ctx->jobs[ctx->job_count++];
+    job->node = node;
+    job->group = ctx->symtab->diagnostic_group;
+    job->stamp = symtab_stamp(ctx->symtab);
+    job->symtab = NULL;
+    job->had_error = false;
+}
+
 static void analyze_statement(AnalyzerContext *ctx, ASTNode *node) {
     if (!node) return;
     
@@ -434,9 +726,16 @@ static void analyze_statement(AnalyzerContext *ctx, ASTNode *node) {
                 ctx->had_error = true;
             }
             
+            /* A declared element type ("list of number") must be one a list can hold */
+            if (node->elem_type != TYPE_UNKNOWN &&
+                !check_element_type(ctx, node->loc, node->elem_type)) {
+                node->elem_type = TYPE_UNKNOWN;
+            }
+            
             /* Analyze initializer if present */
             if (node->data.var_decl.initializer) {
-                DataType init_type = analyze_expression(ctx, node->data.var_decl.initializer);
+                ASTNode *init = node->data.var_decl.initializer;
+                DataType init_type = analyze_expression(ctx, init);
                 
                 /* Check type compatibility */
                 if (!types_compatible(node->data.var_decl.var_type, init_type)) {
@@ -445,16 +744,39 @@ static void analyze_statement(AnalyzerContext *ctx, ASTNode *node) {
                                 datatype_to_string(node->data.var_decl.var_type),
                                 datatype_to_string(init_type));
                     ctx->had_error = true;
+                } else if (init_type == TYPE_LIST) {
+                    check_list_elements(ctx, node->loc, node->elem_type, init->elem_type);
+                    /* An untyped declaration takes the initializer's element type */
+                    if (node->elem_type == TYPE_UNKNOWN) {
+                        node->elem_type = init->elem_type;
+                    }
                 }
                 
                 /* Mark as initialized */
                 Symbol *sym = symtab_lookup(ctx->symtab, node->data.var_decl.name);
-                if (sym) symtab_mark_initialized(sym);
+                if (sym) symtab_mark_initialized(ctx->symtab, sym);
+            }
+            
+            /* A list declared without elements starts out as an empty list */
+            if (!error && node->data.var_decl.var_type == TYPE_LIST) {
+                Symbol *sym = symtab_lookup(ctx->symtab, node->data.var_decl.name);
+                if (sym) {
+                    sym->elem_type = node->elem_type;
+                    symtab_mark_initialized(ctx->symtab, sym);
+                }
             }
             break;
         }
         
         case AST_FUNC_DECL: {
+            /* "__" names belong to the runtime builtins */
+            if (strncmp(node->data.func_decl.name, "__", 2) == 0) {
+                symtab_error(ctx->symtab, node->loc,
+                            "Function name '%s' is reserved (names starting with '__' are builtins)",
+                            node->data.func_decl.name);
+                ctx->had_error = true;
+            }
+            
             /* Declare function in current scope */
             const char *error = symtab_declare_function(
                 ctx->symtab,
@@ -469,35 +791,12 @@ static void analyze_statement(AnalyzerContext *ctx, ASTNode *node) {
                 ctx->had_error = true;
             }
             
-            /* Enter function scope */
-            symtab_enter_function_scope(ctx->symtab, node->data.func_decl.return_type);
-            
-            /* Declare parameters */
-            if (node->data.func_decl.params) {
-                for (size_t i = 0; i < node->data.func_decl.params->count; i++) {
-                    ASTNode *param = node->data.func_decl.params->nodes[i];
-                    if (param && param->type == AST_PARAM_DECL) {
-                        error = symtab_declare_parameter(
-                            ctx->symtab,
-                            param->data.param_decl.name,
-                            param->data.param_decl.param_type,
-                            param->loc
-                        );
-                        if (error) {
-                            symtab_error(ctx->symtab, param->loc, "%s", error);
-                            ctx->had_error = true;
-                        }
-                    }
-                }
-            }
-            
-            /* Analyze function body */
-            if (node->data.func_decl.body) {
-                analyze_node(ctx, node->data.func_decl.body);
+            /* Bodies of top-level functions are checked in the parallel phase */
+            if (ctx->defer_functions && symtab_get_depth(ctx->symtab) == 0) {
+                defer_function(ctx, node);
+            } else {
+                analyze_function_body(ctx, node);
             }
-            
-            /* Exit function scope */
-            symtab_exit_scope(ctx->symtab);
             break;
         }
         
@@ -520,6 +819,8 @@ static void analyze_statement(AnalyzerContext *ctx, ASTNode *node) {
                                 "Cannot assign to function '%s'", name);
                     ctx->had_error = true;
                 } else {
+                    node->data.assign.target->data_type = sym->type;
+                    
                     /* Check type compatibility */
                     DataType value_type = analyze_expression(ctx, node->data.assign.value);
                     if (!types_compatible(sym->type, value_type)) {
@@ -528,13 +829,24 @@ static void analyze_statement(AnalyzerContext *ctx, ASTNode *node) {
                                     datatype_to_string(value_type),
                                     datatype_to_string(sym->type), name);
                         ctx->had_error = true;
+                    } else if (value_type == TYPE_LIST) {
+                        node->data.assign.target->elem_type = sym->elem_type;
+                        check_list_elements(ctx, node->loc, sym->elem_type,
+                                            node->data.assign.value->elem_type);
                     }
-                    symtab_mark_initialized(sym);
+                    symtab_mark_initialized(ctx->symtab, sym);
                 }
             } else {
-                /* Index assignment */
-                analyze_expression(ctx, node->data.assign.target);
-                analyze_expression(ctx, node->data.assign.value);
+                /* Index assignment: the value must fit the list's element type */
+                DataType elem_type = analyze_expression(ctx, node->data.assign.target);
+                DataType value_type = analyze_expression(ctx, node->data.assign.value);
+                if (!types_compatible(elem_type, value_type)) {
+                    symtab_error(ctx->symtab, node->loc,
+                                "Cannot store %s in a list of %s",
+                                datatype_to_string(value_type),
+                                datatype_to_string(elem_type));
+                    ctx->had_error = true;
+                }
             }
             break;
         }
@@ -609,8 +921,10 @@ static void analyze_statement(AnalyzerContext *ctx, ASTNode *node) {
             
             symtab_enter_loop_scope(ctx->symtab);
             
-            /* Declare iterator variable */
-            DataType elem_type = (iter_type == TYPE_TEXT) ? TYPE_TEXT : TYPE_UNKNOWN;
+            /* Declare iterator variable (the node carries its type) */
+            DataType elem_type = (iter_type == TYPE_TEXT)
+                                 ? TYPE_TEXT : node->data.for_each_stmt.iterable->elem_type;
+            node->data_type = elem_type;
             const char *error = symtab_declare_variable(
                 ctx->symtab,
                 node->data.for_each_stmt.iterator_name,
@@ -624,7 +938,7 @@ static void analyze_statement(AnalyzerContext *ctx, ASTNode *node) {
             } else {
                 Symbol *iter_sym = symtab_lookup(ctx->symtab, 
                                                  node->data.for_each_stmt.iterator_name);
-                if (iter_sym) symtab_mark_initialized(iter_sym);
+                if (iter_sym) symtab_mark_initialized(ctx->symtab, iter_sym);
             }
             
             analyze_node(ctx, node->data.for_each_stmt.body);
@@ -707,7 +1021,9 @@ static void analyze_statement(AnalyzerContext *ctx, ASTNode *node) {
                                 node->data.ask_stmt.target_var);
                     ctx->had_error = true;
                 } else {
-                    symtab_mark_initialized(sym);
+                    /* The input is converted to the variable's type */
+                    node->data_type = sym->type;
+                    symtab_mark_initialized(ctx->symtab, sym);
                 }
             }
             break;
@@ -726,7 +1042,9 @@ static void analyze_statement(AnalyzerContext *ctx, ASTNode *node) {
                                 node->data.read_stmt.target_var);
                     ctx->had_error = true;
                 } else {
-                    symtab_mark_initialized(sym);
+                    /* The input is converted to the variable's type */
+                    node->data_type = sym->type;
+                    symtab_mark_initialized(ctx->symtab, sym);
                 }
             }
             break;
@@ -779,17 +1097,107 @@ static void analyze_node(AnalyzerContext *ctx, ASTNode *node) {
         }
         
         default:
+            /* Diagnostics are merged back by top-level statement */
+            if (symtab_get_depth(ctx->symtab) == 0) {
+                symtab_set_diagnostic_group(ctx->symtab, ctx->top_level_count++);
+            }
             analyze_statement(ctx, node);
             break;
     }
 }
 
+/* ============================================================================
+ * PARALLEL PHASE
+ * Queue-er function body gulo worker thread-e check hoy. Prottek body nijer
+ * symbol table-e (global table-er upor layered) analyze hoy, tai global table
+ * sudhu pora hoy ar kono lock lage na; sudhu porer job neyar index ta lock kore.
+ * ============================================================================
+ */
+
+typedef struct {
+    const SymbolTable *globals;
+    FunctionJob *jobs;
+    size_t count;
+    size_t next;                /* Next job to hand out */
+    pthread_mutex_t lock;
+} JobQueue;
+
+static void analyze_job(const SymbolTable *globals, FunctionJob *job) {
+    AnalyzerContext ctx = {0};
+    ctx.symtab = symtab_create_over(globals, job->stamp);
+    symtab_buffer_diagnostics(ctx.symtab, true);
+    
+    analyze_function_body(&ctx, job->node);
+    
+    job->symtab = ctx.symtab;
+    job->had_error = ctx.had_error;
+}
+
+static void *run_jobs(void *arg) {
+    JobQueue *queue = arg;
+    for (;;) {
+        pthread_mutex_lock(&queue->lock);
+        size_t i = queue->next++;
+        pthread_mutex_unlock(&queue->lock);
+        if (i >= queue->count) return NULL;
+        analyze_job(queue->globals, &queue->jobs[i]);
+    }
+}
+
+/* Check every queued body with up to `threads` threads (this one included) */
+static void analyze_jobs(SymbolTable *globals, FunctionJob *jobs, size_t count, int threads) {
+    JobQueue queue = { globals, jobs, count, 0, PTHREAD_MUTEX_INITIALIZER };
+    if ((size_t)threads > count) threads = (int)count;
+    
+    pthread_t *workers = threads > 1 ? malloc((size_t)(threads - 1) * sizeof(pthread_t)) : NULL;
+    int started = 0;
+    while (workers && started < threads - 1 &&
+           pthread_create(&workers[started], NULL, run_jobs, &queue) == 0) {
+        started++;
+    }
+    
+    run_jobs(&queue);
+    for (int i = 0; i < started; i++) {
+        pthread_join(workers[i], NULL);
+    }
+    free(workers);
+    pthread_mutex_destroy(&queue.lock);
+}
+
+/* Print the diagnostics of both phases in source order and add up the counts */
+static void merge_diagnostics(SymbolTable *globals, FunctionJob *jobs, size_t count) {
+    size_t next = 0;
+    for (size_t j = 0; j <= count; j++) {
+        /* Everything reported up to (and including) the declaration of job j */
+        int group = j < count ? jobs[j].group : INT_MAX;
+        while (next < globals->diagnostic_count && globals->diagnostics[next].group <= group) {
+            fprintf(stderr, "%s\n", globals->diagnostics[next].message);
+            free(globals->diagnostics[next].message);
+            next++;
+        }
+        if (j == count) break;
+        
+        SymbolTable *body = jobs[j].symtab;
+        for (size_t i = 0; i < body->diagnostic_count; i++) {
+            fprintf(stderr, "%s\n", body->diagnostics[i].message);
+        }
+        globals->error_count += body->error_count;
+        globals->warning_count += body->warning_count;
+    }
+    globals->diagnostic_count = 0;
+    symtab_buffer_diagnostics(globals, false);
+}
+
 /* ============================================================================
  * MAIN ANALYSIS ENTRY POINT
  * ============================================================================
  */
 
 SemanticResult semantic_analyze(ASTNode *program) {
+    return semantic_analyze_jobs(program, 0);
+}
+
+SemanticResult semantic_analyze_jobs(ASTNode *program, int jobs) {
     /* doing this to avoid uninialized garbage value */
     SemanticResult result = {0};
     /* jodi ast root null hoy analysis sombhov na */
@@ -803,10 +1211,27 @@ SemanticResult semantic_analyze(ASTNode *program) {
     AnalyzerContext ctx = {0};
     ctx.symtab = symtab_create();
     ctx.had_error = false;
+    ctx.defer_functions = true;
+    symtab_buffer_diagnostics(ctx.symtab, true);
     
-    /* Perform analysis */
+    /* Phase 1: declarations and top-level code, in order */
     analyze_node(&ctx, program);
     
+    /* Phase 2: top-level function bodies, in parallel */
+    if (jobs <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        jobs = cpus > 0 ? (int)cpus : 1;
+    }
+    if (ctx.job_count > 0) {
+        analyze_jobs(ctx.symtab, ctx.jobs, ctx.job_count, jobs);
+    }
+    merge_diagnostics(ctx.symtab, ctx.jobs, ctx.job_count);
+    for (size_t i = 0; i < ctx.job_count; i++) {
+        ctx.had_error |= ctx.jobs[i].had_error;
+        symtab_destroy(ctx.jobs[i].symtab);
+    }
+    free(ctx.jobs);
+    
     /* Fill in result */
     result.success = !ctx.had_error && symtab_error_count(ctx.symtab) == 0;
     result.error_count = symtab_error_count(ctx.symtab);
@@ -816,6 +1241,36 @@ SemanticResult semantic_analyze(ASTNode *program) {
     return result;
 }
 
+/* ============================================================================
+ * STREAMING ANALYSIS
+ * Streaming front end-e parser prottek top-level statement reduce korar sathe
+ * sathe eikhane ase; function body tokhoni check hoy (AST porer statement-er
+ * jonno reuse hobe), ar diagnostics shoja print hoy.
+ * ============================================================================
+ */
+
+SemanticResult semantic_stream_begin(void) {
+    SemanticResult result = {0};
+    result.success = true;
+    result.symtab = symtab_create();
+    return result;
+}
+
+bool semantic_stream_statement(SemanticResult *result, ASTNode *statement) {
+    AnalyzerContext ctx = {0};
+    ctx.symtab = result->symtab;
+    ctx.defer_functions = false;
+    int errors_before = symtab_error_count(ctx.symtab);
+    
+    analyze_node(&ctx, statement);
+    
+    result->error_count = symtab_error_count(ctx.symtab);
+    result->warning_count = symtab_warning_count(ctx.symtab);
+    bool ok = !ctx.had_error && result->error_count == errors_before;
+    result->success = result->success && ok;
+    return ok;
+}
+
 void semantic_result_free(SemanticResult *result) {
     /* null-safe clean up guard */
     if (result && result->symtab) {
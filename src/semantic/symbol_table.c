@@ -6,6 +6,14 @@
  * 
  * Implements the symbol table for semantic analysis, managing scopes,
  * variable declarations, function declarations, and lookups.
+ *
+ * Every name seen is interned once in an open-addressed hash table. The
+ * entry holds the innermost binding of the name, and each Symbol links to
+ * the binding it shadows, so lookups never walk the scope chain.
+ *
+ * A table layered over an outer one copies an outer symbol into its own
+ * global scope the first time the name is looked up, so the outer table is
+ * only ever read.
  */
 
 #define _POSIX_C_SOURCE 200809L
@@ -14,6 +22,16 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
+#include <stdint.h>
+
+/* First size of the name table (a power of two) */
+#define NAME_TABLE_INITIAL 256
+
+struct SymbolName {
+    Symbol *binding;            /* Innermost visible binding, or NULL */
+    uint32_t hash;
+    char name[];                /* NUL-terminated */
+};
 
 /* ============================================================================
  * HELPER FUNCTIONS
@@ -30,14 +48,70 @@ static void *safe_malloc(size_t size) {
     return ptr;
 }
 
-static char *safe_strdup(const char *str) {
-    if (!str) return NULL;
-    char *copy = strdup(str);
-    if (!copy) {
-        fprintf(stderr, "Fatal: Out of memory in symbol table\n");
-        exit(1);
+/* ============================================================================
+ * NAME TABLE
+ * ============================================================================
+ */
+
+static uint32_t hash_name(const char *name) {
+    uint32_t h = 2166136261u;
+    for (const unsigned char *p = (const unsigned char *)name; *p; p++) {
+        h = (h ^ *p) * 16777619u;
     }
-    return copy;
+    return h;
+}
+
+static void name_table_insert(SymbolName **slots, size_t capacity, SymbolName *entry) {
+    size_t mask = capacity - 1;
+    size_t i = entry->hash & mask;
+    while (slots[i]) {
+        i = (i + 1) & mask;
+    }
+    slots[i] = entry;
+}
+
+/* Find the entry of a name; NULL if it was never declared */
+static SymbolName *name_table_find(const SymbolTable *table, const char *name) {
+    uint32_t hash = hash_name(name);
+    size_t mask = table->name_capacity - 1;
+    size_t i = hash & mask;
+    while (table->names[i]) {
+        SymbolName *entry = table->names[i];
+        if (entry->hash == hash && strcmp(entry->name, name) == 0) {
+            return entry;
+        }
+        i = (i + 1) & mask;
+    }
+    return NULL;
+}
+
+/* Find or add the entry of a name */
+static SymbolName *name_table_intern(SymbolTable *table, const char *name) {
+    SymbolName *entry = name_table_find(table, name);
+    if (entry) return entry;
+
+    /* Keep the table at most half full */
+    if (2 * (table->name_count + 1) > table->name_capacity) {
+        size_t capacity = table->name_capacity * 2;
+        SymbolName **slots = safe_malloc(capacity * sizeof(SymbolName *));
+        for (size_t i = 0; i < table->name_capacity; i++) {
+            if (table->names[i]) {
+                name_table_insert(slots, capacity, table->names[i]);
+            }
+        }
+        free(table->names);
+        table->names = slots;
+        table->name_capacity = capacity;
+    }
+
+    size_t len = strlen(name);
+    entry = safe_malloc(sizeof(SymbolName) + len + 1);
+    memcpy(entry->name, name, len + 1);
+    entry->hash = hash_name(name);
+    entry->binding = NULL;
+    name_table_insert(table->names, table->name_capacity, entry);
+    table->name_count++;
+    return entry;
 }
 
 /* ============================================================================
@@ -45,29 +119,46 @@ static char *safe_strdup(const char *str) {
  * ============================================================================
  */
 
-static Symbol *symbol_create(const char *name, SymbolKind kind, DataType type,
+static Symbol *symbol_create(SymbolName *entry, SymbolKind kind, DataType type,
                              int scope_level, SourceLocation loc) {
     Symbol *sym = safe_malloc(sizeof(Symbol));
-    sym->name = safe_strdup(name);
+    sym->name = entry->name;
     sym->kind = kind;
     sym->type = type;
+    sym->elem_type = TYPE_UNKNOWN;
     sym->scope_level = scope_level;
     sym->is_initialized = false;
     sym->decl_loc = loc;
-    sym->func_info.params = NULL;
+    sym->declared_at = 0;
+    sym->initialized_at = 0;
+    sym->func_info.param_types = NULL;
+    sym->func_info.param_count = 0;
     sym->func_info.return_type = TYPE_NOTHING;
     sym->func_info.has_return = false;
     sym->next = NULL;
+    sym->shadowed = NULL;
+    sym->entry = entry;
     return sym;
 }
 
 static void symbol_destroy(Symbol *sym) {
     if (!sym) return;
-    free(sym->name);
-    /* Note: func_info.params is owned by AST, don't free here */
+    /* Note: the name belongs to the name table */
+    free(sym->func_info.param_types);
     free(sym);
 }
 
+/* Make sym the visible binding of its name in the current scope */
+static void symbol_bind(SymbolTable *table, Symbol *sym) {
+    sym->declared_at = ++table->stamp;
+    sym->shadowed = sym->entry->binding;
+    sym->entry->binding = sym;
+
+    /* Add to front of current scope's symbol list */
+    sym->next = table->current_scope->symbols;
+    table->current_scope->symbols = sym;
+}
+
 /* ============================================================================
  * SCOPE CREATION AND DESTRUCTION
  * ============================================================================
@@ -88,10 +179,11 @@ static Scope *scope_create(int level, Scope *parent) {
 static void scope_destroy(Scope *scope) {
     if (!scope) return;
     
-    /* Free all symbols in this scope */
+    /* Free all symbols in this scope, newest first, uncovering what they shadowed */
     Symbol *sym = scope->symbols;
     while (sym) {
         Symbol *next = sym->next;
+        sym->entry->binding = sym->shadowed;
         symbol_destroy(sym);
         sym = next;
     }
@@ -111,12 +203,30 @@ SymbolTable *symtab_create(void) {
     table->global_scope = scope_create(0, NULL);
     table->current_scope = table->global_scope;
     table->scope_depth = 0;
+    table->names = safe_malloc(NAME_TABLE_INITIAL * sizeof(SymbolName *));
+    table->name_capacity = NAME_TABLE_INITIAL;
+    table->name_count = 0;
+    table->outer = NULL;
+    table->outer_stamp = 0;
+    table->stamp = 0;
     table->error_count = 0;
     table->warning_count = 0;
+    table->buffer_diagnostics = false;
+    table->diagnostic_group = 0;
+    table->diagnostics = NULL;
+    table->diagnostic_count = 0;
+    table->diagnostic_capacity = 0;
     
     return table;
 }
 
+SymbolTable *symtab_create_over(const SymbolTable *outer, unsigned long stamp) {
+    SymbolTable *table = symtab_create();
+    table->outer = outer;
+    table->outer_stamp = stamp;
+    return table;
+}
+
 void symtab_destroy(SymbolTable *table) {
     if (!table) return;
     
@@ -128,9 +238,21 @@ void symtab_destroy(SymbolTable *table) {
         scope = parent;
     }
     
+    for (size_t i = 0; i < table->name_capacity; i++) {
+        free(table->names[i]);
+    }
+    free(table->names);
+    for (size_t i = 0; i < table->diagnostic_count; i++) {
+        free(table->diagnostics[i].message);
+    }
+    free(table->diagnostics);
     free(table);
 }
 
+unsigned long symtab_stamp(const SymbolTable *table) {
+    return table->stamp;
+}
+
 /* ============================================================================
  * SCOPE MANAGEMENT
  * ============================================================================
@@ -228,21 +350,17 @@ const char *symtab_declare_variable(SymbolTable *table, const char *name,
     /* Check for redeclaration in current scope */
     Symbol *existing = symtab_lookup_current_scope(table, name);
     if (existing) {
-        static char error_buf[256];
-        snprintf(error_buf, sizeof(error_buf),
+        snprintf(table->error_buf, sizeof(table->error_buf),
                  "Redeclaration of '%s' (previously declared at line %d)",
                  name, existing->decl_loc.first_line);
-        return error_buf;
+        return table->error_buf;
     }
     
     /* Create and add the symbol */
-    Symbol *sym = symbol_create(name, 
+    Symbol *sym = symbol_create(name_table_intern(table, name),
                                 is_const ? SYMBOL_CONSTANT : SYMBOL_VARIABLE,
                                 type, table->scope_depth, loc);
-    
-    /* Add to front of current scope's symbol list */
-    sym->next = table->current_scope->symbols;
-    table->current_scope->symbols = sym;
+    symbol_bind(table, sym);
     
     return NULL; /* Success */
 }
@@ -253,24 +371,29 @@ const char *symtab_declare_function(SymbolTable *table, const char *name,
     /* Functions should be declared at global scope (or at least check for redecl) */
     Symbol *existing = symtab_lookup_current_scope(table, name);
     if (existing) {
-        static char error_buf[256];
-        snprintf(error_buf, sizeof(error_buf),
+        snprintf(table->error_buf, sizeof(table->error_buf),
                  "Redeclaration of function '%s' (previously declared at line %d)",
                  name, existing->decl_loc.first_line);
-        return error_buf;
+        return table->error_buf;
     }
     
     /* Create function symbol */
-    Symbol *sym = symbol_create(name, SYMBOL_FUNCTION, TYPE_FUNCTION,
-                                table->scope_depth, loc);
-    sym->func_info.params = params;
+    Symbol *sym = symbol_create(name_table_intern(table, name), SYMBOL_FUNCTION,
+                                TYPE_FUNCTION, table->scope_depth, loc);
+    if (params && params->count > 0) {
+        sym->func_info.param_types = safe_malloc(params->count * sizeof(DataType));
+        for (size_t i = 0; i < params->count; i++) {
+            ASTNode *param = params->nodes[i];
+            sym->func_info.param_types[i] = param && param->type == AST_PARAM_DECL
+                                            ? param->data.param_decl.param_type : TYPE_UNKNOWN;
+        }
+        sym->func_info.param_count = params->count;
+    }
     sym->func_info.return_type = return_type;
     sym->func_info.has_return = false;
     sym->is_initialized = true;  /* Functions are always "initialized" */
-    
-    /* Add to current scope */
-    sym->next = table->current_scope->symbols;
-    table->current_scope->symbols = sym;
+    symbol_bind(table, sym);
+    sym->initialized_at = sym->declared_at;
     
     return NULL; /* Success */
 }
@@ -280,47 +403,64 @@ const char *symtab_declare_parameter(SymbolTable *table, const char *name,
     /* Check for duplicate parameter name */
     Symbol *existing = symtab_lookup_current_scope(table, name);
     if (existing) {
-        static char error_buf[256];
-        snprintf(error_buf, sizeof(error_buf),
+        snprintf(table->error_buf, sizeof(table->error_buf),
                  "Duplicate parameter name '%s'", name);
-        return error_buf;
+        return table->error_buf;
     }
     
     /* Create parameter symbol */
-    Symbol *sym = symbol_create(name, SYMBOL_PARAMETER, type,
-                                table->scope_depth, loc);
+    Symbol *sym = symbol_create(name_table_intern(table, name), SYMBOL_PARAMETER,
+                                type, table->scope_depth, loc);
     sym->is_initialized = true;  /* Parameters are initialized by caller */
-    
-    /* Add to current scope */
-    sym->next = table->current_scope->symbols;
-    table->current_scope->symbols = sym;
+    symbol_bind(table, sym);
+    sym->initialized_at = sym->declared_at;
     
     return NULL; /* Success */
 }
 
+/* Copy the outer binding of a name (as of outer_stamp) into the global scope */
+static Symbol *lookup_outer(SymbolTable *table, const char *name) {
+    SymbolName *outer_entry = name_table_find(table->outer, name);
+    Symbol *outer_sym = outer_entry ? outer_entry->binding : NULL;
+    if (!outer_sym || outer_sym->declared_at > table->outer_stamp) {
+        return NULL;
+    }
+    
+    Symbol *sym = safe_malloc(sizeof(Symbol));
+    *sym = *outer_sym;
+    sym->entry = name_table_intern(table, name);
+    sym->name = sym->entry->name;
+    sym->is_initialized = outer_sym->initialized_at != 0 &&
+                          outer_sym->initialized_at <= table->outer_stamp;
+    sym->initialized_at = 0;
+    if (outer_sym->func_info.param_count > 0) {
+        size_t size = outer_sym->func_info.param_count * sizeof(DataType);
+        sym->func_info.param_types = safe_malloc(size);
+        memcpy(sym->func_info.param_types, outer_sym->func_info.param_types, size);
+    }
+    
+    /* No binding of the name is visible here, so the copy goes under all of them */
+    sym->shadowed = NULL;
+    sym->entry->binding = sym;
+    sym->next = table->global_scope->symbols;
+    table->global_scope->symbols = sym;
+    return sym;
+}
+
 Symbol *symtab_lookup(SymbolTable *table, const char *name) {
-    /* Search from current scope up to global scope */
-    Scope *scope = table->current_scope;
-    while (scope) {
-        Symbol *sym = scope->symbols;
-        while (sym) {
-            if (strcmp(sym->name, name) == 0) {
-                return sym;
-            }
-            sym = sym->next;
-        }
-        scope = scope->parent;
+    /* The innermost binding is the one visible from the current scope */
+    SymbolName *entry = name_table_find(table, name);
+    if (entry && entry->binding) {
+        return entry->binding;
     }
-    return NULL;  /* Not found */
+    return table->outer ? lookup_outer(table, name) : NULL;  /* NULL: not found */
 }
 
 Symbol *symtab_lookup_current_scope(SymbolTable *table, const char *name) {
-    Symbol *sym = table->current_scope->symbols;
-    while (sym) {
-        if (strcmp(sym->name, name) == 0) {
-            return sym;
-        }
-        sym = sym->next;
+    /* Scopes on the current chain have distinct levels */
+    Symbol *sym = symtab_lookup(table, name);
+    if (sym && sym->scope_level == table->scope_depth) {
+        return sym;
     }
     return NULL;  /* Not found */
 }
@@ -333,9 +473,10 @@ Symbol *symtab_lookup_function(SymbolTable *table, const char *name) {
     return NULL;
 }
 
-void symtab_mark_initialized(Symbol *sym) {
-    if (sym) {
+void symtab_mark_initialized(SymbolTable *table, Symbol *sym) {
+    if (sym && !sym->is_initialized) {
         sym->is_initialized = true;
+        sym->initialized_at = ++table->stamp;
     }
 }
 
@@ -344,41 +485,64 @@ void symtab_mark_initialized(Symbol *sym) {
  * ============================================================================
  */
 
-void symtab_error(SymbolTable *table, SourceLocation loc, const char *format, ...) {
-    table->error_count++;
-    
-    fprintf(stderr, "Semantic error at line %d", loc.first_line);
+/* Print one diagnostic line, or keep it if the table buffers them */
+static void report(SymbolTable *table, const char *kind, SourceLocation loc,
+                   const char *format, va_list args) {
+    char head[64];
+    int head_len;
     if (loc.first_column > 0) {
-        fprintf(stderr, ":%d", loc.first_column);
+        head_len = snprintf(head, sizeof(head), "%s at line %d:%d: ",
+                            kind, loc.first_line, loc.first_column);
+    } else {
+        head_len = snprintf(head, sizeof(head), "%s at line %d: ", kind, loc.first_line);
+    }
+    
+    va_list copy;
+    va_copy(copy, args);
+    int body_len = vsnprintf(NULL, 0, format, copy);
+    va_end(copy);
+    
+    char *message = safe_malloc((size_t)head_len + (size_t)body_len + 1);
+    memcpy(message, head, (size_t)head_len);
+    vsnprintf(message + head_len, (size_t)body_len + 1, format, args);
+    
+    if (!table->buffer_diagnostics) {
+        fprintf(stderr, "%s\n", message);
+        free(message);
+        return;
     }
-    fprintf(stderr, ": ");
+    
+    if (table->diagnostic_count == table->diagnostic_capacity) {
+        table->diagnostic_capacity = table->diagnostic_capacity ? table->diagnostic_capacity * 2 : 16;
+        table->diagnostics = realloc(table->diagnostics,
+                                     table->diagnostic_capacity * sizeof(SymbolDiagnostic));
+        if (!table->diagnostics) {
+            fprintf(stderr, "Fatal: Out of memory in symbol table\n");
+            exit(1);
+        }
+    }
+    table->diagnostics[table->diagnostic_count].group = table->diagnostic_group;
+    table->diagnostics[table->diagnostic_count].message = message;
+    table->diagnostic_count++;
+}
+
+void symtab_error(SymbolTable *table, SourceLocation loc, const char *format, ...) {
+    table->error_count++;
     
     va_list args;
     va_start(args, format);
-    vfprintf(stderr, format, args);
+    report(table, "Semantic error", loc, format, args);
     va_end(args);
-    
-    fprintf(stderr, "\n");
 }
 
 void symtab_warning(SymbolTable *table, SourceLocation loc, const char *format, ...) {
     table->warning_count++;
     
-    fprintf(stderr, "Warning at line %d", loc.first_line);
-    if (loc.first_column > 0) {
-        fprintf(stderr, ":%d", loc.first_column);
-    }
-    fprintf(stderr, ": ");
-    
     va_list args; /*special type of variable, ja extra argument dhore rakhar jonno use kora hoy*/
     va_start(args, format); /*extra arguments read শুরু করে।
-দ্বিতীয় parameter format দেয়ার কারণ: compiler জানে fixed parameters কোথায় শেষ হয়েছে, সেখান থেকে variable arguments শুরু।*/
-    vfprintf(stderr, format, args); /*normal fprintf এর মতোই print করে, কিন্তু এখানে arguments list আকারে দেওয়া হয়।
-তাই fprintf না, vfprintf লাগে।
-stderr এ print করছে বলে এটা diagnostic stream (errors/warnings) হিসেবে আলাদা থাকে।*/
-    va_end(args);/*variable argument access শেষ হয়েছে, cleanup/teardown step।*/
-    
-    fprintf(stderr, "\n");
+দ্বিতীয় parameter format দেয়ার কারণ: compiler জানে fixed parameters কোথায় শেষ হয়েছে, সেখান থেকে variable arguments শুরু।*/
+    report(table, "Warning", loc, format, args); /*stderr-এ print (বা buffer) করে, যাতে diagnostic stream (errors/warnings) আলাদা থাকে।*/
+    va_end(args);/*variable argument access শেষ হয়েছে, cleanup/teardown step।*/
 }
 
 int symtab_error_count(SymbolTable *table) {
@@ -389,6 +553,14 @@ int symtab_warning_count(SymbolTable *table) {
     return table->warning_count;
 }
 
+void symtab_buffer_diagnostics(SymbolTable *table, bool buffer) {
+    table->buffer_diagnostics = buffer;
+}
+
+void symtab_set_diagnostic_group(SymbolTable *table, int group) {
+    table->diagnostic_group = group;
+}
+
 /* ============================================================================
  * DEBUGGING / PRINTING
  * ============================================================================
@@ -438,8 +610,8 @@ void symtab_print_scope(Scope *scope) {
         
         if (sym->kind == SYMBOL_FUNCTION) {
             printf(" -> %s", type_to_string(sym->func_info.return_type));
-            if (sym->func_info.params) {
-                printf(" (params: %zu)", sym->func_info.params->count);
+            if (sym->func_info.param_count > 0) {
+                printf(" (params: %zu)", sym->func_info.param_count);
             }
         }
         
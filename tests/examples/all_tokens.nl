@@ -131,8 +131,10 @@ ask "Enter a number: " and store in userInput
 read userInput
 
 -- === SPECIAL KEYWORDS ===
-stop
-skip
+repeat 1 times
+    skip
+    stop
+end repeat
 
 -- === END OF TEST FILE ===
 display "All tokens tested successfully!"
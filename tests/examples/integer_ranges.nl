@@ -0,0 +1,44 @@
+-- NatureLang Example: Small and Large Integers
+-- Loop counters stay small enough for 32-bit (or narrower) C types,
+-- while values computed from them can still need all 64 bits
+
+-- Sum of squares below 100000: i fits 32 bits, i * i and the sum do not
+create a number called i and set it to 0
+create a number called sum and set it to 0
+while i is less than 100000 do
+    sum becomes sum plus i multiplied by i
+    i becomes i plus 1
+end while
+display sum
+
+-- A counter stepping down, and the value it stops at
+create a number called n and set it to 100
+while n is greater than 0 do
+    n becomes n minus 7
+end while
+display n
+
+-- Remainders of a small counter
+create a number called k and set it to 0
+create a number called odd and set it to 0
+while k is less than 50 do
+    odd becomes odd plus k % 2
+    k becomes k plus 1
+    k becomes k plus 1
+end while
+display odd
+display k
+
+-- Small values handed to a function and back
+define a function scale that takes x and returns number
+    give back x multiplied by 1000000
+end function
+
+create a number called j and set it to 0
+create a number called total and set it to 0
+repeat 5000 times
+    total becomes total plus scale(j)
+    j becomes j plus 1
+end repeat
+display total
+
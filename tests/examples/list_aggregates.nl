@@ -0,0 +1,35 @@
+-- NatureLang Example: List Aggregates
+-- Sums, extremes, counts and searches run over a list's storage in one
+-- runtime call instead of a for-each loop
+
+create a list called scores with 7, 3, 9, 3, 12, 5
+display "Total " plus the sum of scores plus ", best " plus the largest in scores plus ", worst " plus the smallest in scores
+
+-- Counting and finding a value (positions start at 0, -1 when absent)
+display the count of 3 in scores
+display the position of 9 in scores
+display the position of 42 in scores
+if scores contains 12 then
+    display "someone scored 12"
+end if
+
+-- Decimal lists give decimal results; a number is looked up as a decimal
+create a list called prices with 2.5, 0.25, 4
+display the sum of prices
+display prices contains 4
+
+-- Text lists can be searched and counted
+create a list called names with "ann", "bob", "ann"
+display the count of "ann" in names
+display names contains "cid"
+
+-- The same on a large list
+create a list called rolls with 100000 random numbers between 1 and 6
+display the smallest in rolls plus the largest in rolls
+
+-- Each phrase is one word to the lexer, in any case and with any spaces
+-- or tabs between its words; "of" works for the extremes as well as "in"
+display The  SUM of scores plus the largest of scores
+display the	smallest OF scores plus The Largest  In scores
+display THE count	of 3 in scores plus the smallest in scores
+display the Position  of 12 in scores plus the sum	of prices
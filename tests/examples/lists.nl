@@ -0,0 +1,40 @@
+-- NatureLang Example: Typed Lists
+-- Every list holds one element type, chosen when it is created: numbers,
+-- decimals, text or flags each live in their own contiguous array
+
+-- A list of numbers, summed in a loop
+create a list called primes with 2, 3, 5, 7, 11
+create a number called total and set it to 0
+for each p in primes do
+    total becomes total plus p
+end for
+display total
+
+-- Numbers mixed with decimals make a list of decimals
+create a list called prices with 2, 4.5, 0.25
+create a decimal called sum and set it to 0
+for each price in prices do
+    sum becomes sum plus price
+end for
+display sum
+
+-- Text elements, read and replaced by position
+create a list called words with "red", "green", "blue"
+display item 1 of words
+set words at 1 to "yellow"
+for each w in words do
+    display w
+end for
+
+-- Flags
+create a list called answers with true, false, true
+for each answer in answers do
+    display answer
+end for
+
+-- A declared element type, starting out empty
+create a list of number called empty
+for each e in empty do
+    display e
+end for
+display primes[4] multiplied by 2
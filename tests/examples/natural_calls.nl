@@ -0,0 +1,32 @@
+-- NatureLang Example: Natural Calls as Operands
+-- "call f with ..." takes every argument up to the end of the expression,
+-- so it can be the last operand of an operator without brackets.
+-- Anywhere else it needs brackets: (call f with 2) plus y
+
+define a function tenfold that takes n and returns number
+    give back n multiplied by 10
+end function
+
+create a number called y and set it to 3
+
+-- Both spellings give 23
+display y plus call tenfold with 2
+display y plus (call tenfold with 2)
+
+-- Precedence still holds to the left of the call: 3 + 4 * 20 = 83
+display y plus 4 multiplied by call tenfold with 2
+
+-- The arguments are greedy: 3 - tenfold(2 + 1) = -27
+display y minus call tenfold with 2 plus 1
+display (call tenfold with 2) plus y
+
+-- Comparisons and between with a call on the right
+if y is less than call tenfold with 1 then
+    display "smaller than ten"
+end if
+if 15 is between y and call tenfold with 2 then
+    display "between three and twenty"
+end if
+
+-- A call inside the arguments of another call: tenfold(3 + tenfold(1)) = 130
+display call tenfold with y plus call tenfold with 1
@@ -0,0 +1,25 @@
+-- NatureLang Example: Number Formatting
+-- Numbers and decimals are shown with every digit they need and no more
+
+create a decimal called price and set it to 19.99
+create a decimal called tenth and set it to 0.1
+create a decimal called big and set it to 1234567.25
+create a number called count and set it to 9000000000
+
+display "Total: " plus big
+display price
+display tenth plus 0.2
+display big
+display 0.00001
+display count multiplied by 1000000000
+
+-- Conversions inside text are written straight into the result
+create a text called line and set it to "Price: " plus price plus ", count: " plus count
+display line
+create a text called report and set it to ""
+create a number called i and set it to 1
+while i is less than 4 do
+    report becomes report plus i plus "=" plus tenth multiplied by i plus " "
+    i becomes i plus 1
+end while
+display report
@@ -0,0 +1,60 @@
+-- NatureLang Example: Patterns the Performance Lint Reports
+-- `naturec check --perf-lint` warns about each loop below; the program
+-- itself is valid and runs
+
+-- Appending to a text inside a loop copies it on every iteration; from
+-- -O1 on the optimizer keeps it in a string builder instead, so only
+-- `naturec check -O0 --perf-lint` reports this loop
+create a text called line and set it to ""
+create a number called i and set it to 0
+while i is less than 100 do
+    line becomes line plus "*"
+    i becomes i plus 1
+end while
+display line
+
+-- Prepending cannot become an append, so it is reported at every level
+create a text called countdown and set it to ""
+i becomes 0
+while i is less than 10 do
+    countdown becomes i plus " " plus countdown
+    i becomes i plus 1
+end while
+display countdown
+
+-- A text built fresh in each iteration is fine
+repeat 3 times
+    create a text called row and set it to "a"
+    row becomes row plus "b"
+    display row
+end repeat
+
+-- Searching one list for every element of another
+create a list called wanted and set it to [2, 4, 6]
+create a list called found and set it to [1, 2, 3, 4]
+create a number called hits and set it to 0
+for each w in wanted do
+    for each f in found do
+        if f is equal to w then
+            hits becomes hits plus 1
+        end if
+    end for
+end for
+display hits
+
+-- Measuring a list the loop never changes in every test of the condition
+create a list called scores and set it to [7, 3, 9, 4]
+create a number called total and set it to 0
+create a number called k and set it to 0
+while k is less than length of scores do
+    total becomes total plus item k of scores
+    k becomes k plus 1
+end while
+display total
+
+-- A loop that replaces the list has to measure it again
+create a list called queue and set it to [4, 8, 15]
+while size of queue is greater than 1 do
+    queue becomes [16]
+end while
+display size of queue
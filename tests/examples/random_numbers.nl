@@ -0,0 +1,42 @@
+-- NatureLang Example: Random Numbers
+-- Seeding the generator makes a run repeatable; without a seed each run
+-- differs (set NL_SEED in the environment to repeat one)
+
+seed random with 2026
+
+-- A thousand dice rolls, made in one go
+create a list called rolls with 1000 random numbers between 1 and 6
+create a number called total and set it to 0
+create a flag called fair and set it to true
+for each roll in rolls do
+    total becomes total plus roll
+    if roll less than 1 then
+        fair becomes false
+    end if
+    if roll greater than 6 then
+        fair becomes false
+    end if
+end for
+display "Every roll between 1 and 6: " plus fair
+
+-- The same seed gives the same numbers again
+seed random with 7
+create a number called first_roll and set it to a random number between 1 and 100
+seed random with 7
+create a number called again and set it to a random number between 1 and 100
+display "Repeatable: " plus (first_roll equals again)
+
+-- A decimal between 0 and 1, and bounds given in either order
+create a decimal called chance and set it to a random decimal
+display "Chance below one: " plus (chance less than 1)
+display a random number between 10 and 1
+display total
+
+-- Each phrase is one word to the lexer, in any case and with any
+-- spaces or tabs between its words
+SEED   Random with 2026
+create a list called again_rolls with 1000 Random	NUMBERS between 1 and 6
+display "Same rolls again: " plus (the sum of again_rolls equals total)
+seed	random with 7
+display "Same first roll: " plus (a RANDOM  number between 1 and 100 equals first_roll)
+display "Decimal at least zero: " plus (a random	Decimal at least 0)
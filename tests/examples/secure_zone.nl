@@ -5,6 +5,13 @@
 create a number called globalCounter and set it to 0
 create a text called globalData and set it to "initial"
 
+-- Builds a text and a list that nothing outside the call can see
+define a function nextChecksum that takes n and returns number
+    create a text called tag and set it to "tag-" plus n plus "-" plus n
+    create a list called tags with tag, "spare"
+    give back n plus n plus 1
+end function
+
 -- Enter a secure zone where certain operations are restricted
 begin secure zone
     -- Can create local variables
@@ -32,6 +39,21 @@ safely do
     display safeCalc
 end safely
 
+-- Text built in a zone is released when the zone ends (with the runtime
+-- in region mode, NL_ALLOC=region), unless the zone hands it outside
+begin secure zone
+    create a number called checksum and set it to 0
+    repeat 20 times
+        checksum becomes nextChecksum(checksum)
+    end repeat
+    display "Checksum: " plus checksum
+end secure zone
+
+begin secure zone
+    globalData becomes "set in a zone, run " plus globalCounter
+end secure zone
+display globalData
+
 -- Back in normal mode - can do anything
 globalCounter becomes globalCounter plus 1
 display "Normal mode counter: "
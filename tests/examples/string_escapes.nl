@@ -0,0 +1,18 @@
+-- NatureLang Example: String Escapes
+-- Escapes are decoded in place inside the source buffer, so each decoded
+-- literal must come out right and leave the tokens after it untouched
+
+display "Say \"hi\" \x41\102C \\o/" plus "!"
+
+-- Literals glued to the next token
+create a text called row and set it to "a\tb"plus"\x7c"plus"c\\"
+display row
+display "line one\nline two"
+display "\"quoted\""plus" and \\backslashed\\"
+
+-- Decoding shrinks the literal; the rest of the line still scans
+create a number called width and set it to 7
+display "\x3d\x3d\x3d " plus width plus " \075\075\075"
+
+-- Escape letters are case-insensitive, like every other word
+display "\X41\Tend"
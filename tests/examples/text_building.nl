@@ -0,0 +1,40 @@
+-- NatureLang Example: Building Text
+-- A chain of "plus" on text is built in one string builder: numbers,
+-- decimals and flags are formatted straight into it, and the finished
+-- message is allocated once
+
+create a text called name and set it to "Ann"
+create a number called score and set it to 42
+create a decimal called ratio and set it to 87.5
+create a flag called passed and set it to true
+
+-- One message from seven pieces
+display name plus " scored " plus score plus " points (" plus ratio plus "%), passed: " plus passed
+
+-- A single piece of text joined to a number
+create a text called label and set it to "item " plus score
+display label
+
+-- A chain inside a function call inside a chain
+define a function shout that takes text words and returns text
+    give back words plus "!"
+end function
+display "[" plus shout(name plus " has " plus score) plus "]"
+
+-- A message longer than the builder's inline space
+create a text called line and set it to label plus ": " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus ", " plus name plus " (" plus score plus ")"
+display line
+
+-- Text built up across a loop is appended in place; reading it inside the
+-- loop sees everything appended so far
+create a text called report and set it to "rows:"
+create a number called row and set it to 1
+repeat 3 times
+    create a text called cells and set it to ""
+    for each p in [2, 3, 5] do
+        cells becomes cells plus " " plus p multiplied by row
+    end for
+    report becomes report plus " (" plus cells plus " )"
+    display report
+    row becomes row plus 1
+end repeat
@@ -94,6 +94,92 @@ run_test() {
     fi
 }
 
+# Test function: a program built by run_test must print the same under every
+# runtime allocator (NL_ALLOC=system, slab, region)
+alloc_test() {
+    local nl_file="$1"
+    local base=$(basename "$nl_file" .nl)
+    local bin_file="$OUT_DIR/$base"
+
+    printf "  %-25s " "alloc $base.nl"
+
+    if [ ! -x "$bin_file" ]; then
+        echo -e "${RED}FAIL (not built)${NC}"
+        inc_failed
+        return
+    fi
+    local expected actual mode
+    expected=$(NL_ALLOC=system timeout 5 "$bin_file" 2>&1 || true)
+    for mode in slab region; do
+        actual=$(NL_ALLOC=$mode timeout 5 "$bin_file" 2>&1 || true)
+        if [ "$actual" != "$expected" ]; then
+            echo -e "${RED}FAIL${NC} (NL_ALLOC=$mode output differs)"
+            inc_failed
+            return
+        fi
+    done
+    echo -e "${GREEN}PASS${NC} → system, slab, region agree"
+    inc_passed
+}
+
+# Test function: feed stdin to a program built by run_test and check one
+# line of its output (buffered display output must come out in order with
+# the prompts)
+input_test() {
+    local nl_file="$1"
+    local input="$2"
+    local line="$3"
+    local expected="$4"
+    local base=$(basename "$nl_file" .nl)
+    local bin_file="$OUT_DIR/$base"
+
+    printf "  %-25s " "input $base.nl"
+
+    if [ ! -x "$bin_file" ]; then
+        echo -e "${RED}FAIL (not built)${NC}"
+        inc_failed
+        return
+    fi
+    local actual
+    actual=$(printf "$input" | timeout 5 "$bin_file" 2>&1 | sed -n "${line}p" || true)
+    if [ "$actual" = "$expected" ]; then
+        echo -e "${GREEN}PASS${NC} → $actual"
+        inc_passed
+    else
+        echo -e "${RED}FAIL${NC} (expected: '$expected', got: '$actual')"
+        inc_failed
+    fi
+}
+
+# Test function: the performance lint must report exactly the given checks
+# (at -O1 unless an -O level comes first)
+lint_test() {
+    local level="-O1"
+    case "$1" in -O*) level="$1"; shift ;; esac
+    local nl_file="$1"
+    shift
+    local base=$(basename "$nl_file" .nl)
+
+    printf "  %-25s " "lint $level $base.nl"
+
+    local warnings
+    if ! warnings=$(ASAN_OPTIONS=detect_leaks=0 "$NATUREC" check $level --perf-lint "$nl_file" 2>&1 >/dev/null); then
+        echo -e "${RED}FAIL (check)${NC}"
+        inc_failed
+        return
+    fi
+    local actual=$(echo "$warnings" | sed -n 's/.*performance \[\([a-z-]*\)\].*/\1/p' | tr '\n' ' ')
+    local expected="$*"
+    [ -n "$expected" ] && expected="$expected "
+    if [ "$actual" = "$expected" ]; then
+        echo -e "${GREEN}PASS${NC} → ${actual:-no warnings}"
+        inc_passed
+    else
+        echo -e "${RED}FAIL${NC} (expected: '$expected', got: '$actual')"
+        inc_failed
+    fi
+}
+
 # ---- Tests ----
 
 # hello.nl: should print "Hello, World!"
@@ -108,6 +194,9 @@ run_test "$EXAMPLES/control_flow.nl" ""
 # functions.nl: first output should be "=== Function Examples ==="
 run_test "$EXAMPLES/functions.nl" "=== Function Examples ==="
 
+# natural_calls.nl: "call f with ..." as the last operand, with and without brackets
+run_test "$EXAMPLES/natural_calls.nl" "23"
+
 # between_operator.nl: compiles and runs
 run_test "$EXAMPLES/between_operator.nl" ""
 
@@ -117,6 +206,27 @@ run_test "$EXAMPLES/filler_words.nl" ""
 # synonyms.nl: compiles and runs
 run_test "$EXAMPLES/synonyms.nl" ""
 
+# integer_ranges.nl: narrowed loop counters, 64-bit sum of squares
+run_test "$EXAMPLES/integer_ranges.nl" "333328333350000"
+
+# lists.nl: typed number, decimal, text and flag lists; sum of primes first
+run_test "$EXAMPLES/lists.nl" "28"
+
+# text_building.nl: concatenation chains and loop accumulators built in a string builder
+run_test "$EXAMPLES/text_building.nl" "Ann scored 42 points (87.5%), passed: yes"
+
+# string_escapes.nl: escapes decoded in place, literals glued to the next token
+run_test "$EXAMPLES/string_escapes.nl" 'Say "hi" ABC \o/!'
+
+# number_format.nl: shortest round-trip decimals, numbers formatted inside text
+run_test "$EXAMPLES/number_format.nl" "Total: 1234567.25"
+
+# random_numbers.nl: seeded generator, bulk random lists, bounds in either order
+run_test "$EXAMPLES/random_numbers.nl" "Every roll between 1 and 6: yes"
+
+# list_aggregates.nl: sum, largest, smallest, count, position and contains on lists
+run_test "$EXAMPLES/list_aggregates.nl" "Total 39, best 12, worst 3"
+
 # natural_writing.nl: needs user input (asks for name)
 run_test "$EXAMPLES/natural_writing.nl" "" "needs_input"
 
@@ -129,6 +239,34 @@ run_test "$EXAMPLES/input_output.nl" "" "needs_input"
 # all_tokens.nl: needs user input (asks for input)
 run_test "$EXAMPLES/all_tokens.nl" "" "needs_input"
 
+# input_output.nl: the greeting is printed before the prompt, the answer after it
+input_test "$EXAMPLES/input_output.nl" 'Ann\n7\n' 2 "What is your name? Hello, "
+# Numbers are parsed in place; padding and CRLF endings are accepted, junk is an error
+input_test "$EXAMPLES/input_output.nl" 'Ann\n  42 \r\n' 7 "42"
+input_test "$EXAMPLES/input_output.nl" 'Ann\nabc\n' 6 "Runtime Error: expected a number on input line 2, got 'abc'"
+# random_numbers.nl: the random phrases in mixed case and spacing (no input)
+input_test "$EXAMPLES/random_numbers.nl" '' 6 "Same rolls again: yes"
+input_test "$EXAMPLES/random_numbers.nl" '' 7 "Same first roll: yes"
+input_test "$EXAMPLES/random_numbers.nl" '' 8 "Decimal at least zero: yes"
+# list_aggregates.nl: the aggregate phrases in mixed case and spacing (no input)
+input_test "$EXAMPLES/list_aggregates.nl" '' 11 "51"
+input_test "$EXAMPLES/list_aggregates.nl" '' 12 "15"
+input_test "$EXAMPLES/list_aggregates.nl" '' 13 "5"
+input_test "$EXAMPLES/list_aggregates.nl" '' 14 "10.75"
+
+# Functions and secure zones released as regions, lists and string builders
+alloc_test "$EXAMPLES/secure_zone.nl"
+alloc_test "$EXAMPLES/lists.nl"
+alloc_test "$EXAMPLES/text_building.nl"
+
+# perf_patterns.nl: one warning per reported loop, none for the clean ones;
+# the append the optimizer keeps in a string builder only at -O0
+lint_test "$EXAMPLES/perf_patterns.nl" text-concat-in-loop search-in-loop length-in-condition
+lint_test -O0 "$EXAMPLES/perf_patterns.nl" text-concat-in-loop text-concat-in-loop search-in-loop length-in-condition
+
+# integer_ranges.nl: loops without quadratic patterns
+lint_test "$EXAMPLES/integer_ranges.nl"
+
 # ---- Summary ----
 echo ""
 echo "=== Summary ==="
@@ -0,0 +1,283 @@
+#!/bin/bash
+# NatureLang Stress Tests
+# Feeds generated programs with very long expression chains, deep nesting
+# and huge flat scopes through every tree walk (semantic analysis, perf lint,
+# AST codegen, IR generation, compact AST round trip, teardown) and checks
+# that none of them crashes, that checking function bodies on several
+# threads reports exactly what one thread does, and that the streaming
+# front end (naturec --stream) produces the same C and diagnostics as the
+# batch one.
+#
+# Usage: stress_tests.sh [terms]    (default: 1000000 terms per chain)
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "$0")" && pwd)"
+ROOT_DIR="$(cd "$SCRIPT_DIR/../.." && pwd)"
+NATUREC="$ROOT_DIR/build/naturec"
+PARSER_TEST="$ROOT_DIR/build/parser_test"
+OUT_DIR="$ROOT_DIR/build/stress"
+TERMS="${1:-1000000}"
+
+# Colors
+GREEN='\033[0;32m'
+RED='\033[0;31m'
+NC='\033[0m'
+
+passed=0
+failed=0
+
+inc_passed() { passed=$((passed + 1)); }
+inc_failed() { failed=$((failed + 1)); }
+
+export ASAN_OPTIONS=detect_leaks=0
+
+mkdir -p "$OUT_DIR"
+
+echo ""
+echo "=== NatureLang Stress Tests ($TERMS-term chains) ==="
+echo ""
+
+for tool in "$NATUREC" "$PARSER_TEST"; do
+    if [ ! -x "$tool" ]; then
+        echo -e "${RED}Error: $tool not found${NC}"
+        echo "Run 'make compiler parser' first."
+        exit 1
+    fi
+done
+
+# ---- Generators ----
+
+# x plus x plus ... (a left-leaning tree TERMS levels deep)
+gen_sum_chain() {
+    awk -v n="$1" 'BEGIN {
+        print "create a number called x and set it to 1"
+        printf "display x"
+        for (i = 1; i < n; i++) printf " plus x"
+        print ""
+    }'
+}
+
+# x + x - x * x / x ... (mixed precedence)
+gen_mixed_chain() {
+    awk -v n="$1" 'BEGIN {
+        split("+ - * /", ops, " ")
+        print "create a number called x and set it to 2"
+        printf "display x"
+        for (i = 1; i < n; i++) printf " %s x", ops[i % 4 + 1]
+        print ""
+    }'
+}
+
+# Comparisons joined by and/or
+gen_logic_chain() {
+    awk -v n="$1" 'BEGIN {
+        print "create a number called x and set it to 1"
+        printf "display x is greater than 0"
+        for (i = 1; i < n; i++) printf (i % 2 ? " and x is less than 5" : " or x is equal to 1")
+        print ""
+    }'
+}
+
+# s plus s plus ... on text (string concatenation)
+gen_concat_chain() {
+    awk -v n="$1" 'BEGIN {
+        print "create a text called s and set it to \"ab\""
+        printf "display s"
+        for (i = 1; i < n; i++) printf " plus s"
+        print ""
+    }'
+}
+
+# x minus (x minus (...)) (a right-leaning tree, as deep as the parser allows)
+gen_paren_nest() {
+    awk -v d="$1" 'BEGIN {
+        print "create a number called x and set it to 1"
+        printf "display "
+        for (i = 0; i < d; i++) printf "x minus ("
+        printf "x"
+        for (i = 0; i < d; i++) printf ")"
+        print ""
+    }'
+}
+
+# if ... then / end if nested D deep
+gen_if_nest() {
+    awk -v d="$1" 'BEGIN {
+        print "create a number called x and set it to 1"
+        for (i = 0; i < d; i++) print "if x is greater than 0 then"
+        print "display x"
+        for (i = 0; i < d; i++) print "end if"
+    }'
+}
+
+# create ... called vN, N times in one scope, plus shadowing in nested scopes
+gen_declarations() {
+    awk -v n="$1" 'BEGIN {
+        for (i = 0; i < n; i++) printf "create a number called v%d and set it to %d\n", i, i
+        print "repeat 2 times"
+        for (i = 0; i < n; i += 1000) printf "    create a text called v%d and set it to \"inner\"\n", i
+        print "    display v0"
+        print "end repeat"
+        printf "display v0 plus v%d\n", n - 1
+    }'
+}
+
+# N functions between globals, every tenth with errors and warnings in its body
+gen_functions() {
+    awk -v n="$1" 'BEGIN {
+        print "create a number called g0 and set it to 0"
+        for (i = 0; i < n; i++) {
+            printf "define a function f%d that takes x and returns number\n", i
+            printf "    create a number called y and set it to x plus g%d\n", int(i / 10)
+            if (i % 10 == 3) {
+                print "    create a text called bad and set it to y"
+                printf "    display later%d\n", i
+                print "    display u"
+            }
+            if (i > 0) printf "    give back f%d(y)\n", i - 1
+            else print "    give back y"
+            print "end function"
+            if (i % 10 == 9) printf "create a number called g%d and set it to %d\n", int(i / 10) + 1, i
+            if (i % 10 == 3) printf "create a number called later%d\ncreate a number called u\n", i
+        }
+        printf "display f%d(1) plus missing\n", n - 1
+    }'
+}
+
+# ---- Checks ----
+
+# Every pass over the tree must finish without crashing
+stress_test() {
+    local name="$1"
+    local nl_file="$OUT_DIR/$name.nl"
+    shift
+    "$@" > "$nl_file"
+
+    printf "  %-25s " "$name"
+    if ! "$PARSER_TEST" -q -s -a --perf-lint "$nl_file" > /dev/null 2> "$OUT_DIR/$name.err"; then
+        echo -e "${RED}FAIL (semantic/AST codegen)${NC}"
+        tail -3 "$OUT_DIR/$name.err"
+        inc_failed
+        return
+    fi
+    if ! "$PARSER_TEST" -k -r "$nl_file" > /dev/null 2> "$OUT_DIR/$name.err"; then
+        echo -e "${RED}FAIL (compact AST/IR)${NC}"
+        tail -3 "$OUT_DIR/$name.err"
+        inc_failed
+        return
+    fi
+    if ! "$NATUREC" build -O1 -o "$OUT_DIR/$name.c" "$nl_file" > /dev/null 2> "$OUT_DIR/$name.err"; then
+        echo -e "${RED}FAIL (naturec)${NC}"
+        tail -3 "$OUT_DIR/$name.err"
+        inc_failed
+        return
+    fi
+    echo -e "${GREEN}PASS${NC}"
+    inc_passed
+}
+
+# Diagnostics must not depend on the number of semantic analysis threads
+jobs_test() {
+    local name="$1"
+    local nl_file="$OUT_DIR/$name.nl"
+    shift
+    "$@" > "$nl_file"
+
+    printf "  %-25s " "$name"
+    "$PARSER_TEST" -q -s -j 1 "$nl_file" > /dev/null 2> "$OUT_DIR/$name.j1.err" || true
+    "$PARSER_TEST" -q -s -j 4 "$nl_file" > /dev/null 2> "$OUT_DIR/$name.j4.err" || true
+    if ! grep -q "Semantic error" "$OUT_DIR/$name.j1.err"; then
+        echo -e "${RED}FAIL (no diagnostics)${NC}"
+        inc_failed
+    elif ! cmp -s "$OUT_DIR/$name.j1.err" "$OUT_DIR/$name.j4.err"; then
+        echo -e "${RED}FAIL (-j 1 and -j 4 differ)${NC}"
+        diff "$OUT_DIR/$name.j1.err" "$OUT_DIR/$name.j4.err" | head -5
+        inc_failed
+    else
+        echo -e "${GREEN}PASS${NC} ($(wc -l < "$OUT_DIR/$name.j1.err") diagnostics)"
+        inc_passed
+    fi
+}
+
+# The streaming front end must agree with the batch one
+stream_test() {
+    local name="$1"
+    local nl_file="$OUT_DIR/$name.nl"
+    shift
+    "$@" > "$nl_file"
+
+    printf "  %-25s " "$name"
+    local mode
+    for mode in batch stream; do
+        local flag=""
+        [ "$mode" = stream ] && flag="--stream"
+        rm -f "$OUT_DIR/$name.c"
+        "$NATUREC" build $flag -O1 -o "$OUT_DIR/$name.c" "$nl_file" 2>&1 > /dev/null \
+            | grep -v '^Generated:' > "$OUT_DIR/$name.$mode.err" || true
+        touch "$OUT_DIR/$name.c"
+        mv "$OUT_DIR/$name.c" "$OUT_DIR/$name.$mode.c"
+    done
+    if ! cmp -s "$OUT_DIR/$name.batch.err" "$OUT_DIR/$name.stream.err"; then
+        echo -e "${RED}FAIL (diagnostics differ)${NC}"
+        diff "$OUT_DIR/$name.batch.err" "$OUT_DIR/$name.stream.err" | head -5
+        inc_failed
+    elif ! cmp -s "$OUT_DIR/$name.batch.c" "$OUT_DIR/$name.stream.c"; then
+        echo -e "${RED}FAIL (generated C differs)${NC}"
+        inc_failed
+    else
+        echo -e "${GREEN}PASS${NC}"
+        inc_passed
+    fi
+}
+
+# A chain small enough for gcc must also compute the right value
+run_test() {
+    local name="$1"
+    local expected="$2"
+    local nl_file="$OUT_DIR/$name.nl"
+    shift 2
+    "$@" > "$nl_file"
+
+    printf "  %-25s " "$name"
+    local actual
+    actual=$("$NATUREC" run "$nl_file" 2> /dev/null | tail -1 || true)
+    if [ "$actual" = "$expected" ]; then
+        echo -e "${GREEN}PASS${NC} → $actual"
+        inc_passed
+    else
+        echo -e "${RED}FAIL${NC} (expected: '$expected', got: '$actual')"
+        inc_failed
+    fi
+}
+
+# ---- Tests ----
+
+stress_test sum_chain     gen_sum_chain "$TERMS"
+stress_test mixed_chain   gen_mixed_chain "$TERMS"
+stress_test logic_chain   gen_logic_chain $((TERMS / 4))
+stress_test concat_chain  gen_concat_chain $((TERMS / 10))
+stress_test paren_nest    gen_paren_nest 3000
+stress_test if_nest       gen_if_nest 2000
+stress_test declarations  gen_declarations $((TERMS / 10))
+jobs_test   functions     gen_functions $((TERMS / 100))
+stream_test stream_sum    gen_sum_chain $((TERMS / 10))
+stream_test stream_decls  gen_declarations $((TERMS / 10))
+stream_test stream_funcs  gen_functions $((TERMS / 100))
+stream_test stream_nest   gen_if_nest 2000
+
+run_test sum_chain_run    2000 gen_sum_chain 2000
+run_test if_nest_run      1    gen_if_nest 500
+
+# ---- Summary ----
+echo ""
+echo "=== Summary ==="
+echo -e "  Passed:  ${GREEN}$passed${NC}"
+echo -e "  Failed:  ${RED}$failed${NC}"
+echo ""
+
+if [ "$failed" -gt 0 ]; then
+    echo -e "${RED}Some stress tests failed!${NC}"
+    exit 1
+fi
+
+echo -e "${GREEN}✓ All stress tests passed!${NC}"